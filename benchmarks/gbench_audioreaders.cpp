@@ -0,0 +1,257 @@
+#include "benchmark/benchmark.h"
+#include <cstring>
+#include <ncine/IFile.h>
+#include <ncine/FileSystem.h>
+#include "IAudioLoader.h"
+#include "IAudioReader.h"
+
+namespace nc = ncine;
+
+const int Frequency = 44100;
+const int NumChannels = 2;
+const int BytesPerSample = 2;
+const int BytesPerSecond = Frequency * NumChannels * BytesPerSample;
+const unsigned int WavHeaderSize = 44;
+/// Ten seconds of 16 bits stereo samples
+const unsigned int WavDataSize = 10 * BytesPerSecond;
+const unsigned int BufferSize = 16 * 1024;
+
+/// The in-memory fixture files, decoded with `IFile::createFromMemory()`
+struct Fixtures
+{
+	Fixtures()
+	{
+		// A synthetic WAV file, so that the benchmark does not depend on the data directory
+		wavSize = WavHeaderSize + WavDataSize;
+		wav = nctl::makeUnique<unsigned char[]>(wavSize);
+		unsigned char *h = wav.get();
+		memcpy(h, "RIFF", 4);
+		write32(h + 4, 36 + WavDataSize);
+		memcpy(h + 8, "WAVEfmt ", 8);
+		write32(h + 16, 16);
+		write16(h + 20, 1);
+		write16(h + 22, NumChannels);
+		write32(h + 24, Frequency);
+		write32(h + 28, BytesPerSecond);
+		write16(h + 32, NumChannels * BytesPerSample);
+		write16(h + 34, BytesPerSample * 8);
+		memcpy(h + 36, "data", 4);
+		write32(h + 40, WavDataSize);
+		for (unsigned int i = 0; i < WavDataSize; i++)
+			h[WavHeaderSize + i] = static_cast<unsigned char>(i * 31 + (i >> 9));
+
+#if defined(WITH_VORBIS) && defined(NCINE_DATA_DIR)
+		// There is no Ogg encoder, the Vorbis fixture is read from the data directory if available
+		const nctl::String oggPath = nc::fs::joinPath(NCINE_DATA_DIR, "sounds/music.ogg");
+		if (nc::fs::isReadableFile(oggPath.data()))
+		{
+			nctl::UniquePtr<nc::IFile> file = nc::IFile::createReadFileHandle(oggPath.data());
+			file->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+			oggSize = file->size();
+			ogg = nctl::makeUnique<unsigned char[]>(oggSize);
+			file->read(ogg.get(), oggSize);
+		}
+#endif
+	}
+
+	nctl::UniquePtr<unsigned char[]> wav;
+	unsigned long int wavSize = 0;
+	nctl::UniquePtr<unsigned char[]> ogg;
+	unsigned long int oggSize = 0;
+
+	static void write16(unsigned char *dest, uint16_t value) { memcpy(dest, &value, 2); }
+	static void write32(unsigned char *dest, uint32_t value) { memcpy(dest, &value, 4); }
+};
+
+static Fixtures &fixtures()
+{
+	static Fixtures fixtures;
+	return fixtures;
+}
+
+/// Returns a loader for the fixture of the specified format, or `nullptr` if not available
+static nctl::UniquePtr<nc::IAudioLoader> createLoader(bool isOgg)
+{
+	Fixtures &f = fixtures();
+	if (isOgg && f.ogg == nullptr)
+		return nctl::UniquePtr<nc::IAudioLoader>();
+
+	nctl::UniquePtr<nc::IAudioLoader> loader = isOgg
+	                                               ? nc::IAudioLoader::createFromMemory("fixture.ogg", f.ogg.get(), f.oggSize)
+	                                               : nc::IAudioLoader::createFromMemory("fixture.wav", f.wav.get(), f.wavSize);
+	if (loader->hasLoaded() == false)
+		loader.reset(nullptr);
+	return loader;
+}
+
+static void parseHeader(benchmark::State &state, bool isOgg)
+{
+	if (createLoader(isOgg) == nullptr)
+	{
+		state.SkipWithError("The fixture file is not available");
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		nctl::UniquePtr<nc::IAudioLoader> loader = createLoader(isOgg);
+		benchmark::DoNotOptimize(loader->numSamples());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/// Decodes the whole fixture with reads of the size passed as argument
+static void decode(benchmark::State &state, bool isOgg)
+{
+	nctl::UniquePtr<nc::IAudioLoader> loader = createLoader(isOgg);
+	if (loader == nullptr)
+	{
+		state.SkipWithError("The fixture file is not available");
+		return;
+	}
+
+	const unsigned long int readSize = state.range(0);
+	nctl::UniquePtr<char[]> buffer = nctl::makeUnique<char[]>(readSize);
+	nctl::UniquePtr<nc::IAudioReader> reader = loader->createReader();
+
+	unsigned long int decodedBytes = 0;
+	for (auto _ : state)
+	{
+		reader->rewind();
+		unsigned long int bytes = 0;
+		do
+		{
+			bytes = reader->read(buffer.get(), readSize);
+			decodedBytes += bytes;
+		} while (bytes > 0);
+		benchmark::ClobberMemory();
+	}
+
+	// A sample includes every channel, as in `IAudioLoader::numSamples()`
+	const unsigned long int bytesPerFrame = loader->numChannels() * loader->bytesPerSample();
+	state.SetItemsProcessed(decodedBytes / bytesPerFrame);
+	state.SetBytesProcessed(decodedBytes);
+}
+
+/// Simulates the refill of an `AudioStream` queue during one second of playback, without an audio device
+/*! Like `AudioStream::enqueue()`, every frame all the played buffers are unqueued and at most one buffer is refilled.
+ *  The frame time in milliseconds is passed as the third argument, every 60th frame takes four times as long. */
+static void streamRefill(benchmark::State &state, bool isOgg)
+{
+	nctl::UniquePtr<nc::IAudioLoader> loader = createLoader(isOgg);
+	if (loader == nullptr)
+	{
+		state.SkipWithError("The fixture file is not available");
+		return;
+	}
+
+	const unsigned long int streamBufferSize = state.range(0);
+	const int numBuffers = static_cast<int>(state.range(1));
+	const float frameTime = state.range(2) / 1000.0f;
+	const float bytesPerSecond = static_cast<float>(loader->frequency() * loader->numChannels() * loader->bytesPerSample());
+
+	nctl::UniquePtr<char[]> memBuffer = nctl::makeUnique<char[]>(streamBufferSize);
+	nctl::UniquePtr<unsigned long int[]> queue = nctl::makeUnique<unsigned long int[]>(numBuffers);
+	nctl::UniquePtr<nc::IAudioReader> reader = loader->createReader();
+
+	unsigned long int decodedBytes = 0;
+	unsigned long int numUnderruns = 0;
+	for (auto _ : state)
+	{
+		reader->rewind();
+		int numQueued = 0;
+		// The bytes already played from the buffer at the front of the queue
+		float playedBytes = 0.0f;
+
+		for (int frame = 0; frame * frameTime < 1.0f; frame++)
+		{
+			// Unqueueing the processed buffers
+			const float frameDuration = (frame % 60 == 59) ? frameTime * 4.0f : frameTime;
+			playedBytes += frameDuration * bytesPerSecond;
+			int numProcessed = 0;
+			while (numProcessed < numQueued && playedBytes >= queue[numProcessed])
+			{
+				playedBytes -= queue[numProcessed];
+				numProcessed++;
+			}
+			if (numQueued > 0 && numProcessed == numQueued)
+				numUnderruns++;
+			for (int i = numProcessed; i < numQueued; i++)
+				queue[i - numProcessed] = queue[i];
+			numQueued -= numProcessed;
+			if (numQueued == 0)
+				playedBytes = 0.0f;
+
+			// Queueing a single buffer, looping the stream
+			if (numQueued < numBuffers)
+			{
+				unsigned long int bytes = reader->read(memBuffer.get(), streamBufferSize);
+				if (bytes < streamBufferSize)
+				{
+					reader->rewind();
+					bytes += reader->read(memBuffer.get() + bytes, streamBufferSize - bytes);
+				}
+				queue[numQueued++] = bytes;
+				decodedBytes += bytes;
+			}
+		}
+		benchmark::ClobberMemory();
+	}
+
+	const unsigned long int bytesPerFrame = loader->numChannels() * loader->bytesPerSample();
+	state.SetItemsProcessed(decodedBytes / bytesPerFrame);
+	state.SetBytesProcessed(decodedBytes);
+	state.counters["underruns/s"] = benchmark::Counter(static_cast<double>(numUnderruns) / state.iterations());
+	state.counters["latency_ms"] = benchmark::Counter(1000.0 * numBuffers * streamBufferSize / bytesPerSecond);
+}
+
+/// The buffer sizes, number of buffers and frame times in milliseconds of the refill simulation
+static void streamRefillArguments(benchmark::internal::Benchmark *bench)
+{
+	for (unsigned int bufferSize : { BufferSize / 4, BufferSize, BufferSize * 4 })
+	{
+		for (int numBuffers = 2; numBuffers <= 4; numBuffers++)
+		{
+			bench->Args({ bufferSize, numBuffers, 16 });
+			bench->Args({ bufferSize, numBuffers, 33 });
+		}
+	}
+}
+
+static void BM_ParseHeaderWav(benchmark::State &state)
+{
+	parseHeader(state, false);
+}
+BENCHMARK(BM_ParseHeaderWav);
+
+static void BM_ParseHeaderOgg(benchmark::State &state)
+{
+	parseHeader(state, true);
+}
+BENCHMARK(BM_ParseHeaderOgg);
+
+static void BM_DecodeWav(benchmark::State &state)
+{
+	decode(state, false);
+}
+BENCHMARK(BM_DecodeWav)->Arg(BufferSize / 4)->Arg(BufferSize)->Arg(BufferSize * 4)->Arg(BufferSize * 16);
+
+static void BM_DecodeOgg(benchmark::State &state)
+{
+	decode(state, true);
+}
+BENCHMARK(BM_DecodeOgg)->Arg(BufferSize / 4)->Arg(BufferSize)->Arg(BufferSize * 4)->Arg(BufferSize * 16);
+
+static void BM_StreamRefillWav(benchmark::State &state)
+{
+	streamRefill(state, false);
+}
+BENCHMARK(BM_StreamRefillWav)->Apply(streamRefillArguments);
+
+static void BM_StreamRefillOgg(benchmark::State &state)
+{
+	streamRefill(state, true);
+}
+BENCHMARK(BM_StreamRefillOgg)->Apply(streamRefillArguments);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,36 @@
+#include "benchmark/benchmark.h"
+#include <ncine/MipMapGenerator.h>
+#include <nctl/UniquePtr.h>
+
+const int Size = 1024;
+const unsigned int NumChannels = 4;
+
+static void generateChain(benchmark::State &state, ncine::MipMapGenerator::Filter filter)
+{
+	const int numLevels = ncine::MipMapGenerator::numLevels(Size, Size);
+	const unsigned long dataSize = ncine::MipMapGenerator::chainDataSize(Size, Size, NumChannels, numLevels);
+	nctl::UniquePtr<uint8_t[]> chain = nctl::makeUnique<uint8_t[]>(dataSize);
+	for (unsigned int i = 0; i < Size * Size * NumChannels; i++)
+		chain[i] = static_cast<uint8_t>(i * 37 + 11);
+
+	for (auto _ : state)
+	{
+		ncine::MipMapGenerator::generate(chain.get(), Size, Size, NumChannels, numLevels, filter);
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations() * Size * Size * NumChannels);
+}
+
+static void BM_GenerateBox(benchmark::State &state)
+{
+	generateChain(state, ncine::MipMapGenerator::Filter::BOX);
+}
+BENCHMARK(BM_GenerateBox);
+
+static void BM_GenerateKaiser(benchmark::State &state)
+{
+	generateChain(state, ncine::MipMapGenerator::Filter::KAISER);
+}
+BENCHMARK(BM_GenerateKaiser);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,85 @@
+#include "benchmark/benchmark.h"
+#include <ncine/PixelConversion.h>
+#include <nctl/UniquePtr.h>
+
+const unsigned int NumPixels = 512 * 512;
+
+struct PixelBuffers
+{
+	nctl::UniquePtr<uint8_t[]> rgb;
+	nctl::UniquePtr<uint8_t[]> rgba;
+	nctl::UniquePtr<uint8_t[]> dest;
+
+	PixelBuffers()
+	    : rgb(nctl::makeUnique<uint8_t[]>(NumPixels * 3)), rgba(nctl::makeUnique<uint8_t[]>(NumPixels * 4)),
+	      dest(nctl::makeUnique<uint8_t[]>(NumPixels * 4))
+	{
+		for (unsigned int i = 0; i < NumPixels * 3; i++)
+			rgb[i] = static_cast<uint8_t>(i * 53 + 7);
+		for (unsigned int i = 0; i < NumPixels * 4; i++)
+			rgba[i] = static_cast<uint8_t>(i * 37 + 11);
+	}
+};
+
+PixelBuffers buffers;
+
+static void BM_SwapRedBlueScalar(benchmark::State &state)
+{
+	const uint8_t *src = buffers.rgba.get();
+	uint8_t *dest = buffers.dest.get();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumPixels; i++)
+		{
+			dest[i * 4 + 0] = src[i * 4 + 2];
+			dest[i * 4 + 1] = src[i * 4 + 1];
+			dest[i * 4 + 2] = src[i * 4 + 0];
+			dest[i * 4 + 3] = src[i * 4 + 3];
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations() * NumPixels * 4);
+}
+BENCHMARK(BM_SwapRedBlueScalar);
+
+static void BM_SwapRedBlue(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		ncine::PixelConversion::swapRedBlue(buffers.rgba.get(), buffers.dest.get(), NumPixels);
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations() * NumPixels * 4);
+}
+BENCHMARK(BM_SwapRedBlue);
+
+static void BM_SwapRedBlueRgbScalar(benchmark::State &state)
+{
+	const uint8_t *src = buffers.rgb.get();
+	uint8_t *dest = buffers.dest.get();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumPixels; i++)
+		{
+			dest[i * 3 + 0] = src[i * 3 + 2];
+			dest[i * 3 + 1] = src[i * 3 + 1];
+			dest[i * 3 + 2] = src[i * 3 + 0];
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations() * NumPixels * 3);
+}
+BENCHMARK(BM_SwapRedBlueRgbScalar);
+
+static void BM_SwapRedBlueRgb(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		ncine::PixelConversion::swapRedBlueRgb(buffers.rgb.get(), buffers.dest.get(), NumPixels);
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations() * NumPixels * 3);
+}
+BENCHMARK(BM_SwapRedBlueRgb);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,197 @@
+#include "benchmark/benchmark.h"
+#include <mutex>
+#include <thread>
+#include <nctl/Array.h>
+#include <nctl/SpscQueue.h>
+#include <nctl/MpmcQueue.h>
+#include <nctl/MpscQueue.h>
+
+/// The number of elements pushed by every producer thread in an iteration
+const unsigned int NumElements = 16 * 1024;
+const unsigned int Capacity = 1024;
+
+/// A bounded queue protected by a mutex, the baseline for the lock-free ones
+template <class T>
+class MutexQueue
+{
+  public:
+	explicit MutexQueue(unsigned int capacity)
+	    : array_(capacity), head_(0), size_(0)
+	{
+		array_.setSize(capacity);
+	}
+
+	bool push(const T &element)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (size_ == array_.size())
+			return false;
+		array_[(head_ + size_) % array_.size()] = element;
+		size_++;
+		return true;
+	}
+
+	bool pop(T &element)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (size_ == 0)
+			return false;
+		element = array_[head_];
+		head_ = (head_ + 1) % array_.size();
+		size_--;
+		return true;
+	}
+
+  private:
+	std::mutex mutex_;
+	nctl::Array<T> array_;
+	unsigned int head_;
+	unsigned int size_;
+};
+
+struct Node : public nctl::MpscQueueNode
+{
+	explicit Node(unsigned int v)
+	    : value(v) {}
+	unsigned int value;
+};
+
+MutexQueue<unsigned int> mutexQueue(Capacity);
+MutexQueue<Node *> mutexNodeQueue(Capacity);
+nctl::SpscQueue<unsigned int> spscQueue(Capacity);
+nctl::MpmcQueue<unsigned int> mpmcQueue(Capacity);
+nctl::MpscQueue<Node> mpscQueue;
+
+template <class Queue>
+void pushElements(Queue &queue)
+{
+	for (unsigned int i = 0; i < NumElements; i++)
+	{
+		while (queue.push(i) == false)
+			std::this_thread::yield();
+	}
+}
+
+template <class Queue>
+void popElements(Queue &queue)
+{
+	unsigned int value = 0;
+	for (unsigned int i = 0; i < NumElements; i++)
+	{
+		while (queue.pop(value) == false)
+			std::this_thread::yield();
+		benchmark::DoNotOptimize(value);
+	}
+}
+
+/// The first thread pushes elements and the second one pops them
+template <class Queue>
+void singleProducerSingleConsumer(benchmark::State &state, Queue &queue)
+{
+	for (auto _ : state)
+	{
+		if (state.thread_index == 0)
+			pushElements(queue);
+		else
+			popElements(queue);
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+
+/// Even threads push elements and odd threads pop them
+template <class Queue>
+void multiProducerMultiConsumer(benchmark::State &state, Queue &queue)
+{
+	for (auto _ : state)
+	{
+		if (state.thread_index % 2 == 0)
+			pushElements(queue);
+		else
+			popElements(queue);
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+
+static void BM_MutexQueueSpsc(benchmark::State &state)
+{
+	singleProducerSingleConsumer(state, mutexQueue);
+}
+BENCHMARK(BM_MutexQueueSpsc)->Threads(2)->UseRealTime();
+
+static void BM_SpscQueue(benchmark::State &state)
+{
+	singleProducerSingleConsumer(state, spscQueue);
+}
+BENCHMARK(BM_SpscQueue)->Threads(2)->UseRealTime();
+
+static void BM_MutexQueueMpmc(benchmark::State &state)
+{
+	multiProducerMultiConsumer(state, mutexQueue);
+}
+BENCHMARK(BM_MutexQueueMpmc)->ThreadRange(2, 8)->UseRealTime();
+
+static void BM_MpmcQueue(benchmark::State &state)
+{
+	multiProducerMultiConsumer(state, mpmcQueue);
+}
+BENCHMARK(BM_MpmcQueue)->ThreadRange(2, 8)->UseRealTime();
+
+/// Every thread but the first pushes newly allocated nodes, the first thread pops and deletes all of them
+static void BM_MutexQueueMpsc(benchmark::State &state)
+{
+	const unsigned int numProducers = state.threads - 1;
+	for (auto _ : state)
+	{
+		if (state.thread_index > 0)
+		{
+			for (unsigned int i = 0; i < NumElements; i++)
+			{
+				Node *node = new Node(i);
+				while (mutexNodeQueue.push(node) == false)
+					std::this_thread::yield();
+			}
+		}
+		else
+		{
+			Node *node = nullptr;
+			for (unsigned int i = 0; i < NumElements * numProducers; i++)
+			{
+				while (mutexNodeQueue.pop(node) == false)
+					std::this_thread::yield();
+				delete node;
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_MutexQueueMpsc)->ThreadRange(2, 8)->UseRealTime();
+
+static void BM_MpscQueue(benchmark::State &state)
+{
+	const unsigned int numProducers = state.threads - 1;
+	for (auto _ : state)
+	{
+		if (state.thread_index > 0)
+		{
+			for (unsigned int i = 0; i < NumElements; i++)
+				mpscQueue.push(new Node(i));
+		}
+		else
+		{
+			for (unsigned int i = 0; i < NumElements * numProducers; i++)
+			{
+				Node *node = mpscQueue.pop();
+				while (node == nullptr)
+				{
+					std::this_thread::yield();
+					node = mpscQueue.pop();
+				}
+				delete node;
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_MpscQueue)->ThreadRange(2, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,110 @@
+#include "benchmark/benchmark.h"
+#include <nctl/Array.h>
+#include <nctl/String.h>
+#include <nctl/UniquePtr.h>
+#include <ncine/Font.h>
+#include "FontGlyph.h"
+
+namespace nc = ncine;
+
+const unsigned int Length = 1024;
+const unsigned int NumAsciiGlyphs = 96;
+const unsigned int FirstMultiByteGlyph = 0x4E00;
+// The FNT parser reads at most 1024 characters and 2048 kerning pairs
+const unsigned int MaxNumGlyphs = 1024;
+const unsigned int NumKernings = 2048;
+
+inline unsigned int glyphCodepoint(unsigned int index)
+{
+	return (index < NumAsciiGlyphs) ? index + 32 : FirstMultiByteGlyph + index - NumAsciiGlyphs;
+}
+
+/// Creates an in-memory AngelCode's `FNT` with ASCII glyphs, multi-byte glyphs and their kerning pairs
+void initFnt(nctl::String &fnt, unsigned int numGlyphs)
+{
+	fnt.format("info face=\"Benchmark\" size=32 bold=0 italic=0 charset=\"\" unicode=1 stretchH=100 smooth=1 aa=1 padding=0,0,0,0 spacing=1,1 outline=0\n");
+	fnt.formatAppend("common lineHeight=36 base=29 scaleW=1024 scaleH=1024 pages=1 packed=0 alphaChnl=1 redChnl=0 greenChnl=0 blueChnl=0\n");
+	fnt.formatAppend("page id=0 file=\"benchmark.png\"\n");
+	fnt.formatAppend("chars count=%u\n", numGlyphs);
+	for (unsigned int i = 0; i < numGlyphs; i++)
+	{
+		fnt.formatAppend("char id=%u x=%u y=%u width=20 height=24 xoffset=-1 yoffset=5 xadvance=%u page=0 chnl=15\n",
+		                 glyphCodepoint(i), (i % 32) * 32, (i / 32) * 32, 16 + i % 8);
+	}
+	const unsigned int numKerningsPerGlyph = NumKernings / numGlyphs;
+	fnt.formatAppend("kernings count=%u\n", numGlyphs * numKerningsPerGlyph);
+	for (unsigned int i = 0; i < numGlyphs; i++)
+	{
+		for (unsigned int j = 0; j < numKerningsPerGlyph; j++)
+			fnt.formatAppend("kerning first=%u second=%u amount=-1\n", glyphCodepoint(i), glyphCodepoint((i + j * 7) % numGlyphs));
+	}
+}
+
+nctl::UniquePtr<nc::Font> createFont(unsigned int numGlyphs)
+{
+	nctl::String fnt(numGlyphs * 96 + NumKernings * 48 + 512);
+	initFnt(fnt, numGlyphs);
+	return nctl::makeUnique<nc::Font>("Benchmark.fnt", reinterpret_cast<const unsigned char *>(fnt.data()), fnt.length());
+}
+
+void initText(nctl::Array<unsigned int> &text, unsigned int numGlyphs)
+{
+	unsigned int seed = 12345;
+	for (unsigned int i = 0; i < Length; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		text.pushBack(glyphCodepoint((seed >> 16) % numGlyphs));
+	}
+}
+
+static void BM_FontGlyph(benchmark::State &state)
+{
+	const unsigned int numGlyphs = NumAsciiGlyphs + state.range(0);
+	nctl::UniquePtr<nc::Font> font = createFont(numGlyphs);
+	nctl::Array<unsigned int> text(Length);
+	initText(text, numGlyphs);
+
+	for (auto _ : state)
+	{
+		int xAdvance = 0;
+		for (unsigned int i = 0; i < Length; i++)
+		{
+			const nc::FontGlyph *glyph = font->glyph(text[i]);
+			if (glyph)
+				xAdvance += glyph->xAdvance();
+		}
+		benchmark::DoNotOptimize(xAdvance);
+	}
+
+	state.SetItemsProcessed(state.iterations() * Length);
+}
+BENCHMARK(BM_FontGlyph)->Arg(0)->Arg(32)->Arg(256)->Arg(MaxNumGlyphs - NumAsciiGlyphs);
+
+static void BM_FontGlyphKerning(benchmark::State &state)
+{
+	const unsigned int numGlyphs = NumAsciiGlyphs + state.range(0);
+	nctl::UniquePtr<nc::Font> font = createFont(numGlyphs);
+	nctl::Array<unsigned int> text(Length);
+	initText(text, numGlyphs);
+
+	for (auto _ : state)
+	{
+		int xAdvance = 0;
+		for (unsigned int i = 0; i < Length; i++)
+		{
+			const nc::FontGlyph *glyph = font->glyph(text[i]);
+			if (glyph)
+			{
+				xAdvance += glyph->xAdvance();
+				if (i + 1 < Length)
+					xAdvance += font->kerning(text[i], text[i + 1]);
+			}
+		}
+		benchmark::DoNotOptimize(xAdvance);
+	}
+
+	state.SetItemsProcessed(state.iterations() * Length);
+}
+BENCHMARK(BM_FontGlyphKerning)->Arg(0)->Arg(32)->Arg(256)->Arg(MaxNumGlyphs - NumAsciiGlyphs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,203 @@
+#include "benchmark/benchmark.h"
+#include <nctl/Atomic.h>
+#include "ThreadPool.h"
+
+namespace nc = ncine;
+
+const unsigned int NumCommands = 16 * 1024;
+/// The number of iterations of the busy loop in a command, to make it fine-grained but not empty
+const unsigned int CommandWork = 64;
+/// The number of commands enqueued by a command of the spawning benchmark
+const unsigned int NumChildren = 4;
+
+nctl::Atomic32 numExecuted;
+
+static void doWork()
+{
+	unsigned int value = 0;
+	for (unsigned int i = 0; i < CommandWork; i++)
+		benchmark::DoNotOptimize(value += i);
+	numExecuted.fetchAdd(1, nctl::Atomic32::MemoryModel::RELAXED);
+}
+
+/// A command that only performs a small amount of work
+class WorkCommand : public nc::IThreadCommand
+{
+  public:
+	void execute() override { doWork(); }
+};
+
+/// A command that enqueues its children on the pool before working, building a tree of commands
+class SpawnCommand : public nc::IThreadCommand
+{
+  public:
+	SpawnCommand(nc::ThreadPool &threadPool, unsigned int depth)
+	    : threadPool_(threadPool), depth_(depth) {}
+
+	void execute() override
+	{
+		if (depth_ > 0)
+		{
+			for (unsigned int i = 0; i < NumChildren; i++)
+				threadPool_.enqueueCommand(nctl::makeUnique<SpawnCommand>(threadPool_, depth_ - 1));
+		}
+		doWork();
+	}
+
+  private:
+	nc::ThreadPool &threadPool_;
+	unsigned int depth_;
+};
+
+/// Enqueues the children of a tree of functions, the function counterpart of `SpawnCommand`
+static void spawnFunctions(nc::ThreadPool *threadPool, unsigned int depth)
+{
+	if (depth > 0)
+	{
+		for (unsigned int i = 0; i < NumChildren; i++)
+			threadPool->enqueue([threadPool, depth]() { spawnFunctions(threadPool, depth - 1); });
+	}
+	doWork();
+}
+
+static void waitForCommands(int32_t numCommands)
+{
+	while (numExecuted.load(nctl::Atomic32::MemoryModel::ACQUIRE) < numCommands)
+		nc::Thread::yieldExecution();
+}
+
+/// Returns the number of commands in a tree of the specified depth
+static unsigned int treeSize(unsigned int depth)
+{
+	unsigned int size = 1;
+	unsigned int levelSize = 1;
+	for (unsigned int i = 0; i < depth; i++)
+	{
+		levelSize *= NumChildren;
+		size += levelSize;
+	}
+	return size;
+}
+
+static void BM_Serial(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		numExecuted.store(0);
+		for (unsigned int i = 0; i < NumCommands; i++)
+		{
+			WorkCommand command;
+			command.execute();
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NumCommands);
+}
+BENCHMARK(BM_Serial);
+
+/// Commands enqueued by the main thread, going through the injection queue
+static void BM_EnqueueExternal(benchmark::State &state)
+{
+	nc::ThreadPool threadPool(state.range(0));
+
+	for (auto _ : state)
+	{
+		numExecuted.store(0);
+		for (unsigned int i = 0; i < NumCommands; i++)
+			threadPool.enqueueCommand(nctl::makeUnique<WorkCommand>());
+		waitForCommands(NumCommands);
+	}
+	state.SetItemsProcessed(state.iterations() * NumCommands);
+}
+BENCHMARK(BM_EnqueueExternal)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+/// Commands enqueued by the workers themselves, going through their deques and spreading by stealing
+static void BM_EnqueueNested(benchmark::State &state)
+{
+	nc::ThreadPool threadPool(state.range(0));
+	// A tree with 4^7 leaves, about as many commands as the external benchmark
+	const unsigned int depth = 7;
+	const unsigned int numCommands = treeSize(depth);
+
+	for (auto _ : state)
+	{
+		numExecuted.store(0);
+		threadPool.enqueueCommand(nctl::makeUnique<SpawnCommand>(threadPool, depth));
+		waitForCommands(numCommands);
+	}
+	state.SetItemsProcessed(state.iterations() * numCommands);
+}
+BENCHMARK(BM_EnqueueNested)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+/// Lambdas enqueued by the main thread, in pooled commands instead of allocated ones
+static void BM_EnqueueFunctionExternal(benchmark::State &state)
+{
+	nc::ThreadPool threadPool(state.range(0));
+
+	for (auto _ : state)
+	{
+		numExecuted.store(0);
+		for (unsigned int i = 0; i < NumCommands; i++)
+			threadPool.enqueue([]() { doWork(); });
+		waitForCommands(NumCommands);
+	}
+	state.SetItemsProcessed(state.iterations() * NumCommands);
+}
+BENCHMARK(BM_EnqueueFunctionExternal)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+/// Lambdas enqueued by the workers themselves
+static void BM_EnqueueFunctionNested(benchmark::State &state)
+{
+	nc::ThreadPool threadPool(state.range(0));
+	const unsigned int depth = 7;
+	const unsigned int numCommands = treeSize(depth);
+
+	for (auto _ : state)
+	{
+		numExecuted.store(0);
+		nc::ThreadPool *threadPoolPtr = &threadPool;
+		threadPool.enqueue([threadPoolPtr]() { spawnFunctions(threadPoolPtr, depth); });
+		waitForCommands(numCommands);
+	}
+	state.SetItemsProcessed(state.iterations() * numCommands);
+}
+BENCHMARK(BM_EnqueueFunctionNested)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+/// The cost of submitting a batch of commands, each one allocated on the heap, excluding their execution
+static void BM_SubmitCommands(benchmark::State &state)
+{
+	nc::ThreadPool threadPool(1);
+	const unsigned int batchSize = state.range(0);
+
+	for (auto _ : state)
+	{
+		numExecuted.store(0);
+		for (unsigned int i = 0; i < batchSize; i++)
+			threadPool.enqueueCommand(nctl::makeUnique<WorkCommand>());
+		state.PauseTiming();
+		waitForCommands(batchSize);
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_SubmitCommands)->Arg(64)->Arg(512)->UseRealTime();
+
+/// The cost of submitting a batch of lambdas, without any allocation, excluding their execution
+static void BM_SubmitFunctions(benchmark::State &state)
+{
+	nc::ThreadPool threadPool(1);
+	const unsigned int batchSize = state.range(0);
+
+	for (auto _ : state)
+	{
+		numExecuted.store(0);
+		for (unsigned int i = 0; i < batchSize; i++)
+			threadPool.enqueue([]() { doWork(); });
+		state.PauseTiming();
+		waitForCommands(batchSize);
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_SubmitFunctions)->Arg(64)->Arg(512)->UseRealTime();
+
+BENCHMARK_MAIN();
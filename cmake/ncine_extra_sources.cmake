@@ -92,6 +92,7 @@ if(OPENAL_FOUND)
 	list(APPEND HEADERS
 		${NCINE_ROOT}/include/ncine/AudioData.h
 		${NCINE_ROOT}/include/ncine/AudioBuffer.h
+		${NCINE_ROOT}/include/ncine/AudioBufferCache.h
 		${NCINE_ROOT}/include/ncine/AudioStream.h
 		${NCINE_ROOT}/include/ncine/IAudioPlayer.h
 		${NCINE_ROOT}/include/ncine/AudioBufferPlayer.h
@@ -104,6 +105,7 @@ if(OPENAL_FOUND)
 		${NCINE_ROOT}/src/include/AudioLoaderWav.h
 		${NCINE_ROOT}/src/include/AudioReaderWav.h
 		${NCINE_ROOT}/src/include/IAudioReader.h
+		${NCINE_ROOT}/src/include/AudioRingBuffer.h
 	)
 
 	list(APPEND SOURCES
@@ -113,12 +115,19 @@ if(OPENAL_FOUND)
 		${NCINE_ROOT}/src/audio/AudioReaderWav.cpp
 		${NCINE_ROOT}/src/audio/AudioData.cpp
 		${NCINE_ROOT}/src/audio/AudioBuffer.cpp
+		${NCINE_ROOT}/src/audio/AudioBufferCache.cpp
 		${NCINE_ROOT}/src/audio/AudioStream.cpp
 		${NCINE_ROOT}/src/audio/IAudioPlayer.cpp
 		${NCINE_ROOT}/src/audio/AudioBufferPlayer.cpp
 		${NCINE_ROOT}/src/audio/AudioStreamPlayer.cpp
+		${NCINE_ROOT}/src/audio/AudioRingBuffer.cpp
 	)
 
+	if(Threads_FOUND)
+		list(APPEND PRIVATE_HEADERS ${NCINE_ROOT}/src/include/AudioStreamDecoder.h)
+		list(APPEND SOURCES ${NCINE_ROOT}/src/audio/AudioStreamDecoder.cpp)
+	endif()
+
 	if(VORBIS_FOUND)
 		target_compile_definitions(ncine PRIVATE "WITH_VORBIS")
 		target_link_libraries(ncine PRIVATE Vorbis::Vorbisfile)
@@ -177,8 +186,14 @@ if(Threads_FOUND)
 		)
 	endif()
 
-	list(APPEND PRIVATE_HEADERS ${NCINE_ROOT}/src/include/ThreadPool.h)
-	list(APPEND SOURCES ${NCINE_ROOT}/src/threading/ThreadPool.cpp)
+	list(APPEND PRIVATE_HEADERS
+		${NCINE_ROOT}/src/include/WorkStealingDeque.h
+		${NCINE_ROOT}/src/include/ThreadPool.h
+	)
+	list(APPEND SOURCES
+		${NCINE_ROOT}/src/threading/WorkStealingDeque.cpp
+		${NCINE_ROOT}/src/threading/ThreadPool.cpp
+	)
 	list(APPEND PRIVATE_HEADERS ${NCINE_ROOT}/src/include/ThreadCommands.h)
 endif()
 
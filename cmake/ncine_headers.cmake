@@ -24,6 +24,8 @@ set(HEADERS
 	${NCINE_ROOT}/include/ncine/IAudioDevice.h
 	${NCINE_ROOT}/include/ncine/IThreadPool.h
 	${NCINE_ROOT}/include/ncine/IThreadCommand.h
+	${NCINE_ROOT}/include/ncine/Task.h
+	${NCINE_ROOT}/include/ncine/TaskGraph.h
 	${NCINE_ROOT}/include/ncine/IGfxCapabilities.h
 	${NCINE_ROOT}/include/ncine/ServiceLocator.h
 	${NCINE_ROOT}/include/ncine/DisplayMode.h
@@ -32,10 +34,22 @@ set(HEADERS
 	${NCINE_ROOT}/include/ncine/FontData.h
 	${NCINE_ROOT}/include/ncine/Font.h
 	${NCINE_ROOT}/include/ncine/FileSystem.h
+	${NCINE_ROOT}/include/ncine/DirectoryScanner.h
 	${NCINE_ROOT}/include/ncine/IFile.h
+	${NCINE_ROOT}/include/ncine/AssetPack.h
+	${NCINE_ROOT}/include/ncine/AssetPackBuilder.h
+	${NCINE_ROOT}/include/ncine/VirtualFileSystem.h
 	${NCINE_ROOT}/include/ncine/IGfxDevice.h
 	${NCINE_ROOT}/include/ncine/TextureData.h
 	${NCINE_ROOT}/include/ncine/Texture.h
+	${NCINE_ROOT}/include/ncine/AsyncTextureLoader.h
+	${NCINE_ROOT}/include/ncine/AsyncFileReader.h
+	${NCINE_ROOT}/include/ncine/TextureCache.h
+	${NCINE_ROOT}/include/ncine/TextureAtlas.h
+	${NCINE_ROOT}/include/ncine/SkylinePacker.h
+	${NCINE_ROOT}/include/ncine/PixelConversion.h
+	${NCINE_ROOT}/include/ncine/MipMapGenerator.h
+	${NCINE_ROOT}/include/ncine/ScreenCapture.h
 	${NCINE_ROOT}/include/ncine/SceneNode.h
 	${NCINE_ROOT}/include/ncine/BaseSprite.h
 	${NCINE_ROOT}/include/ncine/Sprite.h
@@ -54,6 +68,7 @@ set(HEADERS
 
 set(NCTL_HEADERS
 	${NCINE_ROOT}/include/nctl/algorithms.h
+	${NCINE_ROOT}/include/nctl/parallel_algorithms.h
 	${NCINE_ROOT}/include/nctl/iterator.h
 	${NCINE_ROOT}/include/nctl/type_traits.h
 	${NCINE_ROOT}/include/nctl/utility.h
@@ -83,6 +98,10 @@ set(NCTL_HEADERS
 	${NCINE_ROOT}/include/nctl/SparseSetIterator.h
 	${NCINE_ROOT}/include/nctl/ReverseIterator.h
 	${NCINE_ROOT}/include/nctl/Atomic.h
+	${NCINE_ROOT}/include/nctl/SpscQueue.h
+	${NCINE_ROOT}/include/nctl/MpmcQueue.h
+	${NCINE_ROOT}/include/nctl/MpscQueue.h
 	${NCINE_ROOT}/include/nctl/UniquePtr.h
 	${NCINE_ROOT}/include/nctl/SharedPtr.h
+	${NCINE_ROOT}/include/nctl/Function.h
 )
@@ -6,10 +6,16 @@ set(PRIVATE_HEADERS
 	${NCINE_ROOT}/src/include/FrameTimer.h
 	${NCINE_ROOT}/src/include/MemoryFile.h
 	${NCINE_ROOT}/src/include/StandardFile.h
+	${NCINE_ROOT}/src/include/MappedFile.h
+	${NCINE_ROOT}/src/include/PackFile.h
+	${NCINE_ROOT}/src/include/BlockCompression.h
+	${NCINE_ROOT}/src/include/AssetPackFormat.h
 	${NCINE_ROOT}/src/include/FileLogger.h
 	${NCINE_ROOT}/src/include/JoyMapping.h
 	${NCINE_ROOT}/src/input/JoyMappingDb.h
 	${NCINE_ROOT}/src/include/FntParser.h
+	${NCINE_ROOT}/src/include/FntBinary.h
+	${NCINE_ROOT}/src/include/CacheEviction.h
 	${NCINE_ROOT}/src/include/FontGlyph.h
 	${NCINE_ROOT}/src/include/GfxCapabilities.h
 	${NCINE_ROOT}/src/include/RenderResources.h
@@ -5,6 +5,9 @@ set(SOURCES
 	${NCINE_ROOT}/src/base/String.cpp
 	${NCINE_ROOT}/src/base/Clock.cpp
 	${NCINE_ROOT}/src/ServiceLocator.cpp
+	${NCINE_ROOT}/src/IThreadPool.cpp
+	${NCINE_ROOT}/src/Task.cpp
+	${NCINE_ROOT}/src/TaskGraph.cpp
 	${NCINE_ROOT}/src/FileLogger.cpp
 	${NCINE_ROOT}/src/ArrayIndexer.cpp
 	${NCINE_ROOT}/src/TimeStamp.cpp
@@ -13,11 +16,20 @@ set(SOURCES
 	${NCINE_ROOT}/src/FontData.cpp
 	${NCINE_ROOT}/src/Font.cpp
 	${NCINE_ROOT}/src/FntParser.cpp
+	${NCINE_ROOT}/src/FntBinary.cpp
 	${NCINE_ROOT}/src/FontGlyph.cpp
 	${NCINE_ROOT}/src/FileSystem.cpp
 	${NCINE_ROOT}/src/IFile.cpp
 	${NCINE_ROOT}/src/MemoryFile.cpp
 	${NCINE_ROOT}/src/StandardFile.cpp
+	${NCINE_ROOT}/src/MappedFile.cpp
+	${NCINE_ROOT}/src/PackFile.cpp
+	${NCINE_ROOT}/src/BlockCompression.cpp
+	${NCINE_ROOT}/src/AssetPack.cpp
+	${NCINE_ROOT}/src/AssetPackBuilder.cpp
+	${NCINE_ROOT}/src/VirtualFileSystem.cpp
+	${NCINE_ROOT}/src/AsyncFileReader.cpp
+	${NCINE_ROOT}/src/DirectoryScanner.cpp
 	${NCINE_ROOT}/src/input/IInputManager.cpp
 	${NCINE_ROOT}/src/input/JoyMapping.cpp
 	${NCINE_ROOT}/src/graphics/Color.cpp
@@ -37,6 +49,13 @@ set(SOURCES
 	${NCINE_ROOT}/src/graphics/TextureLoaderKtx.cpp
 	${NCINE_ROOT}/src/graphics/TextureData.cpp
 	${NCINE_ROOT}/src/graphics/Texture.cpp
+	${NCINE_ROOT}/src/graphics/AsyncTextureLoader.cpp
+	${NCINE_ROOT}/src/graphics/TextureCache.cpp
+	${NCINE_ROOT}/src/graphics/TextureAtlas.cpp
+	${NCINE_ROOT}/src/graphics/SkylinePacker.cpp
+	${NCINE_ROOT}/src/graphics/PixelConversion.cpp
+	${NCINE_ROOT}/src/graphics/MipMapGenerator.cpp
+	${NCINE_ROOT}/src/graphics/ScreenCapture.cpp
 	${NCINE_ROOT}/src/graphics/DrawableNode.cpp
 	${NCINE_ROOT}/src/graphics/SceneNode.cpp
 	${NCINE_ROOT}/src/graphics/BaseSprite.cpp
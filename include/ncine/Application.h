@@ -13,6 +13,11 @@ class FrameTimer;
 class SceneNode;
 class RenderQueue;
 class IInputManager;
+class AsyncTextureLoader;
+class AsyncFileReader;
+class ScreenCapture;
+class TextureCache;
+class AudioBufferCache;
 class IAppEventHandler;
 class ImGuiDrawing;
 class NuklearDrawing;
@@ -26,7 +31,7 @@ class DLL_PUBLIC Application
 	{
 		RenderingSettings()
 		    : batchingEnabled(true), batchingWithIndices(false),
-		      cullingEnabled(true), minBatchSize(4), maxBatchSize(500) {}
+		      cullingEnabled(true), minBatchSize(4), maxBatchSize(500), maxBatchTextures(4) {}
 
 		/// True if batching is enabled
 		bool batchingEnabled;
@@ -38,6 +43,8 @@ class DLL_PUBLIC Application
 		unsigned int minBatchSize;
 		/// Maximum size for a batch before a forced split
 		unsigned int maxBatchSize;
+		/// Maximum number of different textures in a batch of sprites, one disables multi-texture batching
+		unsigned int maxBatchTextures;
 	};
 
 	struct Timings
@@ -79,6 +86,17 @@ class DLL_PUBLIC Application
 	inline SceneNode &rootNode() { return *rootNode_; }
 	/// Returns the input manager instance
 	inline IInputManager &inputManager() { return *inputManager_; }
+	/// Returns the asynchronous texture loader instance
+	inline AsyncTextureLoader &asyncTextureLoader() { return *asyncTextureLoader_; }
+	/// Returns the asynchronous file reader instance
+	inline AsyncFileReader &asyncFileReader() { return *asyncFileReader_; }
+	/// Returns the texture cache instance
+	inline TextureCache &textureCache() { return *textureCache_; }
+	/// Returns the audio buffer cache instance
+	/*! \note The cache only exists when the engine is compiled with audio support and audio is enabled */
+	inline AudioBufferCache &audioBufferCache() { return *audioBufferCache_; }
+	/// Returns the asynchronous screen and texture capture instance
+	inline ScreenCapture &screenCapture() { return *screenCapture_; }
 
 	/// Returns the total number of frames already rendered
 	unsigned long int numFrames() const;
@@ -132,6 +150,11 @@ class DLL_PUBLIC Application
 	nctl::UniquePtr<SceneNode> rootNode_;
 	nctl::UniquePtr<IDebugOverlay> debugOverlay_;
 	nctl::UniquePtr<IInputManager> inputManager_;
+	nctl::UniquePtr<AsyncTextureLoader> asyncTextureLoader_;
+	nctl::UniquePtr<AsyncFileReader> asyncFileReader_;
+	nctl::UniquePtr<TextureCache> textureCache_;
+	nctl::UniquePtr<AudioBufferCache> audioBufferCache_;
+	nctl::UniquePtr<ScreenCapture> screenCapture_;
 	nctl::UniquePtr<IAppEventHandler> appEventHandler_;
 #ifdef WITH_IMGUI
 	nctl::UniquePtr<ImGuiDrawing> imguiDrawing_;
@@ -0,0 +1,82 @@
+#ifndef CLASS_NCINE_ASSETPACK
+#define CLASS_NCINE_ASSETPACK
+
+#include <cstdint>
+#include "common_defines.h"
+#include <nctl/String.h>
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+class IFile;
+
+/// A read-only archive of asset files, indexed by path
+/*! Packs are created by `AssetPackBuilder`. The index is used in place from a memory mapping and
+ * a lookup is a hash of the path followed by a few probes, while uncompressed entries are read
+ * straight from the mapping without any copy.
+ * A pack is mounted with `VirtualFileSystem::mountPack()` to make its entries available to
+ * the file handle factory methods. */
+class DLL_PUBLIC AssetPack
+{
+  public:
+	/// Opens an asset pack and validates its index
+	explicit AssetPack(const char *filename);
+	~AssetPack();
+
+	/// Returns true if the pack has been successfully opened and validated
+	inline bool isValid() const { return numSlots_ > 0; }
+	/// Returns true if the pack is accessed through a memory mapping
+	inline bool isMapped() const { return mappedData_ != nullptr; }
+	/// Returns the file name of the pack
+	inline const char *filename() const { return filename_.data(); }
+
+	/// Returns the number of entries in the pack
+	inline unsigned int numEntries() const { return numEntries_; }
+	/// Returns the index of the entry with the specified path, or -1 if it is not in the pack
+	int findEntry(const char *path) const;
+	/// Returns the path of the specified entry
+	nctl::String entryPath(unsigned int index) const;
+	/// Returns the size in bytes of the specified entry, once decompressed
+	unsigned long int entrySize(unsigned int index) const;
+	/// Returns true if the specified entry is stored compressed
+	bool isEntryCompressed(unsigned int index) const;
+
+  private:
+	/// File name of the pack
+	nctl::String filename_;
+	/// The handle of the pack file, kept opened while it is mapped
+	nctl::UniquePtr<IFile> fileHandle_;
+	/// A copy of the index, if the pack is not mapped in memory
+	nctl::UniquePtr<unsigned char[]> indexBuffer_;
+	/// Pointer to the beginning of the pack mapping
+	const unsigned char *mappedData_;
+
+	unsigned int numEntries_;
+	unsigned int numSlots_;
+	/// The open addressing hash table of entry indices, inside the index
+	const uint32_t *slots_;
+	/// The array of entry records, inside the index
+	const void *entries_;
+	/// The concatenated entry paths, inside the index
+	const char *paths_;
+
+	/// Validates the index and initializes the pointers inside it
+	bool useIndex(const unsigned char *indexPtr, unsigned long int indexSize, unsigned long int fileSize);
+	/// Returns the index of the entry with a path of the specified length, or -1 if it is not in the pack
+	int findEntry(const char *path, unsigned int length) const;
+	/// Returns a pointer to the entry data, either inside the mapping or inside the buffer, or `nullptr` on failure
+	/*! \note It can be called concurrently by different threads */
+	const unsigned char *loadEntry(unsigned int index, nctl::UniquePtr<unsigned char[]> &buffer) const;
+
+	/// Deleted copy constructor
+	AssetPack(const AssetPack &) = delete;
+	/// Deleted assignment operator
+	AssetPack &operator=(const AssetPack &) = delete;
+
+	/// The `PackFile` class needs to access `loadEntry()`
+	friend class PackFile;
+};
+
+}
+
+#endif
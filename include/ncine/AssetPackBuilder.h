@@ -0,0 +1,76 @@
+#ifndef CLASS_NCINE_ASSETPACKBUILDER
+#define CLASS_NCINE_ASSETPACKBUILDER
+
+#include "common_defines.h"
+#include <nctl/String.h>
+#include <nctl/Array.h>
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+/// A class to create asset pack archives that can be mounted with `AssetPack`
+/*! Files are only read when the pack is saved, one at a time, so that big packs can be created
+ * without holding all their content in memory.
+ * Entry paths always use forward slashes and are relative to the pack mount point.
+ * \note An entry added with the same path of a previous one replaces it */
+class DLL_PUBLIC AssetPackBuilder
+{
+  public:
+	/// Default alignment of entry data in bytes
+	static const unsigned int DefaultAlignment = 16;
+
+	AssetPackBuilder();
+
+	/// Returns the number of added entries
+	inline unsigned int numEntries() const { return entries_.size(); }
+
+	/// Returns the alignment of entry data in bytes
+	inline unsigned int alignment() const { return alignment_; }
+	/// Sets the alignment of entry data, it should be a power of two
+	bool setAlignment(unsigned int alignment);
+	/// Returns true if entries are compressed when it saves enough space
+	inline bool isCompressionEnabled() const { return compressionEnabled_; }
+	/// Sets the compression of entries, entries stored uncompressed can be accessed in place
+	inline void setCompressionEnabled(bool compressionEnabled) { compressionEnabled_ = compressionEnabled; }
+
+	/// Adds a file to the pack with the specified entry path
+	bool addFile(const char *path, const char *filename);
+	/// Adds a copy of a memory buffer to the pack with the specified entry path
+	bool addBuffer(const char *path, const unsigned char *bufferPtr, unsigned long int bufferSize);
+	/// Recursively adds all the files inside a directory, with entry paths relative to it
+	/*! \return The number of added files */
+	unsigned int addDirectory(const char *dirPath);
+
+	/// Writes the pack to a file
+	bool saveToFile(const char *filename);
+
+  private:
+	struct Entry
+	{
+		/// The normalized entry path
+		nctl::String path;
+		/// The file to read the data from, if the entry has not been added from a buffer
+		nctl::String filename;
+		/// A copy of the data, if the entry has been added from a buffer
+		nctl::UniquePtr<unsigned char[]> buffer;
+		unsigned long int bufferSize = 0;
+	};
+
+	nctl::Array<Entry> entries_;
+	unsigned int alignment_;
+	bool compressionEnabled_;
+
+	/// Adds a new entry with a normalized path, returns `nullptr` if the path is not valid
+	Entry *addEntry(const char *path);
+	/// Adds all the files inside a directory, with entry paths prefixed by `pathPrefix`
+	unsigned int addDirectory(const nctl::String &dirPath, const nctl::String &pathPrefix);
+
+	/// Deleted copy constructor
+	AssetPackBuilder(const AssetPackBuilder &) = delete;
+	/// Deleted assignment operator
+	AssetPackBuilder &operator=(const AssetPackBuilder &) = delete;
+};
+
+}
+
+#endif
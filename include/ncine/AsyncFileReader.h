@@ -0,0 +1,141 @@
+#ifndef CLASS_NCINE_ASYNCFILEREADER
+#define CLASS_NCINE_ASYNCFILEREADER
+
+#include "common_defines.h"
+#include <nctl/String.h>
+#include <nctl/Array.h>
+#include <nctl/SharedPtr.h>
+#include <nctl/UniquePtr.h>
+#include <nctl/Atomic.h>
+
+namespace ncine {
+
+/// A read of a whole file, or of a range of it, served in the background by `AsyncFileReader`
+/*! The state can be polled from any thread, the data can be accessed once the read is completed. */
+class DLL_PUBLIC AsyncRead
+{
+  public:
+	/// The states of a read
+	enum class State
+	{
+		PENDING,
+		COMPLETED,
+		FAILED,
+		CANCELED
+	};
+
+	/// Returns the name of the file to read
+	inline const char *filename() const { return filename_.data(); }
+	/// Returns the offset in bytes of the first byte to read
+	inline unsigned long int offset() const { return offset_; }
+
+	/// Returns the state of the read
+	State state() const;
+	/// Returns true if the read is not pending anymore
+	inline bool isDone() const { return state() != State::PENDING; }
+
+	/// Returns the read bytes, or `nullptr` if the read has not completed
+	const unsigned char *data() const;
+	/// Returns the number of read bytes, which can be less than requested if the file is shorter
+	unsigned long int size() const;
+	/// Moves the read bytes out of the request
+	nctl::UniquePtr<unsigned char[]> takeData();
+
+  private:
+	using CompletionCallback = void (*)(const AsyncRead &read, void *userData);
+
+	nctl::String filename_;
+	unsigned long int offset_;
+	/// The number of bytes to read, `AsyncFileReader::WholeFile` to read until the end of the file
+	unsigned long int requestedSize_;
+	CompletionCallback callback_;
+	void *userData_;
+
+	/// Written by the I/O worker before the state changes
+	nctl::UniquePtr<unsigned char[]> buffer_;
+	unsigned long int size_;
+	mutable nctl::Atomic32 state_;
+
+	AsyncRead(const char *filename, unsigned long int offset, unsigned long int size);
+
+	/// Atomically moves the read from the pending state to the specified one, fails if it has been canceled
+	bool finish(State state);
+
+	/// Deleted copy constructor
+	AsyncRead(const AsyncRead &) = delete;
+	/// Deleted assignment operator
+	AsyncRead &operator=(const AsyncRead &) = delete;
+
+	friend class AsyncFileReader;
+};
+
+/// A class to read files on a dedicated I/O thread, without blocking the caller
+/*! Reads are queued and served in batches: reads of the same file share a single handle and
+ * are served in offset order, so that a sequence of ranges is read without seeking, and bytes already
+ * read for an overlapping range are copied instead of being read again.
+ *
+ * Completion callbacks are invoked by `update()`, which the application calls on the main thread at
+ * the beginning of every frame, while the state of a read can be polled or waited for from any thread.
+ * \note Without a worker thread the reads are served by `update()` or `wait()` on the calling thread */
+class DLL_PUBLIC AsyncFileReader
+{
+  public:
+	/// The function invoked by `update()` when a read has completed or has failed
+	using CompletionCallback = void (*)(const AsyncRead &read, void *userData);
+
+	/// The size that requests a read until the end of the file
+	static const unsigned long int WholeFile = ~0UL;
+
+	explicit AsyncFileReader(bool withWorkerThread);
+	/// Cancels the reads that have not been served yet and stops the worker thread
+	~AsyncFileReader();
+
+	/// Queues the read of a whole file
+	nctl::SharedPtr<AsyncRead> readFile(const char *filename);
+	/// Queues the read of a whole file and invokes the callback when it is done
+	nctl::SharedPtr<AsyncRead> readFile(const char *filename, CompletionCallback callback, void *userData);
+	/// Queues the read of a range of a file
+	nctl::SharedPtr<AsyncRead> readRange(const char *filename, unsigned long int offset, unsigned long int size);
+	/// Queues the read of a range of a file and invokes the callback when it is done
+	nctl::SharedPtr<AsyncRead> readRange(const char *filename, unsigned long int offset, unsigned long int size, CompletionCallback callback, void *userData);
+
+	/// Cancels a read that has not been served yet, its callback will not be invoked
+	bool cancel(AsyncRead &read);
+	/// Blocks the calling thread until the read is done
+	/*! \note The completion callback is still invoked by the next `update()` */
+	void wait(const AsyncRead &read);
+
+	/// Invokes the completion callbacks of the reads that are done
+	void update();
+
+	/// Returns the number of reads whose callbacks have not been invoked yet
+	inline unsigned int numPendingReads() const { return requests_.size(); }
+	/// Returns the number of reads that have been served at least in part by copying the bytes of an overlapping read
+	inline unsigned int numCoalescedReads() const { return static_cast<unsigned int>(numCoalescedReads_.load()); }
+
+  private:
+	struct Worker;
+
+	/// The reads submitted by the caller, in submission order
+	nctl::Array<nctl::SharedPtr<AsyncRead>> requests_;
+	/// The I/O thread state, it is `nullptr` if reads are served by the calling thread
+	nctl::UniquePtr<Worker> worker_;
+	mutable nctl::Atomic32 numCoalescedReads_;
+
+	nctl::SharedPtr<AsyncRead> enqueueRead(nctl::SharedPtr<AsyncRead> read);
+	/// Serves the pending reads without a worker thread
+	void serveSynchronously();
+	/// Serves a batch of reads sorted by file name and offset
+	void serveBatch(nctl::Array<nctl::SharedPtr<AsyncRead>> &batch);
+
+	static void workerFunction(void *arg);
+
+	/// Deleted copy constructor
+	AsyncFileReader(const AsyncFileReader &) = delete;
+	/// Deleted assignment operator
+	AsyncFileReader &operator=(const AsyncFileReader &) = delete;
+};
+
+}
+
+#endif
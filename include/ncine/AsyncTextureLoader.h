@@ -0,0 +1,91 @@
+#ifndef CLASS_NCINE_ASYNCTEXTURELOADER
+#define CLASS_NCINE_ASYNCTEXTURELOADER
+
+#include "common_defines.h"
+#include "Colorf.h"
+#include "MipMapGenerator.h"
+#include <nctl/Array.h>
+#include <nctl/SharedPtr.h>
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+class Texture;
+
+/// A class to load textures without stalling the rendering thread
+/*! Texture files are decoded by the worker threads of the thread pool, while the upload to
+ * the GPU happens on the main thread, at the beginning of every frame, within an optional budget.
+ * A placeholder texture is returned immediately and its content is replaced when the upload is done.
+ * \note Without a thread pool the decoding happens on the main thread, one texture per frame */
+class DLL_PUBLIC AsyncTextureLoader
+{
+  public:
+	/// The function invoked on the main thread when a texture has been uploaded or has failed to load
+	using CompletionCallback = void (*)(Texture &texture, bool success, void *userData);
+
+	explicit AsyncTextureLoader(bool withThreadPool);
+	~AsyncTextureLoader();
+
+	/// Returns a placeholder texture while its file is being loaded asynchronously
+	nctl::UniquePtr<Texture> loadTexture(const char *filename);
+	/// Returns a placeholder texture and invokes the callback when its file has been loaded
+	nctl::UniquePtr<Texture> loadTexture(const char *filename, CompletionCallback callback, void *userData);
+
+	/// Returns the number of textures that are still being decoded or uploaded
+	inline unsigned int numPendingTextures() const { return requests_.size(); }
+
+	/// Returns the maximum number of bytes uploaded in a frame, zero means no limit
+	inline unsigned long uploadBudget() const { return uploadBudget_; }
+	/// Sets the maximum number of bytes uploaded in a frame, zero means no limit
+	/*! \note At least one texture is uploaded per frame, even if it exceeds the budget */
+	inline void setUploadBudget(unsigned long uploadBudget) { uploadBudget_ = uploadBudget; }
+
+	/// Returns true if a MIP map chain is generated by the worker threads for textures without one
+	inline bool generatesMipMaps() const { return generatesMipMaps_; }
+	/// Sets whether a MIP map chain is generated by the worker threads for textures without one
+	/*! \note Only uncompressed RGBA textures get a generated chain, the setting affects new requests */
+	inline void setGeneratesMipMaps(bool generatesMipMaps) { generatesMipMaps_ = generatesMipMaps; }
+	/// Returns the filter used to generate MIP map chains
+	inline MipMapGenerator::Filter mipMapFilter() const { return mipMapFilter_; }
+	/// Sets the filter used to generate MIP map chains
+	inline void setMipMapFilter(MipMapGenerator::Filter filter) { mipMapFilter_ = filter; }
+
+	/// Returns the color of the placeholder textures
+	inline const Colorf &placeholderColor() const { return placeholderColor_; }
+	/// Sets the color of the placeholder textures
+	inline void setPlaceholderColor(const Colorf &placeholderColor) { placeholderColor_ = placeholderColor; }
+
+  private:
+	struct Request;
+	class DecodeTextureCommand;
+
+	/// A flag indicating if decoding is performed by the thread pool
+	bool withThreadPool_;
+	/// Maximum number of bytes uploaded in a frame
+	unsigned long uploadBudget_;
+	/// A flag indicating if MIP map chains are generated after decoding
+	bool generatesMipMaps_;
+	/// The filter used to generate MIP map chains
+	MipMapGenerator::Filter mipMapFilter_;
+	/// The color of the placeholder textures
+	Colorf placeholderColor_;
+	/// Requests in submission order, shared with the decoding commands
+	nctl::Array<nctl::SharedPtr<Request>> requests_;
+
+	/// Uploads decoded textures within the budget and invokes completion callbacks
+	void update();
+	/// Detaches a texture that is being destroyed from its pending request
+	void cancel(const Texture *texture);
+
+	/// Deleted copy constructor
+	AsyncTextureLoader(const AsyncTextureLoader &) = delete;
+	/// Deleted assignment operator
+	AsyncTextureLoader &operator=(const AsyncTextureLoader &) = delete;
+
+	friend class Application;
+	friend class Texture;
+};
+
+}
+
+#endif
@@ -43,13 +43,20 @@ class DLL_PUBLIC AudioBuffer : public Object
 	/// Buffer size in bytes
 	unsigned long bufferSize_;
 
+	/// Constructor creating a buffer from samples that have already been decoded
+	AudioBuffer(const char *name, int numChannels, int frequency, const char *samples, unsigned long int samplesSize);
+
 	/// Loads audio samples based on information from the audio loader and reader
 	void load(IAudioLoader &audioLoader);
+	/// Uploads 16 bits samples to the OpenAL buffer
+	void loadSamples(int numChannels, int frequency, const char *samples, unsigned long int samplesSize);
 
 	/// Deleted copy constructor
 	AudioBuffer(const AudioBuffer &) = delete;
 	/// Deleted assignment operator
 	AudioBuffer &operator=(const AudioBuffer &) = delete;
+
+	friend class AudioBufferCache;
 };
 
 }
@@ -0,0 +1,94 @@
+#ifndef CLASS_NCINE_AUDIOBUFFERCACHE
+#define CLASS_NCINE_AUDIOBUFFERCACHE
+
+#include "common_defines.h"
+#include <nctl/SharedPtr.h>
+#include <nctl/HashMap.h>
+#include <nctl/HashMapIterator.h>
+#include <nctl/String.h>
+
+namespace ncine {
+
+class AudioBuffer;
+
+/// A cache that shares audio buffers decoded from the same file
+/*! Buffers are returned as shared pointers and the cache holds a reference of its own, so that a file
+ * is decoded and uploaded to OpenAL only once. When the memory budget is exceeded, the buffers that
+ * are not referenced outside of the cache are evicted, starting from the least recently used one. */
+class DLL_PUBLIC AudioBufferCache
+{
+  public:
+	/// A cache entry
+	struct Entry
+	{
+		Entry()
+		    : lastUse(0), dataSize(0) {}
+
+		/// The shared audio buffer
+		nctl::SharedPtr<AudioBuffer> buffer;
+		/// The value of the cache access counter when the buffer was last retrieved
+		unsigned long int lastUse;
+		/// The amount of memory used by the samples of the buffer when it was added to the cache
+		unsigned long dataSize;
+
+		/// Returns the number of references to the buffer held outside of the cache
+		inline unsigned int numReferences() const { return static_cast<unsigned int>(buffer.useCount() - 1); }
+	};
+
+	AudioBufferCache();
+
+	/// Returns the audio buffer decoded from the specified file, decoding it only if it is not in the cache
+	nctl::SharedPtr<AudioBuffer> retrieve(const char *filename);
+
+	/// Decodes the files of a manifest on the thread pool workers and adds them to the cache
+	/*! The calling thread takes part in decoding and waits for every file, then the samples are uploaded
+	 * to OpenAL on the calling thread. Files that are already in the cache or listed more than once are skipped.
+	 * \return The number of files added to the cache */
+	unsigned int preload(const char *const *filenames, unsigned int numFilenames);
+
+	/// Returns the number of cached buffers
+	inline unsigned int numEntries() const { return entries_.size(); }
+	/// Returns all cache entries, indexed by their file name
+	inline const nctl::StringHashMap<Entry> &entries() const { return entries_; }
+	/// Returns the amount of memory used by the samples of the cached buffers
+	inline unsigned long dataSize() const { return dataSize_; }
+
+	/// Returns the memory budget for the cache, zero means no limit
+	inline unsigned long memoryBudget() const { return memoryBudget_; }
+	/// Sets the memory budget for the cache, zero means no limit
+	void setMemoryBudget(unsigned long memoryBudget);
+
+	/// Evicts unreferenced buffers, least recently used first, until the memory budget is met
+	void trim();
+	/// Evicts every unreferenced buffer, regardless of the memory budget
+	void evictUnreferenced();
+
+  private:
+	/// The initial number of buckets for the entries hashmap
+	static const unsigned int InitialCapacity = 64;
+
+	nctl::StringHashMap<Entry> entries_;
+	/// Memory budget for the cache, zero means no limit
+	unsigned long memoryBudget_;
+	/// The running total of the memory used by the samples of the cached buffers
+	unsigned long dataSize_;
+	/// A counter incremented by every retrieval, used to find the least recently used entry
+	unsigned long int accessCounter_;
+	/// The string used to build the key of an entry
+	nctl::String keyString_;
+
+	/// Inserts a new buffer in the cache with the current key, growing the hashmap if needed
+	/*! \return False if a buffer with the same key is already in the cache */
+	bool insert(const nctl::SharedPtr<AudioBuffer> &buffer);
+	/// Evicts unreferenced buffers, least recently used first, until the data size is not greater than the target
+	void evict(unsigned long targetSize);
+
+	/// Deleted copy constructor
+	AudioBufferCache(const AudioBufferCache &) = delete;
+	/// Deleted assignment operator
+	AudioBufferCache &operator=(const AudioBufferCache &) = delete;
+};
+
+}
+
+#endif
@@ -12,6 +12,8 @@ class AudioBuffer;
 class DLL_PUBLIC AudioBufferPlayer : public IAudioPlayer
 {
   public:
+	/// A constructor creating a player with no buffer, to be set before playing
+	AudioBufferPlayer();
 	/// A constructor creating a player from a shared buffer
 	explicit AudioBufferPlayer(AudioBuffer *audioBuffer);
 	inline ~AudioBufferPlayer() override { stop(); }
@@ -21,6 +23,11 @@ class DLL_PUBLIC AudioBufferPlayer : public IAudioPlayer
 	int frequency() const override;
 	unsigned long bufferSize() const override;
 
+	/// Returns the audio buffer used by the player
+	inline const AudioBuffer *audioBuffer() const { return audioBuffer_; }
+	/// Sets the audio buffer used by the player, stopping it first
+	void setAudioBuffer(AudioBuffer *audioBuffer);
+
 	void play() override;
 	void pause() override;
 	void stop() override;
@@ -32,6 +39,16 @@ class DLL_PUBLIC AudioBufferPlayer : public IAudioPlayer
 
   private:
 	AudioBuffer *audioBuffer_;
+	/// The playback position in seconds reached while virtual
+	float virtualOffset_;
+
+	/// Returns the duration of the buffer in seconds
+	float duration() const;
+
+	void virtualize() override;
+	void devirtualize(unsigned int source) override;
+	/// Attaches the buffer to the source, applies the properties and starts playing
+	void playOnSource();
 
 	/// Deleted copy constructor
 	AudioBufferPlayer(const AudioBufferPlayer &) = delete;
@@ -2,13 +2,19 @@
 #define CLASS_NCINE_AUDIOSTREAM
 
 #include <nctl/StaticArray.h>
+#include <nctl/UniquePtr.h>
+#include <nctl/Atomic.h>
 
 namespace ncine {
 
 class AudioData;
 class IAudioReader;
+class AudioRingBuffer;
+class AudioStreamDecoder;
 
 /// Audio stream class
+/*! When the application runs with threads, the stream is decoded ahead by the audio thread into a ring buffer,
+ * otherwise it is decoded by the main thread when a buffer is queued. */
 class DLL_PUBLIC AudioStream
 {
   public:
@@ -52,18 +58,41 @@ class DLL_PUBLIC AudioStream
 	/// The associated reader to continuosly stream decoded data
 	nctl::UniquePtr<IAudioReader> audioReader_;
 
+	/// Size in bytes of the ring of data decoded ahead, four times the size of a streaming buffer
+	static const unsigned int RingBufferSize = 4 * BufferSize;
+	/// The audio thread decoding the stream, or `nullptr` if it is decoded when a buffer is queued
+	AudioStreamDecoder *decoder_;
+	/// The data decoded by the audio thread and not yet queued to OpenAL
+	nctl::UniquePtr<AudioRingBuffer> ringBuffer_;
+	/// Written by the main thread, read by the audio thread when it reaches the end of the stream
+	nctl::Atomic32 isLooping_;
+	/// Set by the audio thread when the whole stream has been decoded in the ring
+	nctl::Atomic32 isEndOfStream_;
+
 	/// Constructor creating an audio stream from a named memory buffer
 	AudioStream(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize);
 	/// Constructor creating an audio stream from an audio file
 	explicit AudioStream(const char *filename);
 	/// Constructor creating an audio stream from an audio data class
 	explicit AudioStream(AudioData &audioData);
+	/// Decodes up to the specified number of bytes in the ring, called by the audio thread
+	unsigned long int decodeAhead(unsigned int maxBytes);
+	/// Fills a memory buffer with decoded data, returns the number of bytes or zero if the data is not ready yet
+	unsigned long int fillBuffer(bool looping, bool &isEndOfStream);
+	/// Rewinds the reader and discards the data decoded ahead
+	void rewind();
+	/// Stops the source and unqueues every buffer without rewinding, to continue the stream on another source
+	void releaseSource(unsigned int source);
+	/// Discards decoded data to advance the stream while its player is virtual
+	bool skip(unsigned long int &bytes, bool looping);
+
 	/// Deleted copy constructor
 	AudioStream(const AudioStream &) = delete;
 	/// Deleted assignment operator
 	AudioStream &operator=(const AudioStream &) = delete;
 
 	friend class AudioStreamPlayer;
+	friend class AudioStreamDecoder;
 };
 
 }
@@ -35,11 +35,20 @@ class DLL_PUBLIC AudioStreamPlayer : public IAudioPlayer
 
   private:
 	AudioStream audioStream_;
+	/// The number of decoded bytes still to be skipped to catch up with the virtual playback position
+	unsigned long int virtualBytes_;
+
+	void virtualize() override;
+	void devirtualize(unsigned int source) override;
+	/// Discards the data played while virtual, returns false if the end of the stream has been reached
+	bool skipVirtualTime();
 
 	/// Deleted copy constructor
 	AudioStreamPlayer(const AudioStreamPlayer &) = delete;
 	/// Deleted assignment operator
 	AudioStreamPlayer &operator=(const AudioStreamPlayer &) = delete;
+
+	friend class ALAudioDevice;
 };
 
 }
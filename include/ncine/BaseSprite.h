@@ -8,6 +8,7 @@ namespace ncine {
 
 class Texture;
 class GLUniformBlockCache;
+struct TextureRegion;
 
 /// The base class for sprites
 /*! \note Users cannot create instances of this class */
@@ -28,6 +29,8 @@ class DLL_PUBLIC BaseSprite : public DrawableNode
 	inline Recti texRect() const { return texRect_; }
 	/// Sets the texture source rectangle for blitting
 	void setTexRect(const Recti &rect);
+	/// Sets both the texture object and the source rectangle from a texture region, like one from a `TextureAtlas`
+	void setTextureRegion(const TextureRegion &region);
 
 	/// Returns `true` if the sprite is horizontally flipped
 	inline bool isFlippedX() const { return flippedX_; }
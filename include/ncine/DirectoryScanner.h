@@ -0,0 +1,82 @@
+#ifndef CLASS_NCINE_DIRECTORYSCANNER
+#define CLASS_NCINE_DIRECTORYSCANNER
+
+#include <cstdint>
+#include "common_defines.h"
+#include "FileSystem.h"
+#include <nctl/String.h>
+#include <nctl/Array.h>
+#include <nctl/SharedPtr.h>
+
+namespace ncine {
+
+/// A class that lists a directory tree together with the metadata of every entry
+/*! Entries are read in a single pass: the type comes from the directory stream itself, while the
+ * metadata is retrieved with one `fstatat()` call relative to the directory being read, or directly
+ * from the directory stream on Windows. Subdirectories are scanned in parallel by the workers of
+ * the thread pool, if there is one, with the calling thread also taking part in the scan.
+ *
+ * Results can be cached, then a scan of the same directory with the same options returns the stored
+ * result until it is invalidated.
+ * \note The cache should only be accessed from one thread */
+class DLL_PUBLIC DirectoryScanner
+{
+  public:
+	/// A file or a directory found by a scan
+	struct Entry
+	{
+		/// The path relative to the scanned directory, with forward slashes as separators
+		nctl::String path;
+		/// The size in bytes of a file
+		long int size = 0;
+		/// The last modification time in seconds since the Unix epoch
+		int64_t modificationTime = 0;
+		/// The permissions mask, made of `FileSystem::Permission` values
+		int permissions = 0;
+		bool isDirectory = false;
+		bool isHidden = false;
+	};
+
+	/// The entries found by a scan
+	/*! Entries of a directory always come after the entry of the directory itself */
+	struct Result
+	{
+		/// The scanned directory
+		nctl::String path;
+		nctl::Array<Entry> entries;
+		/// The number of scanned directories, including the root
+		unsigned int numDirectories = 0;
+	};
+
+	/// The options of a scan
+	struct Options
+	{
+		/// Scans subdirectories too
+		bool recursive = true;
+		/// Retrieves size, modification time and permissions, otherwise only the type of entries is known
+		bool withMetadata = true;
+		/// Scans subdirectories with the thread pool workers
+		bool parallel = true;
+		/// Stores the result for the next scans with the same path and options
+		bool useCache = false;
+	};
+
+	/// Scans a directory tree with the default options
+	static nctl::SharedPtr<Result> scan(const char *path);
+	/// Scans a directory tree, returns an empty pointer if the path is not a directory
+	static nctl::SharedPtr<Result> scan(const char *path, const Options &options);
+
+	/// Removes the cached results of scans of the specified directory
+	static bool invalidateCache(const char *path);
+	/// Removes all the cached results
+	static void clearCache();
+	/// Returns the number of cached results
+	static unsigned int numCachedResults();
+
+	/// Converts the modification time of an entry to a local date
+	static FileSystem::FileDate fileDate(int64_t time);
+};
+
+}
+
+#endif
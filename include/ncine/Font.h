@@ -3,12 +3,14 @@
 
 #include "Object.h"
 #include "Vector2.h"
+#include <nctl/Array.h>
 #include <nctl/HashMap.h>
 
 namespace ncine {
 
 class FontData;
 class FntParser;
+class FntBinary;
 class FontGlyph;
 class Texture;
 
@@ -23,15 +25,17 @@ class DLL_PUBLIC Font : public Object
 		GLYPH_IN_ALPHA
 	};
 
-	/// Constructs the object from an AngelCode's `FNT` memory buffer and a texture
+	/// Constructs the object from an AngelCode's `FNT` or a binary font memory buffer without a texture
+	Font(const char *fntBufferName, const unsigned char *fntBufferPtr, unsigned long int fntBufferSize);
+	/// Constructs the object from an AngelCode's `FNT` or a binary font memory buffer and a texture
 	Font(const char *fntBufferName, const unsigned char *fntBufferPtr, unsigned long int fntBufferSize, const char *texFilename);
-	/// Constructs the object from an AngelCode's `FNT` memory buffer and a texture memory buffer
+	/// Constructs the object from an AngelCode's `FNT` or a binary font memory buffer and a texture memory buffer
 	Font(const char *fntBufferName, const unsigned char *fntBufferPtr, unsigned long int fntBufferSize,
 	     const char *texBufferName, const unsigned char *texBufferPtr, unsigned long int texBufferSize);
 
-	/// Constructs the object from an AngelCode's `FNT` file
+	/// Constructs the object from an AngelCode's `FNT` or a binary font file
 	explicit Font(const char *fntFilename);
-	/// Constructs the object from an AngelCode's `FNT` file and a texture file
+	/// Constructs the object from an AngelCode's `FNT` or a binary font file and a texture file
 	Font(const char *fntFilename, const char *texFilename);
 
 	/// Constructs the object from a FontData object
@@ -54,6 +58,8 @@ class DLL_PUBLIC Font : public Object
 	inline unsigned int numKernings() const { return numKernings_; }
 	/// Returns a constant pointer to a glyph
 	const FontGlyph *glyph(unsigned int glyphId) const;
+	/// Returns the kerning amount between two glyphs
+	int kerning(unsigned int firstGlyphId, unsigned int secondGlyphId) const;
 
 	inline RenderMode renderMode() const { return renderMode_; }
 
@@ -79,10 +85,26 @@ class DLL_PUBLIC Font : public Object
 	static const unsigned int GlyphArraySize = 256;
 	/// Array of font glyphs encoded in a single UTF-8 code unit
 	nctl::UniquePtr<FontGlyph[]> glyphArray_;
-	/// Maximum number of font glyphs stored in the hashmap (multi-byte UTF-8 characters)
-	static const unsigned int GlyphHashmapSize = 1024;
-	/// Hashmap of font glyphs encoded in more than one UTF-8 code unit
-	nctl::HashMap<unsigned short int, FontGlyph> glyphHashMap_;
+	/// Compact and contiguous table of font glyphs encoded in more than one UTF-8 code unit
+	nctl::Array<FontGlyph> glyphTable_;
+	/// Hashmap of indices in the glyph table, using the codepoint as a key
+	nctl::UniquePtr<nctl::HashMap<unsigned int, unsigned int>> glyphIndices_;
+
+	static const unsigned int InvalidCodepoint = ~0U;
+	static const unsigned int InvalidIndex = ~0U;
+	/// A structure holding the glyph table index of a recently used codepoint
+	struct GlyphCacheEntry
+	{
+		unsigned int codepoint = InvalidCodepoint;
+		unsigned int index = InvalidIndex;
+	};
+	/// Number of entries in the direct mapped cache of multi-byte glyphs (a power of two)
+	static const unsigned int GlyphCacheSize = 64;
+	/// Direct mapped cache of recently used glyphs encoded in more than one UTF-8 code unit
+	mutable GlyphCacheEntry glyphCache_[GlyphCacheSize];
+
+	/// Hashmap of kerning amounts, using the pair of glyph codepoints as a key
+	nctl::UniquePtr<nctl::HashMap<uint64_t, int>> kerningHashMap_;
 
 	RenderMode renderMode_;
 
@@ -91,14 +113,14 @@ class DLL_PUBLIC Font : public Object
 	/// Deleted assignment operator
 	Font &operator=(const Font &) = delete;
 
-	/// Retrieves font information from the FNT parser
-	void retrieveInfoFromFnt(const FntParser &fntParser);
+	/// Retrieves font information from the FNT parser or the binary font
+	template <class FntSource> void retrieveInfoFromFnt(const FntSource &fntSource);
 
 	/// Checks whether the FNT information are compatible with rendering or not
-	void checkFntInformation(const FntParser &fntParser);
+	template <class FntSource> void checkFntInformation(const FntSource &fntSource);
 
 	/// Determines the render mode based on the FNT information
-	void determineRenderMode(const FntParser &fntParser);
+	template <class FntSource> void determineRenderMode(const FntSource &fntSource);
 };
 
 }
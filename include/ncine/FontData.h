@@ -7,13 +7,15 @@
 namespace ncine {
 
 class FntParser;
+class FntBinary;
 class TextureData;
 class ITextureLoader;
 
 /// A Fnt parser wrapper class
 /*! The class offers a way to users to parse Fnt data, to load texture data
  * and check if they are valid before trying to create an actual Font class
- * \note The object can be reused to create multiple fonts */
+ * \note The object can be reused to create multiple fonts
+ * \note Binary fonts are recognized by their signature or by the `nfnt` file extension */
 class DLL_PUBLIC FontData
 {
   public:
@@ -33,17 +35,22 @@ class DLL_PUBLIC FontData
 	/// Returns the name of the buffer or file used to load Texture data from
 	const char *texFilename() const;
 
+	/// Converts an AngelCode's `FNT` file to the precompiled binary font format
+	static bool convertToBinary(const char *fntFilename, const char *binaryFilename);
+
   private:
 	/// A flag indicating if the loading process has been successful
 	bool isValid_;
 
 	/// A smart pointer to the Fnt parser object
 	nctl::UniquePtr<FntParser> fntParser_;
+	/// A smart pointer to the binary font object, used instead of the parser
+	nctl::UniquePtr<FntBinary> fntBinary_;
 	/// A smart pointer to the TextureData object
 	nctl::UniquePtr<TextureData> texData_;
 
 	/// Checks if the parsed FNT information is valid when used with the texture
-	bool checkFntInformation() const;
+	template <class FntSource> bool checkFntInformation(const FntSource &fntSource) const;
 
 	/// Deleted copy constructor
 	FontData(const FontData &) = delete;
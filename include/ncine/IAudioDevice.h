@@ -3,9 +3,20 @@
 
 #include "common_defines.h"
 
+namespace nctl {
+
+template <class T>
+class SharedPtr;
+
+}
+
 namespace ncine {
 
 class IAudioPlayer;
+class AudioBuffer;
+template <class T>
+class Vector3;
+using Vector3f = Vector3<float>;
 
 /// Audio device interface class
 class DLL_PUBLIC IAudioDevice
@@ -27,8 +38,10 @@ class DLL_PUBLIC IAudioDevice
 	/// Sets the listener gain value
 	virtual void setGain(float gain) = 0;
 
-	/// Returns the number of active players
+	/// Returns the number of active players, including the virtual ones
 	virtual unsigned int numPlayers() const = 0;
+	/// Returns the number of active players that are not holding a source
+	virtual unsigned int numVirtualPlayers() const = 0;
 	/// Returns the specified running player object
 	virtual const IAudioPlayer *player(unsigned int index) const = 0;
 
@@ -50,7 +63,20 @@ class DLL_PUBLIC IAudioDevice
 	virtual unsigned int nextAvailableSource() = 0;
 	/// Registers a new stream player for buffer update
 	virtual void registerPlayer(IAudioPlayer *player) = 0;
+	/// Plays a buffer once on a pooled player, without allocating one
+	/*! The player only keeps a pointer to the buffer, the sound is stopped if the buffer is destroyed while playing.
+	 *  \return False if every pooled player is busy */
+	virtual bool playOneShot(AudioBuffer &audioBuffer, float gain, float pitch, const Vector3f &position) = 0;
+	/// Plays a shared buffer once on a pooled player, holding a reference to the buffer until the sound stops
+	/*! A buffer retrieved from an `AudioBufferCache` cannot be evicted while it is playing.
+	 *  \return False if every pooled player is busy */
+	virtual bool playOneShot(const nctl::SharedPtr<AudioBuffer> &audioBuffer, float gain, float pitch, const Vector3f &position) = 0;
+	/// Stops the one-shot sounds that are playing the specified buffer, it is called when the buffer is destroyed
+	virtual void stopOneShots(const AudioBuffer &audioBuffer) = 0;
+
 	/// Updates players state (and buffer queue in the case of stream players)
+	/*! When there are more playing players than sources, the most important ones are given a source
+	 *  and the others become virtual. Players are ranked by priority first, then by their audible gain. */
 	virtual void updatePlayers() = 0;
 };
 
@@ -66,6 +92,7 @@ class DLL_PUBLIC NullAudioDevice : public IAudioDevice
 	void setGain(float gain) override {}
 
 	unsigned int numPlayers() const override { return 0; }
+	unsigned int numVirtualPlayers() const override { return 0; }
 	const IAudioPlayer *player(unsigned int index) const override { return nullptr; }
 
 	void stopPlayers() override {}
@@ -78,6 +105,9 @@ class DLL_PUBLIC NullAudioDevice : public IAudioDevice
 
 	unsigned int nextAvailableSource() override { return UnavailableSource; }
 	void registerPlayer(IAudioPlayer *player) override {}
+	bool playOneShot(AudioBuffer &audioBuffer, float gain, float pitch, const Vector3f &position) override { return false; }
+	bool playOneShot(const nctl::SharedPtr<AudioBuffer> &audioBuffer, float gain, float pitch, const Vector3f &position) override { return false; }
+	void stopOneShots(const AudioBuffer &audioBuffer) override {}
 	void updatePlayers() override {}
 };
 
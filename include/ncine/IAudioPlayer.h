@@ -3,6 +3,7 @@
 
 #include "Object.h"
 #include "Vector3.h"
+#include "TimeStamp.h"
 
 namespace ncine {
 
@@ -23,7 +24,7 @@ class DLL_PUBLIC IAudioPlayer : public Object
 	IAudioPlayer(ObjectType type);
 	~IAudioPlayer() override {}
 
-	/// Returns the OpenAL id of the player source
+	/// Returns the OpenAL id of the player source, or `IAudioDevice::UnavailableSource` if the player is virtual
 	inline unsigned int sourceId() const { return sourceId_; }
 	/// Returns the OpenAL id of the currently playing buffer
 	virtual unsigned int bufferId() const = 0;
@@ -49,12 +50,21 @@ class DLL_PUBLIC IAudioPlayer : public Object
 	inline bool isPaused() const { return state_ == PlayerState::PAUSED; }
 	/// Queries the stopped state of the player
 	inline bool isStopped() const { return state_ == PlayerState::STOPPED; }
+	/// Queries whether the player is playing or paused without holding an OpenAL source
+	/*! A virtual player is not heard but its playback position keeps advancing,
+	 *  it is given a source again by the device when it becomes important enough. */
+	bool isVirtual() const;
 
 	/// Queries the looping property of the player
 	inline bool isLooping() const { return isLooping_; }
 	/// Sets player looping property
 	inline void setLooping(bool isLooping) { isLooping_ = isLooping; }
 
+	/// Returns the player priority, players with a higher priority are the last ones to become virtual
+	inline int priority() const { return priority_; }
+	/// Sets the player priority
+	inline void setPriority(int priority) { priority_ = priority; }
+
 	/// Returns player gain value
 	inline float gain() const { return gain_; }
 	/// Sets player gain value
@@ -77,18 +87,32 @@ class DLL_PUBLIC IAudioPlayer : public Object
 	PlayerState state_;
 	/// Looping status flag
 	bool isLooping_;
+	/// Player priority when competing for a source
+	int priority_;
 	/// Player gain value
 	float gain_;
 	/// Player pitch value
 	float pitch_;
 	/// Player position in space
 	Vector3f position_;
+	/// The time of the last update of the playback position while virtual
+	TimeStamp virtualTimeStamp_;
 
 	/// Updates the state of the player if the source has done playing
 	/*! It is called every frame by the `IAudioDevice` class and it is
 	 *  also responsible for buffer queueing/unqueueing in stream players. */
 	virtual void updateState() = 0;
 
+	/// Releases the OpenAL source while playing, remembering the playback position
+	virtual void virtualize() = 0;
+	/// Resumes playing on the specified OpenAL source from the position reached while virtual
+	virtual void devirtualize(unsigned int source) = 0;
+
+	/// Applies the gain, pitch and position properties to the source
+	void applySourceProperties();
+	/// Returns the playback time elapsed since the last call, taking pitch into account
+	float advanceVirtualTime();
+
 	friend class ALAudioDevice;
 };
 
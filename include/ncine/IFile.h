@@ -18,7 +18,9 @@ class DLL_PUBLIC IFile
 		BASE = 0,
 		MEMORY,
 		STANDARD,
-		ASSET
+		ASSET,
+		MAPPED,
+		PACK
 	};
 
 	/// Open mode bitmask
@@ -66,6 +68,9 @@ class DLL_PUBLIC IFile
 	inline void setExitOnFailToOpen(bool shouldExitOnFailToOpen) { shouldExitOnFailToOpen_ = shouldExitOnFailToOpen; }
 	/// Returns true if the file is already opened
 	virtual bool isOpened() const;
+	/// Returns a pointer to the whole file content if it can be accessed in place, `nullptr` otherwise
+	/*! \note The pointer is valid as long as the file is opened */
+	virtual const unsigned char *mappedData() const { return nullptr; }
 
 	/// Returns file name with path
 	const char *filename() const { return filename_.data(); }
@@ -111,7 +116,15 @@ class DLL_PUBLIC IFile
 	static nctl::UniquePtr<IFile> createFromMemory(const unsigned char *bufferPtr, unsigned long int bufferSize);
 
 	/// Returns the proper file handle according to prepended tags
+	/*! \note The mounts of the `VirtualFileSystem` are not searched, so that files can be written to their real path */
 	static nctl::UniquePtr<IFile> createFileHandle(const char *filename);
+	/// Returns a file handle to read from, opened from its mount if the file is in the `VirtualFileSystem`
+	/*! \note Mounted files can be read-only, the handle should not be opened for writing */
+	static nctl::UniquePtr<IFile> createReadFileHandle(const char *filename);
+	/// Returns a read-only file handle whose content is mapped in memory, if supported by the file type
+	/*! \note Files mounted in the `VirtualFileSystem` are opened from their mount.
+	 *  If the mapping fails the handle falls back to buffered reads and `mappedData()` returns `nullptr` */
+	static nctl::UniquePtr<IFile> createMappedFileHandle(const char *filename);
 
   protected:
 	/// File type
@@ -137,8 +150,13 @@ class DLL_PUBLIC IFile
 	unsigned long int fileSize_;
 
   private:
+	/// Returns a file handle for the platform file system, without searching the virtual file system mounts
+	static nctl::UniquePtr<IFile> createPlatformFileHandle(const char *filename, bool mapped);
+
 	/// The `TextureSaverPng` class needs to access the `filePointer_`
 	friend class TextureSaverPng;
+	/// The `VirtualFileSystem` class needs to access `createPlatformFileHandle()`
+	friend class VirtualFileSystem;
 };
 
 }
@@ -2,6 +2,7 @@
 #define CLASS_NCINE_ITHREADCOMMAND
 
 #include "common_defines.h"
+#include <nctl/Function.h>
 
 namespace ncine {
 
@@ -15,6 +16,30 @@ class DLL_PUBLIC IThreadCommand
 	virtual void execute() = 0;
 };
 
+/// The function type accepted by `IThreadPool::enqueue()`, small lambdas are stored without allocating
+using ThreadFunction = nctl::Function<void()>;
+
+/// A command that executes a function
+class DLL_PUBLIC FunctionCommand : public IThreadCommand
+{
+  public:
+	FunctionCommand() {}
+	explicit FunctionCommand(ThreadFunction function)
+	    : function_(nctl::move(function)) {}
+
+	void execute() override { function_(); }
+
+	/// Returns true if the command holds a function to execute
+	inline bool hasFunction() const { return static_cast<bool>(function_); }
+	/// Sets the function to execute, replacing the previous one
+	inline void setFunction(ThreadFunction function) { function_ = nctl::move(function); }
+	/// Destroys the function and what it has captured
+	inline void resetFunction() { function_.reset(); }
+
+  private:
+	ThreadFunction function_;
+};
+
 }
 
 #endif
@@ -5,8 +5,17 @@
 #include "IThreadCommand.h"
 #include <nctl/UniquePtr.h>
 
+namespace nctl {
+
+template <class T>
+class SharedPtr;
+
+}
+
 namespace ncine {
 
+class Task;
+
 /// Thread pool interface class
 class DLL_PUBLIC IThreadPool
 {
@@ -15,6 +24,39 @@ class DLL_PUBLIC IThreadPool
 
 	/// Enqueues a command request for a worker thread
 	virtual void enqueueCommand(nctl::UniquePtr<IThreadCommand> threadCommand) = 0;
+	/// Enqueues a function for a worker thread, like a lambda
+	/*! The default implementation wraps the function in a newly allocated `FunctionCommand`,
+	 * a thread pool can override it to reuse its commands and avoid any allocation. */
+	virtual void enqueue(ThreadFunction function);
+	/// Returns the number of worker threads, zero if commands are never executed
+	/*! Submitted tasks, `parallelFor()` and the other parallel helpers, like the directory scanner, split their work
+	 * among this many workers plus the calling thread. With zero threads they do all the work on the calling thread.
+	 * The default implementation returns zero, so that a thread pool that does not override it is never waited upon. */
+	virtual unsigned int numThreads() const { return 0; }
+	/// Executes one of the pending commands on the calling thread, returns false if there are none
+	/*! The default implementation never finds a command, a waiting thread will only yield in that case */
+	virtual bool executePendingCommand() { return false; }
+
+	/// Enqueues a command as a task and returns its handle
+	/*! \note Without worker threads the command is executed immediately on the calling thread */
+	nctl::SharedPtr<Task> submit(nctl::UniquePtr<IThreadCommand> threadCommand);
+	/// Submits a task created by `Task::create()`, it is enqueued once all its dependencies have completed
+	void submit(nctl::SharedPtr<Task> task);
+	/// Enqueues a command as a task that starts after the completion of another one, and returns its handle
+	nctl::SharedPtr<Task> then(Task &task, nctl::UniquePtr<IThreadCommand> threadCommand);
+	/// Waits for the completion of a task, executing pending commands on the calling thread in the meantime
+	void wait(Task &task);
+
+	/// The function called by `parallelFor()` with a range of indices, from `begin` included to `end` excluded
+	using RangeFunction = void (*)(unsigned int begin, unsigned int end, void *userData);
+
+	/// Returns the number of indices in a chunk when splitting a range of the specified size, if no grain size is specified
+	unsigned int defaultGrainSize(unsigned int numIndices) const;
+	/// Calls a function on chunks of at most `grainSize` indices from `first` to `last`, until the whole range is covered
+	/*! Chunks are executed in parallel by the worker threads and by the calling thread, which returns once all of them
+	 * have been executed. A chunk always starts at a multiple of the grain size from `first`.
+	 * A grain size of zero is replaced by the value returned by `defaultGrainSize()`. */
+	void parallelFor(unsigned int first, unsigned int last, unsigned int grainSize, RangeFunction function, void *userData);
 };
 
 inline IThreadPool::~IThreadPool() {}
@@ -24,6 +66,8 @@ class DLL_PUBLIC NullThreadPool : public IThreadPool
 {
   public:
 	void enqueueCommand(nctl::UniquePtr<IThreadCommand> threadCommand) override {}
+	void enqueue(ThreadFunction function) override {}
+	unsigned int numThreads() const override { return 0; }
 };
 
 }
@@ -0,0 +1,40 @@
+#ifndef CLASS_NCINE_MIPMAPGENERATOR
+#define CLASS_NCINE_MIPMAPGENERATOR
+
+#include <cstdint>
+#include "common_defines.h"
+
+namespace ncine {
+
+/// MIP map chain generation methods for uncompressed images with 8 bits per channel
+/*! Each level is half the size of the previous one, rounded down and clamped to one pixel, as OpenGL expects.
+ * \note Levels are tightly packed one after the other, with the layout computed by `TextureFormat::calculateMipSizes()` */
+class DLL_PUBLIC MipMapGenerator
+{
+  public:
+	/// The filter used to downsample a level to the next one
+	enum class Filter
+	{
+		/// Averages each 2x2 block, with SSE2 or NEON kernels for four channel images
+		BOX,
+		/// A separable six taps Kaiser windowed sinc, sharper than the box filter
+		KAISER
+	};
+
+	/// Returns the number of levels of a complete MIP map chain, including the base one
+	static int numLevels(int width, int height);
+	/// Returns the size of a level in pixels, given the size of the base one
+	static int levelSize(int baseSize, int level);
+	/// Returns the size in bytes of a complete MIP map chain with the specified number of levels
+	static unsigned long chainDataSize(int width, int height, unsigned int numChannels, int numLevels);
+
+	/// Downsamples an image to the next MIP map level
+	static void downsample(const uint8_t *src, int srcWidth, int srcHeight, unsigned int numChannels, uint8_t *dest, Filter filter);
+	/// Fills all the levels after the base one of a tightly packed MIP map chain
+	/*! \note The base level must already be at the beginning of the buffer */
+	static void generate(uint8_t *pixels, int width, int height, unsigned int numChannels, int numLevels, Filter filter);
+};
+
+}
+
+#endif
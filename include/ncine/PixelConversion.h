@@ -0,0 +1,36 @@
+#ifndef CLASS_NCINE_PIXELCONVERSION
+#define CLASS_NCINE_PIXELCONVERSION
+
+#include <cstdint>
+#include "common_defines.h"
+
+namespace ncine {
+
+/// Pixel format conversion methods, with SSE2 or NEON kernels when available
+/*! Loaders use them at decode time, so that BGR and BGRA pixels can be uploaded as RGB and RGBA ones
+ * without a conversion by the driver. */
+class DLL_PUBLIC PixelConversion
+{
+  public:
+	/// The instruction set used by the conversion kernels
+	enum class Kernels
+	{
+		SCALAR,
+		SSE2,
+		NEON
+	};
+
+	/// Returns the instruction set used by the conversion kernels
+	static Kernels kernels();
+
+	/// Swaps the red and blue channels of four channel pixels, converting between BGRA and RGBA
+	/*! \note The source and destination buffers can be the same */
+	static void swapRedBlue(const uint8_t *src, uint8_t *dest, unsigned int numPixels);
+	/// Swaps the red and blue channels of three channel pixels, converting between BGR and RGB
+	/*! \note The source and destination buffers can be the same */
+	static void swapRedBlueRgb(const uint8_t *src, uint8_t *dest, unsigned int numPixels);
+};
+
+}
+
+#endif
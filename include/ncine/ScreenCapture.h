@@ -0,0 +1,76 @@
+#ifndef CLASS_NCINE_SCREENCAPTURE
+#define CLASS_NCINE_SCREENCAPTURE
+
+#include "common_defines.h"
+#include <nctl/Array.h>
+#include <nctl/SharedPtr.h>
+
+namespace ncine {
+
+class Texture;
+
+/// A class to save screenshots and texture contents without stalling the rendering thread
+/*! Pixels are read back into a pixel buffer object and copied out only when a fence says the GPU is done,
+ * then the image is encoded and written to disk by the worker threads of the thread pool.
+ * The file format is chosen by the extension, either PNG or WebP.
+ * \note Without a thread pool the encoding happens on the main thread, as soon as the pixels are available */
+class DLL_PUBLIC ScreenCapture
+{
+  public:
+	/// The function invoked on the main thread when a capture has been saved or has failed
+	using CompletionCallback = void (*)(const char *filename, bool success, void *userData);
+
+	explicit ScreenCapture(bool withThreadPool);
+	~ScreenCapture();
+
+	/// Captures the screen at the end of the current frame, returns false if the capture cannot be queued
+	bool captureScreen(const char *filename);
+	/// Captures the screen at the end of the current frame and invokes the callback when the file has been saved
+	bool captureScreen(const char *filename, CompletionCallback callback, void *userData);
+	/// Captures the current content of an uncompressed texture, returns false if the capture cannot be queued
+	bool captureTexture(Texture &texture, const char *filename);
+	/// Captures the current content of an uncompressed texture and invokes the callback when the file has been saved
+	bool captureTexture(Texture &texture, const char *filename, CompletionCallback callback, void *userData);
+
+	/// Returns the number of captures that are being read back, encoded or saved
+	inline unsigned int numPendingCaptures() const { return requests_.size(); }
+	/// Returns the maximum number of pending captures, new ones are refused when the limit is reached
+	inline unsigned int maxPendingCaptures() const { return maxPendingCaptures_; }
+	/// Sets the maximum number of pending captures, each one holds a full copy of the pixels
+	inline void setMaxPendingCaptures(unsigned int maxPendingCaptures) { maxPendingCaptures_ = (maxPendingCaptures > 0) ? maxPendingCaptures : 1; }
+
+  private:
+	struct Request;
+	class EncodeImageCommand;
+
+	/// Default maximum number of pending captures
+	static const unsigned int DefaultMaxPendingCaptures = 4;
+
+	/// A flag indicating if encoding is performed by the thread pool
+	bool withThreadPool_;
+	/// Maximum number of pending captures
+	unsigned int maxPendingCaptures_;
+	/// Captures in submission order, shared with the encoding commands
+	nctl::Array<nctl::SharedPtr<Request>> requests_;
+
+	/// Creates a request if the queue is not full and the file format is supported
+	Request *createRequest(const char *filename, CompletionCallback callback, void *userData);
+	/// Reads back the screen for the requests of this frame, collects finished readbacks and invokes completion callbacks
+	/*! \note It is called at the end of the frame, before swapping buffers */
+	void update();
+	/// Copies the pixels out of the buffer object once the fence is signaled, returns false if the GPU is not done yet
+	bool collectPixels(Request &request, bool wait);
+	/// Starts the encoding of a request with collected pixels
+	void encode(const nctl::SharedPtr<Request> &request);
+
+	/// Deleted copy constructor
+	ScreenCapture(const ScreenCapture &) = delete;
+	/// Deleted assignment operator
+	ScreenCapture &operator=(const ScreenCapture &) = delete;
+
+	friend class Application;
+};
+
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef CLASS_NCINE_SKYLINEPACKER
+#define CLASS_NCINE_SKYLINEPACKER
+
+#include "common_defines.h"
+#include "Rect.h"
+#include <nctl/Array.h>
+
+namespace ncine {
+
+/// A rectangle packer based on the skyline bottom-left heuristic
+/*! The packed area is described by a list of horizontal segments, the skyline.
+ * Every rectangle is placed where its top edge is the lowest, then the skyline is raised. */
+class DLL_PUBLIC SkylinePacker
+{
+  public:
+	SkylinePacker(int width, int height);
+
+	/// Returns the width of the packing area
+	inline int width() const { return width_; }
+	/// Returns the height of the packing area
+	inline int height() const { return height_; }
+	/// Returns the number of packed rectangles
+	inline unsigned int numRects() const { return numRects_; }
+	/// Returns the ratio between the packed area and the total one
+	inline float occupancy() const { return usedArea_ / static_cast<float>(width_ * height_); }
+
+	/// Packs a rectangle of the specified size, returns false if there is not enough space
+	bool insert(int width, int height, Recti &rect);
+	/// Removes all packed rectangles
+	void clear();
+
+  private:
+	/// A horizontal segment of the skyline
+	struct Segment
+	{
+		Segment()
+		    : x(0), y(0), width(0) {}
+		Segment(int xx, int yy, int ww)
+		    : x(xx), y(yy), width(ww) {}
+
+		int x;
+		int y;
+		int width;
+	};
+
+	int width_;
+	int height_;
+	unsigned int numRects_;
+	unsigned long usedArea_;
+	nctl::Array<Segment> skyline_;
+
+	/// Returns the vertical position of a rectangle starting at the specified segment, or -1 if it does not fit
+	int fitsAt(unsigned int index, int width, int height) const;
+	/// Raises the skyline at the specified segment with a newly packed rectangle
+	void addSegment(unsigned int index, const Recti &rect);
+};
+
+}
+
+#endif
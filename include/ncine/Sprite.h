@@ -21,6 +21,10 @@ class DLL_PUBLIC Sprite : public BaseSprite
 	Sprite(Texture *texture, float xx, float yy);
 	/// Constructor for a sprite with a texture and a specified position as a vector but no parent
 	Sprite(Texture *texture, const Vector2f &position);
+	/// Constructor for a sprite with a parent and a texture region, positioned in the relative origin
+	Sprite(SceneNode *parent, const TextureRegion &region);
+	/// Constructor for a sprite with a parent, a texture region and a specified relative position
+	Sprite(SceneNode *parent, const TextureRegion &region, float xx, float yy);
 
 	inline static ObjectType sType() { return ObjectType::SPRITE; }
 };
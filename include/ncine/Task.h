@@ -0,0 +1,83 @@
+#ifndef CLASS_NCINE_TASK
+#define CLASS_NCINE_TASK
+
+#include "common_defines.h"
+#include "IThreadCommand.h"
+#include <nctl/Array.h>
+#include <nctl/SharedPtr.h>
+#include <nctl/UniquePtr.h>
+#include <nctl/Atomic.h>
+
+namespace ncine {
+
+class IThreadPool;
+
+/// A thread command with a completion state and dependencies on other tasks
+/*! A task is executed by a thread pool once it has been submitted and all the tasks it depends on
+ * have completed. The state can be polled from any thread and the command can be accessed to read
+ * its results once the task is done. A task is created and submitted by `IThreadPool::submit()`,
+ * or it is created by `Task::create()` to add dependencies before submitting it.
+ * \note Dependencies should not form a cycle, the tasks in a cycle are never executed nor destroyed */
+class DLL_PUBLIC Task
+{
+  public:
+	/// The states of a task
+	enum class State
+	{
+		/// Waiting to be submitted or for its dependencies to complete
+		WAITING,
+		/// Enqueued to a thread pool or being executed
+		ENQUEUED,
+		/// The command has been executed
+		DONE
+	};
+
+	/// Creates a task for a command, to be submitted later
+	static nctl::SharedPtr<Task> create(nctl::UniquePtr<IThreadCommand> command);
+
+	/// Returns the state of the task
+	State state() const;
+	/// Returns true if the command has been executed
+	inline bool isDone() const { return state() == State::DONE; }
+
+	/// Returns the command of the task, to access its results once the task is done
+	inline IThreadCommand *command() { return command_.get(); }
+	/// Returns the number of dependencies that have not completed yet, plus one until the task is submitted
+	inline int32_t numPendingDependencies() const { return numPendingDependencies_.load(); }
+
+	/// Makes another task wait for the completion of this one, the successor should not have been submitted yet
+	void addSuccessor(const nctl::SharedPtr<Task> &successor);
+
+  private:
+	nctl::UniquePtr<IThreadCommand> command_;
+	/// The thread pool the task has been submitted to
+	IThreadPool *threadPool_;
+	mutable nctl::Atomic32 state_;
+	/// The task is enqueued when the counter reaches zero, the submission itself counts as a dependency
+	mutable nctl::Atomic32 numPendingDependencies_;
+
+	/// The tasks depending on this one, guarded by a spin lock as they can be added while the task is running
+	nctl::Array<nctl::SharedPtr<Task>> successors_;
+	nctl::Atomic32 successorsLock_;
+
+	explicit Task(nctl::UniquePtr<IThreadCommand> command);
+
+	void lockSuccessors();
+	void unlockSuccessors();
+
+	/// Removes one pending dependency, the task is enqueued when there are none left
+	static void releaseDependency(nctl::SharedPtr<Task> &task);
+	/// Executes the command, marks the task as done and releases its successors
+	void run();
+
+	/// Deleted copy constructor
+	Task(const Task &) = delete;
+	/// Deleted assignment operator
+	Task &operator=(const Task &) = delete;
+
+	friend class IThreadPool;
+};
+
+}
+
+#endif
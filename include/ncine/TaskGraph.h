@@ -0,0 +1,53 @@
+#ifndef CLASS_NCINE_TASKGRAPH
+#define CLASS_NCINE_TASKGRAPH
+
+#include "Task.h"
+
+namespace ncine {
+
+/// A builder for a graph of tasks connected by dependencies
+/*! Tasks are added and connected first, then the whole graph is submitted at once.
+ * Every task starts as soon as the tasks it depends on have completed, without any further
+ * intervention from the thread that submitted the graph.
+ * \note The graph is not checked for cycles, the tasks in a cycle are never executed */
+class DLL_PUBLIC TaskGraph
+{
+  public:
+	TaskGraph();
+	explicit TaskGraph(unsigned int capacity);
+
+	/// Adds a task for a command to the graph and returns its index
+	unsigned int addTask(nctl::UniquePtr<IThreadCommand> command);
+	/// Makes a task wait for the completion of another one, both specified by their index
+	void addDependency(unsigned int taskIndex, unsigned int dependencyIndex);
+
+	/// Returns the number of tasks in the graph
+	inline unsigned int numTasks() const { return tasks_.size(); }
+	/// Returns the task with the specified index
+	inline Task &task(unsigned int index) { return *tasks_[index]; }
+	/// Returns the command of the task with the specified index
+	inline IThreadCommand *command(unsigned int index) { return tasks_[index]->command(); }
+
+	/// Submits every task of the graph to a thread pool
+	void submit(IThreadPool &threadPool);
+	/// Returns true if every task of the graph has completed
+	bool isDone() const;
+	/// Waits for every task of the graph, executing pending commands in the meantime
+	void wait(IThreadPool &threadPool);
+
+	/// Removes every task from the graph, so that it can be built again
+	void clear();
+
+  private:
+	nctl::Array<nctl::SharedPtr<Task>> tasks_;
+	bool isSubmitted_;
+
+	/// Deleted copy constructor
+	TaskGraph(const TaskGraph &) = delete;
+	/// Deleted assignment operator
+	TaskGraph &operator=(const TaskGraph &) = delete;
+};
+
+}
+
+#endif
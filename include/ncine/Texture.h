@@ -9,6 +9,7 @@ namespace ncine {
 class TextureData;
 class ITextureLoader;
 class GLTexture;
+class Colorf;
 
 /// Texture class
 class DLL_PUBLIC Texture : public Object
@@ -33,6 +34,17 @@ class DLL_PUBLIC Texture : public Object
 		REPEAT
 	};
 
+	/// Loading states of a texture
+	enum class LoadingState
+	{
+		/// The texture content has been uploaded
+		LOADED,
+		/// The texture is a placeholder waiting for an asynchronous load
+		PENDING,
+		/// The asynchronous load has failed and the texture is still a placeholder
+		FAILED
+	};
+
 	Texture(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize);
 	Texture(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize, int width, int height);
 	Texture(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize, Vector2i size);
@@ -65,6 +77,11 @@ class DLL_PUBLIC Texture : public Object
 	/// Returns the amount of video memory needed to load the texture
 	inline unsigned long dataSize() const { return dataSize_; }
 
+	/// Returns the loading state of the texture
+	inline LoadingState loadingState() const { return loadingState_; }
+	/// Returns true if the texture content has been uploaded
+	inline bool isLoaded() const { return loadingState_ == LoadingState::LOADED; }
+
 	/// Returns the texture filtering for minification
 	inline Filtering minFiltering() const { return minFiltering_; }
 	/// Returns the texture filtering for magnification
@@ -91,6 +108,7 @@ class DLL_PUBLIC Texture : public Object
 	bool isCompressed_;
 	unsigned int numChannels_;
 	unsigned long dataSize_;
+	LoadingState loadingState_;
 
 	Filtering minFiltering_;
 	Filtering magFiltering_;
@@ -101,13 +119,24 @@ class DLL_PUBLIC Texture : public Object
 	/// Deleted assignment operator
 	Texture &operator=(const Texture &) = delete;
 
+	/// Creates a single pixel placeholder texture waiting for an asynchronous load
+	Texture(const char *filename, const Colorf &placeholderColor);
+	/// Creates a texture from RGBA pixels already in memory, like a texture atlas page
+	Texture(const char *name, int width, int height, const unsigned char *rgbaPixels);
+
 	/// Loads a texture overriding the size detected by the texture loader
 	void load(const ITextureLoader &texLoader, int width, int height);
 
+	/// Replaces the placeholder with the decoded content, or marks the load as failed if the loader is null
+	void completeAsyncLoad(const ITextureLoader *texLoader);
+
 	/// Sets the OpenGL object label for the texture
 	void setGLTextureLabel(const char *filename);
 
 	friend class Material;
+	friend class AsyncTextureLoader;
+	friend class TextureAtlas;
+	friend class ScreenCapture;
 };
 
 }
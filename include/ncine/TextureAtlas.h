@@ -0,0 +1,114 @@
+#ifndef CLASS_NCINE_TEXTUREATLAS
+#define CLASS_NCINE_TEXTUREATLAS
+
+#include "common_defines.h"
+#include "Rect.h"
+#include <nctl/Array.h>
+#include <nctl/HashMap.h>
+#include <nctl/String.h>
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+class Texture;
+class ITextureLoader;
+
+/// A rectangular area of a texture, like an image packed in a texture atlas
+struct TextureRegion
+{
+	TextureRegion()
+	    : texture(nullptr) {}
+	TextureRegion(Texture *tex, const Recti &r)
+	    : texture(tex), rect(r) {}
+
+	/// The texture containing the region
+	Texture *texture;
+	/// The area of the region in texture pixels
+	Recti rect;
+};
+
+/// A class that packs many images in a few shared texture pages at run-time
+/*! Sprites using regions of the same page share the same texture and can be batched together.
+ * Images are packed with a skyline bottom-left heuristic, from the tallest to the shortest.
+ * \note Only uncompressed images with 8 bits per channel can be packed, they are all converted to RGBA */
+class DLL_PUBLIC TextureAtlas
+{
+  public:
+	/// Creates an atlas with pages as big as the maximum texture size, up to 2048 pixels
+	TextureAtlas();
+	/// Creates an atlas with pages of the specified size
+	TextureAtlas(int pageWidth, int pageHeight);
+	~TextureAtlas();
+
+	/// Returns the number of pixels around each image
+	inline int padding() const { return padding_; }
+	/// Sets the number of pixels around each image, filled with copies of its borders to avoid bleeding when filtering
+	inline void setPadding(int padding) { padding_ = (padding >= 0) ? padding : 0; }
+
+	/// Decodes an image file and adds it to the ones to pack, returns its region index or -1 on failure
+	int addImage(const char *filename);
+	/// Decodes an image from a memory buffer and adds it to the ones to pack, returns its region index or -1 on failure
+	int addImage(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize);
+
+	/// Packs all the added images in pages and uploads them to the GPU
+	/*! \return False if there are no images or if one of them does not fit in a page
+	 * \note The decoded images are released once uploaded, so an atlas can only be built once */
+	bool build();
+	/// Returns true if the atlas has been built and its regions are valid
+	inline bool isBuilt() const { return pages_.isEmpty() == false; }
+
+	/// Returns the number of texture pages
+	inline unsigned int numPages() const { return pages_.size(); }
+	/// Returns the specified texture page
+	inline Texture *page(unsigned int index) { return pages_[index].get(); }
+
+	/// Returns the number of regions, one for each added image
+	inline unsigned int numRegions() const { return images_.size(); }
+	/// Returns the region of the image with the specified index
+	/*! \note Regions are valid only after the atlas has been built */
+	inline const TextureRegion &region(unsigned int index) const { return images_[index].region; }
+	/// Returns the region of the image with the specified name, or `nullptr` if not found
+	const TextureRegion *findRegion(const char *name) const;
+
+  private:
+	/// An image added to the atlas
+	struct Image
+	{
+		Image();
+		~Image();
+		Image(Image &&other);
+		Image &operator=(Image &&other);
+
+		nctl::String name;
+		/// The decoded image, released after being uploaded
+		nctl::UniquePtr<ITextureLoader> texLoader;
+		unsigned int pageIndex;
+		TextureRegion region;
+	};
+
+	/// Default and maximum size for the texture pages
+	static const int DefaultPageSize = 2048;
+
+	/// The initial number of buckets for the region indices hashmap
+	static const unsigned int InitialCapacity = 32;
+
+	int pageWidth_;
+	int pageHeight_;
+	int padding_;
+	nctl::Array<Image> images_;
+	/// The indices of the images, by name
+	nctl::StringHashMap<unsigned int> imageIndices_;
+	nctl::Array<nctl::UniquePtr<Texture>> pages_;
+
+	/// Validates the decoded image and adds it, returns its index or -1 on failure
+	int addDecodedImage(const char *name, nctl::UniquePtr<ITextureLoader> texLoader);
+
+	/// Deleted copy constructor
+	TextureAtlas(const TextureAtlas &) = delete;
+	/// Deleted assignment operator
+	TextureAtlas &operator=(const TextureAtlas &) = delete;
+};
+
+}
+
+#endif
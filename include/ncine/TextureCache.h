@@ -0,0 +1,92 @@
+#ifndef CLASS_NCINE_TEXTURECACHE
+#define CLASS_NCINE_TEXTURECACHE
+
+#include "common_defines.h"
+#include "Vector2.h"
+#include <nctl/SharedPtr.h>
+#include <nctl/HashMap.h>
+#include <nctl/HashMapIterator.h>
+#include <nctl/String.h>
+
+namespace ncine {
+
+class Texture;
+
+/// A cache that shares textures loaded from the same file with the same parameters
+/*! Textures are returned as shared pointers and the cache holds a reference of its own.
+ * When the memory budget is exceeded, the textures that are not referenced outside
+ * of the cache are evicted, starting from the least recently used one. */
+class DLL_PUBLIC TextureCache
+{
+  public:
+	/// A cache entry
+	struct Entry
+	{
+		Entry()
+		    : lastUse(0), dataSize(0) {}
+
+		/// The shared texture
+		nctl::SharedPtr<Texture> texture;
+		/// The value of the cache access counter when the texture was last retrieved
+		unsigned long int lastUse;
+		/// The amount of video memory used by the texture when it was added to the cache
+		unsigned long dataSize;
+
+		/// Returns the number of references to the texture held outside of the cache
+		inline unsigned int numReferences() const { return static_cast<unsigned int>(texture.useCount() - 1); }
+	};
+
+	TextureCache();
+
+	/// Returns the texture loaded from the specified file, loading it only if it is not in the cache
+	nctl::SharedPtr<Texture> retrieve(const char *filename);
+	/// Returns the texture loaded from the specified file with a size override
+	nctl::SharedPtr<Texture> retrieve(const char *filename, int width, int height);
+	/// Returns the texture loaded from the specified file with a size override as a `Vector2<int>` object
+	nctl::SharedPtr<Texture> retrieve(const char *filename, Vector2i size);
+
+	/// Returns the number of cached textures
+	inline unsigned int numEntries() const { return entries_.size(); }
+	/// Returns all cache entries, indexed by their key
+	inline const nctl::StringHashMap<Entry> &entries() const { return entries_; }
+	/// Returns the amount of video memory used by the cached textures
+	inline unsigned long dataSize() const { return dataSize_; }
+
+	/// Returns the video memory budget for the cache, zero means no limit
+	inline unsigned long memoryBudget() const { return memoryBudget_; }
+	/// Sets the video memory budget for the cache, zero means no limit
+	void setMemoryBudget(unsigned long memoryBudget);
+
+	/// Evicts unreferenced textures, least recently used first, until the memory budget is met
+	void trim();
+	/// Evicts every unreferenced texture, regardless of the memory budget
+	void evictUnreferenced();
+
+  private:
+	/// The initial number of buckets for the entries hashmap
+	static const unsigned int InitialCapacity = 64;
+
+	nctl::StringHashMap<Entry> entries_;
+	/// Video memory budget for the cache, zero means no limit
+	unsigned long memoryBudget_;
+	/// The running total of the video memory used by the cached textures
+	unsigned long dataSize_;
+	/// A counter incremented by every retrieval, used to find the least recently used entry
+	unsigned long int accessCounter_;
+	/// The string used to build the key of an entry
+	nctl::String keyString_;
+
+	/// Evicts unreferenced textures, least recently used first, until the data size is not greater than the target
+	void evict(unsigned long targetSize);
+	/// Updates the cache counters in the render statistics
+	void updateStatistics();
+
+	/// Deleted copy constructor
+	TextureCache(const TextureCache &) = delete;
+	/// Deleted assignment operator
+	TextureCache &operator=(const TextureCache &) = delete;
+};
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define CLASS_NCINE_TEXTUREDATA
 
 #include "common_defines.h"
+#include "MipMapGenerator.h"
 #include <nctl/UniquePtr.h>
 
 namespace ncine {
@@ -24,6 +25,10 @@ class DLL_PUBLIC TextureData
 	/// Returns the name of the buffer or file used to load data from
 	const char *filename() const;
 
+	/// Generates a MIP map chain if the data is an uncompressed 8 bits per channel image without one
+	/*! \note It can be called on a worker thread, before creating the texture on the main thread */
+	bool generateMipMaps(MipMapGenerator::Filter filter);
+
   private:
 	/// A smart pointer to the texture loader object
 	nctl::UniquePtr<ITextureLoader> texLoader_;
@@ -0,0 +1,89 @@
+#ifndef CLASS_NCINE_VIRTUALFILESYSTEM
+#define CLASS_NCINE_VIRTUALFILESYSTEM
+
+#include "common_defines.h"
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+class IFile;
+
+/// A layer that mounts directories, asset packs and memory buffers under a common path hierarchy
+/*! Every mount adds its files to a hashed index of normalized paths, where separators are forward slashes,
+ * dot components are resolved and letters are lowercase. Queries and file handle creation are then resolved
+ * with a single lookup, without accessing the disk. Directories are scanned only once, when they are mounted.
+ *
+ * `IFile::createReadFileHandle()` and `IFile::createMappedFileHandle()` search the index before the file system,
+ * so that textures, fonts, audio buffers and scripts are transparently loaded from the mounts by their usual path.
+ * Handles created with `IFile::createFileHandle()`, like the ones used to write files, ignore the mounts.
+ * When the same path is provided by more than one mount, the one with the highest priority wins, and
+ * between mounts with the same priority the last mounted one wins.
+ * \note Mounts should not be changed while other threads are loading files */
+class DLL_PUBLIC VirtualFileSystem
+{
+  public:
+	/// The kinds of mounts
+	enum class MountType
+	{
+		DIRECTORY,
+		PACK,
+		BUFFER
+	};
+
+	/// The priority of mounts when it is not specified
+	static const int DefaultPriority = 0;
+
+	/// Mounts the files inside a directory under the specified mount point
+	static bool mountDirectory(const char *dirPath, const char *mountPoint);
+	/// Mounts the files inside a directory under the specified mount point with a priority
+	static bool mountDirectory(const char *dirPath, const char *mountPoint, int priority);
+	/// Mounts the entries of an asset pack under the specified mount point
+	static bool mountPack(const char *packFilename, const char *mountPoint);
+	/// Mounts the entries of an asset pack under the specified mount point with a priority
+	static bool mountPack(const char *packFilename, const char *mountPoint, int priority);
+	/// Mounts a read-only memory buffer as a file with the specified path
+	/*! \note The buffer is not copied and it should outlive the mount */
+	static bool mountBuffer(const char *filename, const unsigned char *bufferPtr, unsigned long int bufferSize);
+	/// Mounts a read-only memory buffer as a file with the specified path and a priority
+	static bool mountBuffer(const char *filename, const unsigned char *bufferPtr, unsigned long int bufferSize, int priority);
+
+	/// Unmounts the directory, pack or buffer mounted from the specified source
+	/*! \note Files that are still opened keep working until they are destroyed */
+	static bool unmount(const char *source);
+	/// Unmounts everything
+	static void unmountAll();
+	/// Scans the mounted directories again, to index files that have been created or deleted since they were mounted
+	static void rescanDirectories();
+
+	/// Returns the number of mounts
+	static unsigned int numMounts();
+	/// Returns the number of mounts of the specified type
+	static unsigned int numMounts(MountType type);
+	/// Returns the number of indexed files and directories
+	static unsigned int numIndexedPaths();
+
+	/// Returns true if the path is a file or a directory of one of the mounts
+	static bool exists(const char *path);
+	/// Returns true if the path is a file of one of the mounts
+	static bool isFile(const char *path);
+	/// Returns true if the path is a directory of one of the mounts
+	static bool isDirectory(const char *path);
+	/// Returns the size in bytes of a file of one of the mounts, or -1 if it cannot be found
+	static long int fileSize(const char *path);
+	/// Returns the type of the mount that provides the path
+	static bool mountType(const char *path, MountType &type);
+
+  private:
+	/// Returns a handle to a file of one of the mounts, or `nullptr` if the file cannot be found
+	static nctl::UniquePtr<IFile> createFileHandle(const char *filename, bool mapped);
+
+	/// The `IFile` factory methods search the mounts
+	friend class IFile;
+};
+
+/// Meant to be used as a shorter alias for the virtual file system class
+using vfs = VirtualFileSystem;
+
+}
+
+#endif
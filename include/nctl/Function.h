@@ -0,0 +1,189 @@
+#ifndef CLASS_NCTL_FUNCTION
+#define CLASS_NCTL_FUNCTION
+
+#include <new>
+#include "utility.h"
+
+#include <ncine/config.h>
+#if NCINE_WITH_ALLOCATORS
+	#include "AllocManager.h"
+	#include "IAllocator.h"
+#endif
+
+namespace nctl {
+
+/// The default size of the inline storage of a `Function`, enough for a few captured pointers
+const unsigned int DefaultFunctionInlineSize = 4 * sizeof(void *);
+
+template <class Signature, unsigned int InlineSize = DefaultFunctionInlineSize>
+class Function;
+
+/// A move-only wrapper for any callable object with the specified signature
+/*! Callables that fit in the inline storage, like lambdas capturing a few pointers or references,
+ * are stored inside the object and never allocate memory. Bigger ones are allocated on the heap.
+ * \note Calling an empty function is not allowed */
+template <class R, class... Args, unsigned int InlineSize>
+class Function<R(Args...), InlineSize>
+{
+  public:
+	/// Creates an empty function
+	Function()
+	    : operations_(nullptr) {}
+	/// Creates a function from a callable object, a lambda or a function pointer
+	template <class F>
+	Function(F callable);
+	~Function() { reset(); }
+
+	/// Move constructor
+	Function(Function &&other);
+	/// Move assignment operator
+	Function &operator=(Function &&other);
+
+	/// Returns true if the function is not empty
+	inline explicit operator bool() const { return operations_ != nullptr; }
+	/// Returns true if the callable is stored inside the object, without any heap allocation
+	inline bool isInline() const { return operations_ != nullptr && operations_->isInline; }
+
+	/// Calls the stored callable
+	inline R operator()(Args... args) { return operations_->invoke(storage_, nctl::forward<Args>(args)...); }
+
+	/// Destroys the stored callable, leaving the function empty
+	void reset();
+
+  private:
+	/// The inline storage, aligned for any fundamental type
+	union Storage
+	{
+		void *heapPointer;
+		void (*functionPointer)();
+		long long integer;
+		long double floatingPoint;
+		unsigned char buffer[InlineSize];
+	};
+
+	/// The type-erased operations on a stored callable
+	struct Operations
+	{
+		R (*invoke)(Storage &storage, Args &&... args);
+		/// Move constructs the callable in the destination storage and destroys the source one
+		void (*move)(Storage &destination, Storage &source);
+		void (*destroy)(Storage &storage);
+		bool isInline;
+	};
+
+	/// The operations for a callable that is stored inline
+	template <class F>
+	struct InlineOperations
+	{
+		static R invoke(Storage &storage, Args &&... args) { return (*reinterpret_cast<F *>(storage.buffer))(nctl::forward<Args>(args)...); }
+		static void move(Storage &destination, Storage &source)
+		{
+			F *callable = reinterpret_cast<F *>(source.buffer);
+			new (destination.buffer) F(nctl::move(*callable));
+			callable->~F();
+		}
+		static void destroy(Storage &storage) { reinterpret_cast<F *>(storage.buffer)->~F(); }
+
+		static const Operations table;
+	};
+
+	/// The operations for a callable that is allocated on the heap
+	template <class F>
+	struct HeapOperations
+	{
+		static R invoke(Storage &storage, Args &&... args) { return (*static_cast<F *>(storage.heapPointer))(nctl::forward<Args>(args)...); }
+		static void move(Storage &destination, Storage &source) { destination.heapPointer = source.heapPointer; }
+		static void destroy(Storage &storage)
+		{
+#if !NCINE_WITH_ALLOCATORS
+			delete static_cast<F *>(storage.heapPointer);
+#else
+			theDefaultAllocator().deleteObject(static_cast<F *>(storage.heapPointer));
+#endif
+		}
+
+		static const Operations table;
+	};
+
+	Storage storage_;
+	/// The operations for the type of the stored callable, `nullptr` if the function is empty
+	const Operations *operations_;
+
+	/// Deleted copy constructor
+	Function(const Function &) = delete;
+	/// Deleted assignment operator
+	Function &operator=(const Function &) = delete;
+};
+
+template <class R, class... Args, unsigned int InlineSize>
+template <class F>
+const typename Function<R(Args...), InlineSize>::Operations Function<R(Args...), InlineSize>::InlineOperations<F>::table = {
+	&InlineOperations<F>::invoke, &InlineOperations<F>::move, &InlineOperations<F>::destroy, true
+};
+
+template <class R, class... Args, unsigned int InlineSize>
+template <class F>
+const typename Function<R(Args...), InlineSize>::Operations Function<R(Args...), InlineSize>::HeapOperations<F>::table = {
+	&HeapOperations<F>::invoke, &HeapOperations<F>::move, &HeapOperations<F>::destroy, false
+};
+
+template <class R, class... Args, unsigned int InlineSize>
+template <class F>
+Function<R(Args...), InlineSize>::Function(F callable)
+{
+	if (sizeof(F) <= sizeof(Storage) && alignof(F) <= alignof(Storage))
+	{
+		new (storage_.buffer) F(nctl::move(callable));
+		operations_ = &InlineOperations<F>::table;
+	}
+	else
+	{
+#if !NCINE_WITH_ALLOCATORS
+		storage_.heapPointer = new F(nctl::move(callable));
+#else
+		storage_.heapPointer = theDefaultAllocator().newObject<F>(nctl::move(callable));
+#endif
+		operations_ = &HeapOperations<F>::table;
+	}
+}
+
+template <class R, class... Args, unsigned int InlineSize>
+Function<R(Args...), InlineSize>::Function(Function &&other)
+    : operations_(other.operations_)
+{
+	if (operations_ != nullptr)
+	{
+		operations_->move(storage_, other.storage_);
+		other.operations_ = nullptr;
+	}
+}
+
+template <class R, class... Args, unsigned int InlineSize>
+Function<R(Args...), InlineSize> &Function<R(Args...), InlineSize>::operator=(Function &&other)
+{
+	if (this != &other)
+	{
+		reset();
+		operations_ = other.operations_;
+		if (operations_ != nullptr)
+		{
+			operations_->move(storage_, other.storage_);
+			other.operations_ = nullptr;
+		}
+	}
+	return *this;
+}
+
+template <class R, class... Args, unsigned int InlineSize>
+void Function<R(Args...), InlineSize>::reset()
+{
+	if (operations_ != nullptr)
+	{
+		operations_->destroy(storage_);
+		operations_ = nullptr;
+	}
+}
+
+}
+
+#endif
@@ -0,0 +1,222 @@
+#ifndef CLASS_NCTL_MPMCQUEUE
+#define CLASS_NCTL_MPMCQUEUE
+
+#include <new>
+#include <ncine/common_macros.h>
+#include "Atomic.h"
+#include "utility.h"
+
+#include <ncine/config.h>
+#if NCINE_WITH_ALLOCATORS
+	#include "AllocManager.h"
+	#include "IAllocator.h"
+#endif
+
+namespace nctl {
+
+/// A bounded lock-free queue for any number of producer and consumer threads
+/*! The capacity is rounded up to the next power of two.
+ * Every slot has a sequence number that tells if it is ready to be written or to be read,
+ * so producers and consumers only contend on the index they are advancing. */
+template <class T>
+class MpmcQueue
+{
+  public:
+	explicit MpmcQueue(unsigned int capacity);
+#if NCINE_WITH_ALLOCATORS
+	MpmcQueue(unsigned int capacity, IAllocator &alloc);
+#endif
+	~MpmcQueue();
+
+	/// Returns true if the queue is empty
+	/*! \note The result might already be stale when other threads are using the queue */
+	inline bool isEmpty() const { return size() == 0; }
+	/// Returns the number of elements in the queue
+	/*! \note The result might already be stale when other threads are using the queue */
+	unsigned int size() const;
+	/// Returns the queue capacity
+	inline unsigned int capacity() const { return mask_ + 1; }
+
+	/// Copies an element at the end of the queue, returns false if the queue is full
+	inline bool push(const T &element) { return emplace(element); }
+	/// Moves an element at the end of the queue, returns false if the queue is full
+	inline bool push(T &&element) { return emplace(nctl::move(element)); }
+	/// Constructs a new element at the end of the queue, returns false if the queue is full
+	template <typename... Args>
+	bool emplace(Args &&... args);
+	/// Moves the element at the front of the queue in the specified one, returns false if the queue is empty
+	bool pop(T &element);
+
+  private:
+	using MemoryModel = Atomic32::MemoryModel;
+	/// The size of the padding that separates the producer and the consumer indices
+	static const unsigned int CacheLineSize = 64;
+
+#if NCINE_WITH_ALLOCATORS
+	/// The custom memory allocator for the queue
+	IAllocator &alloc_;
+#endif
+	T *array_;
+	/// The sequence number of every slot
+	/*! It is equal to the slot position when the slot can be written,
+	 * and to the slot position plus one when it can be read. */
+	Atomic32 *sequences_;
+	const uint32_t mask_;
+
+	char padding0_[CacheLineSize];
+	/// The position of the next element to push
+	mutable Atomic32 enqueuePos_;
+	char padding1_[CacheLineSize];
+	/// The position of the next element to pop
+	mutable Atomic32 dequeuePos_;
+	char padding2_[CacheLineSize];
+
+	/// Allocates the slots and initializes their sequence numbers
+	void init();
+	/// Returns the smallest power of two that is not less than the specified capacity
+	static uint32_t roundUpCapacity(unsigned int capacity);
+
+	/// Deleted copy constructor
+	MpmcQueue(const MpmcQueue &) = delete;
+	/// Deleted assignment operator
+	MpmcQueue &operator=(const MpmcQueue &) = delete;
+};
+
+template <class T>
+MpmcQueue<T>::MpmcQueue(unsigned int capacity)
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(theDefaultAllocator()),
+#endif
+      array_(nullptr), sequences_(nullptr), mask_(roundUpCapacity(capacity) - 1),
+      enqueuePos_(0), dequeuePos_(0)
+{
+	init();
+}
+
+#if NCINE_WITH_ALLOCATORS
+template <class T>
+MpmcQueue<T>::MpmcQueue(unsigned int capacity, IAllocator &alloc)
+    : alloc_(alloc), array_(nullptr), sequences_(nullptr), mask_(roundUpCapacity(capacity) - 1),
+      enqueuePos_(0), dequeuePos_(0)
+{
+	init();
+}
+#endif
+
+template <class T>
+MpmcQueue<T>::~MpmcQueue()
+{
+	// No other thread can be using the queue, every element between the two positions has been published
+	const uint32_t enqueuePos = static_cast<uint32_t>(enqueuePos_.load(MemoryModel::ACQUIRE));
+	for (uint32_t pos = static_cast<uint32_t>(dequeuePos_.load(MemoryModel::ACQUIRE)); pos != enqueuePos; pos++)
+		destructObject(array_ + (pos & mask_));
+
+#if !NCINE_WITH_ALLOCATORS
+	::operator delete(array_);
+	::operator delete(sequences_);
+#else
+	alloc_.deallocate(array_);
+	alloc_.deallocate(sequences_);
+#endif
+}
+
+template <class T>
+unsigned int MpmcQueue<T>::size() const
+{
+	const uint32_t dequeuePos = static_cast<uint32_t>(dequeuePos_.load(MemoryModel::ACQUIRE));
+	const uint32_t enqueuePos = static_cast<uint32_t>(enqueuePos_.load(MemoryModel::ACQUIRE));
+	// The two positions are not read at the same time, the consumers could have gone past the loaded enqueue position
+	const int32_t size = static_cast<int32_t>(enqueuePos - dequeuePos);
+	return (size > 0) ? static_cast<unsigned int>(size) : 0;
+}
+
+template <class T>
+template <typename... Args>
+bool MpmcQueue<T>::emplace(Args &&... args)
+{
+	uint32_t pos = static_cast<uint32_t>(enqueuePos_.load(MemoryModel::RELAXED));
+	for (;;)
+	{
+		const uint32_t sequence = static_cast<uint32_t>(sequences_[pos & mask_].load(MemoryModel::ACQUIRE));
+		const int32_t diff = static_cast<int32_t>(sequence - pos);
+		if (diff == 0)
+		{
+			// The slot is free, trying to claim it by advancing the position
+			if (enqueuePos_.cmpExchange(static_cast<int32_t>(pos + 1), static_cast<int32_t>(pos), MemoryModel::RELAXED))
+				break;
+		}
+		else if (diff < 0)
+		{
+			// The slot still holds an element from the previous lap, the queue is full
+			return false;
+		}
+		pos = static_cast<uint32_t>(enqueuePos_.load(MemoryModel::RELAXED));
+	}
+
+	new (array_ + (pos & mask_)) T(nctl::forward<Args>(args)...);
+	sequences_[pos & mask_].store(static_cast<int32_t>(pos + 1), MemoryModel::RELEASE);
+	return true;
+}
+
+template <class T>
+bool MpmcQueue<T>::pop(T &element)
+{
+	uint32_t pos = static_cast<uint32_t>(dequeuePos_.load(MemoryModel::RELAXED));
+	for (;;)
+	{
+		const uint32_t sequence = static_cast<uint32_t>(sequences_[pos & mask_].load(MemoryModel::ACQUIRE));
+		const int32_t diff = static_cast<int32_t>(sequence - (pos + 1));
+		if (diff == 0)
+		{
+			// The slot has been published, trying to claim it by advancing the position
+			if (dequeuePos_.cmpExchange(static_cast<int32_t>(pos + 1), static_cast<int32_t>(pos), MemoryModel::RELAXED))
+				break;
+		}
+		else if (diff < 0)
+		{
+			// The slot has not been written yet, the queue is empty
+			return false;
+		}
+		pos = static_cast<uint32_t>(dequeuePos_.load(MemoryModel::RELAXED));
+	}
+
+	T *slot = array_ + (pos & mask_);
+	element = nctl::move(*slot);
+	destructObject(slot);
+	// Making the slot writable again for the producers of the next lap
+	sequences_[pos & mask_].store(static_cast<int32_t>(pos + mask_ + 1), MemoryModel::RELEASE);
+	return true;
+}
+
+template <class T>
+void MpmcQueue<T>::init()
+{
+	const unsigned int capacity = mask_ + 1;
+#if !NCINE_WITH_ALLOCATORS
+	array_ = static_cast<T *>(::operator new(capacity * sizeof(T)));
+	sequences_ = static_cast<Atomic32 *>(::operator new(capacity * sizeof(Atomic32)));
+#else
+	array_ = static_cast<T *>(alloc_.allocate(capacity * sizeof(T)));
+	sequences_ = static_cast<Atomic32 *>(alloc_.allocate(capacity * sizeof(Atomic32)));
+#endif
+
+	for (unsigned int i = 0; i < capacity; i++)
+		new (sequences_ + i) Atomic32(static_cast<int32_t>(i));
+}
+
+template <class T>
+uint32_t MpmcQueue<T>::roundUpCapacity(unsigned int capacity)
+{
+	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
+	FATAL_ASSERT_MSG(capacity <= 0x40000000u, "The capacity is too big");
+
+	uint32_t roundedCapacity = 1;
+	while (roundedCapacity < capacity)
+		roundedCapacity <<= 1;
+	return roundedCapacity;
+}
+
+}
+
+#endif
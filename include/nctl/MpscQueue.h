@@ -0,0 +1,149 @@
+#ifndef CLASS_NCTL_MPSCQUEUE
+#define CLASS_NCTL_MPSCQUEUE
+
+#include <cstdint>
+#include <ncine/common_macros.h>
+#include "Atomic.h"
+
+namespace nctl {
+
+template <class T> class MpscQueue;
+
+/// The base class for the elements of an `MpscQueue`, it holds the link to the next element
+class MpscQueueNode
+{
+  public:
+	MpscQueueNode()
+	    : next_(0) {}
+	/// Copy constructor, the link is not copied as the new node is not in any queue
+	MpscQueueNode(const MpscQueueNode &)
+	    : next_(0) {}
+	/// Assignment operator, the link is not copied as it belongs to the queue
+	MpscQueueNode &operator=(const MpscQueueNode &) { return *this; }
+
+  private:
+	Atomic64 next_;
+
+	template <class T> friend class MpscQueue;
+};
+
+/// An unbounded intrusive queue for any number of producer threads and a single consumer thread
+/*! Elements derive from `MpscQueueNode` and are linked together, so pushing never allocates memory
+ * and the queue never owns its elements. Pushing is lock-free: a new element replaces the back of the queue
+ * with a compare-and-swap loop, as `Atomic64` has no exchange operation, then it is linked to the previous one.
+ * \note A producer that is preempted after linking an element but before publishing it makes the
+ * elements pushed after it invisible to the consumer until it resumes. */
+template <class T>
+class MpscQueue
+{
+  public:
+	MpscQueue();
+
+	/// Returns true if the queue is empty, it should only be called by the consumer thread
+	bool isEmpty();
+
+	/// Pushes an element at the end of the queue, it can be called by any thread
+	void push(T *element);
+	/// Returns the element at the front of the queue, or `nullptr` if the queue is empty
+	/*! It should only be called by the consumer thread */
+	T *pop();
+
+  private:
+	using MemoryModel = Atomic64::MemoryModel;
+	/// The size of the padding that separates the producer and the consumer data
+	static const unsigned int CacheLineSize = 64;
+
+	/// The last element pushed, shared by all producers
+	Atomic64 back_;
+	char padding0_[CacheLineSize];
+	/// The next element to pop, only accessed by the consumer
+	MpscQueueNode *front_;
+	/// A node that is never returned, it keeps the queue from ever being completely unlinked
+	MpscQueueNode stub_;
+
+	void pushNode(MpscQueueNode *node);
+
+	static inline int64_t toInt(MpscQueueNode *node) { return static_cast<int64_t>(reinterpret_cast<intptr_t>(node)); }
+	static inline MpscQueueNode *toNode(int64_t value) { return reinterpret_cast<MpscQueueNode *>(static_cast<intptr_t>(value)); }
+
+	/// Deleted copy constructor
+	MpscQueue(const MpscQueue &) = delete;
+	/// Deleted assignment operator
+	MpscQueue &operator=(const MpscQueue &) = delete;
+};
+
+template <class T>
+MpscQueue<T>::MpscQueue()
+    : back_(toInt(&stub_)), front_(&stub_)
+{
+}
+
+template <class T>
+bool MpscQueue<T>::isEmpty()
+{
+	return (front_ == &stub_ && stub_.next_.load(MemoryModel::ACQUIRE) == 0 &&
+	        toNode(back_.load(MemoryModel::ACQUIRE)) == &stub_);
+}
+
+template <class T>
+void MpscQueue<T>::push(T *element)
+{
+	ASSERT(element);
+	pushNode(element);
+}
+
+template <class T>
+T *MpscQueue<T>::pop()
+{
+	MpscQueueNode *front = front_;
+	MpscQueueNode *next = toNode(front->next_.load(MemoryModel::ACQUIRE));
+
+	// Skipping the stub node
+	if (front == &stub_)
+	{
+		if (next == nullptr)
+			return nullptr;
+		front_ = next;
+		front = next;
+		next = toNode(next->next_.load(MemoryModel::ACQUIRE));
+	}
+
+	if (next != nullptr)
+	{
+		front_ = next;
+		return static_cast<T *>(front);
+	}
+
+	// The front element is not the last one pushed, a producer has not published its link yet
+	if (front != toNode(back_.load(MemoryModel::ACQUIRE)))
+		return nullptr;
+
+	// Pushing the stub node back so that the last element can be unlinked
+	pushNode(&stub_);
+	next = toNode(front->next_.load(MemoryModel::ACQUIRE));
+	if (next != nullptr)
+	{
+		front_ = next;
+		return static_cast<T *>(front);
+	}
+
+	return nullptr;
+}
+
+template <class T>
+void MpscQueue<T>::pushNode(MpscQueueNode *node)
+{
+	node->next_.store(0, MemoryModel::RELAXED);
+
+	// Exchanging the back of the queue with the new node, retrying if another producer has changed it
+	int64_t prev = back_.load(MemoryModel::RELAXED);
+	while (back_.cmpExchange(toInt(node), prev, MemoryModel::SEQ_CST) == false)
+		prev = back_.load(MemoryModel::RELAXED);
+
+	// Publishing the link, the consumer cannot reach the new node before this point
+	toNode(prev)->next_.store(toInt(node), MemoryModel::RELEASE);
+}
+
+}
+
+#endif
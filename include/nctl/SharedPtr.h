@@ -176,8 +176,8 @@ SharedPtr<T>::~SharedPtr()
 {
 	if (ctrlBlock_)
 	{
-		ctrlBlock_->counter_--;
-		if (ctrlBlock_->counter_ <= 0)
+		// Decrementing and testing the counter in one atomic operation, so that only the last owner deletes the block
+		if (--ctrlBlock_->counter_ <= 0)
 #if !NCINE_WITH_ALLOCATORS
 			delete ctrlBlock_;
 #else
@@ -221,8 +221,7 @@ void SharedPtr<T>::reset(T *newPtr)
 	// check for self reset
 	if (ptr_ != newPtr)
 	{
-		ctrlBlock_->counter_--;
-		if (ctrlBlock_->counter_ <= 0)
+		if (--ctrlBlock_->counter_ <= 0)
 			ctrlBlock_->dispose();
 
 		ptr_ = newPtr;
@@ -234,8 +233,7 @@ void SharedPtr<T>::reset(T *newPtr)
 template <class T>
 void SharedPtr<T>::reset(nullptr_t)
 {
-	ctrlBlock_->counter_--;
-	if (ctrlBlock_->counter_ <= 0)
+	if (--ctrlBlock_->counter_ <= 0)
 		ctrlBlock_->dispose();
 
 	ptr_ = nullptr;
@@ -0,0 +1,173 @@
+#ifndef CLASS_NCTL_SPSCQUEUE
+#define CLASS_NCTL_SPSCQUEUE
+
+#include <new>
+#include <ncine/common_macros.h>
+#include "Atomic.h"
+#include "utility.h"
+
+#include <ncine/config.h>
+#if NCINE_WITH_ALLOCATORS
+	#include "AllocManager.h"
+	#include "IAllocator.h"
+#endif
+
+namespace nctl {
+
+/// A bounded lock-free queue for one producer thread and one consumer thread
+/*! The capacity is rounded up to the next power of two.
+ * Only one thread at a time can push elements and only one thread at a time can pop them. */
+template <class T>
+class SpscQueue
+{
+  public:
+	explicit SpscQueue(unsigned int capacity);
+#if NCINE_WITH_ALLOCATORS
+	SpscQueue(unsigned int capacity, IAllocator &alloc);
+#endif
+	~SpscQueue();
+
+	/// Returns true if the queue is empty
+	/*! \note The result might already be stale if called by a thread that is neither the producer nor the consumer */
+	inline bool isEmpty() const { return size() == 0; }
+	/// Returns the number of elements in the queue
+	inline unsigned int size() const { return static_cast<uint32_t>(tail_.load(MemoryModel::ACQUIRE)) - static_cast<uint32_t>(head_.load(MemoryModel::ACQUIRE)); }
+	/// Returns the queue capacity
+	inline unsigned int capacity() const { return mask_ + 1; }
+
+	/// Copies an element at the end of the queue, returns false if the queue is full
+	inline bool push(const T &element) { return emplace(element); }
+	/// Moves an element at the end of the queue, returns false if the queue is full
+	inline bool push(T &&element) { return emplace(nctl::move(element)); }
+	/// Constructs a new element at the end of the queue, returns false if the queue is full
+	template <typename... Args>
+	bool emplace(Args &&... args);
+	/// Moves the element at the front of the queue in the specified one, returns false if the queue is empty
+	bool pop(T &element);
+
+  private:
+	using MemoryModel = Atomic32::MemoryModel;
+	/// The size of the padding that separates the producer and the consumer data
+	static const unsigned int CacheLineSize = 64;
+
+#if NCINE_WITH_ALLOCATORS
+	/// The custom memory allocator for the queue
+	IAllocator &alloc_;
+#endif
+	T *array_;
+	const uint32_t mask_;
+
+	char padding0_[CacheLineSize];
+	/// The index of the next element to pop, only written by the consumer
+	mutable Atomic32 head_;
+	/// The consumer copy of the tail index, it is refreshed only when the queue seems empty
+	uint32_t cachedTail_;
+
+	char padding1_[CacheLineSize];
+	/// The index of the next element to push, only written by the producer
+	mutable Atomic32 tail_;
+	/// The producer copy of the head index, it is refreshed only when the queue seems full
+	uint32_t cachedHead_;
+	char padding2_[CacheLineSize];
+
+	/// Returns the smallest power of two that is not less than the specified capacity
+	static uint32_t roundUpCapacity(unsigned int capacity);
+
+	/// Deleted copy constructor
+	SpscQueue(const SpscQueue &) = delete;
+	/// Deleted assignment operator
+	SpscQueue &operator=(const SpscQueue &) = delete;
+};
+
+template <class T>
+SpscQueue<T>::SpscQueue(unsigned int capacity)
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(theDefaultAllocator()),
+#endif
+      array_(nullptr), mask_(roundUpCapacity(capacity) - 1),
+      head_(0), cachedTail_(0), tail_(0), cachedHead_(0)
+{
+#if !NCINE_WITH_ALLOCATORS
+	array_ = static_cast<T *>(::operator new((mask_ + 1) * sizeof(T)));
+#else
+	array_ = static_cast<T *>(alloc_.allocate((mask_ + 1) * sizeof(T)));
+#endif
+}
+
+#if NCINE_WITH_ALLOCATORS
+template <class T>
+SpscQueue<T>::SpscQueue(unsigned int capacity, IAllocator &alloc)
+    : alloc_(alloc), array_(nullptr), mask_(roundUpCapacity(capacity) - 1),
+      head_(0), cachedTail_(0), tail_(0), cachedHead_(0)
+{
+	array_ = static_cast<T *>(alloc_.allocate((mask_ + 1) * sizeof(T)));
+}
+#endif
+
+template <class T>
+SpscQueue<T>::~SpscQueue()
+{
+	const uint32_t tail = static_cast<uint32_t>(tail_.load(MemoryModel::ACQUIRE));
+	for (uint32_t head = static_cast<uint32_t>(head_.load(MemoryModel::RELAXED)); head != tail; head++)
+		destructObject(array_ + (head & mask_));
+
+#if !NCINE_WITH_ALLOCATORS
+	::operator delete(array_);
+#else
+	alloc_.deallocate(array_);
+#endif
+}
+
+template <class T>
+template <typename... Args>
+bool SpscQueue<T>::emplace(Args &&... args)
+{
+	const uint32_t tail = static_cast<uint32_t>(tail_.load(MemoryModel::RELAXED));
+	if (tail - cachedHead_ > mask_)
+	{
+		cachedHead_ = static_cast<uint32_t>(head_.load(MemoryModel::ACQUIRE));
+		if (tail - cachedHead_ > mask_)
+			return false;
+	}
+
+	new (array_ + (tail & mask_)) T(nctl::forward<Args>(args)...);
+	// Publishing the new element to the consumer
+	tail_.store(static_cast<int32_t>(tail + 1), MemoryModel::RELEASE);
+	return true;
+}
+
+template <class T>
+bool SpscQueue<T>::pop(T &element)
+{
+	const uint32_t head = static_cast<uint32_t>(head_.load(MemoryModel::RELAXED));
+	if (head == cachedTail_)
+	{
+		cachedTail_ = static_cast<uint32_t>(tail_.load(MemoryModel::ACQUIRE));
+		if (head == cachedTail_)
+			return false;
+	}
+
+	T *slot = array_ + (head & mask_);
+	element = nctl::move(*slot);
+	destructObject(slot);
+	// Giving the slot back to the producer
+	head_.store(static_cast<int32_t>(head + 1), MemoryModel::RELEASE);
+	return true;
+}
+
+template <class T>
+uint32_t SpscQueue<T>::roundUpCapacity(unsigned int capacity)
+{
+	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
+	FATAL_ASSERT_MSG(capacity <= 0x40000000u, "The capacity is too big");
+
+	uint32_t roundedCapacity = 1;
+	while (roundedCapacity < capacity)
+		roundedCapacity <<= 1;
+	return roundedCapacity;
+}
+
+}
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef NCTL_PARALLEL_ALGORITHMS
+#define NCTL_PARALLEL_ALGORITHMS
+
+#include "algorithms.h"
+#include "Array.h"
+#include <ncine/IThreadPool.h>
+
+namespace nctl {
+
+///////////////////////////////////////////////////////////
+// TEMPLATE FUNCTIONS (parallel)
+///////////////////////////////////////////////////////////
+
+namespace {
+
+	/// Calls a function taking an index for every index of a range
+	template <class Function>
+	void parallelForIndices(unsigned int begin, unsigned int end, void *userData)
+	{
+		Function &fn = *static_cast<Function *>(userData);
+		for (unsigned int i = begin; i < end; i++)
+			fn(i);
+	}
+
+	/// Calls a function taking the beginning and the end of a range
+	template <class Function>
+	void parallelForRanges(unsigned int begin, unsigned int end, void *userData)
+	{
+		Function &fn = *static_cast<Function *>(userData);
+		fn(begin, end);
+	}
+
+	/// Merges pairs of consecutive sorted runs of the specified width from the input range into an output one
+	/*! The store function moves an element of the input range to an index of the output range */
+	template <class Iterator, class Compare, class Store>
+	inline void parallelMergeRuns(ncine::IThreadPool &threadPool, Iterator in, unsigned int size, unsigned int width, Compare comp, Store store)
+	{
+		const unsigned int numMerges = (size + 2 * width - 1) / (2 * width);
+		auto mergeRuns = [&](unsigned int merge) {
+			unsigned int left = merge * 2 * width;
+			const unsigned int mid = (size - left > width) ? left + width : size;
+			const unsigned int end = (size - mid > width) ? mid + width : size;
+
+			unsigned int right = mid;
+			unsigned int index = left;
+			while (left < mid && right < end)
+			{
+				// Taking from the left run when elements are equivalent, so that merging is stable
+				if (comp(in[right], in[left]))
+					store(index++, in[right++]);
+				else
+					store(index++, in[left++]);
+			}
+			while (left < mid)
+				store(index++, in[left++]);
+			while (right < end)
+				store(index++, in[right++]);
+		};
+		threadPool.parallelFor(0, numMerges, 1, parallelForIndices<decltype(mergeRuns)>, &mergeRuns);
+	}
+
+}
+
+/// Calls a function with every index from `first` to `last` excluded, splitting the range in chunks executed in parallel
+/*! The function is executed by the worker threads and by the calling thread, which returns when every index has been processed.
+ * A grain size of zero lets the thread pool decide how many indices to process in a chunk. */
+template <class Function>
+inline void parallelFor(ncine::IThreadPool &threadPool, unsigned int first, unsigned int last, unsigned int grainSize, Function fn)
+{
+	threadPool.parallelFor(first, last, grainSize, parallelForIndices<Function>, &fn);
+}
+
+/// Calls a function with every index from `first` to `last` excluded, in parallel, letting the thread pool choose the grain size
+template <class Function>
+inline void parallelFor(ncine::IThreadPool &threadPool, unsigned int first, unsigned int last, Function fn)
+{
+	threadPool.parallelFor(first, last, 0, parallelForIndices<Function>, &fn);
+}
+
+/// Calls a function with the beginning and the end of every chunk of the range from `first` to `last` excluded, in parallel
+/*! Useful when some work can be shared between all the indices of a chunk */
+template <class Function>
+inline void parallelForRange(ncine::IThreadPool &threadPool, unsigned int first, unsigned int last, unsigned int grainSize, Function fn)
+{
+	threadPool.parallelFor(first, last, grainSize, parallelForRanges<Function>, &fn);
+}
+
+/// Applies an operation in parallel to the elements of a range, storing the result at the result iterator
+/*! \note Both iterators should be random access ones */
+template <class IteratorIn, class IteratorOut, class UnaryOperation>
+inline IteratorOut parallelTransform(ncine::IThreadPool &threadPool, IteratorIn first, const IteratorIn last, IteratorOut result,
+                                     UnaryOperation op, unsigned int grainSize = 0)
+{
+	const unsigned int size = static_cast<unsigned int>(distance(first, last));
+	auto transformElement = [&](unsigned int i) { result[i] = op(first[i]); };
+	threadPool.parallelFor(0, size, grainSize, parallelForIndices<decltype(transformElement)>, &transformElement);
+
+	return result + size;
+}
+
+/// Combines the elements of a range in parallel with an associative operation, starting from an initial value
+/*! Every chunk is reduced on its own and the partial results are combined in the order of the range,
+ * so the operation does not need to be commutative.
+ * \note The iterator should be a random access one */
+template <class Iterator, class T, class BinaryOperation>
+inline T parallelReduce(ncine::IThreadPool &threadPool, Iterator first, const Iterator last, T init,
+                        BinaryOperation binaryOp, unsigned int grainSize = 0)
+{
+	const unsigned int size = static_cast<unsigned int>(distance(first, last));
+	if (size == 0)
+		return init;
+
+	if (grainSize == 0)
+		grainSize = threadPool.defaultGrainSize(size);
+	const unsigned int numChunks = (size + grainSize - 1) / grainSize;
+
+	Array<T> partials(numChunks);
+	for (unsigned int i = 0; i < numChunks; i++)
+		partials.pushBack(init);
+
+	auto reduceChunk = [&](unsigned int begin, unsigned int end) {
+		T partial = first[begin];
+		for (unsigned int i = begin + 1; i < end; i++)
+			partial = binaryOp(partial, first[i]);
+		partials[begin / grainSize] = partial;
+	};
+	threadPool.parallelFor(0, size, grainSize, parallelForRanges<decltype(reduceChunk)>, &reduceChunk);
+
+	T result = init;
+	for (unsigned int i = 0; i < numChunks; i++)
+		result = binaryOp(result, partials[i]);
+	return result;
+}
+
+/// Sorts a range in parallel with a custom comparison
+/*! Every chunk is sorted on its own with `quicksort()`, then the sorted runs are merged in parallel
+ * through a temporary buffer. The last merge passes involve fewer threads, as there are fewer runs to merge.
+ * Elements are moved, never copied.
+ * \note The sort is not stable and the iterator should be a random access one */
+template <class Iterator, class Compare>
+inline void parallelSort(ncine::IThreadPool &threadPool, Iterator first, Iterator last, Compare comp, unsigned int grainSize = 0)
+{
+	const unsigned int size = static_cast<unsigned int>(distance(first, last));
+	if (grainSize == 0)
+		grainSize = threadPool.defaultGrainSize(size);
+
+	if (threadPool.numThreads() == 0 || size <= grainSize)
+	{
+		quicksort(first, last, comp);
+		return;
+	}
+
+	auto sortChunk = [&](unsigned int begin, unsigned int end) { quicksort(first + begin, first + end, comp); };
+	threadPool.parallelFor(0, size, grainSize, parallelForRanges<decltype(sortChunk)>, &sortChunk);
+
+	// The first merge pass moves the elements into the uninitialized buffer, then passes alternate between the two
+	using T = typename IteratorTraits<Iterator>::ValueType;
+	Array<T> buffer(size);
+	buffer.setSize(size);
+	auto constructInBuffer = [&](unsigned int index, T &element) { new (&buffer[index]) T(nctl::move(element)); };
+	auto moveToBuffer = [&](unsigned int index, T &element) { buffer[index] = nctl::move(element); };
+	auto moveToRange = [&](unsigned int index, T &element) { first[index] = nctl::move(element); };
+
+	parallelMergeRuns(threadPool, first, size, grainSize, comp, constructInBuffer);
+	bool isInBuffer = true;
+	for (unsigned int width = grainSize * 2; width < size; width *= 2)
+	{
+		if (isInBuffer)
+			parallelMergeRuns(threadPool, buffer.begin(), size, width, comp, moveToRange);
+		else
+			parallelMergeRuns(threadPool, first, size, width, comp, moveToBuffer);
+		isInBuffer = !isInBuffer;
+	}
+
+	if (isInBuffer == false)
+		return;
+
+	auto moveBack = [&](unsigned int i) { first[i] = nctl::move(buffer[i]); };
+	threadPool.parallelFor(0, size, 0, parallelForIndices<decltype(moveBack)>, &moveBack);
+}
+
+/// Sorts a range in parallel, in ascending order
+template <class Iterator>
+inline void parallelSort(ncine::IThreadPool &threadPool, Iterator first, Iterator last)
+{
+	parallelSort(threadPool, first, last, IsLess<typename IteratorTraits<Iterator>::ValueType>);
+}
+
+}
+
+#endif
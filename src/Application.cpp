@@ -11,6 +11,11 @@
 #include "Timer.h" // for `sleep()`
 #include "FrameTimer.h"
 #include "SceneNode.h"
+#include "AsyncTextureLoader.h"
+#include "AsyncFileReader.h"
+#include "ScreenCapture.h"
+#include "TextureCache.h"
+#include "AudioBufferCache.h"
 #include <nctl/String.h>
 #include "IInputManager.h"
 #include "JoyMapping.h"
@@ -99,7 +104,7 @@ void Application::initCommon()
 	theServiceLocator().registerIndexer(nctl::makeUnique<ArrayIndexer>());
 #ifdef WITH_AUDIO
 	if (appCfg_.withAudio)
-		theServiceLocator().registerAudioDevice(nctl::makeUnique<ALAudioDevice>());
+		theServiceLocator().registerAudioDevice(nctl::makeUnique<ALAudioDevice>(appCfg_.withThreads));
 #endif
 #ifdef WITH_THREADS
 	if (appCfg_.withThreads)
@@ -107,6 +112,20 @@ void Application::initCommon()
 #endif
 	theServiceLocator().registerGfxCapabilities(nctl::makeUnique<GfxCapabilities>());
 	GLDebug::init(theServiceLocator().gfxCapabilities());
+#ifdef WITH_THREADS
+	asyncTextureLoader_ = nctl::makeUnique<AsyncTextureLoader>(appCfg_.withThreads);
+	asyncFileReader_ = nctl::makeUnique<AsyncFileReader>(appCfg_.withThreads);
+	screenCapture_ = nctl::makeUnique<ScreenCapture>(appCfg_.withThreads);
+#else
+	asyncTextureLoader_ = nctl::makeUnique<AsyncTextureLoader>(false);
+	asyncFileReader_ = nctl::makeUnique<AsyncFileReader>(false);
+	screenCapture_ = nctl::makeUnique<ScreenCapture>(false);
+#endif
+	textureCache_ = nctl::makeUnique<TextureCache>();
+#ifdef WITH_AUDIO
+	if (appCfg_.withAudio)
+		audioBufferCache_ = nctl::makeUnique<AudioBufferCache>();
+#endif
 
 	LOGI_X("Data path: \"%s\"", fs::dataPath().data());
 	LOGI_X("Save path: \"%s\"", fs::savePath().data());
@@ -216,6 +235,16 @@ void Application::step()
 	if (debugOverlay_)
 		debugOverlay_->update();
 
+	{
+		ZoneScopedN("File reads");
+		asyncFileReader_->update();
+	}
+
+	{
+		ZoneScopedN("Texture uploads");
+		asyncTextureLoader_->update();
+	}
+
 	if (rootNode_ != nullptr && renderQueue_ != nullptr)
 	{
 		ZoneScopedN("SceneGraph");
@@ -270,6 +299,11 @@ void Application::step()
 	}
 #endif
 
+	{
+		ZoneScopedN("Screen captures");
+		screenCapture_->update();
+	}
+
 	gfxDevice_->update();
 	FrameMark;
 	TracyGpuCollect;
@@ -315,6 +349,13 @@ void Application::shutdownCommon()
 
 	debugOverlay_.reset(nullptr);
 	rootNode_.reset(nullptr);
+	textureCache_.reset(nullptr);
+	audioBufferCache_.reset(nullptr);
+	// The audio device owns the pooled one-shot players, which are objects tracked by the indexer
+	theServiceLocator().unregisterAudioDevice();
+	asyncTextureLoader_.reset(nullptr);
+	asyncFileReader_.reset(nullptr);
+	screenCapture_.reset(nullptr);
 	renderQueue_.reset(nullptr);
 	RenderResources::dispose();
 	frameTimer_.reset(nullptr);
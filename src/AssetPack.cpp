@@ -0,0 +1,235 @@
+#include <cstring> // for memcpy()
+#include "return_macros.h"
+#include "AssetPack.h"
+#include "AssetPackFormat.h"
+#include "BlockCompression.h"
+#include "IFile.h"
+
+namespace ncine {
+
+namespace {
+
+	inline const AssetPackFormat::Entry &entryAt(const void *entries, unsigned int index)
+	{
+		return static_cast<const AssetPackFormat::Entry *>(entries)[index];
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+AssetPack::AssetPack(const char *filename)
+    : filename_(filename), mappedData_(nullptr), numEntries_(0), numSlots_(0),
+      slots_(nullptr), entries_(nullptr), paths_(nullptr)
+{
+	fileHandle_ = IFile::createMappedFileHandle(filename);
+	fileHandle_->setExitOnFailToOpen(false);
+	fileHandle_->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+	RETURN_ASSERT_MSG_X(fileHandle_->isOpened(), "Asset pack \"%s\" cannot be opened", filename);
+
+	const unsigned long int fileSize = static_cast<unsigned long int>(fileHandle_->size());
+	if (fileHandle_->mappedData() != nullptr)
+	{
+		// The index is used in place and the mapping is kept for the whole life of the pack
+		if (useIndex(fileHandle_->mappedData(), fileSize, fileSize))
+			mappedData_ = fileHandle_->mappedData();
+		else
+			fileHandle_.reset(nullptr);
+		return;
+	}
+
+	// Without a mapping only the index is loaded, entries are read on demand from a new handle
+	AssetPackFormat::Header header;
+	memset(&header, 0, sizeof(AssetPackFormat::Header));
+	fileHandle_->read(&header, sizeof(AssetPackFormat::Header));
+
+	const uint64_t indexSize = AssetPackFormat::indexSize(IFile::int32FromLE(header.numEntries), IFile::int32FromLE(header.numSlots), IFile::int32FromLE(header.pathsSize));
+	if (indexSize <= fileSize)
+	{
+		indexBuffer_ = nctl::makeUnique<unsigned char[]>(static_cast<unsigned long int>(indexSize));
+		fileHandle_->seek(0, SEEK_SET);
+		fileHandle_->read(indexBuffer_.get(), static_cast<unsigned long int>(indexSize));
+	}
+	fileHandle_.reset(nullptr);
+
+	if (indexBuffer_ == nullptr || useIndex(indexBuffer_.get(), static_cast<unsigned long int>(indexSize), fileSize) == false)
+	{
+		indexBuffer_.reset(nullptr);
+		LOGE_X("Asset pack \"%s\" has a truncated or corrupted index", filename);
+	}
+}
+
+AssetPack::~AssetPack() = default;
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+int AssetPack::findEntry(const char *path) const
+{
+	ASSERT(path);
+	return findEntry(path, static_cast<unsigned int>(strlen(path)));
+}
+
+nctl::String AssetPack::entryPath(unsigned int index) const
+{
+	FATAL_ASSERT(index < numEntries_);
+	const AssetPackFormat::Entry &entry = entryAt(entries_, index);
+
+	nctl::String path(entry.pathLength + 1);
+	path.assign(paths_ + entry.pathOffset, entry.pathLength);
+	return path;
+}
+
+unsigned long int AssetPack::entrySize(unsigned int index) const
+{
+	FATAL_ASSERT(index < numEntries_);
+	return static_cast<unsigned long int>(IFile::int64FromLE(entryAt(entries_, index).size));
+}
+
+bool AssetPack::isEntryCompressed(unsigned int index) const
+{
+	FATAL_ASSERT(index < numEntries_);
+	return (IFile::int32FromLE(entryAt(entries_, index).flags) & AssetPackFormat::Flags::COMPRESSED);
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool AssetPack::useIndex(const unsigned char *indexPtr, unsigned long int indexSize, unsigned long int fileSize)
+{
+	RETURNF_ASSERT_MSG_X(indexSize >= sizeof(AssetPackFormat::Header), "\"%s\" is not an asset pack", filename_.data());
+
+	const AssetPackFormat::Header *header = reinterpret_cast<const AssetPackFormat::Header *>(indexPtr);
+	RETURNF_ASSERT_MSG_X(IFile::int32FromLE(header->signature) == AssetPackFormat::Signature, "\"%s\" is not an asset pack", filename_.data());
+	RETURNF_ASSERT_MSG_X(IFile::int16FromLE(header->version) == AssetPackFormat::Version, "Asset pack version %u is not supported", IFile::int16FromLE(header->version));
+	RETURNF_ASSERT_MSG_X(IFile::int16FromLE(header->headerSize) == sizeof(AssetPackFormat::Header), "Asset pack header size is %u instead of %u", IFile::int16FromLE(header->headerSize), sizeof(AssetPackFormat::Header));
+
+	const uint32_t numEntries = IFile::int32FromLE(header->numEntries);
+	const uint32_t numSlots = IFile::int32FromLE(header->numSlots);
+	const uint32_t pathsSize = IFile::int32FromLE(header->pathsSize);
+	RETURNF_ASSERT_MSG_X(numSlots > numEntries && (numSlots & (numSlots - 1)) == 0, "Asset pack has %u hash table slots for %u entries", numSlots, numEntries);
+	const uint64_t expectedSize = AssetPackFormat::indexSize(numEntries, numSlots, pathsSize);
+	RETURNF_ASSERT_MSG_X(indexSize >= expectedSize, "Asset pack index is truncated: %lu bytes instead of %lu", indexSize, static_cast<unsigned long int>(expectedSize));
+
+	const uint32_t *slots = reinterpret_cast<const uint32_t *>(indexPtr + sizeof(AssetPackFormat::Header));
+	const AssetPackFormat::Entry *entries = reinterpret_cast<const AssetPackFormat::Entry *>(slots + numSlots);
+	unsigned int numEmptySlots = 0;
+	for (unsigned int i = 0; i < numSlots; i++)
+	{
+		const uint32_t slot = IFile::int32FromLE(slots[i]);
+		RETURNF_ASSERT_MSG_X(slot == AssetPackFormat::EmptySlot || slot < numEntries, "Asset pack hash table slot %u is out of range", i);
+		if (slot == AssetPackFormat::EmptySlot)
+			numEmptySlots++;
+	}
+	// Probing always terminates on an empty slot
+	RETURNF_ASSERT_MSG(numEmptySlots > 0, "Asset pack hash table has no empty slots");
+	for (unsigned int i = 0; i < numEntries; i++)
+	{
+		const AssetPackFormat::Entry &entry = entries[i];
+		const uint64_t pathEnd = uint64_t(IFile::int32FromLE(entry.pathOffset)) + IFile::int32FromLE(entry.pathLength);
+		const uint64_t dataOffset = IFile::int64FromLE(entry.dataOffset);
+		const uint64_t storedSize = IFile::int64FromLE(entry.storedSize);
+		const bool isCompressed = (IFile::int32FromLE(entry.flags) & AssetPackFormat::Flags::COMPRESSED);
+		RETURNF_ASSERT_MSG_X(pathEnd <= pathsSize, "Asset pack entry %u has an invalid path", i);
+		// Two checks instead of a sum that a crafted offset could overflow
+		RETURNF_ASSERT_MSG_X(dataOffset <= fileSize && storedSize <= fileSize - dataOffset, "Asset pack entry %u is truncated", i);
+		RETURNF_ASSERT_MSG_X(isCompressed || entry.storedSize == entry.size, "Asset pack entry %u has an invalid size", i);
+	}
+
+	slots_ = slots;
+	entries_ = entries;
+	paths_ = reinterpret_cast<const char *>(entries + numEntries);
+	numEntries_ = numEntries;
+	numSlots_ = numSlots;
+
+	return true;
+}
+
+int AssetPack::findEntry(const char *path, unsigned int length) const
+{
+	if (numSlots_ == 0)
+		return -1;
+
+	const uint32_t hash = AssetPackFormat::hashPath(path, length);
+	const unsigned int mask = numSlots_ - 1;
+	for (unsigned int slotIndex = hash & mask;; slotIndex = (slotIndex + 1) & mask)
+	{
+		const uint32_t entryIndex = IFile::int32FromLE(slots_[slotIndex]);
+		if (entryIndex == AssetPackFormat::EmptySlot)
+			return -1;
+
+		const AssetPackFormat::Entry &entry = entryAt(entries_, entryIndex);
+		if (IFile::int32FromLE(entry.hash) != hash || IFile::int32FromLE(entry.pathLength) != length)
+			continue;
+
+		// Paths in the pack always use forward slashes
+		const char *entryPath = paths_ + IFile::int32FromLE(entry.pathOffset);
+		unsigned int i = 0;
+		while (i < length && (entryPath[i] == path[i] || (entryPath[i] == '/' && path[i] == '\\')))
+			i++;
+		if (i == length)
+			return static_cast<int>(entryIndex);
+	}
+}
+
+const unsigned char *AssetPack::loadEntry(unsigned int index, nctl::UniquePtr<unsigned char[]> &buffer) const
+{
+	ASSERT(index < numEntries_);
+	const AssetPackFormat::Entry &entry = entryAt(entries_, index);
+	const unsigned long int dataOffset = static_cast<unsigned long int>(IFile::int64FromLE(entry.dataOffset));
+	const unsigned long int storedSize = static_cast<unsigned long int>(IFile::int64FromLE(entry.storedSize));
+	const unsigned long int size = static_cast<unsigned long int>(IFile::int64FromLE(entry.size));
+	const bool isCompressed = (IFile::int32FromLE(entry.flags) & AssetPackFormat::Flags::COMPRESSED);
+
+	if (mappedData_ != nullptr && isCompressed == false)
+		return mappedData_ + dataOffset;
+	// An empty entry still needs a valid pointer
+	if (size == 0)
+		return reinterpret_cast<const unsigned char *>(paths_);
+
+	nctl::UniquePtr<unsigned char[]> storedBuffer;
+	const unsigned char *storedData = mappedData_ + dataOffset;
+	if (mappedData_ == nullptr)
+	{
+		// Every load opens its own handle, so that entries can be read concurrently
+		nctl::UniquePtr<IFile> fileHandle = IFile::createReadFileHandle(filename_.data());
+		fileHandle->setExitOnFailToOpen(false);
+		fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+		if (fileHandle->isOpened() == false)
+		{
+			LOGE_X("Asset pack \"%s\" cannot be opened", filename_.data());
+			return nullptr;
+		}
+
+		storedBuffer = nctl::makeUnique<unsigned char[]>(storedSize);
+		fileHandle->seek(static_cast<long int>(dataOffset), SEEK_SET);
+		if (fileHandle->read(storedBuffer.get(), storedSize) != storedSize)
+		{
+			LOGE_X("Entry %u of asset pack \"%s\" cannot be read", index, filename_.data());
+			return nullptr;
+		}
+
+		if (isCompressed == false)
+		{
+			buffer = nctl::move(storedBuffer);
+			return buffer.get();
+		}
+		storedData = storedBuffer.get();
+	}
+
+	buffer = nctl::makeUnique<unsigned char[]>(size);
+	if (BlockCompression::decompress(storedData, storedSize, buffer.get(), size) == false)
+	{
+		LOGE_X("Entry %u of asset pack \"%s\" cannot be decompressed", index, filename_.data());
+		buffer.reset(nullptr);
+		return nullptr;
+	}
+
+	return buffer.get();
+}
+
+}
@@ -0,0 +1,295 @@
+#include <cstring> // for memset()
+#include "return_macros.h"
+#include "AssetPackBuilder.h"
+#include "AssetPackFormat.h"
+#include "BlockCompression.h"
+#include "FileSystem.h"
+#include "IFile.h"
+
+namespace ncine {
+
+namespace {
+
+	/// Entries smaller than this are never compressed
+	const unsigned long int MinCompressionSize = 64;
+	/// An entry is stored compressed only if it saves at least this fraction of its size
+	const unsigned long int MinCompressionSavingRatio = 8;
+
+	inline unsigned long int alignOffset(unsigned long int offset, unsigned int alignment)
+	{
+		return (offset + alignment - 1) & ~static_cast<unsigned long int>(alignment - 1);
+	}
+
+	/// Writes zeros to the file, used for padding
+	bool writeZeros(IFile &fileHandle, unsigned long int numBytes)
+	{
+		unsigned char zeros[256];
+		memset(zeros, 0, sizeof(zeros));
+		while (numBytes > 0)
+		{
+			const unsigned long int bytes = (numBytes > sizeof(zeros)) ? sizeof(zeros) : numBytes;
+			if (fileHandle.write(zeros, bytes) != bytes)
+				return false;
+			numBytes -= bytes;
+		}
+		return true;
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+AssetPackBuilder::AssetPackBuilder()
+    : alignment_(DefaultAlignment), compressionEnabled_(true)
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool AssetPackBuilder::setAlignment(unsigned int alignment)
+{
+	RETURNF_ASSERT_MSG_X(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment %u is not a power of two", alignment);
+	alignment_ = alignment;
+	return true;
+}
+
+bool AssetPackBuilder::addFile(const char *path, const char *filename)
+{
+	ASSERT(filename);
+	RETURNF_ASSERT_MSG_X(fs::isReadableFile(filename), "File \"%s\" cannot be read", filename);
+
+	Entry *entry = addEntry(path);
+	if (entry == nullptr)
+		return false;
+
+	entry->filename = nctl::String(filename);
+	return true;
+}
+
+bool AssetPackBuilder::addBuffer(const char *path, const unsigned char *bufferPtr, unsigned long int bufferSize)
+{
+	ASSERT(bufferPtr != nullptr || bufferSize == 0);
+
+	Entry *entry = addEntry(path);
+	if (entry == nullptr)
+		return false;
+
+	if (bufferSize > 0)
+	{
+		entry->buffer = nctl::makeUnique<unsigned char[]>(bufferSize);
+		memcpy(entry->buffer.get(), bufferPtr, bufferSize);
+	}
+	entry->bufferSize = bufferSize;
+	return true;
+}
+
+unsigned int AssetPackBuilder::addDirectory(const char *dirPath)
+{
+	ASSERT(dirPath);
+	RETURNF_ASSERT_MSG_X(fs::isDirectory(dirPath), "\"%s\" is not a directory", dirPath);
+	return addDirectory(nctl::String(dirPath), nctl::String());
+}
+
+bool AssetPackBuilder::saveToFile(const char *filename)
+{
+	const unsigned int numAddedEntries = entries_.size();
+
+	unsigned int numSlots = 2;
+	while (numSlots < numAddedEntries * 2)
+		numSlots <<= 1;
+	const unsigned int slotMask = numSlots - 1;
+
+	// The hash table is first filled with the indices of the added entries, the last one wins on duplicate paths
+	nctl::UniquePtr<uint32_t[]> slots = nctl::makeUnique<uint32_t[]>(numSlots);
+	for (unsigned int i = 0; i < numSlots; i++)
+		slots[i] = AssetPackFormat::EmptySlot;
+	nctl::UniquePtr<uint32_t[]> hashes = nctl::makeUnique<uint32_t[]>(numAddedEntries);
+	nctl::UniquePtr<uint32_t[]> packIndices = nctl::makeUnique<uint32_t[]>(numAddedEntries);
+
+	for (unsigned int i = 0; i < numAddedEntries; i++)
+	{
+		const nctl::String &path = entries_[i].path;
+		hashes[i] = AssetPackFormat::hashPath(path.data(), path.length());
+		packIndices[i] = 0;
+
+		unsigned int slotIndex = hashes[i] & slotMask;
+		while (slots[slotIndex] != AssetPackFormat::EmptySlot)
+		{
+			const unsigned int otherIndex = slots[slotIndex];
+			if (hashes[otherIndex] == hashes[i] && entries_[otherIndex].path == path)
+			{
+				LOGW_X("Entry \"%s\" has been added more than once, the last one is used", path.data());
+				packIndices[otherIndex] = AssetPackFormat::EmptySlot;
+				break;
+			}
+			slotIndex = (slotIndex + 1) & slotMask;
+		}
+		slots[slotIndex] = i;
+	}
+
+	// Entries keep the order in which they have been added
+	unsigned int numEntries = 0;
+	unsigned long int pathsSize = 0;
+	for (unsigned int i = 0; i < numAddedEntries; i++)
+	{
+		if (packIndices[i] == AssetPackFormat::EmptySlot)
+			continue;
+		packIndices[i] = numEntries++;
+		pathsSize += entries_[i].path.length();
+	}
+	for (unsigned int i = 0; i < numSlots; i++)
+	{
+		if (slots[i] != AssetPackFormat::EmptySlot)
+			slots[i] = IFile::int32FromLE(packIndices[slots[i]]);
+	}
+
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filename);
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+	RETURNF_ASSERT_MSG_X(fileHandle->isOpened(), "File \"%s\" cannot be opened", filename);
+
+	// The index is written at the end, when the offsets of all entries are known
+	const unsigned long int indexSize = static_cast<unsigned long int>(AssetPackFormat::indexSize(numEntries, numSlots, static_cast<uint32_t>(pathsSize)));
+	unsigned long int offset = alignOffset(indexSize, alignment_);
+	RETURNF_ASSERT_MSG_X(writeZeros(*fileHandle, offset), "Cannot write to the file \"%s\"", filename);
+
+	nctl::UniquePtr<AssetPackFormat::Entry[]> records = nctl::makeUnique<AssetPackFormat::Entry[]>(numEntries);
+	nctl::UniquePtr<char[]> paths = nctl::makeUnique<char[]>(pathsSize > 0 ? pathsSize : 1);
+	unsigned long int pathOffset = 0;
+	unsigned long int numCompressed = 0;
+
+	for (unsigned int i = 0; i < numAddedEntries; i++)
+	{
+		if (packIndices[i] == AssetPackFormat::EmptySlot)
+			continue;
+		const Entry &entry = entries_[i];
+
+		// File content is read only now, one entry at a time
+		nctl::UniquePtr<unsigned char[]> fileBuffer;
+		const unsigned char *data = entry.buffer.get();
+		unsigned long int size = entry.bufferSize;
+		if (entry.filename.isEmpty() == false)
+		{
+			nctl::UniquePtr<IFile> entryHandle = IFile::createReadFileHandle(entry.filename.data());
+			entryHandle->setExitOnFailToOpen(false);
+			entryHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+			RETURNF_ASSERT_MSG_X(entryHandle->isOpened(), "File \"%s\" cannot be opened", entry.filename.data());
+
+			size = static_cast<unsigned long int>(entryHandle->size());
+			fileBuffer = nctl::makeUnique<unsigned char[]>(size > 0 ? size : 1);
+			RETURNF_ASSERT_MSG_X(entryHandle->read(fileBuffer.get(), size) == size, "File \"%s\" cannot be read", entry.filename.data());
+			data = fileBuffer.get();
+		}
+
+		uint32_t flags = 0;
+		unsigned long int storedSize = size;
+		nctl::UniquePtr<unsigned char[]> compressedBuffer;
+		if (compressionEnabled_ && size >= MinCompressionSize)
+		{
+			const unsigned long int maxStoredSize = size - size / MinCompressionSavingRatio;
+			compressedBuffer = nctl::makeUnique<unsigned char[]>(maxStoredSize);
+			const unsigned long int compressedSize = BlockCompression::compress(data, size, compressedBuffer.get(), maxStoredSize);
+			if (compressedSize > 0)
+			{
+				flags |= AssetPackFormat::Flags::COMPRESSED;
+				storedSize = compressedSize;
+				data = compressedBuffer.get();
+				numCompressed++;
+			}
+		}
+
+		const unsigned long int alignedOffset = alignOffset(offset, alignment_);
+		RETURNF_ASSERT_MSG_X(writeZeros(*fileHandle, alignedOffset - offset), "Cannot write to the file \"%s\"", filename);
+		RETURNF_ASSERT_MSG_X(storedSize == 0 || fileHandle->write(const_cast<unsigned char *>(data), storedSize) == storedSize, "Cannot write to the file \"%s\"", filename);
+
+		AssetPackFormat::Entry &record = records[packIndices[i]];
+		record.hash = IFile::int32FromLE(hashes[i]);
+		record.pathOffset = IFile::int32FromLE(static_cast<uint32_t>(pathOffset));
+		record.pathLength = IFile::int32FromLE(entry.path.length());
+		record.flags = IFile::int32FromLE(flags);
+		record.dataOffset = IFile::int64FromLE(alignedOffset);
+		record.storedSize = IFile::int64FromLE(storedSize);
+		record.size = IFile::int64FromLE(size);
+
+		memcpy(paths.get() + pathOffset, entry.path.data(), entry.path.length());
+		pathOffset += entry.path.length();
+		offset = alignedOffset + storedSize;
+	}
+
+	AssetPackFormat::Header header;
+	memset(&header, 0, sizeof(AssetPackFormat::Header));
+	header.signature = IFile::int32FromLE(AssetPackFormat::Signature);
+	header.version = IFile::int16FromLE(AssetPackFormat::Version);
+	header.headerSize = IFile::int16FromLE(sizeof(AssetPackFormat::Header));
+	header.numEntries = IFile::int32FromLE(numEntries);
+	header.numSlots = IFile::int32FromLE(numSlots);
+	header.alignment = IFile::int32FromLE(alignment_);
+	header.pathsSize = IFile::int32FromLE(static_cast<uint32_t>(pathsSize));
+
+	fileHandle->seek(0, SEEK_SET);
+	fileHandle->write(&header, sizeof(AssetPackFormat::Header));
+	fileHandle->write(slots.get(), numSlots * sizeof(uint32_t));
+	fileHandle->write(records.get(), numEntries * sizeof(AssetPackFormat::Entry));
+	const unsigned long int bytesWritten = fileHandle->write(paths.get(), pathsSize);
+	RETURNF_ASSERT_MSG_X(bytesWritten == pathsSize, "Cannot write to the file \"%s\"", filename);
+	fileHandle->close();
+
+	LOGI_X("Asset pack \"%s\" saved: %u entries, %lu compressed, %lu bytes", filename, numEntries, numCompressed, offset);
+	return true;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+AssetPackBuilder::Entry *AssetPackBuilder::addEntry(const char *path)
+{
+	ASSERT(path);
+
+	// Paths are stored with forward slashes and without leading separators or current directory references
+	while (*path == '/' || *path == '\\' || (path[0] == '.' && (path[1] == '/' || path[1] == '\\')))
+		path += (*path == '.') ? 2 : 1;
+	if (*path == '\0')
+	{
+		LOGE("Entry path is empty");
+		return nullptr;
+	}
+
+	entries_.emplaceBack();
+	Entry &entry = entries_.back();
+	entry.path = nctl::String(path);
+	for (char &c : entry.path)
+	{
+		if (c == '\\')
+			c = '/';
+	}
+
+	return &entry;
+}
+
+unsigned int AssetPackBuilder::addDirectory(const nctl::String &dirPath, const nctl::String &pathPrefix)
+{
+	unsigned int numAdded = 0;
+
+	FileSystem::Directory dir(dirPath.data());
+	while (const char *entryName = dir.readNext())
+	{
+		if (strcmp(entryName, ".") == 0 || strcmp(entryName, "..") == 0)
+			continue;
+
+		const nctl::String entryFilename = fs::joinPath(dirPath, entryName);
+		const nctl::String entryPath = pathPrefix.isEmpty() ? nctl::String(entryName) : pathPrefix + "/" + entryName;
+		if (fs::isDirectory(entryFilename.data()))
+			numAdded += addDirectory(entryFilename, entryPath);
+		else if (addFile(entryPath.data(), entryFilename.data()))
+			numAdded++;
+	}
+
+	return numAdded;
+}
+
+}
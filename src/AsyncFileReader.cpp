@@ -0,0 +1,345 @@
+#include <cstring> // for memcpy()
+#include "common_macros.h"
+#include "AsyncFileReader.h"
+#include "IFile.h"
+#include <nctl/algorithms.h>
+#include "tracy.h"
+
+#ifdef WITH_THREADS
+	#include "Thread.h"
+	#include "ThreadSync.h"
+#endif
+
+namespace ncine {
+
+#ifdef WITH_THREADS
+struct AsyncFileReader::Worker
+{
+	Worker()
+	    : queue(16), shouldQuit(false) {}
+
+	Thread thread;
+	Mutex queueMutex;
+	/// Signaled when new reads are queued or when the thread should quit
+	CondVariable queueCV;
+	/// Broadcast every time a batch of reads has been served
+	CondVariable doneCV;
+	nctl::Array<nctl::SharedPtr<AsyncRead>> queue;
+	bool shouldQuit;
+};
+#else
+struct AsyncFileReader::Worker
+{
+};
+#endif
+
+namespace {
+
+	/// Orders reads by file name first and by offset second
+	bool compareReads(const nctl::SharedPtr<AsyncRead> &first, const nctl::SharedPtr<AsyncRead> &second)
+	{
+		const int result = strcmp(first->filename(), second->filename());
+		if (result != 0)
+			return (result < 0);
+		return (first->offset() < second->offset());
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// AsyncRead
+///////////////////////////////////////////////////////////
+
+AsyncRead::AsyncRead(const char *filename, unsigned long int offset, unsigned long int size)
+    : filename_(filename), offset_(offset), requestedSize_(size), callback_(nullptr), userData_(nullptr),
+      size_(0), state_(static_cast<int32_t>(State::PENDING))
+{
+}
+
+AsyncRead::State AsyncRead::state() const
+{
+	return static_cast<State>(state_.load(nctl::Atomic32::MemoryModel::ACQUIRE));
+}
+
+const unsigned char *AsyncRead::data() const
+{
+	return (state() == State::COMPLETED) ? buffer_.get() : nullptr;
+}
+
+unsigned long int AsyncRead::size() const
+{
+	return (state() == State::COMPLETED) ? size_ : 0;
+}
+
+nctl::UniquePtr<unsigned char[]> AsyncRead::takeData()
+{
+	if (state() != State::COMPLETED)
+		return nctl::UniquePtr<unsigned char[]>();
+	return nctl::move(buffer_);
+}
+
+bool AsyncRead::finish(State state)
+{
+	return state_.cmpExchange(static_cast<int32_t>(state), static_cast<int32_t>(State::PENDING));
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+AsyncFileReader::AsyncFileReader(bool withWorkerThread)
+    : requests_(16)
+{
+#ifdef WITH_THREADS
+	if (withWorkerThread)
+	{
+		worker_ = nctl::makeUnique<Worker>();
+		worker_->thread.run(workerFunction, this);
+	#if !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+		worker_->thread.setName("IOThread");
+	#endif
+	}
+#endif
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+#ifdef WITH_THREADS
+	if (worker_ != nullptr)
+	{
+		worker_->queueMutex.lock();
+		worker_->shouldQuit = true;
+		worker_->queueCV.signal();
+		worker_->queueMutex.unlock();
+		worker_->thread.join();
+	}
+#endif
+
+	for (nctl::SharedPtr<AsyncRead> &read : requests_)
+		read->finish(AsyncRead::State::CANCELED);
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::SharedPtr<AsyncRead> AsyncFileReader::readFile(const char *filename)
+{
+	return readRange(filename, 0, WholeFile, nullptr, nullptr);
+}
+
+nctl::SharedPtr<AsyncRead> AsyncFileReader::readFile(const char *filename, CompletionCallback callback, void *userData)
+{
+	return readRange(filename, 0, WholeFile, callback, userData);
+}
+
+nctl::SharedPtr<AsyncRead> AsyncFileReader::readRange(const char *filename, unsigned long int offset, unsigned long int size)
+{
+	return readRange(filename, offset, size, nullptr, nullptr);
+}
+
+nctl::SharedPtr<AsyncRead> AsyncFileReader::readRange(const char *filename, unsigned long int offset, unsigned long int size, CompletionCallback callback, void *userData)
+{
+	ASSERT(filename);
+	nctl::SharedPtr<AsyncRead> read(new AsyncRead(filename, offset, size));
+	read->callback_ = callback;
+	read->userData_ = userData;
+	requests_.pushBack(read);
+
+#ifdef WITH_THREADS
+	if (worker_ != nullptr)
+	{
+		worker_->queueMutex.lock();
+		worker_->queue.pushBack(read);
+		worker_->queueCV.signal();
+		worker_->queueMutex.unlock();
+	}
+#endif
+
+	return read;
+}
+
+bool AsyncFileReader::cancel(AsyncRead &read)
+{
+	return read.finish(AsyncRead::State::CANCELED);
+}
+
+void AsyncFileReader::wait(const AsyncRead &read)
+{
+	if (read.isDone())
+		return;
+
+#ifdef WITH_THREADS
+	if (worker_ != nullptr)
+	{
+		worker_->queueMutex.lock();
+		while (read.isDone() == false)
+			worker_->doneCV.wait(worker_->queueMutex);
+		worker_->queueMutex.unlock();
+		return;
+	}
+#endif
+
+	serveSynchronously();
+}
+
+void AsyncFileReader::update()
+{
+	if (requests_.isEmpty())
+		return;
+
+	if (worker_ == nullptr)
+		serveSynchronously();
+
+	unsigned int index = 0;
+	while (index < requests_.size())
+	{
+		// The reference stays valid if a callback queues new reads
+		AsyncRead &read = *requests_[index];
+		const AsyncRead::State state = read.state();
+		if (state == AsyncRead::State::PENDING)
+		{
+			index++;
+			continue;
+		}
+
+		if (state != AsyncRead::State::CANCELED && read.callback_ != nullptr)
+			read.callback_(read, read.userData_);
+		requests_.removeAt(index);
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void AsyncFileReader::serveSynchronously()
+{
+	nctl::Array<nctl::SharedPtr<AsyncRead>> batch(requests_.size());
+	for (nctl::SharedPtr<AsyncRead> &read : requests_)
+	{
+		if (read->state() == AsyncRead::State::PENDING)
+			batch.pushBack(read);
+	}
+
+	if (batch.isEmpty() == false)
+		serveBatch(batch);
+}
+
+void AsyncFileReader::serveBatch(nctl::Array<nctl::SharedPtr<AsyncRead>> &batch)
+{
+	ZoneScoped;
+	nctl::quicksort(batch.begin(), batch.end(), compareReads);
+	nctl::Array<AsyncRead::State> results(batch.size());
+
+	unsigned int groupStart = 0;
+	while (groupStart < batch.size())
+	{
+		unsigned int groupEnd = groupStart + 1;
+		while (groupEnd < batch.size() && strcmp(batch[groupEnd]->filename(), batch[groupStart]->filename()) == 0)
+			groupEnd++;
+
+		// All the reads of a file share the same handle
+		nctl::UniquePtr<IFile> fileHandle = IFile::createReadFileHandle(batch[groupStart]->filename());
+		fileHandle->setExitOnFailToOpen(false);
+		fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+		const bool isOpened = fileHandle->isOpened();
+		const unsigned long int fileSize = isOpened ? static_cast<unsigned long int>(fileHandle->size()) : 0;
+		if (isOpened == false)
+			LOGW_X("File \"%s\" cannot be opened for %u asynchronous reads", batch[groupStart]->filename(), groupEnd - groupStart);
+
+		// The served read whose range ends furthest, used to copy the bytes of overlapping ranges
+		const AsyncRead *coverRead = nullptr;
+		unsigned long int coverEnd = 0;
+
+		results.clear();
+		for (unsigned int i = groupStart; i < groupEnd; i++)
+		{
+			AsyncRead &read = *batch[i];
+			results.pushBack(AsyncRead::State::FAILED);
+			if (isOpened == false || read.state() != AsyncRead::State::PENDING || read.offset_ > fileSize)
+				continue;
+
+			const unsigned long int available = fileSize - read.offset_;
+			const unsigned long int size = (read.requestedSize_ > available) ? available : read.requestedSize_;
+			const unsigned long int end = read.offset_ + size;
+			nctl::UniquePtr<unsigned char[]> buffer;
+			if (size > 0)
+				buffer = nctl::makeUnique<unsigned char[]>(size);
+
+			unsigned long int bytesRead = 0;
+			if (coverRead != nullptr && read.offset_ < coverEnd)
+			{
+				bytesRead = ((coverEnd < end) ? coverEnd : end) - read.offset_;
+				memcpy(buffer.get(), coverRead->buffer_.get() + (read.offset_ - coverRead->offset_), bytesRead);
+				numCoalescedReads_.fetchAdd(1);
+			}
+
+			if (bytesRead < size)
+			{
+				// Ranges in offset order are read one after the other without seeking
+				const long int position = static_cast<long int>(read.offset_ + bytesRead);
+				if (fileHandle->tell() != position)
+					fileHandle->seek(position, SEEK_SET);
+				bytesRead += fileHandle->read(buffer.get() + bytesRead, size - bytesRead);
+			}
+
+			if (bytesRead == size)
+			{
+				read.buffer_ = nctl::move(buffer);
+				read.size_ = size;
+				results.back() = AsyncRead::State::COMPLETED;
+				if (end > coverEnd)
+				{
+					coverRead = &read;
+					coverEnd = end;
+				}
+			}
+		}
+
+		// The reads of a file are only published when all of them have been served, as their buffers might be copied
+		for (unsigned int i = groupStart; i < groupEnd; i++)
+			batch[i]->finish(results[i - groupStart]);
+
+		groupStart = groupEnd;
+	}
+}
+
+void AsyncFileReader::workerFunction(void *arg)
+{
+#ifdef WITH_THREADS
+	AsyncFileReader *reader = static_cast<AsyncFileReader *>(arg);
+	Worker &worker = *reader->worker_;
+	nctl::Array<nctl::SharedPtr<AsyncRead>> batch(16);
+
+	LOGD_X("I/O thread %u is starting", Thread::self());
+
+	while (true)
+	{
+		worker.queueMutex.lock();
+		while (worker.queue.isEmpty() && worker.shouldQuit == false)
+			worker.queueCV.wait(worker.queueMutex);
+
+		if (worker.shouldQuit)
+		{
+			worker.queueMutex.unlock();
+			break;
+		}
+
+		// All the reads queued in the meantime are served together
+		nctl::swap(batch, worker.queue);
+		worker.queueMutex.unlock();
+
+		reader->serveBatch(batch);
+		batch.clear();
+
+		worker.queueMutex.lock();
+		worker.doneCV.broadcast();
+		worker.queueMutex.unlock();
+	}
+
+	LOGD_X("I/O thread %u is exiting", Thread::self());
+#endif
+}
+
+}
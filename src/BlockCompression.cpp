@@ -0,0 +1,220 @@
+#include <cstdint>
+#include <cstring> // for memcpy()
+#include "common_macros.h"
+#include "BlockCompression.h"
+
+namespace ncine {
+
+namespace {
+
+	/// Minimum length of a back reference
+	const unsigned int MinMatch = 4;
+	/// The last match must start at least this number of bytes before the end of the input
+	const unsigned int MatchFindLimit = 12;
+	/// The last bytes of the input are always encoded as literals
+	const unsigned int LastLiterals = 5;
+	/// Maximum distance of a back reference
+	const unsigned int MaxOffset = 65535;
+	/// Number of bits of the hash table indices
+	const unsigned int HashLog = 12;
+
+	inline uint32_t read32(const unsigned char *ptr)
+	{
+		uint32_t value;
+		memcpy(&value, ptr, sizeof(uint32_t));
+		return value;
+	}
+
+	inline unsigned int hashSequence(uint32_t sequence)
+	{
+		return (sequence * 2654435761U) >> (32 - HashLog);
+	}
+
+	/// Writes the continuation bytes of a length, returns `nullptr` if the destination is full
+	unsigned char *writeLength(unsigned char *op, const unsigned char *opEnd, unsigned long int length)
+	{
+		while (length >= 255)
+		{
+			if (op >= opEnd)
+				return nullptr;
+			*op++ = 255;
+			length -= 255;
+		}
+		if (op >= opEnd)
+			return nullptr;
+		*op++ = static_cast<unsigned char>(length);
+		return op;
+	}
+
+	/// Writes a run of literals followed by a back reference, the last sequence of a block has a zero match length
+	unsigned char *writeSequence(unsigned char *op, const unsigned char *opEnd, const unsigned char *literals,
+	                             unsigned long int numLiterals, unsigned int offset, unsigned long int matchLength)
+	{
+		if (op >= opEnd)
+			return nullptr;
+		unsigned char *token = op++;
+		*token = static_cast<unsigned char>((numLiterals >= 15 ? 15 : numLiterals) << 4);
+		if (numLiterals >= 15 && (op = writeLength(op, opEnd, numLiterals - 15)) == nullptr)
+			return nullptr;
+
+		if (static_cast<unsigned long int>(opEnd - op) < numLiterals)
+			return nullptr;
+		memcpy(op, literals, numLiterals);
+		op += numLiterals;
+
+		if (matchLength == 0)
+			return op;
+
+		if (opEnd - op < 2)
+			return nullptr;
+		*op++ = static_cast<unsigned char>(offset & 0xFF);
+		*op++ = static_cast<unsigned char>(offset >> 8);
+
+		const unsigned long int length = matchLength - MinMatch;
+		*token |= static_cast<unsigned char>(length >= 15 ? 15 : length);
+		if (length >= 15)
+			op = writeLength(op, opEnd, length - 15);
+
+		return op;
+	}
+
+	/// Reads the continuation bytes of a length, returns false if the input ends first
+	bool readLength(const unsigned char *&ip, const unsigned char *ipEnd, unsigned long int &length)
+	{
+		unsigned char byte = 0;
+		do
+		{
+			if (ip >= ipEnd)
+				return false;
+			byte = *ip++;
+			length += byte;
+		} while (byte == 255);
+
+		return true;
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned long int BlockCompression::compressBound(unsigned long int size)
+{
+	return size + size / 255 + 16;
+}
+
+unsigned long int BlockCompression::compress(const unsigned char *src, unsigned long int srcSize, unsigned char *dest, unsigned long int destCapacity)
+{
+	ASSERT(src != nullptr || srcSize == 0);
+	ASSERT(dest != nullptr || destCapacity == 0);
+
+	// Positions are relative to the beginning of the input, stale entries are rejected by comparing the sequences
+	uint32_t hashTable[1 << HashLog];
+	memset(hashTable, 0, sizeof(hashTable));
+
+	const unsigned char *ip = src;
+	const unsigned char *anchor = src;
+	const unsigned char *srcEnd = src + srcSize;
+	unsigned char *op = dest;
+	const unsigned char *opEnd = dest + destCapacity;
+
+	if (srcSize > MatchFindLimit)
+	{
+		const unsigned char *searchLimit = srcEnd - MatchFindLimit;
+		const unsigned char *matchLimit = srcEnd - LastLiterals;
+
+		while (ip < searchLimit)
+		{
+			const uint32_t sequence = read32(ip);
+			const unsigned int hash = hashSequence(sequence);
+			const unsigned char *ref = src + hashTable[hash];
+			hashTable[hash] = static_cast<uint32_t>(ip - src);
+
+			if (ref < ip && ip - ref <= MaxOffset && read32(ref) == sequence)
+			{
+				const unsigned char *matchEnd = ip + MinMatch;
+				const unsigned char *refEnd = ref + MinMatch;
+				while (matchEnd < matchLimit && *matchEnd == *refEnd)
+				{
+					matchEnd++;
+					refEnd++;
+				}
+
+				op = writeSequence(op, opEnd, anchor, ip - anchor, static_cast<unsigned int>(ip - ref), matchEnd - ip);
+				if (op == nullptr)
+					return 0;
+				ip = matchEnd;
+				anchor = ip;
+			}
+			else
+			{
+				// The search accelerates on data that does not compress
+				ip += 1 + ((ip - anchor) >> 6);
+			}
+		}
+	}
+
+	op = writeSequence(op, opEnd, anchor, srcEnd - anchor, 0, 0);
+	return (op != nullptr) ? static_cast<unsigned long int>(op - dest) : 0;
+}
+
+bool BlockCompression::decompress(const unsigned char *src, unsigned long int srcSize, unsigned char *dest, unsigned long int destSize)
+{
+	ASSERT(src != nullptr || srcSize == 0);
+	ASSERT(dest != nullptr || destSize == 0);
+
+	const unsigned char *ip = src;
+	const unsigned char *ipEnd = src + srcSize;
+	unsigned char *op = dest;
+	unsigned char *opEnd = dest + destSize;
+
+	while (ip < ipEnd)
+	{
+		const unsigned int token = *ip++;
+
+		unsigned long int numLiterals = token >> 4;
+		if (numLiterals == 15 && readLength(ip, ipEnd, numLiterals) == false)
+			return false;
+		if (static_cast<unsigned long int>(ipEnd - ip) < numLiterals || static_cast<unsigned long int>(opEnd - op) < numLiterals)
+			return false;
+		memcpy(op, ip, numLiterals);
+		ip += numLiterals;
+		op += numLiterals;
+
+		// The last sequence of a block has no back reference
+		if (ip == ipEnd)
+			break;
+
+		if (ipEnd - ip < 2)
+			return false;
+		const unsigned int offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > static_cast<unsigned long int>(op - dest))
+			return false;
+
+		unsigned long int matchLength = token & 15;
+		if (matchLength == 15 && readLength(ip, ipEnd, matchLength) == false)
+			return false;
+		matchLength += MinMatch;
+		if (static_cast<unsigned long int>(opEnd - op) < matchLength)
+			return false;
+
+		const unsigned char *ref = op - offset;
+		if (offset >= matchLength)
+		{
+			memcpy(op, ref, matchLength);
+			op += matchLength;
+		}
+		else
+		{
+			// Overlapping references repeat the last `offset` bytes
+			for (unsigned long int i = 0; i < matchLength; i++)
+				*op++ = *ref++;
+		}
+	}
+
+	return (op == opEnd);
+}
+
+}
@@ -0,0 +1,471 @@
+#include "common_macros.h"
+#include "DirectoryScanner.h"
+#include "ServiceLocator.h"
+#include "IThreadPool.h"
+#include <nctl/HashMap.h>
+#include <nctl/UniquePtr.h>
+#include "tracy.h"
+
+#ifdef _WIN32
+	#include "common_windefines.h"
+	#include <windef.h>
+	#include <WinBase.h>
+	#include <fileapi.h>
+	#include <Timezoneapi.h>
+#else
+	#include <cerrno>
+	#include <cstring>
+	#include <ctime>
+	#include <unistd.h>
+	#include <fcntl.h>
+	#include <sys/stat.h>
+	#include <dirent.h>
+#endif
+
+#ifdef __ANDROID__
+	#include "AssetFile.h"
+#endif
+
+#ifdef WITH_THREADS
+	#include "ThreadSync.h"
+#endif
+
+namespace ncine {
+
+namespace {
+
+	/// The scan of a single directory, it stores the entries found in that directory only
+	struct ScanJob
+	{
+		ScanJob(const nctl::String &dir, const nctl::String &relative)
+		    : dirPath(dir), relativePath(relative), entries(16) {}
+
+		/// The path of the directory on disk
+		nctl::String dirPath;
+		/// The path of the directory relative to the scanned root
+		nctl::String relativePath;
+		nctl::Array<DirectoryScanner::Entry> entries;
+	};
+
+	/// The state shared between the threads taking part in a scan
+	class ScanState
+	{
+	  public:
+		explicit ScanState(const DirectoryScanner::Options &options)
+		    : options_(options), jobs_(64), queue_(64), numPendingJobs_(0) {}
+
+		inline nctl::Array<nctl::UniquePtr<ScanJob>> &jobs() { return jobs_; }
+
+		/// Adds the root directory job, before any thread has started
+		void addRootJob(const nctl::String &dirPath)
+		{
+			jobs_.pushBack(nctl::makeUnique<ScanJob>(dirPath, nctl::String()));
+			queue_.pushBack(jobs_.back().get());
+			numPendingJobs_ = 1;
+		}
+
+		/// Scans directories until there are no more jobs, it can be executed by more than one thread at the same time
+		void run();
+
+	  private:
+		DirectoryScanner::Options options_;
+		/// All the jobs in creation order, a subdirectory job is always created after the job of its parent
+		nctl::Array<nctl::UniquePtr<ScanJob>> jobs_;
+		/// The jobs that are waiting to be executed
+		nctl::Array<ScanJob *> queue_;
+		/// The number of jobs that have not been completed yet, queued or being executed
+		unsigned int numPendingJobs_;
+#ifdef WITH_THREADS
+		Mutex mutex_;
+		/// Signaled when new jobs are queued or when all jobs are completed
+		CondVariable queueCV_;
+#endif
+
+		inline void lock()
+		{
+#ifdef WITH_THREADS
+			mutex_.lock();
+#endif
+		}
+		inline void unlock()
+		{
+#ifdef WITH_THREADS
+			mutex_.unlock();
+#endif
+		}
+	};
+
+	/// A thread pool command that helps executing the jobs of a scan
+	class ScanCommand : public IThreadCommand
+	{
+	  public:
+		explicit ScanCommand(const nctl::SharedPtr<ScanState> &state)
+		    : state_(state) {}
+
+		void execute() override
+		{
+			ZoneScopedN("Scan directories");
+			state_->run();
+		}
+
+	  private:
+		nctl::SharedPtr<ScanState> state_;
+	};
+
+	nctl::String relativeEntryPath(const nctl::String &relativeDirPath, const char *name)
+	{
+		if (relativeDirPath.isEmpty())
+			return nctl::String(name);
+
+		nctl::String path(relativeDirPath.length() + static_cast<unsigned int>(strlen(name)) + 2);
+		path = relativeDirPath;
+		path.append("/");
+		path.append(name);
+		return path;
+	}
+
+#ifdef _WIN32
+	/// The number of 100 nanoseconds intervals between the Windows epoch (1601) and the Unix one (1970)
+	const int64_t EpochDifference = 116444736000000000LL;
+
+	int64_t fileTimeToSeconds(const FILETIME &fileTime)
+	{
+		const int64_t intervals = (static_cast<int64_t>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime;
+		return (intervals - EpochDifference) / 10000000LL;
+	}
+
+	/// Scans a single directory with one `FindFirstFileEx()` call that also returns the metadata of every entry
+	bool scanDirectory(ScanJob &job, const DirectoryScanner::Options &options, nctl::Array<nctl::String> &subDirs)
+	{
+		const nctl::String pattern = fs::joinPath(job.dirPath, "*");
+		WIN32_FIND_DATAA findData;
+		HANDLE hFindFile = FindFirstFileExA(pattern.data(), FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+		if (hFindFile == INVALID_HANDLE_VALUE)
+			return false;
+
+		do
+		{
+			const char *name = findData.cFileName;
+			if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0)
+				continue;
+
+			job.entries.emplaceBack();
+			DirectoryScanner::Entry &entry = job.entries.back();
+			entry.path = relativeEntryPath(job.relativePath, name);
+			entry.isDirectory = (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
+			entry.isHidden = (findData.dwFileAttributes & FILE_ATTRIBUTE_HIDDEN);
+			if (options.withMetadata)
+			{
+				if (entry.isDirectory == false)
+					entry.size = static_cast<long int>((static_cast<int64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow);
+				entry.modificationTime = fileTimeToSeconds(findData.ftLastWriteTime);
+				entry.permissions = fs::Permission::READ;
+				if ((findData.dwFileAttributes & FILE_ATTRIBUTE_READONLY) == 0)
+					entry.permissions += fs::Permission::WRITE;
+				// Using the same rules as `FileSystem::isExecutable()`
+				if (entry.isDirectory || fs::hasExtension(name, "exe") || fs::hasExtension(name, "bat") || fs::hasExtension(name, "com"))
+					entry.permissions += fs::Permission::EXECUTE;
+			}
+
+			if (entry.isDirectory && options.recursive)
+				subDirs.pushBack(entry.path);
+		} while (FindNextFileA(hFindFile, &findData));
+
+		FindClose(hFindFile);
+		return true;
+	}
+#else
+	int nativeModeToEnum(unsigned int nativeMode)
+	{
+		int mode = 0;
+
+		if (nativeMode & S_IRUSR)
+			mode += FileSystem::Permission::READ;
+		if (nativeMode & S_IWUSR)
+			mode += FileSystem::Permission::WRITE;
+		if (nativeMode & S_IXUSR)
+			mode += FileSystem::Permission::EXECUTE;
+
+		return mode;
+	}
+
+	/// Scans a single directory, the type of entries comes from `d_type` and the metadata from `fstatat()`
+	bool scanDirectory(ScanJob &job, const DirectoryScanner::Options &options, nctl::Array<nctl::String> &subDirs)
+	{
+		const int dirFd = ::open(job.dirPath.data(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (dirFd == -1)
+		{
+			LOGD_X("open error: %s", strerror(errno));
+			return false;
+		}
+
+		// The stream owns the descriptor, which is still valid for `fstatat()` until the stream is closed
+		DIR *dirStream = ::fdopendir(dirFd);
+		if (dirStream == nullptr)
+		{
+			LOGD_X("fdopendir error: %s", strerror(errno));
+			::close(dirFd);
+			return false;
+		}
+
+		while (const struct dirent *dirEntry = ::readdir(dirStream))
+		{
+			const char *name = dirEntry->d_name;
+			if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0)
+				continue;
+
+			job.entries.emplaceBack();
+			DirectoryScanner::Entry &entry = job.entries.back();
+			entry.path = relativeEntryPath(job.relativePath, name);
+			entry.isDirectory = (dirEntry->d_type == DT_DIR);
+			entry.isHidden = (name[0] == '.');
+
+			// Some file systems do not fill the type field, the entry is then stated even without metadata
+			if (options.withMetadata || dirEntry->d_type == DT_UNKNOWN)
+			{
+				struct stat sb;
+				if (::fstatat(dirFd, name, &sb, AT_SYMLINK_NOFOLLOW) == 0)
+				{
+					entry.isDirectory = S_ISDIR(sb.st_mode);
+					if (options.withMetadata)
+					{
+						if (entry.isDirectory == false)
+							entry.size = static_cast<long int>(sb.st_size);
+						entry.modificationTime = static_cast<int64_t>(sb.st_mtime);
+						entry.permissions = nativeModeToEnum(sb.st_mode);
+					}
+				}
+				else
+					LOGD_X("fstatat error: %s", strerror(errno));
+			}
+
+			if (entry.isDirectory && options.recursive)
+				subDirs.pushBack(entry.path);
+		}
+
+		::closedir(dirStream);
+		return true;
+	}
+#endif
+
+	void ScanState::run()
+	{
+		nctl::Array<nctl::String> subDirs(16);
+
+		lock();
+		while (true)
+		{
+#ifdef WITH_THREADS
+			while (queue_.isEmpty() && numPendingJobs_ > 0)
+				queueCV_.wait(mutex_);
+#endif
+			// With a single thread the queue can only be empty when every job has been completed
+			if (queue_.isEmpty())
+				break;
+
+			ScanJob *job = queue_.back();
+			queue_.popBack();
+			unlock();
+
+			subDirs.clear();
+			scanDirectory(*job, options_, subDirs);
+
+			lock();
+			for (const nctl::String &subDir : subDirs)
+			{
+				jobs_.pushBack(nctl::makeUnique<ScanJob>(fs::joinPath(jobs_[0]->dirPath, subDir), subDir));
+				queue_.pushBack(jobs_.back().get());
+			}
+			numPendingJobs_ += subDirs.size() - 1;
+#ifdef WITH_THREADS
+			if (subDirs.size() > 1 || numPendingJobs_ == 0)
+				queueCV_.broadcast();
+#endif
+		}
+		unlock();
+	}
+
+#ifdef __ANDROID__
+	/// Android assets can only be listed by name, their directories are scanned by the calling thread
+	void scanAssetDirectory(const nctl::String &dirPath, const nctl::String &relativePath,
+	                        const DirectoryScanner::Options &options, DirectoryScanner::Result &result)
+	{
+		result.numDirectories++;
+		FileSystem::Directory dir(dirPath.data());
+		while (const char *name = dir.readNext())
+		{
+			result.entries.emplaceBack();
+			DirectoryScanner::Entry &entry = result.entries.back();
+			entry.path = relativeEntryPath(relativePath, name);
+			const nctl::String path = fs::joinPath(dirPath, name);
+			entry.isDirectory = AssetFile::tryOpenDirectory(path.data());
+			if (options.withMetadata)
+			{
+				entry.permissions = entry.isDirectory ? (fs::Permission::READ + fs::Permission::EXECUTE) : fs::Permission::READ;
+				if (entry.isDirectory == false)
+					entry.size = static_cast<long int>(AssetFile::length(path.data()));
+			}
+
+			if (entry.isDirectory && options.recursive)
+			{
+				// The entry reference is not valid anymore once the recursion adds new entries
+				const nctl::String subDirPath = entry.path;
+				scanAssetDirectory(path, subDirPath, options, result);
+			}
+		}
+	}
+#endif
+
+	const unsigned int InitialCacheCapacity = 16;
+
+	/// The cache is created on first use, to avoid depending on the initialization order of static objects
+	nctl::StringHashMap<nctl::SharedPtr<DirectoryScanner::Result>> &cache()
+	{
+		static nctl::StringHashMap<nctl::SharedPtr<DirectoryScanner::Result>> cachedResults(InitialCacheCapacity);
+		return cachedResults;
+	}
+
+	void addToCache(const nctl::String &key, const nctl::SharedPtr<DirectoryScanner::Result> &result)
+	{
+		nctl::StringHashMap<nctl::SharedPtr<DirectoryScanner::Result>> &cachedResults = cache();
+		if ((cachedResults.size() + 1) * 4 > cachedResults.capacity() * 3)
+			cachedResults.rehash(cachedResults.capacity() * 2);
+		cachedResults.insert(key, result);
+	}
+
+	/// The key of a cached result, the parallel option does not change the result
+	nctl::String cacheKey(const char *path, bool recursive, bool withMetadata)
+	{
+		nctl::String key(static_cast<unsigned int>(strlen(path)) + 4);
+		key.format("%c%c|%s", recursive ? 'R' : '-', withMetadata ? 'M' : '-', path);
+		return key;
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::SharedPtr<DirectoryScanner::Result> DirectoryScanner::scan(const char *path)
+{
+	return scan(path, Options());
+}
+
+nctl::SharedPtr<DirectoryScanner::Result> DirectoryScanner::scan(const char *path, const Options &options)
+{
+	ZoneScoped;
+	if (path == nullptr || fs::isDirectory(path) == false)
+		return nctl::SharedPtr<Result>();
+
+	const nctl::String key = cacheKey(path, options.recursive, options.withMetadata);
+	if (options.useCache)
+	{
+		const nctl::SharedPtr<Result> *cachedResult = cache().find(key);
+		if (cachedResult != nullptr)
+			return *cachedResult;
+	}
+
+	nctl::SharedPtr<Result> result = nctl::makeShared<Result>();
+	result->path = nctl::String(path);
+
+#ifdef __ANDROID__
+	if (AssetFile::assetPath(path))
+	{
+		scanAssetDirectory(result->path, nctl::String(), options, *result);
+		if (options.useCache)
+			addToCache(key, result);
+		return result;
+	}
+#endif
+
+	nctl::SharedPtr<ScanState> state = nctl::makeShared<ScanState>(options);
+	state->addRootJob(result->path);
+
+	if (options.parallel && options.recursive)
+	{
+		// The calling thread takes part in the scan, so that it completes even if the pool workers are busy
+		const unsigned int numThreads = theServiceLocator().threadPool().numThreads();
+		for (unsigned int i = 0; i < numThreads; i++)
+			theServiceLocator().threadPool().enqueueCommand(nctl::makeUnique<ScanCommand>(state));
+	}
+	state->run();
+
+	// Concatenating the entries in job creation order puts every directory before its own entries
+	unsigned int numEntries = 0;
+	for (const nctl::UniquePtr<ScanJob> &job : state->jobs())
+		numEntries += job->entries.size();
+	result->entries.setCapacity(numEntries);
+	for (nctl::UniquePtr<ScanJob> &job : state->jobs())
+	{
+		for (DirectoryScanner::Entry &entry : job->entries)
+			result->entries.pushBack(nctl::move(entry));
+	}
+	result->numDirectories = state->jobs().size();
+
+	if (options.useCache)
+		addToCache(key, result);
+
+	return result;
+}
+
+bool DirectoryScanner::invalidateCache(const char *path)
+{
+	if (path == nullptr)
+		return false;
+
+	bool removed = false;
+	for (unsigned int i = 0; i < 4; i++)
+		removed |= cache().remove(cacheKey(path, i & 1, i & 2));
+	return removed;
+}
+
+void DirectoryScanner::clearCache()
+{
+	cache().clear();
+}
+
+unsigned int DirectoryScanner::numCachedResults()
+{
+	return cache().size();
+}
+
+FileSystem::FileDate DirectoryScanner::fileDate(int64_t time)
+{
+	FileSystem::FileDate date = {};
+#ifdef _WIN32
+	const int64_t intervals = time * 10000000LL + EpochDifference;
+	FILETIME fileTime;
+	fileTime.dwLowDateTime = static_cast<DWORD>(intervals);
+	fileTime.dwHighDateTime = static_cast<DWORD>(intervals >> 32);
+
+	FILETIME localTime;
+	SYSTEMTIME sysTime;
+	FileTimeToLocalFileTime(&fileTime, &localTime);
+	FileTimeToSystemTime(&localTime, &sysTime);
+	date.year = sysTime.wYear;
+	date.month = sysTime.wMonth;
+	date.day = sysTime.wDay;
+	date.weekDay = sysTime.wDayOfWeek;
+	date.hour = sysTime.wHour;
+	date.minute = sysTime.wMinute;
+	date.second = sysTime.wSecond;
+#else
+	const time_t timer = static_cast<time_t>(time);
+	struct tm local;
+	if (localtime_r(&timer, &local) != nullptr)
+	{
+		date.year = local.tm_year + 1900;
+		date.month = local.tm_mon + 1;
+		date.day = local.tm_mday;
+		date.weekDay = local.tm_wday;
+		date.hour = local.tm_hour;
+		date.minute = local.tm_min;
+		date.second = local.tm_sec;
+	}
+#endif
+
+	return date;
+}
+
+}
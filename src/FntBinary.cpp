@@ -0,0 +1,189 @@
+#include <cstring>
+#include <nctl/CString.h>
+#include "return_macros.h"
+#include "FntBinary.h"
+#include "IFile.h"
+#include "FileSystem.h"
+
+namespace ncine {
+
+static_assert(sizeof(FntBinary::Header) == 36 + FntParser::MaxFaceNameLength + FntParser::MaxFileNameLength, "Binary font header should not be padded");
+static_assert(sizeof(FntBinary::CharTag) == 20, "Binary font character record should not be padded");
+static_assert(sizeof(FntBinary::KerningTag) == 12, "Binary font kerning record should not be padded");
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+FntBinary::FntBinary(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize)
+    : header_(nullptr), charTags_(nullptr), kerningTags_(nullptr),
+      numCharTags_(0), numKerningTags_(0), filename_(bufferName)
+{
+	useBuffer(bufferPtr, bufferSize);
+}
+
+FntBinary::FntBinary(const char *filename)
+    : header_(nullptr), charTags_(nullptr), kerningTags_(nullptr),
+      numCharTags_(0), numKerningTags_(0), filename_(filename)
+{
+	fileHandle_ = IFile::createMappedFileHandle(filename);
+	fileHandle_->setExitOnFailToOpen(false);
+	fileHandle_->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+	RETURN_ASSERT_MSG_X(fileHandle_->isOpened(), "File \"%s\" cannot be opened", filename);
+
+	// Records are used in place, from the mapping or from a single allocation for the whole file
+	const unsigned long int size = static_cast<unsigned long int>(fileHandle_->size());
+	if (fileHandle_->mappedData() != nullptr)
+	{
+		if (useBuffer(fileHandle_->mappedData(), size) == false)
+			fileHandle_.reset(nullptr);
+		return;
+	}
+
+	fileBuffer_ = nctl::makeUnique<unsigned char[]>(size);
+	const unsigned long int bytesRead = fileHandle_->read(fileBuffer_.get(), size);
+	fileHandle_.reset(nullptr);
+
+	if (useBuffer(fileBuffer_.get(), bytesRead) == false)
+		fileBuffer_.reset(nullptr);
+}
+
+FntBinary::~FntBinary()
+{
+	// Defined to solve deletion of incomplete type pointer (forward declared class)
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool FntBinary::hasBinaryExtension(const char *filename)
+{
+	return fs::hasExtension(filename, "nfnt");
+}
+
+bool FntBinary::hasSignature(const unsigned char *bufferPtr, unsigned long int bufferSize)
+{
+	if (bufferPtr == nullptr || bufferSize < sizeof(Header))
+		return false;
+
+	// The signature is compared in the host byte order, like all the other fields
+	uint32_t signature = 0;
+	memcpy(&signature, bufferPtr, sizeof(uint32_t));
+	return (signature == Signature);
+}
+
+bool FntBinary::saveToFile(const FntParser &fntParser, const char *filename)
+{
+	const FntParser::InfoTag &infoTag = fntParser.infoTag();
+	const FntParser::CommonTag &commonTag = fntParser.commonTag();
+
+	Header header;
+	memset(&header, 0, sizeof(Header));
+	header.signature = Signature;
+	header.version = Version;
+	header.headerSize = sizeof(Header);
+	header.size = static_cast<int16_t>(infoTag.size);
+	header.lineHeight = static_cast<uint16_t>(commonTag.lineHeight);
+	header.base = static_cast<uint16_t>(commonTag.base);
+	header.scaleW = static_cast<uint16_t>(commonTag.scaleW);
+	header.scaleH = static_cast<uint16_t>(commonTag.scaleH);
+	header.pages = static_cast<uint16_t>(commonTag.pages);
+	header.packed = commonTag.packed ? 1 : 0;
+	header.outline = static_cast<uint8_t>(infoTag.outline);
+	header.alphaChnl = static_cast<uint8_t>(commonTag.alphaChnl);
+	header.redChnl = static_cast<uint8_t>(commonTag.redChnl);
+	header.greenChnl = static_cast<uint8_t>(commonTag.greenChnl);
+	header.blueChnl = static_cast<uint8_t>(commonTag.blueChnl);
+	header.numChars = fntParser.numCharTags();
+	header.numKernings = fntParser.numKerningTags();
+	nctl::strncpy(header.face, FntParser::MaxFaceNameLength, infoTag.face.data(), FntParser::MaxFaceNameLength - 1);
+	if (fntParser.numPageTags() > 0)
+		nctl::strncpy(header.pageFile, FntParser::MaxFileNameLength, fntParser.pageTag(0).file.data(), FntParser::MaxFileNameLength - 1);
+
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filename);
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+	RETURNF_ASSERT_MSG_X(fileHandle->isOpened(), "File \"%s\" cannot be opened", filename);
+
+	fileHandle->write(&header, sizeof(Header));
+
+	for (unsigned int i = 0; i < fntParser.numCharTags(); i++)
+	{
+		const FntParser::CharTag &charTag = fntParser.charTag(i);
+		CharTag record;
+		record.id = static_cast<uint32_t>(charTag.id);
+		record.x = static_cast<uint16_t>(charTag.x);
+		record.y = static_cast<uint16_t>(charTag.y);
+		record.width = static_cast<uint16_t>(charTag.width);
+		record.height = static_cast<uint16_t>(charTag.height);
+		record.xoffset = static_cast<int16_t>(charTag.xoffset);
+		record.yoffset = static_cast<int16_t>(charTag.yoffset);
+		record.xadvance = static_cast<int16_t>(charTag.xadvance);
+		record.page = static_cast<uint16_t>(charTag.page);
+		fileHandle->write(&record, sizeof(CharTag));
+	}
+
+	for (unsigned int i = 0; i < fntParser.numKerningTags(); i++)
+	{
+		const FntParser::KerningTag &kerningTag = fntParser.kerningTag(i);
+		KerningTag record;
+		record.first = static_cast<uint32_t>(kerningTag.first);
+		record.second = static_cast<uint32_t>(kerningTag.second);
+		record.amount = static_cast<int32_t>(kerningTag.amount);
+		fileHandle->write(&record, sizeof(KerningTag));
+	}
+
+	fileHandle->close();
+	LOGI_X("Binary font saved to \"%s\": %u characters, %u kernings", filename, header.numChars, header.numKernings);
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note The records are used in place, the buffer is assumed to be in the byte order of the host */
+bool FntBinary::useBuffer(const unsigned char *bufferPtr, unsigned long int bufferSize)
+{
+	RETURNF_ASSERT_MSG_X(hasSignature(bufferPtr, bufferSize), "\"%s\" is not a binary font", filename_.data());
+
+	const Header *header = reinterpret_cast<const Header *>(bufferPtr);
+	RETURNF_ASSERT_MSG_X(header->version == Version, "Binary font version %u is not supported", header->version);
+	RETURNF_ASSERT_MSG_X(header->headerSize == sizeof(Header), "Binary font header size is %u instead of %u", header->headerSize, sizeof(Header));
+
+	// Computed in 64 bits, so that the counts in a crafted header cannot overflow the size on 32 bits platforms
+	const uint64_t expectedSize = sizeof(Header) + static_cast<uint64_t>(header->numChars) * sizeof(CharTag) +
+	                              static_cast<uint64_t>(header->numKernings) * sizeof(KerningTag);
+	RETURNF_ASSERT_MSG_X(static_cast<uint64_t>(bufferSize) >= expectedSize, "Binary font is truncated: %lu bytes instead of %llu",
+	                     bufferSize, static_cast<unsigned long long>(expectedSize));
+
+	header_ = header;
+	charTags_ = reinterpret_cast<const CharTag *>(bufferPtr + sizeof(Header));
+	kerningTags_ = reinterpret_cast<const KerningTag *>(bufferPtr + sizeof(Header) + header->numChars * sizeof(CharTag));
+	numCharTags_ = header->numChars;
+	numKerningTags_ = header->numKernings;
+
+	infoTag_.face.assign(header->face, nctl::strnlen(header->face, FntParser::MaxFaceNameLength));
+	infoTag_.size = header->size;
+	infoTag_.outline = header->outline;
+
+	commonTag_.lineHeight = header->lineHeight;
+	commonTag_.base = header->base;
+	commonTag_.scaleW = header->scaleW;
+	commonTag_.scaleH = header->scaleH;
+	commonTag_.pages = header->pages;
+	commonTag_.packed = (header->packed != 0);
+	commonTag_.alphaChnl = static_cast<FntParser::ChannelData>(header->alphaChnl);
+	commonTag_.redChnl = static_cast<FntParser::ChannelData>(header->redChnl);
+	commonTag_.greenChnl = static_cast<FntParser::ChannelData>(header->greenChnl);
+	commonTag_.blueChnl = static_cast<FntParser::ChannelData>(header->blueChnl);
+
+	pageTag_.file.assign(header->pageFile, nctl::strnlen(header->pageFile, FntParser::MaxFileNameLength));
+
+	LOGI_X("Binary font used for \"%s\", size %d, texture %dx%d, %u characters, %u kernings", infoTag_.face.data(), infoTag_.size, commonTag_.scaleW, commonTag_.scaleH, numCharTags_, numKerningTags_);
+	return true;
+}
+
+}
@@ -18,7 +18,7 @@ FntParser::FntParser(const char *bufferName, const char *bufferPtr, unsigned lon
 FntParser::FntParser(const char *fntFilename)
     : numPageTags_(0), numCharTags_(0), numKerningTags_(0), filename_(fntFilename)
 {
-	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(fntFilename);
+	nctl::UniquePtr<IFile> fileHandle = IFile::createReadFileHandle(fntFilename);
 	fileHandle->open(IFile::OpenMode::READ);
 
 	const long int size = fileHandle->size();
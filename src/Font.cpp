@@ -2,33 +2,90 @@
 #include <nctl/CString.h>
 #include "Font.h"
 #include "FntParser.h"
+#include "FntBinary.h"
 #include "FontData.h"
 #include "FontGlyph.h"
 #include "Texture.h"
 #include "FileSystem.h"
+#include "VirtualFileSystem.h"
 #include "tracy.h"
 
 namespace ncine {
 
+namespace {
+
+	/// Packs the codepoints of a kerning pair into a single hashmap key
+	inline uint64_t kerningKey(unsigned int firstGlyphId, unsigned int secondGlyphId)
+	{
+		return (static_cast<uint64_t>(firstGlyphId) << 32) | static_cast<uint64_t>(secondGlyphId);
+	}
+
+	/// Returns the path of the page texture, a texture inside a virtual file system mount cannot be resolved on the file system
+	nctl::String pageTexturePath(const nctl::String &dirName, const nctl::String &pageFile)
+	{
+		nctl::String texFilename = fs::joinPath(dirName, pageFile);
+		if (VirtualFileSystem::isFile(texFilename.data()))
+			return texFilename;
+		return fs::absoluteJoinPath(dirName, pageFile);
+	}
+
+}
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
 
+/*! \note The font can only be queried for its glyphs and kerning pairs, it cannot be rendered by a `TextNode` */
+Font::Font(const char *fntBufferName, const unsigned char *fntBufferPtr, unsigned long int fntBufferSize)
+    : Object(ObjectType::FONT, fntBufferName),
+      lineHeight_(0), base_(0), width_(0), height_(0), numGlyphs_(0), numKernings_(0),
+      glyphArray_(nctl::makeUnique<FontGlyph[]>(GlyphArraySize)),
+      renderMode_(RenderMode::GLYPH_IN_RED)
+{
+	ZoneScoped;
+	ZoneText(fntBufferName, nctl::strnlen(fntBufferName, nctl::String::MaxCStringLength));
+
+	if (FntBinary::hasSignature(fntBufferPtr, fntBufferSize))
+	{
+		FntBinary fntBinary(fntBufferName, fntBufferPtr, fntBufferSize);
+		FATAL_ASSERT_MSG_X(fntBinary.isValid(), "Binary font \"%s\" is not valid", fntBufferName);
+		retrieveInfoFromFnt(fntBinary);
+		checkFntInformation(fntBinary);
+	}
+	else
+	{
+		FntParser fntParser(fntBufferName, reinterpret_cast<const char *>(fntBufferPtr), fntBufferSize);
+		retrieveInfoFromFnt(fntParser);
+		checkFntInformation(fntParser);
+	}
+}
+
 /*! \note The specified texture will override the one in the FNT file */
 Font::Font(const char *fntBufferName, const unsigned char *fntBufferPtr, unsigned long int fntBufferSize, const char *texFilename)
     : Object(ObjectType::FONT, fntBufferName),
       texture_(nctl::makeUnique<Texture>(texFilename)),
       lineHeight_(0), base_(0), width_(0), height_(0), numGlyphs_(0), numKernings_(0),
       glyphArray_(nctl::makeUnique<FontGlyph[]>(GlyphArraySize)),
-      glyphHashMap_(GlyphHashmapSize), renderMode_(RenderMode::GLYPH_IN_RED)
+      renderMode_(RenderMode::GLYPH_IN_RED)
 {
 	ZoneScoped;
 	ZoneText(fntBufferName, nctl::strnlen(fntBufferName, nctl::String::MaxCStringLength));
 
-	FntParser fntParser(fntBufferName, reinterpret_cast<const char *>(fntBufferPtr), fntBufferSize);
-	retrieveInfoFromFnt(fntParser);
-	checkFntInformation(fntParser);
-	determineRenderMode(fntParser);
+	if (FntBinary::hasSignature(fntBufferPtr, fntBufferSize))
+	{
+		FntBinary fntBinary(fntBufferName, fntBufferPtr, fntBufferSize);
+		FATAL_ASSERT_MSG_X(fntBinary.isValid(), "Binary font \"%s\" is not valid", fntBufferName);
+		retrieveInfoFromFnt(fntBinary);
+		checkFntInformation(fntBinary);
+		determineRenderMode(fntBinary);
+	}
+	else
+	{
+		FntParser fntParser(fntBufferName, reinterpret_cast<const char *>(fntBufferPtr), fntBufferSize);
+		retrieveInfoFromFnt(fntParser);
+		checkFntInformation(fntParser);
+		determineRenderMode(fntParser);
+	}
 }
 
 /*! \note The specified texture will override the one in the FNT file */
@@ -38,15 +95,26 @@ Font::Font(const char *fntBufferName, const unsigned char *fntBufferPtr, unsigne
       texture_(nctl::makeUnique<Texture>(texBufferName, texBufferPtr, texBufferSize)),
       lineHeight_(0), base_(0), width_(0), height_(0), numGlyphs_(0), numKernings_(0),
       glyphArray_(nctl::makeUnique<FontGlyph[]>(GlyphArraySize)),
-      glyphHashMap_(GlyphHashmapSize), renderMode_(RenderMode::GLYPH_IN_RED)
+      renderMode_(RenderMode::GLYPH_IN_RED)
 {
 	ZoneScoped;
 	ZoneText(fntBufferName, nctl::strnlen(fntBufferName, nctl::String::MaxCStringLength));
 
-	FntParser fntParser(fntBufferName, reinterpret_cast<const char *>(fntBufferPtr), fntBufferSize);
-	retrieveInfoFromFnt(fntParser);
-	checkFntInformation(fntParser);
-	determineRenderMode(fntParser);
+	if (FntBinary::hasSignature(fntBufferPtr, fntBufferSize))
+	{
+		FntBinary fntBinary(fntBufferName, fntBufferPtr, fntBufferSize);
+		FATAL_ASSERT_MSG_X(fntBinary.isValid(), "Binary font \"%s\" is not valid", fntBufferName);
+		retrieveInfoFromFnt(fntBinary);
+		checkFntInformation(fntBinary);
+		determineRenderMode(fntBinary);
+	}
+	else
+	{
+		FntParser fntParser(fntBufferName, reinterpret_cast<const char *>(fntBufferPtr), fntBufferSize);
+		retrieveInfoFromFnt(fntParser);
+		checkFntInformation(fntParser);
+		determineRenderMode(fntParser);
+	}
 }
 
 /*! \note The texture specified by the FNT file will be automatically loaded */
@@ -54,19 +122,33 @@ Font::Font(const char *fntFilename)
     : Object(ObjectType::FONT, fntFilename),
       lineHeight_(0), base_(0), width_(0), height_(0), numGlyphs_(0), numKernings_(0),
       glyphArray_(nctl::makeUnique<FontGlyph[]>(GlyphArraySize)),
-      glyphHashMap_(GlyphHashmapSize), renderMode_(RenderMode::GLYPH_IN_RED)
+      renderMode_(RenderMode::GLYPH_IN_RED)
 {
 	ZoneScoped;
 	ZoneText(fntFilename, nctl::strnlen(fntFilename, nctl::String::MaxCStringLength));
 
-	FntParser fntParser(fntFilename);
-	retrieveInfoFromFnt(fntParser);
-
 	nctl::String dirName = fs::dirName(fntFilename);
-	nctl::String texFilename = fs::absoluteJoinPath(dirName, fntParser.pageTag(0).file);
-	texture_ = nctl::makeUnique<Texture>(texFilename.data());
-	checkFntInformation(fntParser);
-	determineRenderMode(fntParser);
+	if (FntBinary::hasBinaryExtension(fntFilename))
+	{
+		FntBinary fntBinary(fntFilename);
+		FATAL_ASSERT_MSG_X(fntBinary.isValid(), "Binary font \"%s\" is not valid", fntFilename);
+		retrieveInfoFromFnt(fntBinary);
+
+		nctl::String texFilename = pageTexturePath(dirName, fntBinary.pageTag(0).file);
+		texture_ = nctl::makeUnique<Texture>(texFilename.data());
+		checkFntInformation(fntBinary);
+		determineRenderMode(fntBinary);
+	}
+	else
+	{
+		FntParser fntParser(fntFilename);
+		retrieveInfoFromFnt(fntParser);
+
+		nctl::String texFilename = pageTexturePath(dirName, fntParser.pageTag(0).file);
+		texture_ = nctl::makeUnique<Texture>(texFilename.data());
+		checkFntInformation(fntParser);
+		determineRenderMode(fntParser);
+	}
 }
 
 /*! \note The specified texture will override the one in the FNT file */
@@ -75,15 +157,26 @@ Font::Font(const char *fntFilename, const char *texFilename)
       texture_(nctl::makeUnique<Texture>(texFilename)),
       lineHeight_(0), base_(0), width_(0), height_(0), numGlyphs_(0), numKernings_(0),
       glyphArray_(nctl::makeUnique<FontGlyph[]>(GlyphArraySize)),
-      glyphHashMap_(GlyphHashmapSize), renderMode_(RenderMode::GLYPH_IN_RED)
+      renderMode_(RenderMode::GLYPH_IN_RED)
 {
 	ZoneScoped;
 	ZoneText(fntFilename, nctl::strnlen(fntFilename, nctl::String::MaxCStringLength));
 
-	FntParser fntParser(fntFilename);
-	retrieveInfoFromFnt(fntParser);
-	checkFntInformation(fntParser);
-	determineRenderMode(fntParser);
+	if (FntBinary::hasBinaryExtension(fntFilename))
+	{
+		FntBinary fntBinary(fntFilename);
+		FATAL_ASSERT_MSG_X(fntBinary.isValid(), "Binary font \"%s\" is not valid", fntFilename);
+		retrieveInfoFromFnt(fntBinary);
+		checkFntInformation(fntBinary);
+		determineRenderMode(fntBinary);
+	}
+	else
+	{
+		FntParser fntParser(fntFilename);
+		retrieveInfoFromFnt(fntParser);
+		checkFntInformation(fntParser);
+		determineRenderMode(fntParser);
+	}
 }
 
 Font::Font(const FontData &fontData)
@@ -91,16 +184,24 @@ Font::Font(const FontData &fontData)
       texture_(nctl::makeUnique<Texture>(*fontData.texData_)),
       lineHeight_(0), base_(0), width_(0), height_(0), numGlyphs_(0), numKernings_(0),
       glyphArray_(nctl::makeUnique<FontGlyph[]>(GlyphArraySize)),
-      glyphHashMap_(GlyphHashmapSize), renderMode_(RenderMode::GLYPH_IN_RED)
+      renderMode_(RenderMode::GLYPH_IN_RED)
 {
 	FATAL_ASSERT(fontData.isValid());
 
 	ZoneScoped;
 	ZoneText(fontData.fntFilename(), nctl::strnlen(fontData.fntFilename(), nctl::String::MaxCStringLength));
 
-	retrieveInfoFromFnt(*fontData.fntParser_);
 	// `FontData` has already checked the FNT information validity
-	determineRenderMode(*fontData.fntParser_);
+	if (fontData.fntBinary_)
+	{
+		retrieveInfoFromFnt(*fontData.fntBinary_);
+		determineRenderMode(*fontData.fntBinary_);
+	}
+	else
+	{
+		retrieveInfoFromFnt(*fontData.fntParser_);
+		determineRenderMode(*fontData.fntParser_);
+	}
 }
 
 Font::~Font()
@@ -115,54 +216,92 @@ const FontGlyph *Font::glyph(unsigned int glyphId) const
 {
 	if (glyphId < GlyphArraySize)
 		return &glyphArray_[glyphId];
-	else
-		return glyphHashMap_.find(glyphId);
+	else if (glyphIndices_ == nullptr)
+		return nullptr;
+
+	GlyphCacheEntry &cacheEntry = glyphCache_[glyphId & (GlyphCacheSize - 1)];
+	if (cacheEntry.codepoint != glyphId)
+	{
+		const unsigned int *index = glyphIndices_->find(glyphId);
+		cacheEntry.codepoint = glyphId;
+		cacheEntry.index = index ? *index : InvalidIndex;
+	}
+
+	return (cacheEntry.index != InvalidIndex) ? &glyphTable_[cacheEntry.index] : nullptr;
+}
+
+int Font::kerning(unsigned int firstGlyphId, unsigned int secondGlyphId) const
+{
+	if (kerningHashMap_ == nullptr)
+		return 0;
+
+	const int *amount = kerningHashMap_->find(kerningKey(firstGlyphId, secondGlyphId));
+	return amount ? *amount : 0;
 }
 
 ///////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
-void Font::retrieveInfoFromFnt(const FntParser &fntParser)
+template <class FntSource>
+void Font::retrieveInfoFromFnt(const FntSource &fntSource)
 {
-	const FntParser::CommonTag &commonTag = fntParser.commonTag();
+	const FntParser::CommonTag &commonTag = fntSource.commonTag();
 
 	lineHeight_ = static_cast<unsigned int>(commonTag.lineHeight);
 	base_ = static_cast<unsigned int>(commonTag.base);
 	width_ = static_cast<unsigned int>(commonTag.scaleW);
 	height_ = static_cast<unsigned int>(commonTag.scaleH);
 
-	const unsigned int numChars = (fntParser.numCharTags() < GlyphArraySize + GlyphHashmapSize) ? fntParser.numCharTags() : GlyphArraySize + GlyphHashmapSize;
-	for (unsigned int i = 0; i < numChars; i++)
+	unsigned int numMultiByteChars = 0;
+	for (unsigned int i = 0; i < fntSource.numCharTags(); i++)
+	{
+		if (static_cast<unsigned int>(fntSource.charTag(i).id) >= GlyphArraySize)
+			numMultiByteChars++;
+	}
+
+	if (numMultiByteChars > 0)
 	{
-		const FntParser::CharTag &charTag = fntParser.charTag(i);
-		if (charTag.id < static_cast<int>(GlyphArraySize))
+		glyphTable_.setCapacity(numMultiByteChars);
+		glyphIndices_ = nctl::makeUnique<nctl::HashMap<unsigned int, unsigned int>>(numMultiByteChars * 2);
+	}
+
+	for (unsigned int i = 0; i < fntSource.numCharTags(); i++)
+	{
+		const auto &charTag = fntSource.charTag(i);
+		if (static_cast<unsigned int>(charTag.id) < GlyphArraySize)
+		{
 			glyphArray_[charTag.id].set(charTag.x, charTag.y, charTag.width, charTag.height, charTag.xoffset, charTag.yoffset, charTag.xadvance);
-		else
-			glyphHashMap_.emplace(charTag.id, charTag.x, charTag.y, charTag.width, charTag.height, charTag.xoffset, charTag.yoffset, charTag.xadvance);
-		numGlyphs_++;
+			numGlyphs_++;
+		}
+		else if (glyphTable_.size() < numMultiByteChars && glyphIndices_->insert(charTag.id, glyphTable_.size()))
+		{
+			glyphTable_.emplaceBack(charTag.x, charTag.y, charTag.width, charTag.height, charTag.xoffset, charTag.yoffset, charTag.xadvance);
+			numGlyphs_++;
+		}
 	}
 
-	for (unsigned int i = 0; i < fntParser.numKerningTags(); i++)
+	if (fntSource.numKerningTags() > 0)
+		kerningHashMap_ = nctl::makeUnique<nctl::HashMap<uint64_t, int>>(fntSource.numKerningTags() * 2);
+
+	for (unsigned int i = 0; i < fntSource.numKerningTags(); i++)
 	{
-		const FntParser::KerningTag &kerningTag = fntParser.kerningTag(i);
-		if (kerningTag.first < static_cast<int>(GlyphArraySize))
-			glyphArray_[kerningTag.first].addKerning(kerningTag.second, kerningTag.amount);
-		else
-			glyphHashMap_[kerningTag.first].addKerning(kerningTag.second, kerningTag.amount);
-		numKernings_++;
+		const auto &kerningTag = fntSource.kerningTag(i);
+		if (kerningHashMap_->insert(kerningKey(kerningTag.first, kerningTag.second), kerningTag.amount))
+			numKernings_++;
 	}
 
 	LOGI_X("FNT file information retrieved: %u glyphs and %u kernings", numGlyphs_, numKernings_);
 }
 
 /*! \note The same checks are performed by `FontData::checkFntInformation()` using a `ITextureLoader` object */
-void Font::checkFntInformation(const FntParser &fntParser)
+template <class FntSource>
+void Font::checkFntInformation(const FntSource &fntSource)
 {
-	const FntParser::InfoTag &infoTag = fntParser.infoTag();
+	const FntParser::InfoTag &infoTag = fntSource.infoTag();
 	FATAL_ASSERT_MSG_X(infoTag.outline == 0, "Font outline is not supported");
 
-	const FntParser::CommonTag &commonTag = fntParser.commonTag();
+	const FntParser::CommonTag &commonTag = fntSource.commonTag();
 	FATAL_ASSERT_MSG_X(commonTag.pages == 1, "Multiple texture pages are not supported (pages: %d)", commonTag.pages);
 	FATAL_ASSERT_MSG(commonTag.packed == false, "Characters packed into each of the texture channels are not supported");
 
@@ -187,9 +326,10 @@ void Font::checkFntInformation(const FntParser &fntParser)
 	}
 }
 
-void Font::determineRenderMode(const FntParser &fntParser)
+template <class FntSource>
+void Font::determineRenderMode(const FntSource &fntSource)
 {
-	const FntParser::CommonTag &commonTag = fntParser.commonTag();
+	const FntParser::CommonTag &commonTag = fntSource.commonTag();
 
 	if (texture_)
 	{
@@ -1,6 +1,7 @@
 #include "return_macros.h"
 #include "FontData.h"
 #include "FntParser.h"
+#include "FntBinary.h"
 #include "TextureData.h"
 #include "ITextureLoader.h"
 #include "FileSystem.h"
@@ -12,38 +13,74 @@ namespace ncine {
 ///////////////////////////////////////////////////////////
 
 FontData::FontData(const char *fntBufferName, const char *fntBufferPtr, unsigned long int fntBufferSize, const char *texFilename)
-    : isValid_(false),
-      fntParser_(nctl::makeUnique<FntParser>(fntBufferName, fntBufferPtr, fntBufferSize)),
-      texData_(nctl::makeUnique<TextureData>(texFilename))
+    : isValid_(false), texData_(nctl::makeUnique<TextureData>(texFilename))
 {
-	isValid_ = texData_->isValid() && checkFntInformation();
+	const unsigned char *bufferPtr = reinterpret_cast<const unsigned char *>(fntBufferPtr);
+	if (FntBinary::hasSignature(bufferPtr, fntBufferSize))
+	{
+		fntBinary_ = nctl::makeUnique<FntBinary>(fntBufferName, bufferPtr, fntBufferSize);
+		isValid_ = fntBinary_->isValid() && texData_->isValid() && checkFntInformation(*fntBinary_);
+	}
+	else
+	{
+		fntParser_ = nctl::makeUnique<FntParser>(fntBufferName, fntBufferPtr, fntBufferSize);
+		isValid_ = texData_->isValid() && checkFntInformation(*fntParser_);
+	}
 }
 
 FontData::FontData(const char *fntBufferName, const char *fntBufferPtr, unsigned long int fntBufferSize,
                    const char *texBufferName, const unsigned char *texBufferPtr, unsigned long int texBufferSize)
-    : isValid_(false),
-      fntParser_(nctl::makeUnique<FntParser>(fntBufferName, fntBufferPtr, fntBufferSize)),
-      texData_(nctl::makeUnique<TextureData>(texBufferName, texBufferPtr, texBufferSize))
+    : isValid_(false), texData_(nctl::makeUnique<TextureData>(texBufferName, texBufferPtr, texBufferSize))
 {
-	isValid_ = texData_->isValid() && checkFntInformation();
+	const unsigned char *bufferPtr = reinterpret_cast<const unsigned char *>(fntBufferPtr);
+	if (FntBinary::hasSignature(bufferPtr, fntBufferSize))
+	{
+		fntBinary_ = nctl::makeUnique<FntBinary>(fntBufferName, bufferPtr, fntBufferSize);
+		isValid_ = fntBinary_->isValid() && texData_->isValid() && checkFntInformation(*fntBinary_);
+	}
+	else
+	{
+		fntParser_ = nctl::makeUnique<FntParser>(fntBufferName, fntBufferPtr, fntBufferSize);
+		isValid_ = texData_->isValid() && checkFntInformation(*fntParser_);
+	}
 }
 
 FontData::FontData(const char *fntFilename)
-    : isValid_(false), fntParser_(nctl::makeUnique<FntParser>(fntFilename))
+    : isValid_(false)
 {
 	nctl::String dirName = fs::dirName(fntFilename);
-	nctl::String texFilename = fs::absoluteJoinPath(dirName, fntParser_->pageTag(0).file);
-	texData_ = nctl::makeUnique<TextureData>(texFilename.data());
+	if (FntBinary::hasBinaryExtension(fntFilename))
+	{
+		fntBinary_ = nctl::makeUnique<FntBinary>(fntFilename);
+		if (fntBinary_->isValid() == false)
+			return;
 
-	isValid_ = texData_->isValid() && checkFntInformation();
+		nctl::String texFilename = fs::absoluteJoinPath(dirName, fntBinary_->pageTag(0).file);
+		texData_ = nctl::makeUnique<TextureData>(texFilename.data());
+		isValid_ = texData_->isValid() && checkFntInformation(*fntBinary_);
+	}
+	else
+	{
+		fntParser_ = nctl::makeUnique<FntParser>(fntFilename);
+		nctl::String texFilename = fs::absoluteJoinPath(dirName, fntParser_->pageTag(0).file);
+		texData_ = nctl::makeUnique<TextureData>(texFilename.data());
+		isValid_ = texData_->isValid() && checkFntInformation(*fntParser_);
+	}
 }
 
 FontData::FontData(const char *fntFilename, const char *texFilename)
-    : isValid_(false),
-      fntParser_(nctl::makeUnique<FntParser>(fntFilename)),
-      texData_(nctl::makeUnique<TextureData>(texFilename))
+    : isValid_(false), texData_(nctl::makeUnique<TextureData>(texFilename))
 {
-	isValid_ = texData_->isValid() && checkFntInformation();
+	if (FntBinary::hasBinaryExtension(fntFilename))
+	{
+		fntBinary_ = nctl::makeUnique<FntBinary>(fntFilename);
+		isValid_ = fntBinary_->isValid() && texData_->isValid() && checkFntInformation(*fntBinary_);
+	}
+	else
+	{
+		fntParser_ = nctl::makeUnique<FntParser>(fntFilename);
+		isValid_ = texData_->isValid() && checkFntInformation(*fntParser_);
+	}
 }
 
 FontData::~FontData()
@@ -57,12 +94,19 @@ FontData::~FontData()
 
 const char *FontData::fntFilename() const
 {
-	return fntParser_->filename();
+	return fntBinary_ ? fntBinary_->filename() : fntParser_->filename();
 }
 
 const char *FontData::texFilename() const
 {
-	return texData_->filename();
+	return texData_ ? texData_->filename() : nullptr;
+}
+
+/*! \note The texture file is not loaded and the page file name is stored as it is */
+bool FontData::convertToBinary(const char *fntFilename, const char *binaryFilename)
+{
+	nctl::UniquePtr<FntParser> fntParser = nctl::makeUnique<FntParser>(fntFilename);
+	return FntBinary::saveToFile(*fntParser, binaryFilename);
 }
 
 ///////////////////////////////////////////////////////////
@@ -70,12 +114,13 @@ const char *FontData::texFilename() const
 ///////////////////////////////////////////////////////////
 
 /*! \note The same checks are performed by `Font::checkFntInformation()` using a `Texture` object */
-bool FontData::checkFntInformation() const
+template <class FntSource>
+bool FontData::checkFntInformation(const FntSource &fntSource) const
 {
-	const FntParser::InfoTag &infoTag = fntParser_->infoTag();
+	const FntParser::InfoTag &infoTag = fntSource.infoTag();
 	RETURNF_ASSERT_MSG_X(infoTag.outline == 0, "Font outline is not supported");
 
-	const FntParser::CommonTag &commonTag = fntParser_->commonTag();
+	const FntParser::CommonTag &commonTag = fntSource.commonTag();
 	RETURNF_ASSERT_MSG_X(commonTag.pages == 1, "Multiple texture pages are not supported (pages: %d)", commonTag.pages);
 	RETURNF_ASSERT_MSG(commonTag.packed == false, "Characters packed into each of the texture channels are not supported");
 
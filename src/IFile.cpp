@@ -2,6 +2,8 @@
 #include "IFile.h"
 #include "MemoryFile.h"
 #include "StandardFile.h"
+#include "MappedFile.h"
+#include "VirtualFileSystem.h"
 
 #ifdef __ANDROID__
 	#include <cstring>
@@ -66,13 +68,45 @@ nctl::UniquePtr<IFile> IFile::createFromMemory(const unsigned char *bufferPtr, u
 nctl::UniquePtr<IFile> IFile::createFileHandle(const char *filename)
 {
 	ASSERT(filename);
+	return createPlatformFileHandle(filename, false);
+}
+
+nctl::UniquePtr<IFile> IFile::createReadFileHandle(const char *filename)
+{
+	ASSERT(filename);
+	nctl::UniquePtr<IFile> mountedFile = VirtualFileSystem::createFileHandle(filename, false);
+	if (mountedFile != nullptr)
+		return mountedFile;
+
+	return createPlatformFileHandle(filename, false);
+}
+
+/*! \note Android assets are not mapped and a normal asset file handle is returned */
+nctl::UniquePtr<IFile> IFile::createMappedFileHandle(const char *filename)
+{
+	ASSERT(filename);
+	nctl::UniquePtr<IFile> mountedFile = VirtualFileSystem::createFileHandle(filename, true);
+	if (mountedFile != nullptr)
+		return mountedFile;
+
+	return createPlatformFileHandle(filename, true);
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::UniquePtr<IFile> IFile::createPlatformFileHandle(const char *filename, bool mapped)
+{
 #ifdef __ANDROID__
 	const char *assetFilename = AssetFile::assetPath(filename);
 	if (assetFilename)
 		return nctl::makeUnique<AssetFile>(assetFilename);
-	else
 #endif
-		return nctl::makeUnique<StandardFile>(filename);
+
+	if (mapped)
+		return nctl::makeUnique<MappedFile>(filename);
+	return nctl::makeUnique<StandardFile>(filename);
 }
 
 }
@@ -0,0 +1,150 @@
+#include "common_macros.h"
+#include "IThreadPool.h"
+#include "Task.h"
+#include <nctl/Atomic.h>
+
+#ifdef WITH_THREADS
+	#include "Thread.h"
+#endif
+
+namespace ncine {
+
+namespace {
+
+	/// The number of chunks for every thread, including the calling one, when the grain size is not specified
+	const unsigned int ChunksPerThread = 4;
+
+	/// The state of a parallel loop, shared between the calling thread and the worker threads helping it
+	class ParallelForState
+	{
+	  public:
+		ParallelForState(unsigned int first, unsigned int last, unsigned int grainSize, IThreadPool::RangeFunction function, void *userData)
+		    : first_(first), last_(last), grainSize_(grainSize), numChunks_((last - first + grainSize - 1) / grainSize),
+		      function_(function), userData_(userData), nextChunk_(0), numDoneChunks_(0) {}
+
+		/// Executes chunks until there are none left, it can be called by more than one thread at the same time
+		/*! A thread that starts after the loop has completed does not find any chunk and never calls the function */
+		void run()
+		{
+			int32_t chunk = nextChunk_.fetchAdd(1);
+			while (chunk < numChunks_)
+			{
+				const unsigned int begin = first_ + static_cast<unsigned int>(chunk) * grainSize_;
+				const unsigned int end = (last_ - begin > grainSize_) ? begin + grainSize_ : last_;
+				function_(begin, end, userData_);
+				numDoneChunks_.fetchAdd(1, nctl::Atomic32::MemoryModel::RELEASE);
+				chunk = nextChunk_.fetchAdd(1);
+			}
+		}
+
+		inline bool isDone() { return numDoneChunks_.load(nctl::Atomic32::MemoryModel::ACQUIRE) == numChunks_; }
+		inline unsigned int numChunks() const { return static_cast<unsigned int>(numChunks_); }
+
+	  private:
+		const unsigned int first_;
+		const unsigned int last_;
+		const unsigned int grainSize_;
+		const int32_t numChunks_;
+		IThreadPool::RangeFunction function_;
+		void *userData_;
+		nctl::Atomic32 nextChunk_;
+		nctl::Atomic32 numDoneChunks_;
+	};
+
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void IThreadPool::enqueue(ThreadFunction function)
+{
+	ASSERT(function);
+	enqueueCommand(nctl::makeUnique<FunctionCommand>(nctl::move(function)));
+}
+
+nctl::SharedPtr<Task> IThreadPool::submit(nctl::UniquePtr<IThreadCommand> threadCommand)
+{
+	nctl::SharedPtr<Task> task = Task::create(nctl::move(threadCommand));
+	submit(task);
+	return task;
+}
+
+void IThreadPool::submit(nctl::SharedPtr<Task> task)
+{
+	ASSERT(task);
+	FATAL_ASSERT_MSG(task->threadPool_ == nullptr, "The task has already been submitted");
+
+	task->threadPool_ = this;
+	// Releasing the dependency that prevents a task from starting before being submitted
+	Task::releaseDependency(task);
+}
+
+nctl::SharedPtr<Task> IThreadPool::then(Task &task, nctl::UniquePtr<IThreadCommand> threadCommand)
+{
+	nctl::SharedPtr<Task> continuation = Task::create(nctl::move(threadCommand));
+	task.addSuccessor(continuation);
+	submit(continuation);
+	return continuation;
+}
+
+void IThreadPool::wait(Task &task)
+{
+	FATAL_ASSERT_MSG(task.threadPool_ != nullptr, "The task has not been submitted");
+
+	while (task.isDone() == false)
+	{
+		// Helping the workers instead of blocking, which also prevents a deadlock when waiting from a worker thread
+		if (executePendingCommand() == false)
+		{
+#ifdef WITH_THREADS
+			Thread::yieldExecution();
+#endif
+		}
+	}
+}
+
+unsigned int IThreadPool::defaultGrainSize(unsigned int numIndices) const
+{
+	const unsigned int numChunks = (numThreads() + 1) * ChunksPerThread;
+	const unsigned int grainSize = (numIndices + numChunks - 1) / numChunks;
+	return (grainSize > 0) ? grainSize : 1;
+}
+
+void IThreadPool::parallelFor(unsigned int first, unsigned int last, unsigned int grainSize, RangeFunction function, void *userData)
+{
+	ASSERT(function);
+	if (first >= last)
+		return;
+
+	if (grainSize == 0)
+		grainSize = defaultGrainSize(last - first);
+
+	// Without worker threads, or with a single chunk, the loop is executed on the calling thread
+	if (numThreads() == 0 || last - first <= grainSize)
+	{
+		for (unsigned int begin = first; begin < last; begin += grainSize)
+			function(begin, (last - begin > grainSize) ? begin + grainSize : last, userData);
+		return;
+	}
+
+	nctl::SharedPtr<ParallelForState> state = nctl::makeShared<ParallelForState>(first, last, grainSize, function, userData);
+	// The calling thread executes chunks too, so one chunk is left for it
+	const unsigned int numCommands = (numThreads() < state->numChunks() - 1) ? numThreads() : state->numChunks() - 1;
+	for (unsigned int i = 0; i < numCommands; i++)
+		enqueue([state]() mutable { state->run(); });
+	state->run();
+
+	// Waiting for the chunks still executed by the worker threads
+	while (state->isDone() == false)
+	{
+		if (executePendingCommand() == false)
+		{
+#ifdef WITH_THREADS
+			Thread::yieldExecution();
+#endif
+		}
+	}
+}
+
+}
@@ -0,0 +1,257 @@
+#include <cstdlib> // for exit()
+#include <cstring> // for memcpy()
+
+#ifdef _WIN32
+	#include "common_windefines.h"
+	#include <windef.h>
+	#include <WinBase.h>
+	#include <fileapi.h>
+	#include <memoryapi.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+#include "common_macros.h"
+#include "MappedFile.h"
+#include "StandardFile.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+MappedFile::MappedFile(const char *filename)
+    : IFile(filename), mappedPtr_(nullptr), seekOffset_(0)
+{
+	type_ = FileType::MAPPED;
+}
+
+MappedFile::~MappedFile()
+{
+	if (shouldCloseOnDestruction_)
+		close();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note The operating system handles are released as soon as the mapping has been created */
+void MappedFile::open(unsigned char mode)
+{
+	if (mappedPtr_ != nullptr || fallbackFile_ != nullptr)
+	{
+		LOGW_X("File \"%s\" is already opened", filename_.data());
+		return;
+	}
+	if (mode & OpenMode::WRITE)
+	{
+		LOGE_X("Cannot open the file \"%s\", memory mapped files are read-only", filename_.data());
+		return;
+	}
+
+#ifdef _WIN32
+	HANDLE fileHandle = CreateFileA(filename_.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		failToOpen("cannot open");
+		return;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(fileHandle, &fileSize) == 0 || fileSize.QuadPart == 0)
+	{
+		CloseHandle(fileHandle);
+		openFallback("an empty file cannot be mapped");
+		return;
+	}
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void *mappedPtr = (mappingHandle != nullptr) ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	// The view keeps a reference to the mapping object
+	if (mappingHandle != nullptr)
+		CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+
+	if (mappedPtr == nullptr)
+	{
+		openFallback("the mapping has failed");
+		return;
+	}
+	fileSize_ = static_cast<unsigned long int>(fileSize.QuadPart);
+#else
+	const int fileDescriptor = ::open(filename_.data(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		failToOpen("cannot open");
+		return;
+	}
+
+	struct stat fileStat;
+	if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		::close(fileDescriptor);
+		openFallback("an empty file cannot be mapped");
+		return;
+	}
+
+	int mapFlags = MAP_PRIVATE;
+	#ifdef MAP_POPULATE
+	// The whole content is going to be accessed, faulting pages in now spares the consumer thread
+	mapFlags |= MAP_POPULATE;
+	#endif
+	void *mappedPtr = mmap(nullptr, fileStat.st_size, PROT_READ, mapFlags, fileDescriptor, 0);
+	// The mapping keeps a reference to the file
+	::close(fileDescriptor);
+
+	if (mappedPtr == MAP_FAILED)
+	{
+		openFallback("the mapping has failed");
+		return;
+	}
+	fileSize_ = static_cast<unsigned long int>(fileStat.st_size);
+#endif
+
+	mappedPtr_ = static_cast<const unsigned char *>(mappedPtr);
+	seekOffset_ = 0;
+	// The mapped file appears to be opened like a memory file
+	fileDescriptor_ = 0;
+	LOGI_X("File \"%s\" mapped in memory (%lu bytes)", filename_.data(), fileSize_);
+}
+
+void MappedFile::close()
+{
+	if (fallbackFile_ != nullptr)
+	{
+		fallbackFile_.reset(nullptr);
+		fileDescriptor_ = -1;
+		filePointer_ = nullptr;
+		return;
+	}
+	else if (mappedPtr_ == nullptr)
+		return;
+
+#ifdef _WIN32
+	const bool unmapped = (UnmapViewOfFile(mappedPtr_) != 0);
+#else
+	const bool unmapped = (munmap(const_cast<unsigned char *>(mappedPtr_), fileSize_) == 0);
+#endif
+	if (unmapped == false)
+		LOGW_X("Cannot unmap the file \"%s\"", filename_.data());
+	else
+		LOGI_X("File \"%s\" unmapped", filename_.data());
+
+	mappedPtr_ = nullptr;
+	seekOffset_ = 0;
+	fileDescriptor_ = -1;
+}
+
+long int MappedFile::seek(long int offset, int whence) const
+{
+	if (fallbackFile_ != nullptr)
+		return fallbackFile_->seek(offset, whence);
+
+	long int seekValue = -1;
+
+	if (mappedPtr_ != nullptr)
+	{
+		switch (whence)
+		{
+			case SEEK_SET:
+				seekValue = offset;
+				break;
+			case SEEK_CUR:
+				seekValue = seekOffset_ + offset;
+				break;
+			case SEEK_END:
+				seekValue = fileSize_ + offset;
+				break;
+		}
+	}
+
+	if (seekValue < 0 || seekValue > static_cast<long int>(fileSize_))
+		seekValue = -1;
+	else
+		seekOffset_ = seekValue;
+
+	return seekValue;
+}
+
+long int MappedFile::tell() const
+{
+	if (fallbackFile_ != nullptr)
+		return fallbackFile_->tell();
+
+	long int tellValue = -1;
+
+	if (mappedPtr_ != nullptr)
+		tellValue = seekOffset_;
+
+	return tellValue;
+}
+
+unsigned long int MappedFile::read(void *buffer, unsigned long int bytes) const
+{
+	ASSERT(buffer);
+	if (fallbackFile_ != nullptr)
+		return fallbackFile_->read(buffer, bytes);
+
+	unsigned long int bytesRead = 0;
+
+	if (mappedPtr_ != nullptr)
+	{
+		bytesRead = (seekOffset_ + bytes > fileSize_) ? fileSize_ - seekOffset_ : bytes;
+		memcpy(buffer, mappedPtr_ + seekOffset_, bytesRead);
+		seekOffset_ += bytesRead;
+	}
+
+	return bytesRead;
+}
+
+unsigned long int MappedFile::write(void *buffer, unsigned long int bytes)
+{
+	ASSERT(buffer);
+	LOGW_X("Cannot write to the memory mapped file \"%s\"", filename_.data());
+	return 0;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void MappedFile::failToOpen(const char *reason)
+{
+	if (shouldExitOnFailToOpen_)
+	{
+		LOGF_X("Cannot map the file \"%s\": %s", filename_.data(), reason);
+		exit(EXIT_FAILURE);
+	}
+	else
+		LOGE_X("Cannot map the file \"%s\": %s", filename_.data(), reason);
+}
+
+void MappedFile::openFallback(const char *reason)
+{
+	LOGW_X("File \"%s\" is not mapped, %s: falling back to buffered reads", filename_.data(), reason);
+
+	// The file has already been opened once, the stream is not going to fail
+	fallbackFile_ = nctl::makeUnique<StandardFile>(filename_.data());
+	fallbackFile_->setExitOnFailToOpen(shouldExitOnFailToOpen_);
+	fallbackFile_->open(OpenMode::READ | OpenMode::BINARY);
+	if (fallbackFile_->isOpened() == false)
+	{
+		fallbackFile_.reset(nullptr);
+		failToOpen("cannot open");
+		return;
+	}
+
+	fileSize_ = fallbackFile_->size();
+	filePointer_ = fallbackFile_->ptr();
+	fileDescriptor_ = fallbackFile_->fd();
+}
+
+}
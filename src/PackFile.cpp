@@ -0,0 +1,133 @@
+#include <cstdlib> // for exit()
+#include <cstring> // for memcpy()
+#include "common_macros.h"
+#include "PackFile.h"
+#include "AssetPack.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+PackFile::PackFile(const char *filename, const nctl::SharedPtr<AssetPack> &pack, unsigned int entryIndex)
+    : IFile(filename), pack_(pack), entryIndex_(entryIndex), dataPtr_(nullptr), seekOffset_(0)
+{
+	ASSERT(pack_ != nullptr);
+	type_ = FileType::PACK;
+	fileSize_ = pack_->entrySize(entryIndex_);
+}
+
+PackFile::~PackFile()
+{
+	if (shouldCloseOnDestruction_)
+		close();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void PackFile::open(unsigned char mode)
+{
+	if (dataPtr_ != nullptr)
+	{
+		LOGW_X("File \"%s\" is already opened", filename_.data());
+		return;
+	}
+
+	if (mode & OpenMode::WRITE)
+	{
+		LOGE_X("Cannot open the file \"%s\" for writing, it is inside the asset pack \"%s\"", filename_.data(), pack_->filename());
+		return;
+	}
+
+	dataPtr_ = pack_->loadEntry(entryIndex_, dataBuffer_);
+	if (dataPtr_ == nullptr)
+	{
+		if (shouldExitOnFailToOpen_)
+		{
+			LOGF_X("Cannot open the file \"%s\" from the asset pack \"%s\"", filename_.data(), pack_->filename());
+			exit(EXIT_FAILURE);
+		}
+		else
+			LOGE_X("Cannot open the file \"%s\" from the asset pack \"%s\"", filename_.data(), pack_->filename());
+		return;
+	}
+
+	seekOffset_ = 0;
+	// The entry appears to be opened like a memory file
+	fileDescriptor_ = 0;
+	LOGI_X("File \"%s\" opened from the asset pack \"%s\" (%lu bytes)", filename_.data(), pack_->filename(), fileSize_);
+}
+
+void PackFile::close()
+{
+	dataPtr_ = nullptr;
+	dataBuffer_.reset(nullptr);
+	seekOffset_ = 0;
+	fileDescriptor_ = -1;
+}
+
+long int PackFile::seek(long int offset, int whence) const
+{
+	long int seekValue = -1;
+
+	if (dataPtr_ != nullptr)
+	{
+		switch (whence)
+		{
+			case SEEK_SET:
+				seekValue = offset;
+				break;
+			case SEEK_CUR:
+				seekValue = seekOffset_ + offset;
+				break;
+			case SEEK_END:
+				seekValue = fileSize_ + offset;
+				break;
+		}
+	}
+
+	if (seekValue < 0 || seekValue > static_cast<long int>(fileSize_))
+		seekValue = -1;
+	else
+		seekOffset_ = seekValue;
+
+	return seekValue;
+}
+
+long int PackFile::tell() const
+{
+	long int tellValue = -1;
+
+	if (dataPtr_ != nullptr)
+		tellValue = seekOffset_;
+
+	return tellValue;
+}
+
+unsigned long int PackFile::read(void *buffer, unsigned long int bytes) const
+{
+	ASSERT(buffer);
+
+	unsigned long int bytesRead = 0;
+
+	if (dataPtr_ != nullptr)
+	{
+		bytesRead = (seekOffset_ + bytes > fileSize_) ? fileSize_ - seekOffset_ : bytes;
+		memcpy(buffer, dataPtr_ + seekOffset_, bytesRead);
+		seekOffset_ += bytesRead;
+	}
+
+	return bytesRead;
+}
+
+unsigned long int PackFile::write(void *buffer, unsigned long int bytes)
+{
+	ASSERT(buffer);
+	LOGW_X("Cannot write to the file \"%s\", it is inside the asset pack \"%s\"", filename_.data(), pack_->filename());
+	return 0;
+}
+
+}
@@ -0,0 +1,102 @@
+#include "common_macros.h"
+#include "Task.h"
+#include "IThreadPool.h"
+
+#ifdef WITH_THREADS
+	#include "Thread.h"
+#endif
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+Task::Task(nctl::UniquePtr<IThreadCommand> command)
+    : command_(nctl::move(command)), threadPool_(nullptr), state_(static_cast<int32_t>(State::WAITING)),
+      numPendingDependencies_(1), successorsLock_(0)
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::SharedPtr<Task> Task::create(nctl::UniquePtr<IThreadCommand> command)
+{
+	ASSERT(command);
+	// The constructor is private, so the task cannot be created by `makeShared()`
+	return nctl::SharedPtr<Task>(new Task(nctl::move(command)));
+}
+
+Task::State Task::state() const
+{
+	return static_cast<State>(state_.load(nctl::Atomic32::MemoryModel::ACQUIRE));
+}
+
+void Task::addSuccessor(const nctl::SharedPtr<Task> &successor)
+{
+	ASSERT(successor);
+	FATAL_ASSERT_MSG(successor->threadPool_ == nullptr, "Dependencies cannot be added to a submitted task");
+	FATAL_ASSERT_MSG(successor.get() != this, "A task cannot depend on itself");
+
+	// The successor is not added if this task is already done, as it would never be released
+	lockSuccessors();
+	if (state_.load(nctl::Atomic32::MemoryModel::RELAXED) != static_cast<int32_t>(State::DONE))
+	{
+		successor->numPendingDependencies_.fetchAdd(1);
+		successors_.pushBack(successor);
+	}
+	unlockSuccessors();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void Task::lockSuccessors()
+{
+	while (successorsLock_.cmpExchange(1, 0, nctl::Atomic32::MemoryModel::ACQUIRE) == false)
+	{
+#ifdef WITH_THREADS
+		Thread::yieldExecution();
+#endif
+	}
+}
+
+void Task::unlockSuccessors()
+{
+	successorsLock_.store(0, nctl::Atomic32::MemoryModel::RELEASE);
+}
+
+void Task::releaseDependency(nctl::SharedPtr<Task> &task)
+{
+	if (task->numPendingDependencies_.fetchSub(1) != 1)
+		return;
+
+	task->state_.store(static_cast<int32_t>(State::ENQUEUED));
+	// Without worker threads the task is executed immediately, as enqueued commands would never be
+	if (task->threadPool_->numThreads() == 0)
+		task->run();
+	else
+	{
+		// The captured copy of the pointer keeps the task alive until it has run
+		task->threadPool_->enqueue([task]() mutable { task->run(); });
+	}
+}
+
+void Task::run()
+{
+	command_->execute();
+
+	// No successor can be added once the state is done
+	lockSuccessors();
+	state_.store(static_cast<int32_t>(State::DONE), nctl::Atomic32::MemoryModel::RELEASE);
+	nctl::Array<nctl::SharedPtr<Task>> successors(nctl::move(successors_));
+	unlockSuccessors();
+
+	for (nctl::SharedPtr<Task> &successor : successors)
+		releaseDependency(successor);
+}
+
+}
@@ -0,0 +1,75 @@
+#include "common_macros.h"
+#include "TaskGraph.h"
+#include "IThreadPool.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+TaskGraph::TaskGraph()
+    : TaskGraph(16)
+{
+}
+
+TaskGraph::TaskGraph(unsigned int capacity)
+    : tasks_(capacity), isSubmitted_(false)
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned int TaskGraph::addTask(nctl::UniquePtr<IThreadCommand> command)
+{
+	FATAL_ASSERT_MSG(isSubmitted_ == false, "Tasks cannot be added to a submitted graph");
+
+	tasks_.pushBack(Task::create(nctl::move(command)));
+	return tasks_.size() - 1;
+}
+
+void TaskGraph::addDependency(unsigned int taskIndex, unsigned int dependencyIndex)
+{
+	FATAL_ASSERT_MSG(isSubmitted_ == false, "Dependencies cannot be added to a submitted graph");
+	FATAL_ASSERT_MSG_X(taskIndex < tasks_.size(), "Task index %u is out of range (size: %u)", taskIndex, tasks_.size());
+	FATAL_ASSERT_MSG_X(dependencyIndex < tasks_.size(), "Dependency index %u is out of range (size: %u)", dependencyIndex, tasks_.size());
+
+	tasks_[dependencyIndex]->addSuccessor(tasks_[taskIndex]);
+}
+
+void TaskGraph::submit(IThreadPool &threadPool)
+{
+	FATAL_ASSERT_MSG(isSubmitted_ == false, "The graph has already been submitted");
+
+	isSubmitted_ = true;
+	for (nctl::SharedPtr<Task> &task : tasks_)
+		threadPool.submit(task);
+}
+
+bool TaskGraph::isDone() const
+{
+	for (const nctl::SharedPtr<Task> &task : tasks_)
+	{
+		if (task->isDone() == false)
+			return false;
+	}
+	return true;
+}
+
+void TaskGraph::wait(IThreadPool &threadPool)
+{
+	FATAL_ASSERT_MSG(isSubmitted_, "The graph has not been submitted");
+
+	for (nctl::SharedPtr<Task> &task : tasks_)
+		threadPool.wait(*task);
+}
+
+void TaskGraph::clear()
+{
+	tasks_.clear();
+	isSubmitted_ = false;
+}
+
+}
@@ -0,0 +1,522 @@
+#include <cstring> // for strcmp()
+#include "return_macros.h"
+#include "VirtualFileSystem.h"
+#include "FileSystem.h"
+#include "DirectoryScanner.h"
+#include "AssetPack.h"
+#include "IFile.h"
+#include "MemoryFile.h"
+#include "PackFile.h"
+#include <nctl/Array.h>
+#include <nctl/HashMap.h>
+#include <nctl/HashSet.h>
+#include <nctl/SharedPtr.h>
+#include <nctl/CString.h>
+
+namespace ncine {
+
+namespace {
+
+	/// Initial capacity of the index, it doubles every time it gets three quarters full
+	const unsigned int InitialIndexCapacity = 256;
+
+	/// A file or a directory provided by a mount
+	struct MountedPath
+	{
+		/// The normalized virtual path
+		nctl::String key;
+		/// The file system path, for mounted directories
+		nctl::String path;
+		/// The index of the entry, for mounted packs
+		unsigned int entryIndex = 0;
+		/// The size in bytes of a file
+		long int size = 0;
+		bool isDirectory = false;
+	};
+
+	struct Mount
+	{
+		VirtualFileSystem::MountType type = VirtualFileSystem::MountType::DIRECTORY;
+		/// The directory path, pack file name or buffer name the mount has been created from
+		nctl::String source;
+		/// The normalized mount point
+		nctl::String mountPoint;
+		int priority = VirtualFileSystem::DefaultPriority;
+		/// The mounting order, used to break ties between mounts with the same priority
+		unsigned int order = 0;
+
+		nctl::SharedPtr<AssetPack> pack;
+		const unsigned char *bufferPtr = nullptr;
+		unsigned long int bufferSize = 0;
+
+		nctl::Array<MountedPath> paths;
+	};
+
+	/// The mount providing a path, together with the index of the path inside it
+	struct IndexedPath
+	{
+		const Mount *mount = nullptr;
+		unsigned int pathIndex = 0;
+	};
+
+	struct VfsState
+	{
+		VfsState()
+		    : index(InitialIndexCapacity), mountCounter(0) {}
+
+		/// Mounts are heap allocated so that the index can point to them
+		nctl::Array<nctl::UniquePtr<Mount>> mounts;
+		nctl::StringHashMap<IndexedPath> index;
+		unsigned int mountCounter;
+	};
+
+	/// The state is created on first use, to avoid depending on the initialization order of static objects
+	VfsState &state()
+	{
+		static VfsState vfsState;
+		return vfsState;
+	}
+
+	inline bool isSeparator(char c)
+	{
+		return (c == '/' || c == '\\');
+	}
+
+	inline char toLowerAscii(char c)
+	{
+		return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+
+	/// Returns a lowercase copy of the path with forward slashes, without empty and dot components and without a trailing slash
+	nctl::String normalizePath(const char *path)
+	{
+		const unsigned int length = nctl::strnlen(path, nctl::String::MaxCStringLength);
+		nctl::String normalized(length + 1);
+		char *dest = normalized.data();
+
+		unsigned int destLength = 0;
+		unsigned int rootLength = 0;
+		if (isSeparator(path[0]))
+		{
+			dest[destLength++] = '/';
+			rootLength = 1;
+		}
+
+		unsigned int i = 0;
+		while (i < length)
+		{
+			while (i < length && isSeparator(path[i]))
+				i++;
+			const unsigned int start = i;
+			while (i < length && isSeparator(path[i]) == false)
+				i++;
+			const unsigned int componentLength = i - start;
+
+			if (componentLength == 0 || (componentLength == 1 && path[start] == '.'))
+				continue;
+			if (componentLength == 2 && path[start] == '.' && path[start + 1] == '.')
+			{
+				unsigned int lastStart = destLength;
+				while (lastStart > rootLength && dest[lastStart - 1] != '/')
+					lastStart--;
+				const bool lastIsParent = (destLength - lastStart == 2 && dest[lastStart] == '.' && dest[lastStart + 1] == '.');
+				// A parent reference removes the previous component, if there is one to remove
+				if (destLength > rootLength && lastIsParent == false)
+				{
+					destLength = (lastStart > rootLength) ? lastStart - 1 : rootLength;
+					continue;
+				}
+			}
+
+			if (destLength > rootLength)
+				dest[destLength++] = '/';
+			for (unsigned int j = 0; j < componentLength; j++)
+				dest[destLength++] = toLowerAscii(path[start + j]);
+		}
+
+		dest[destLength] = '\0';
+		normalized.setLength(destLength);
+		return normalized;
+	}
+
+	/// Returns the normalized virtual path of a path relative to a normalized mount point
+	nctl::String virtualPath(const nctl::String &mountPoint, const char *relativePath)
+	{
+		if (mountPoint.isEmpty())
+			return normalizePath(relativePath);
+		return normalizePath(fs::joinPath(mountPoint, relativePath).data());
+	}
+
+	/// Returns true if the first mount overrides the paths of the second one
+	inline bool hasPrecedence(const Mount &first, const Mount &second)
+	{
+		return (first.priority > second.priority || (first.priority == second.priority && first.order > second.order));
+	}
+
+	void addToIndex(const Mount &mount)
+	{
+		nctl::StringHashMap<IndexedPath> &index = state().index;
+		for (unsigned int i = 0; i < mount.paths.size(); i++)
+		{
+			const nctl::String &key = mount.paths[i].key;
+			IndexedPath *indexedPath = index.find(key);
+			if (indexedPath == nullptr)
+			{
+				if ((index.size() + 1) * 4 > index.capacity() * 3)
+					index.rehash(index.capacity() * 2);
+
+				IndexedPath newIndexedPath;
+				newIndexedPath.mount = &mount;
+				newIndexedPath.pathIndex = i;
+				index.insert(key, newIndexedPath);
+			}
+			else if (hasPrecedence(mount, *indexedPath->mount))
+			{
+				indexedPath->mount = &mount;
+				indexedPath->pathIndex = i;
+			}
+		}
+	}
+
+	/// Rebuilds the index from the paths of every mount, without accessing the disk
+	void rebuildIndex()
+	{
+		VfsState &vfsState = state();
+		vfsState.index.clear();
+		for (const nctl::UniquePtr<Mount> &mount : vfsState.mounts)
+			addToIndex(*mount);
+	}
+
+	/// Adds the mount point and all its parent directories to the paths of a mount
+	void addMountPointPaths(Mount &mount)
+	{
+		const nctl::String &mountPoint = mount.mountPoint;
+		for (unsigned int i = 1; i <= mountPoint.length(); i++)
+		{
+			if (i == mountPoint.length() || mountPoint[i] == '/')
+			{
+				mount.paths.emplaceBack();
+				MountedPath &mountedPath = mount.paths.back();
+				mountedPath.key = nctl::String(i + 1);
+				mountedPath.key.assign(mountPoint.data(), i);
+				mountedPath.isDirectory = true;
+			}
+		}
+	}
+
+	void scanDirectory(Mount &mount)
+	{
+		// The tree is scanned in a single pass, with sizes, and indexed without further file system calls
+		const nctl::SharedPtr<DirectoryScanner::Result> result = DirectoryScanner::scan(mount.source.data());
+		if (result == nullptr)
+			return;
+
+		mount.paths.setCapacity(mount.paths.size() + result->entries.size());
+		for (const DirectoryScanner::Entry &entry : result->entries)
+		{
+			mount.paths.emplaceBack();
+			MountedPath &mountedPath = mount.paths.back();
+			mountedPath.path = fs::joinPath(mount.source, entry.path);
+			mountedPath.key = virtualPath(mount.mountPoint, entry.path.data());
+			mountedPath.isDirectory = entry.isDirectory;
+			mountedPath.size = entry.size;
+		}
+	}
+
+	void scanPack(Mount &mount)
+	{
+		const AssetPack &pack = *mount.pack;
+		nctl::StringHashSet directories(InitialIndexCapacity);
+
+		for (unsigned int i = 0; i < pack.numEntries(); i++)
+		{
+			const nctl::String entryPath = pack.entryPath(i);
+			mount.paths.emplaceBack();
+			MountedPath &mountedPath = mount.paths.back();
+			mountedPath.key = virtualPath(mount.mountPoint, entryPath.data());
+			mountedPath.entryIndex = i;
+			mountedPath.size = static_cast<long int>(pack.entrySize(i));
+
+			// Packs only store files, their directories are derived from the entry paths
+			const nctl::String key = mountedPath.key;
+			for (unsigned int j = mount.mountPoint.length() + 1; j < key.length(); j++)
+			{
+				if (key[j] != '/')
+					continue;
+
+				nctl::String dirKey(j + 1);
+				dirKey.assign(key.data(), j);
+				if (directories.contains(dirKey))
+					continue;
+
+				if ((directories.size() + 1) * 4 > directories.capacity() * 3)
+					directories.rehash(directories.capacity() * 2);
+				directories.insert(dirKey);
+				mount.paths.emplaceBack();
+				MountedPath &dirPath = mount.paths.back();
+				dirPath.key = nctl::move(dirKey);
+				dirPath.isDirectory = true;
+			}
+		}
+	}
+
+	bool addMount(nctl::UniquePtr<Mount> mount)
+	{
+		VfsState &vfsState = state();
+		for (const nctl::UniquePtr<Mount> &other : vfsState.mounts)
+		{
+			if (other->type == mount->type && other->source == mount->source)
+			{
+				LOGW_X("\"%s\" is already mounted", mount->source.data());
+				return false;
+			}
+		}
+
+		mount->order = vfsState.mountCounter++;
+		addToIndex(*mount);
+		vfsState.mounts.pushBack(nctl::move(mount));
+		return true;
+	}
+
+	const MountedPath *findPath(const char *path, const Mount **mount)
+	{
+		ASSERT(path);
+		const VfsState &vfsState = state();
+		if (vfsState.mounts.isEmpty())
+			return nullptr;
+
+		const IndexedPath *indexedPath = vfsState.index.find(normalizePath(path));
+		if (indexedPath == nullptr)
+			return nullptr;
+
+		if (mount)
+			*mount = indexedPath->mount;
+		return &indexedPath->mount->paths[indexedPath->pathIndex];
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool VirtualFileSystem::mountDirectory(const char *dirPath, const char *mountPoint)
+{
+	return mountDirectory(dirPath, mountPoint, DefaultPriority);
+}
+
+bool VirtualFileSystem::mountDirectory(const char *dirPath, const char *mountPoint, int priority)
+{
+	ASSERT(dirPath);
+	ASSERT(mountPoint);
+	RETURNF_ASSERT_MSG_X(fs::isDirectory(dirPath), "\"%s\" is not a directory", dirPath);
+
+	nctl::UniquePtr<Mount> mount = nctl::makeUnique<Mount>();
+	mount->type = MountType::DIRECTORY;
+	mount->source = nctl::String(dirPath);
+	mount->mountPoint = normalizePath(mountPoint);
+	mount->priority = priority;
+	addMountPointPaths(*mount);
+	scanDirectory(*mount);
+
+	const unsigned int numPaths = mount->paths.size();
+	if (addMount(nctl::move(mount)) == false)
+		return false;
+
+	LOGI_X("Directory \"%s\" mounted at \"%s\" with %u paths", dirPath, mountPoint, numPaths);
+	return true;
+}
+
+bool VirtualFileSystem::mountPack(const char *packFilename, const char *mountPoint)
+{
+	return mountPack(packFilename, mountPoint, DefaultPriority);
+}
+
+bool VirtualFileSystem::mountPack(const char *packFilename, const char *mountPoint, int priority)
+{
+	ASSERT(packFilename);
+	ASSERT(mountPoint);
+
+	for (const nctl::UniquePtr<Mount> &other : state().mounts)
+	{
+		if (other->type == MountType::PACK && other->source == packFilename)
+		{
+			LOGW_X("Asset pack \"%s\" is already mounted", packFilename);
+			return false;
+		}
+	}
+
+	nctl::SharedPtr<AssetPack> pack = nctl::makeShared<AssetPack>(packFilename);
+	if (pack->isValid() == false)
+		return false;
+
+	nctl::UniquePtr<Mount> mount = nctl::makeUnique<Mount>();
+	mount->type = MountType::PACK;
+	mount->source = nctl::String(packFilename);
+	mount->mountPoint = normalizePath(mountPoint);
+	mount->priority = priority;
+	mount->pack = nctl::move(pack);
+	addMountPointPaths(*mount);
+	scanPack(*mount);
+
+	const unsigned int numEntries = mount->pack->numEntries();
+	addMount(nctl::move(mount));
+
+	LOGI_X("Asset pack \"%s\" mounted at \"%s\" with %u entries", packFilename, mountPoint, numEntries);
+	return true;
+}
+
+bool VirtualFileSystem::mountBuffer(const char *filename, const unsigned char *bufferPtr, unsigned long int bufferSize)
+{
+	return mountBuffer(filename, bufferPtr, bufferSize, DefaultPriority);
+}
+
+bool VirtualFileSystem::mountBuffer(const char *filename, const unsigned char *bufferPtr, unsigned long int bufferSize, int priority)
+{
+	ASSERT(filename);
+	RETURNF_ASSERT_MSG_X(bufferPtr != nullptr && bufferSize > 0, "Buffer \"%s\" is empty", filename);
+
+	nctl::UniquePtr<Mount> mount = nctl::makeUnique<Mount>();
+	mount->type = MountType::BUFFER;
+	mount->source = nctl::String(filename);
+	mount->mountPoint = normalizePath(filename);
+	mount->priority = priority;
+	mount->bufferPtr = bufferPtr;
+	mount->bufferSize = bufferSize;
+	RETURNF_ASSERT_MSG_X(mount->mountPoint.isEmpty() == false, "\"%s\" is not a valid file name", filename);
+	// The parent directories of the buffer are indexed too
+	addMountPointPaths(*mount);
+	MountedPath &bufferPath = mount->paths.back();
+	bufferPath.isDirectory = false;
+	bufferPath.size = static_cast<long int>(bufferSize);
+
+	if (addMount(nctl::move(mount)) == false)
+		return false;
+
+	LOGI_X("Buffer \"%s\" mounted at address 0x%lx (%lu bytes)", filename, bufferPtr, bufferSize);
+	return true;
+}
+
+bool VirtualFileSystem::unmount(const char *source)
+{
+	ASSERT(source);
+
+	VfsState &vfsState = state();
+	for (unsigned int i = 0; i < vfsState.mounts.size(); i++)
+	{
+		if (vfsState.mounts[i]->source == source)
+		{
+			vfsState.mounts.removeAt(i);
+			rebuildIndex();
+			LOGI_X("\"%s\" unmounted", source);
+			return true;
+		}
+	}
+
+	LOGW_X("\"%s\" is not mounted", source);
+	return false;
+}
+
+void VirtualFileSystem::unmountAll()
+{
+	VfsState &vfsState = state();
+	vfsState.mounts.clear();
+	vfsState.index.clear();
+}
+
+void VirtualFileSystem::rescanDirectories()
+{
+	VfsState &vfsState = state();
+	for (nctl::UniquePtr<Mount> &mount : vfsState.mounts)
+	{
+		if (mount->type != MountType::DIRECTORY)
+			continue;
+
+		mount->paths.clear();
+		addMountPointPaths(*mount);
+		scanDirectory(*mount);
+	}
+	rebuildIndex();
+}
+
+unsigned int VirtualFileSystem::numMounts()
+{
+	return state().mounts.size();
+}
+
+unsigned int VirtualFileSystem::numMounts(MountType type)
+{
+	unsigned int count = 0;
+	for (const nctl::UniquePtr<Mount> &mount : state().mounts)
+	{
+		if (mount->type == type)
+			count++;
+	}
+	return count;
+}
+
+unsigned int VirtualFileSystem::numIndexedPaths()
+{
+	return state().index.size();
+}
+
+bool VirtualFileSystem::exists(const char *path)
+{
+	return (findPath(path, nullptr) != nullptr);
+}
+
+bool VirtualFileSystem::isFile(const char *path)
+{
+	const MountedPath *mountedPath = findPath(path, nullptr);
+	return (mountedPath != nullptr && mountedPath->isDirectory == false);
+}
+
+bool VirtualFileSystem::isDirectory(const char *path)
+{
+	const MountedPath *mountedPath = findPath(path, nullptr);
+	return (mountedPath != nullptr && mountedPath->isDirectory);
+}
+
+long int VirtualFileSystem::fileSize(const char *path)
+{
+	const MountedPath *mountedPath = findPath(path, nullptr);
+	if (mountedPath == nullptr || mountedPath->isDirectory)
+		return -1;
+	return mountedPath->size;
+}
+
+bool VirtualFileSystem::mountType(const char *path, MountType &type)
+{
+	const Mount *mount = nullptr;
+	if (findPath(path, &mount) == nullptr)
+		return false;
+
+	type = mount->type;
+	return true;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::UniquePtr<IFile> VirtualFileSystem::createFileHandle(const char *filename, bool mapped)
+{
+	const Mount *mount = nullptr;
+	const MountedPath *mountedPath = findPath(filename, &mount);
+	if (mountedPath == nullptr || mountedPath->isDirectory)
+		return nctl::UniquePtr<IFile>();
+
+	switch (mount->type)
+	{
+		case MountType::DIRECTORY:
+			return IFile::createPlatformFileHandle(mountedPath->path.data(), mapped);
+		case MountType::PACK:
+			return nctl::makeUnique<PackFile>(filename, mount->pack, mountedPath->entryIndex);
+		case MountType::BUFFER:
+			return nctl::makeUnique<MemoryFile>(filename, mount->bufferPtr, mount->bufferSize);
+	}
+
+	return nctl::UniquePtr<IFile>();
+}
+
+}
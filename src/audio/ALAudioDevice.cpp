@@ -4,15 +4,35 @@
 #include "AudioStreamPlayer.h"
 #include <nctl/algorithms.h>
 
+#ifdef WITH_THREADS
+	#include "AudioStreamDecoder.h"
+#endif
+
 namespace ncine {
 
+const float ALAudioDevice::VirtualizationHysteresis = 1.5f;
+
+namespace {
+
+	/// Returns true if the first player is more important than the second one
+	bool isMoreImportant(const IAudioPlayer *first, float firstAudibility, const IAudioPlayer *second, float secondAudibility)
+	{
+		if (first->priority() != second->priority())
+			return first->priority() > second->priority();
+		return firstAudibility > secondAudibility;
+	}
+
+}
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
 
-ALAudioDevice::ALAudioDevice()
+ALAudioDevice::ALAudioDevice(bool withStreamingThread)
     : device_(nullptr), context_(nullptr), gain_(1.0f),
-      sources_(nctl::StaticArrayMode::EXTEND_SIZE), deviceName_(nullptr)
+      sources_(nctl::StaticArrayMode::EXTEND_SIZE), players_(MaxSources * 4),
+      rankedPlayers_(MaxSources * 4), oneShotPlayers_(OneShotPoolSize),
+      oneShotBuffers_(nctl::StaticArrayMode::EXTEND_SIZE), nextOneShot_(0), deviceName_(nullptr)
 {
 	device_ = alcOpenDevice(nullptr);
 	FATAL_ASSERT_MSG_X(device_ != nullptr, "alcOpenDevice failed: %x", alGetError());
@@ -39,10 +59,30 @@ ALAudioDevice::ALAudioDevice()
 
 	alListener3f(AL_POSITION, 0.0f, 0.0f, 0.0f);
 	alListenerf(AL_GAIN, gain_);
+
+	for (unsigned int i = 0; i < OneShotPoolSize; i++)
+		oneShotPlayers_.pushBack(nctl::makeUnique<AudioBufferPlayer>());
+
+#ifdef WITH_THREADS
+	if (withStreamingThread)
+		streamDecoder_ = nctl::makeUnique<AudioStreamDecoder>();
+#endif
 }
 
 ALAudioDevice::~ALAudioDevice()
 {
+#ifdef WITH_THREADS
+	// Streams still alive are detached from the audio thread before it stops
+	streamDecoder_.reset(nullptr);
+#endif
+
+	// Pooled players stop their sources when destroyed
+	players_.clear();
+	oneShotPlayers_.clear();
+	// Shared buffers are released while the context is still current
+	for (nctl::SharedPtr<AudioBuffer> &audioBuffer : oneShotBuffers_)
+		audioBuffer = nctl::SharedPtr<AudioBuffer>();
+
 	for (ALuint sourceId : sources_)
 		alSourcei(sourceId, AL_BUFFER, AL_NONE);
 	alDeleteSources(MaxSources, sources_.data());
@@ -71,6 +111,17 @@ const IAudioPlayer *ALAudioDevice::player(unsigned int index) const
 	return nullptr;
 }
 
+unsigned int ALAudioDevice::numVirtualPlayers() const
+{
+	unsigned int numVirtualPlayers = 0;
+	for (const IAudioPlayer *player : players_)
+	{
+		if (player->isVirtual())
+			numVirtualPlayers++;
+	}
+	return numVirtualPlayers;
+}
+
 void ALAudioDevice::stopPlayers()
 {
 	forEach(players_.begin(), players_.end(), [](IAudioPlayer *player) { player->stop(); });
@@ -133,7 +184,21 @@ unsigned int ALAudioDevice::nextAvailableSource()
 	for (ALuint sourceId : sources_)
 	{
 		alGetSourcei(sourceId, AL_SOURCE_STATE, &sourceState);
-		if (sourceState != AL_PLAYING && sourceState != AL_PAUSED)
+		if (sourceState == AL_PLAYING || sourceState == AL_PAUSED)
+			continue;
+
+		// A stream source can be briefly stopped while waiting for its first buffer
+		bool isAssigned = false;
+		for (const IAudioPlayer *player : players_)
+		{
+			if (player->sourceId() == sourceId && player->isPlaying())
+			{
+				isAssigned = true;
+				break;
+			}
+		}
+
+		if (isAssigned == false)
 			return sourceId;
 	}
 
@@ -143,18 +208,156 @@ unsigned int ALAudioDevice::nextAvailableSource()
 void ALAudioDevice::registerPlayer(IAudioPlayer *player)
 {
 	ASSERT(player);
+	// A paused player is still registered if it is played again before the next update
+	for (const IAudioPlayer *registeredPlayer : players_)
+	{
+		if (registeredPlayer == player)
+			return;
+	}
 	players_.pushBack(player);
+
+#ifdef WITH_THREADS
+	// A stream stays registered until it is destroyed, so that it is decoded ahead again after being stopped
+	if (streamDecoder_ != nullptr && player->type() == AudioStreamPlayer::sType())
+		streamDecoder_->registerStream(static_cast<AudioStreamPlayer *>(player)->audioStream_);
+#endif
+}
+
+bool ALAudioDevice::playOneShot(AudioBuffer &audioBuffer, float gain, float pitch, const Vector3f &position)
+{
+	return (startOneShot(audioBuffer, gain, pitch, position) >= 0);
+}
+
+bool ALAudioDevice::playOneShot(const nctl::SharedPtr<AudioBuffer> &audioBuffer, float gain, float pitch, const Vector3f &position)
+{
+	ASSERT(audioBuffer != nullptr);
+	nctl::SharedPtr<AudioBuffer> sharedBuffer(audioBuffer);
+	const int index = startOneShot(*sharedBuffer, gain, pitch, position);
+	if (index < 0)
+		return false;
+
+	oneShotBuffers_[index] = nctl::move(sharedBuffer);
+	return true;
+}
+
+void ALAudioDevice::stopOneShots(const AudioBuffer &audioBuffer)
+{
+	for (nctl::UniquePtr<AudioBufferPlayer> &player : oneShotPlayers_)
+	{
+		if (player->audioBuffer() == &audioBuffer)
+			player->setAudioBuffer(nullptr);
+	}
 }
 
 void ALAudioDevice::updatePlayers()
 {
+	// Shared buffers are released as soon as their one-shot sounds stop, so that a cache can evict them
+	for (unsigned int i = 0; i < OneShotPoolSize; i++)
+	{
+		if (oneShotBuffers_[i] != nullptr && oneShotPlayers_[i]->isStopped())
+			oneShotBuffers_[i] = nctl::SharedPtr<AudioBuffer>();
+	}
+
+	bool hasVirtualPlayers = false;
 	for (int i = players_.size() - 1; i >= 0; i--)
 	{
 		if (players_[i]->isPlaying())
+		{
+			// Virtual players advance their playback position without a source
 			players_[i]->updateState();
+			if (players_[i]->isVirtual())
+				hasVirtualPlayers = true;
+		}
 		else
 			players_.unorderedRemoveAt(i);
 	}
+
+	if (hasVirtualPlayers)
+		assignSources();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! The player is taken from a pool, round robin, and it is reused as soon as it is not playing anymore. */
+int ALAudioDevice::startOneShot(AudioBuffer &audioBuffer, float gain, float pitch, const Vector3f &position)
+{
+	for (unsigned int i = 0; i < OneShotPoolSize; i++)
+	{
+		const unsigned int index = (nextOneShot_ + i) % OneShotPoolSize;
+		AudioBufferPlayer &player = *oneShotPlayers_[index];
+		if (player.isPlaying())
+			continue;
+
+		// The shared buffer of the previous sound is released before reusing the player
+		oneShotBuffers_[index] = nctl::SharedPtr<AudioBuffer>();
+		player.setAudioBuffer(&audioBuffer);
+		player.setLooping(false);
+		player.setGain(gain);
+		player.setPitch(pitch);
+		player.setPosition(position);
+		player.play();
+
+		nextOneShot_ = (index + 1) % OneShotPoolSize;
+		return static_cast<int>(index);
+	}
+
+	return -1;
+}
+
+void ALAudioDevice::assignSources()
+{
+	ALfloat listenerPosition[3];
+	alGetListenerfv(AL_POSITION, listenerPosition);
+	const Vector3f listener(listenerPosition[0], listenerPosition[1], listenerPosition[2]);
+
+	rankedPlayers_.clear();
+	for (IAudioPlayer *player : players_)
+	{
+		if (player->isPlaying() == false)
+			continue;
+
+		// The default inverse distance model with a reference distance of one
+		const float distance = (player->position() - listener).length();
+		const float audibility = player->gain() / (distance > 1.0f ? distance : 1.0f);
+		rankedPlayers_.emplaceBack(player, audibility);
+	}
+
+	nctl::quicksort(rankedPlayers_.begin(), rankedPlayers_.end(), [](const RankedPlayer &a, const RankedPlayer &b) {
+		return isMoreImportant(a.player, a.audibility, b.player, b.audibility);
+	});
+
+	// Virtual players take free sources first, then the sources of the least important players
+	bool hasFreeSources = true;
+	int leastImportant = rankedPlayers_.size() - 1;
+	for (int i = 0; i < static_cast<int>(rankedPlayers_.size()); i++)
+	{
+		IAudioPlayer *player = rankedPlayers_[i].player;
+		if (player->isVirtual() == false)
+			continue;
+
+		unsigned int source = hasFreeSources ? nextAvailableSource() : UnavailableSource;
+		if (source == UnavailableSource)
+		{
+			hasFreeSources = false;
+			while (leastImportant > i && rankedPlayers_[leastImportant].player->isVirtual())
+				leastImportant--;
+			if (leastImportant <= i)
+				break;
+
+			// The hysteresis prevents two players with a similar audibility from swapping sources every frame
+			const RankedPlayer &victim = rankedPlayers_[leastImportant];
+			if (isMoreImportant(player, rankedPlayers_[i].audibility, victim.player, victim.audibility * VirtualizationHysteresis) == false)
+				break;
+
+			source = victim.player->sourceId();
+			victim.player->virtualize();
+			leastImportant--;
+		}
+
+		player->devirtualize(source);
+	}
 }
 
 }
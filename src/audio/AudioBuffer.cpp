@@ -4,6 +4,7 @@
 #include "AudioBuffer.h"
 #include "AudioData.h"
 #include "IAudioLoader.h"
+#include "ServiceLocator.h"
 #include "tracy.h"
 
 namespace ncine {
@@ -61,8 +62,26 @@ AudioBuffer::AudioBuffer(AudioData &audioData)
 	load(*audioData.audioLoader_.get());
 }
 
+/*! Private constructor called only by `AudioBufferCache`. */
+AudioBuffer::AudioBuffer(const char *name, int numChannels, int frequency, const char *samples, unsigned long int samplesSize)
+    : Object(ObjectType::AUDIOBUFFER, name),
+      numChannels_(0), frequency_(0), bufferSize_(0)
+{
+	ZoneScoped;
+	ZoneText(name, strnlen(name, nctl::String::MaxCStringLength));
+
+	alGetError();
+	alGenBuffers(1, &bufferId_);
+	const ALenum error = alGetError();
+	ASSERT_MSG_X(error == AL_NO_ERROR, "alGenBuffers failed: %x", error);
+
+	loadSamples(numChannels, frequency, samples, samplesSize);
+}
+
 AudioBuffer::~AudioBuffer()
 {
+	// A buffer cannot be deleted while it is attached to the source of a pooled player
+	theServiceLocator().audioDevice().stopOneShots(*this);
 	alDeleteBuffers(1, &bufferId_);
 }
 
@@ -72,22 +91,28 @@ AudioBuffer::~AudioBuffer()
 
 void AudioBuffer::load(IAudioLoader &audioLoader)
 {
-	frequency_ = audioLoader.frequency();
-	numChannels_ = audioLoader.numChannels();
-
-	FATAL_ASSERT_MSG_X(numChannels_ == 1 || numChannels_ == 2, "Unsupported number of channels: %d", numChannels_);
-	const ALenum format = (numChannels_ == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
-
 	// Buffer size calculated as samples * channels * 16bit
-	bufferSize_ = audioLoader.bufferSize();
-	nctl::UniquePtr<char[]> buffer = nctl::makeUnique<char[]>(bufferSize_);
+	const unsigned long int samplesSize = audioLoader.bufferSize();
+	nctl::UniquePtr<char[]> buffer = nctl::makeUnique<char[]>(samplesSize);
 
 	nctl::UniquePtr<IAudioReader> audioReader = audioLoader.createReader();
-	audioReader->read(buffer.get(), bufferSize_);
+	audioReader->read(buffer.get(), samplesSize);
+
+	loadSamples(audioLoader.numChannels(), audioLoader.frequency(), buffer.get(), samplesSize);
+}
+
+void AudioBuffer::loadSamples(int numChannels, int frequency, const char *samples, unsigned long int samplesSize)
+{
+	frequency_ = frequency;
+	numChannels_ = numChannels;
+
+	FATAL_ASSERT_MSG_X(numChannels_ == 1 || numChannels_ == 2, "Unsupported number of channels: %d", numChannels_);
+	const ALenum format = (numChannels_ == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+	bufferSize_ = samplesSize;
 
 	alGetError();
 	// On iOS `alBufferDataStatic()` could be used instead
-	alBufferData(bufferId_, format, buffer.get(), bufferSize_, frequency_);
+	alBufferData(bufferId_, format, samples, bufferSize_, frequency_);
 	const ALenum error = alGetError();
 	ASSERT_MSG_X(error == AL_NO_ERROR, "alBufferData failed: %x", error);
 }
@@ -0,0 +1,250 @@
+#include "common_macros.h"
+#include "AudioBufferCache.h"
+#include "AudioBuffer.h"
+#include "IAudioLoader.h"
+#include "ServiceLocator.h"
+#include "IThreadPool.h"
+#include "CacheEviction.h"
+#include <nctl/Array.h>
+#include <nctl/HashSet.h>
+#include <nctl/Atomic.h>
+#include "tracy.h"
+
+#ifdef WITH_THREADS
+	#include "ThreadSync.h"
+#endif
+
+namespace ncine {
+
+namespace {
+
+	/// The samples of a file decoded by a preloading worker
+	struct DecodedFile
+	{
+		nctl::String filename;
+		bool hasDecoded = false;
+		int numChannels = 0;
+		int frequency = 0;
+		unsigned long int samplesSize = 0;
+		nctl::UniquePtr<char[]> samples;
+	};
+
+	/// The state shared between the threads decoding a manifest
+	class PreloadState
+	{
+	  public:
+		explicit PreloadState(unsigned int numFiles)
+		    : files(numFiles), nextFile_(0), numDecodedFiles_(0) {}
+
+		nctl::Array<DecodedFile> files;
+
+		/// Decodes files until there are none left, it can be executed by more than one thread at the same time
+		void run()
+		{
+			const int32_t numFiles = static_cast<int32_t>(files.size());
+			int32_t index = nextFile_.fetchAdd(1);
+			while (index < numFiles)
+			{
+				decode(files[index]);
+				// The last decoded file wakes up the thread waiting for the manifest
+				if (numDecodedFiles_.fetchAdd(1) + 1 == numFiles)
+				{
+#ifdef WITH_THREADS
+					mutex_.lock();
+					decodedCV_.broadcast();
+					mutex_.unlock();
+#endif
+				}
+				index = nextFile_.fetchAdd(1);
+			}
+		}
+
+		/// Blocks the calling thread until every file has been decoded
+		void wait()
+		{
+#ifdef WITH_THREADS
+			const int32_t numFiles = static_cast<int32_t>(files.size());
+			mutex_.lock();
+			while (numDecodedFiles_.load() < numFiles)
+				decodedCV_.wait(mutex_);
+			mutex_.unlock();
+#endif
+		}
+
+	  private:
+		nctl::Atomic32 nextFile_;
+		nctl::Atomic32 numDecodedFiles_;
+#ifdef WITH_THREADS
+		Mutex mutex_;
+		CondVariable decodedCV_;
+#endif
+
+		void decode(DecodedFile &file)
+		{
+			ZoneScopedN("Decode audio file");
+			nctl::UniquePtr<IAudioLoader> audioLoader = IAudioLoader::createFromFile(file.filename.data());
+			if (audioLoader->hasLoaded() == false)
+				return;
+
+			file.numChannels = audioLoader->numChannels();
+			file.frequency = audioLoader->frequency();
+			file.samplesSize = audioLoader->bufferSize();
+			file.samples = nctl::makeUnique<char[]>(file.samplesSize);
+			nctl::UniquePtr<IAudioReader> audioReader = audioLoader->createReader();
+			audioReader->read(file.samples.get(), file.samplesSize);
+			file.hasDecoded = true;
+		}
+	};
+
+	/// A thread pool command that helps decoding the files of a manifest
+	class PreloadCommand : public IThreadCommand
+	{
+	  public:
+		explicit PreloadCommand(const nctl::SharedPtr<PreloadState> &state)
+		    : state_(state) {}
+
+		void execute() override { state_->run(); }
+
+	  private:
+		nctl::SharedPtr<PreloadState> state_;
+	};
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+AudioBufferCache::AudioBufferCache()
+    : entries_(InitialCapacity), memoryBudget_(0), dataSize_(0), accessCounter_(0), keyString_(nctl::String::MaxCStringLength)
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::SharedPtr<AudioBuffer> AudioBufferCache::retrieve(const char *filename)
+{
+	ZoneScoped;
+	keyString_ = filename;
+
+	accessCounter_++;
+	Entry *entry = entries_.find(keyString_);
+	if (entry != nullptr)
+	{
+		entry->lastUse = accessCounter_;
+		return entry->buffer;
+	}
+
+	nctl::SharedPtr<AudioBuffer> buffer(nctl::makeUnique<AudioBuffer>(filename));
+	insert(buffer);
+
+	// The new buffer is referenced by the returned pointer and cannot be evicted
+	trim();
+	return buffer;
+}
+
+unsigned int AudioBufferCache::preload(const char *const *filenames, unsigned int numFilenames)
+{
+	ZoneScoped;
+	if (numFilenames == 0)
+		return 0;
+
+	nctl::SharedPtr<PreloadState> state = nctl::makeShared<PreloadState>(numFilenames);
+	// Twice the number of files, as the hashset cannot be completely filled
+	nctl::StringHashSet manifestFiles(numFilenames * 2);
+	for (unsigned int i = 0; i < numFilenames; i++)
+	{
+		keyString_ = filenames[i];
+		if (entries_.find(keyString_) != nullptr)
+			continue;
+
+		// A file that appears more than once in the manifest is decoded only once
+		if (manifestFiles.insert(keyString_) == false)
+			continue;
+
+		state->files.emplaceBack();
+		state->files.back().filename = nctl::String(filenames[i]);
+	}
+
+	if (state->files.isEmpty())
+		return 0;
+
+	// The calling thread takes part in decoding, so that the manifest is decoded even without worker threads
+	IThreadPool &threadPool = theServiceLocator().threadPool();
+	const unsigned int numCommands = (threadPool.numThreads() < state->files.size()) ? threadPool.numThreads() : state->files.size() - 1;
+	for (unsigned int i = 0; i < numCommands; i++)
+		threadPool.enqueueCommand(nctl::makeUnique<PreloadCommand>(state));
+	state->run();
+	state->wait();
+
+	unsigned int numLoaded = 0;
+	for (DecodedFile &file : state->files)
+	{
+		if (file.hasDecoded == false)
+		{
+			LOGW_X("Cannot preload audio file \"%s\"", file.filename.data());
+			continue;
+		}
+
+		// The constructor from decoded samples is private, so the buffer cannot be created by `makeUnique()`
+		nctl::SharedPtr<AudioBuffer> buffer(new AudioBuffer(file.filename.data(), file.numChannels, file.frequency, file.samples.get(), file.samplesSize));
+		file.samples.reset(nullptr);
+		keyString_ = file.filename.data();
+		accessCounter_++;
+		if (insert(buffer))
+			numLoaded++;
+	}
+
+	LOGI_X("Preloaded %u audio files out of %u", numLoaded, numFilenames);
+	trim();
+	return numLoaded;
+}
+
+void AudioBufferCache::setMemoryBudget(unsigned long memoryBudget)
+{
+	memoryBudget_ = memoryBudget;
+	trim();
+}
+
+void AudioBufferCache::trim()
+{
+	if (memoryBudget_ == 0)
+		return;
+
+	evict(memoryBudget_);
+}
+
+void AudioBufferCache::evictUnreferenced()
+{
+	evict(0);
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool AudioBufferCache::insert(const nctl::SharedPtr<AudioBuffer> &buffer)
+{
+	if (entries_.loadFactor() >= 0.75f)
+		entries_.rehash(entries_.capacity() * 2);
+
+	Entry newEntry;
+	newEntry.buffer = buffer;
+	newEntry.lastUse = accessCounter_;
+	newEntry.dataSize = buffer->bufferSize();
+	const bool inserted = entries_.insert(keyString_, newEntry);
+	if (inserted)
+		dataSize_ += newEntry.dataSize;
+	return inserted;
+}
+
+void AudioBufferCache::evict(unsigned long targetSize)
+{
+	dataSize_ = evictLeastRecentlyUsed(entries_, dataSize_, targetSize, [](const nctl::String &key, unsigned long dataSize) {
+		LOGI_X("Evicting audio buffer \"%s\" from the cache (%lu bytes)", key.data(), dataSize);
+	});
+}
+
+}
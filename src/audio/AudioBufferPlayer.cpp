@@ -2,6 +2,8 @@
 #include "common_headers.h"
 #include "AudioBufferPlayer.h"
 #include "AudioBuffer.h"
+#include <nctl/algorithms.h>
+#include <cmath> // for fmodf()
 
 namespace ncine {
 
@@ -9,8 +11,13 @@ namespace ncine {
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
 
+AudioBufferPlayer::AudioBufferPlayer()
+    : IAudioPlayer(ObjectType::AUDIOBUFFER_PLAYER), audioBuffer_(nullptr), virtualOffset_(0.0f)
+{
+}
+
 AudioBufferPlayer::AudioBufferPlayer(AudioBuffer *audioBuffer)
-    : IAudioPlayer(ObjectType::AUDIOBUFFER_PLAYER), audioBuffer_(audioBuffer)
+    : IAudioPlayer(ObjectType::AUDIOBUFFER_PLAYER), audioBuffer_(audioBuffer), virtualOffset_(0.0f)
 {
 	ASSERT(audioBuffer);
 	if (audioBuffer_)
@@ -42,6 +49,15 @@ unsigned long AudioBufferPlayer::bufferSize() const
 	return (audioBuffer_ ? audioBuffer_->bufferSize() : 0UL);
 }
 
+void AudioBufferPlayer::setAudioBuffer(AudioBuffer *audioBuffer)
+{
+	stop();
+	audioBuffer_ = audioBuffer;
+	if (audioBuffer_)
+		setName(audioBuffer_->name());
+}
+
+/*! When there are no available sources the player starts as virtual, it will be heard when given a source. */
 void AudioBufferPlayer::play()
 {
 	switch (state_)
@@ -49,26 +65,12 @@ void AudioBufferPlayer::play()
 		case PlayerState::INITIAL:
 		case PlayerState::STOPPED:
 		{
-			const unsigned int source = theServiceLocator().audioDevice().nextAvailableSource();
-			if (source == IAudioDevice::UnavailableSource)
-			{
-				LOGW("No more available audio sources for playing");
-				return;
-			}
-			sourceId_ = source;
-
-			if (audioBuffer_)
-			{
-				alSourcei(sourceId_, AL_BUFFER, audioBuffer_->bufferId());
-				// Setting OpenAL source looping only if not streaming
-				alSourcei(sourceId_, AL_LOOPING, isLooping_);
-			}
-
-			alSourcef(sourceId_, AL_GAIN, gain_);
-			alSourcef(sourceId_, AL_PITCH, pitch_);
-			alSourcefv(sourceId_, AL_POSITION, position_.data());
-
-			alSourcePlay(sourceId_);
+			virtualOffset_ = 0.0f;
+			sourceId_ = theServiceLocator().audioDevice().nextAvailableSource();
+			if (sourceId_ != IAudioDevice::UnavailableSource)
+				playOnSource();
+			else
+				virtualTimeStamp_ = TimeStamp::now();
 			state_ = PlayerState::PLAYING;
 
 			theServiceLocator().audioDevice().registerPlayer(this);
@@ -78,7 +80,10 @@ void AudioBufferPlayer::play()
 			break;
 		case PlayerState::PAUSED:
 		{
-			alSourcePlay(sourceId_);
+			if (sourceId_ != IAudioDevice::UnavailableSource)
+				alSourcePlay(sourceId_);
+			else
+				virtualTimeStamp_ = TimeStamp::now();
 			state_ = PlayerState::PLAYING;
 
 			theServiceLocator().audioDevice().registerPlayer(this);
@@ -96,7 +101,10 @@ void AudioBufferPlayer::pause()
 			break;
 		case PlayerState::PLAYING:
 		{
-			alSourcePause(sourceId_);
+			if (sourceId_ != IAudioDevice::UnavailableSource)
+				alSourcePause(sourceId_);
+			else
+				virtualOffset_ += advanceVirtualTime();
 			state_ = PlayerState::PAUSED;
 			break;
 		}
@@ -115,9 +123,12 @@ void AudioBufferPlayer::stop()
 		case PlayerState::PLAYING:
 		case PlayerState::PAUSED:
 		{
-			alSourceStop(sourceId_);
-			// Detach the buffer from source
-			alSourcei(sourceId_, AL_BUFFER, 0);
+			if (sourceId_ != IAudioDevice::UnavailableSource)
+			{
+				alSourceStop(sourceId_);
+				// Detach the buffer from source
+				alSourcei(sourceId_, AL_BUFFER, 0);
+			}
 
 			sourceId_ = 0;
 			state_ = PlayerState::STOPPED;
@@ -128,7 +139,22 @@ void AudioBufferPlayer::stop()
 
 void AudioBufferPlayer::updateState()
 {
-	if (state_ == PlayerState::PLAYING)
+	if (state_ == PlayerState::PLAYING && sourceId_ == IAudioDevice::UnavailableSource)
+	{
+		virtualOffset_ += advanceVirtualTime();
+		const float duration = this->duration();
+		if (virtualOffset_ >= duration)
+		{
+			if (isLooping_ && duration > 0.0f)
+				virtualOffset_ = fmodf(virtualOffset_, duration);
+			else
+			{
+				state_ = PlayerState::STOPPED;
+				sourceId_ = 0;
+			}
+		}
+	}
+	else if (state_ == PlayerState::PLAYING)
 	{
 		ALenum alState;
 		alGetSourcei(sourceId_, AL_SOURCE_STATE, &alState);
@@ -144,4 +170,61 @@ void AudioBufferPlayer::updateState()
 	}
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+float AudioBufferPlayer::duration() const
+{
+	if (audioBuffer_ == nullptr || audioBuffer_->numChannels() == 0 || audioBuffer_->frequency() == 0)
+		return 0.0f;
+
+	// Buffers always hold 16 bits samples
+	const unsigned long int bytesPerSecond = audioBuffer_->frequency() * audioBuffer_->numChannels() * 2;
+	return audioBuffer_->bufferSize() / static_cast<float>(bytesPerSecond);
+}
+
+void AudioBufferPlayer::virtualize()
+{
+	ASSERT(state_ == PlayerState::PLAYING && sourceId_ != IAudioDevice::UnavailableSource);
+
+	alGetSourcef(sourceId_, AL_SEC_OFFSET, &virtualOffset_);
+	alSourceStop(sourceId_);
+	// Detach the buffer from source
+	alSourcei(sourceId_, AL_BUFFER, 0);
+
+	sourceId_ = IAudioDevice::UnavailableSource;
+	virtualTimeStamp_ = TimeStamp::now();
+}
+
+void AudioBufferPlayer::devirtualize(unsigned int source)
+{
+	ASSERT(state_ == PlayerState::PLAYING && sourceId_ == IAudioDevice::UnavailableSource);
+
+	virtualOffset_ += advanceVirtualTime();
+	const float duration = this->duration();
+	if (isLooping_ && duration > 0.0f)
+		virtualOffset_ = fmodf(virtualOffset_, duration);
+	else
+		virtualOffset_ = nctl::min(virtualOffset_, duration);
+
+	sourceId_ = source;
+	playOnSource();
+}
+
+void AudioBufferPlayer::playOnSource()
+{
+	if (audioBuffer_)
+	{
+		alSourcei(sourceId_, AL_BUFFER, audioBuffer_->bufferId());
+		// Setting OpenAL source looping only if not streaming
+		alSourcei(sourceId_, AL_LOOPING, isLooping_);
+	}
+
+	applySourceProperties();
+	// The offset of a stopped source is applied when it starts playing
+	alSourcef(sourceId_, AL_SEC_OFFSET, virtualOffset_);
+	alSourcePlay(sourceId_);
+}
+
 }
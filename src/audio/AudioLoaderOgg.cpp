@@ -87,7 +87,7 @@ nctl::UniquePtr<IAudioReader> AudioLoaderOgg::createReader()
 	if (fileHandle_ == nullptr)
 	{
 		if (constructionInfo_.bufferPtr == nullptr)
-			fileHandle_ = IFile::createFileHandle(constructionInfo_.name.data());
+			fileHandle_ = IFile::createReadFileHandle(constructionInfo_.name.data());
 		else
 			fileHandle_ = IFile::createFromMemory(constructionInfo_.name.data(), constructionInfo_.bufferPtr, constructionInfo_.bufferSize);
 
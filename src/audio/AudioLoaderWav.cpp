@@ -49,7 +49,7 @@ nctl::UniquePtr<IAudioReader> AudioLoaderWav::createReader()
 	if (fileHandle_ == nullptr)
 	{
 		if (constructionInfo_.bufferPtr == nullptr)
-			fileHandle_ = IFile::createFileHandle(constructionInfo_.name.data());
+			fileHandle_ = IFile::createMappedFileHandle(constructionInfo_.name.data());
 		else
 			fileHandle_ = IFile::createFromMemory(constructionInfo_.name.data(), constructionInfo_.bufferPtr, constructionInfo_.bufferSize);
 
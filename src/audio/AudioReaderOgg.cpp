@@ -34,7 +34,8 @@ unsigned long int AudioReaderOgg::read(char *buffer, unsigned long int bufferSiz
 	ASSERT(buffer);
 	ASSERT(bufferSize > 0);
 
-	static int bitStream = 0;
+	// A local variable, as streams can be decoded by the audio thread while buffers are decoded by the main one
+	int bitStream = 0;
 	long bytes = 0;
 	unsigned long int bufferSeek = 0;
 
@@ -50,10 +51,6 @@ unsigned long int AudioReaderOgg::read(char *buffer, unsigned long int bufferSiz
 			FATAL_MSG_X("Error decoding at bitstream %d", bitStream);
 		}
 
-		// Reset the static variable at the end of a decoding process
-		if (bytes <= 0)
-			bitStream = 0;
-
 		bufferSeek += bytes;
 	} while (bytes > 0 && bufferSize - bufferSeek > 0);
 
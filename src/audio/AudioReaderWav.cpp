@@ -29,9 +29,8 @@ unsigned long int AudioReaderWav::read(char *buffer, unsigned long int bufferSiz
 
 	do
 	{
-		// Read up to a buffer's worth of decoded sound data
-		bytes = fileHandle_->read(buffer, bufferSize);
-		FATAL_ASSERT_MSG(bytes > 0, "Zero bytes read from file");
+		// Read up to a buffer's worth of decoded sound data, zero bytes are read at the end of the file
+		bytes = fileHandle_->read(buffer + bufferSeek, bufferSize - bufferSeek);
 		bufferSeek += bytes;
 	} while (bytes > 0 && bufferSize - bufferSeek > 0);
 
@@ -40,7 +39,9 @@ unsigned long int AudioReaderWav::read(char *buffer, unsigned long int bufferSiz
 
 void AudioReaderWav::rewind() const
 {
-	clearerr(fileHandle_->ptr());
+	// Mapped and memory files have no stream whose error state needs to be cleared
+	if (fileHandle_->ptr() != nullptr)
+		clearerr(fileHandle_->ptr());
 	fileHandle_->seek(AudioLoaderWav::HeaderSize, SEEK_SET);
 }
 
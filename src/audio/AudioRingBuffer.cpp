@@ -0,0 +1,70 @@
+#include <cstring> // for memcpy()
+#include "common_macros.h"
+#include "AudioRingBuffer.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+AudioRingBuffer::AudioRingBuffer(unsigned int capacity)
+    : buffer_(nctl::makeUnique<char[]>(capacity)), capacity_(capacity), readPosition_(0), writePosition_(0)
+{
+	FATAL_ASSERT_MSG_X(capacity > 0 && (capacity & (capacity - 1)) == 0, "The capacity %u is not a power of two", capacity);
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned int AudioRingBuffer::size() const
+{
+	const uint32_t writePosition = static_cast<uint32_t>(writePosition_.load(nctl::Atomic32::MemoryModel::ACQUIRE));
+	const uint32_t readPosition = static_cast<uint32_t>(readPosition_.load(nctl::Atomic32::MemoryModel::ACQUIRE));
+	return writePosition - readPosition;
+}
+
+char *AudioRingBuffer::writeRegion(unsigned int &length)
+{
+	const uint32_t writePosition = static_cast<uint32_t>(writePosition_.load(nctl::Atomic32::MemoryModel::RELAXED));
+	const uint32_t readPosition = static_cast<uint32_t>(readPosition_.load(nctl::Atomic32::MemoryModel::ACQUIRE));
+	const unsigned int offset = writePosition & (capacity_ - 1);
+	const unsigned int freeBytes = capacity_ - (writePosition - readPosition);
+
+	// The region stops at the end of the buffer, the rest is returned by the next call
+	length = (freeBytes < capacity_ - offset) ? freeBytes : capacity_ - offset;
+	return buffer_.get() + offset;
+}
+
+void AudioRingBuffer::commitWrite(unsigned int bytes)
+{
+	const uint32_t writePosition = static_cast<uint32_t>(writePosition_.load(nctl::Atomic32::MemoryModel::RELAXED));
+	writePosition_.store(static_cast<int32_t>(writePosition + bytes), nctl::Atomic32::MemoryModel::RELEASE);
+}
+
+unsigned int AudioRingBuffer::read(char *buffer, unsigned int bytes)
+{
+	ASSERT(buffer);
+	const uint32_t readPosition = static_cast<uint32_t>(readPosition_.load(nctl::Atomic32::MemoryModel::RELAXED));
+	const uint32_t writePosition = static_cast<uint32_t>(writePosition_.load(nctl::Atomic32::MemoryModel::ACQUIRE));
+	const unsigned int availableBytes = writePosition - readPosition;
+	if (bytes > availableBytes)
+		bytes = availableBytes;
+
+	const unsigned int offset = readPosition & (capacity_ - 1);
+	const unsigned int firstPart = (bytes < capacity_ - offset) ? bytes : capacity_ - offset;
+	memcpy(buffer, buffer_.get() + offset, firstPart);
+	memcpy(buffer + firstPart, buffer_.get(), bytes - firstPart);
+
+	// The release store makes the space available to the producer only after the bytes have been copied
+	readPosition_.store(static_cast<int32_t>(readPosition + bytes), nctl::Atomic32::MemoryModel::RELEASE);
+	return bytes;
+}
+
+void AudioRingBuffer::clear()
+{
+	readPosition_.store(writePosition_.load(nctl::Atomic32::MemoryModel::ACQUIRE), nctl::Atomic32::MemoryModel::RELEASE);
+}
+
+}
@@ -6,8 +6,13 @@
 #include "AudioData.h"
 #include "IAudioLoader.h"
 #include "IAudioReader.h"
+#include "AudioRingBuffer.h"
 #include "tracy.h"
 
+#ifdef WITH_THREADS
+	#include "AudioStreamDecoder.h"
+#endif
+
 namespace ncine {
 
 ///////////////////////////////////////////////////////////
@@ -17,7 +22,7 @@ namespace ncine {
 /*! Private constructor called only by `AudioStreamPlayer`. */
 AudioStream::AudioStream(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize)
     : buffersIds_(nctl::StaticArrayMode::EXTEND_SIZE),
-      nextAvailableBufferIndex_(0), currentBufferId_(0), frequency_(0)
+      nextAvailableBufferIndex_(0), currentBufferId_(0), frequency_(0), decoder_(nullptr)
 {
 	ZoneScoped;
 	ZoneText(bufferName, nctl::strnlen(bufferName, nctl::String::MaxCStringLength));
@@ -41,7 +46,7 @@ AudioStream::AudioStream(const char *bufferName, const unsigned char *bufferPtr,
 /*! Private constructor called only by `AudioStreamPlayer`. */
 AudioStream::AudioStream(const char *filename)
     : buffersIds_(nctl::StaticArrayMode::EXTEND_SIZE),
-      nextAvailableBufferIndex_(0), currentBufferId_(0), frequency_(0)
+      nextAvailableBufferIndex_(0), currentBufferId_(0), frequency_(0), decoder_(nullptr)
 {
 	ZoneScoped;
 	ZoneText(filename, nctl::strnlen(filename, nctl::String::MaxCStringLength));
@@ -65,7 +70,7 @@ AudioStream::AudioStream(const char *filename)
 /*! Private constructor called only by `AudioStreamPlayer`. */
 AudioStream::AudioStream(AudioData &audioData)
     : buffersIds_(nctl::StaticArrayMode::EXTEND_SIZE),
-      nextAvailableBufferIndex_(0), currentBufferId_(0), frequency_(0)
+      nextAvailableBufferIndex_(0), currentBufferId_(0), frequency_(0), decoder_(nullptr)
 {
 	FATAL_ASSERT(audioData.isValid());
 
@@ -89,6 +94,10 @@ AudioStream::AudioStream(AudioData &audioData)
 
 AudioStream::~AudioStream()
 {
+#ifdef WITH_THREADS
+	if (decoder_ != nullptr)
+		decoder_->unregisterStream(*this);
+#endif
 	alDeleteBuffers(NumBuffers, buffersIds_.data());
 }
 
@@ -120,18 +129,8 @@ bool AudioStream::enqueue(unsigned int source, bool looping)
 	{
 		currentBufferId_ = buffersIds_[nextAvailableBufferIndex_];
 
-		unsigned long bytes = audioReader_->read(memBuffer_.get(), BufferSize);
-
-		// EOF reached
-		if (bytes < BufferSize)
-		{
-			if (looping)
-			{
-				audioReader_->rewind();
-				const unsigned long moreBytes = audioReader_->read(memBuffer_.get() + bytes, BufferSize - bytes);
-				bytes += moreBytes;
-			}
-		}
+		bool isEndOfStream = false;
+		const unsigned long bytes = fillBuffer(looping, isEndOfStream);
 
 		// If it is still decoding data then enqueue
 		if (bytes > 0)
@@ -142,7 +141,7 @@ bool AudioStream::enqueue(unsigned int source, bool looping)
 			nextAvailableBufferIndex_++;
 		}
 		// If there is no more data left to decode and the queue is empty
-		else if (nextAvailableBufferIndex_ == 0)
+		else if (isEndOfStream && nextAvailableBufferIndex_ == 0)
 		{
 			shouldKeepPlaying = false;
 			stop(source);
@@ -168,6 +167,111 @@ bool AudioStream::enqueue(unsigned int source, bool looping)
 }
 
 void AudioStream::stop(unsigned int source)
+{
+	releaseSource(source);
+	rewind();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note It is called by the audio thread while the decoder mutex is locked */
+unsigned long int AudioStream::decodeAhead(unsigned int maxBytes)
+{
+#ifdef WITH_THREADS
+	// The end of stream flag is only cleared by the main thread while the decoder mutex is locked
+	if (isEndOfStream_.load(nctl::Atomic32::MemoryModel::RELAXED) != 0)
+	{
+		if (isLooping_.load(nctl::Atomic32::MemoryModel::RELAXED) == 0)
+			return 0;
+		audioReader_->rewind();
+		isEndOfStream_.store(0, nctl::Atomic32::MemoryModel::RELEASE);
+	}
+
+	unsigned int length = 0;
+	char *region = ringBuffer_->writeRegion(length);
+	if (length == 0)
+		return 0;
+	if (length > maxBytes)
+		length = maxBytes;
+
+	ZoneScopedN("Decode audio stream");
+	unsigned long int bytes = audioReader_->read(region, length);
+	if (bytes < length && isLooping_.load(nctl::Atomic32::MemoryModel::RELAXED) != 0)
+	{
+		audioReader_->rewind();
+		bytes += audioReader_->read(region + bytes, length - bytes);
+	}
+	ringBuffer_->commitWrite(static_cast<unsigned int>(bytes));
+
+	// The flag is published after the last bytes, the main thread reads them before stopping
+	if (bytes < length)
+		isEndOfStream_.store(1, nctl::Atomic32::MemoryModel::RELEASE);
+	return bytes;
+#else
+	return 0;
+#endif
+}
+
+unsigned long int AudioStream::fillBuffer(bool looping, bool &isEndOfStream)
+{
+	isEndOfStream = false;
+
+#ifdef WITH_THREADS
+	if (decoder_ != nullptr)
+	{
+		isLooping_.store(looping ? 1 : 0, nctl::Atomic32::MemoryModel::RELAXED);
+
+		// The flag is read before the size, so that the bytes decoded before the end are not missed
+		const bool hasDecodingEnded = (isEndOfStream_.load(nctl::Atomic32::MemoryModel::ACQUIRE) != 0);
+		const unsigned int decodedBytes = ringBuffer_->size();
+		// A partial buffer is only queued with the last bytes of the stream
+		if (decodedBytes < static_cast<unsigned int>(BufferSize) && hasDecodingEnded == false)
+			return 0;
+
+		isEndOfStream = (hasDecodingEnded && decodedBytes == 0);
+		return ringBuffer_->read(memBuffer_.get(), BufferSize);
+	}
+#endif
+
+	ZoneScopedN("Decode audio stream");
+	unsigned long bytes = audioReader_->read(memBuffer_.get(), BufferSize);
+
+	// EOF reached
+	if (bytes < BufferSize)
+	{
+		if (looping)
+		{
+			audioReader_->rewind();
+			const unsigned long moreBytes = audioReader_->read(memBuffer_.get() + bytes, BufferSize - bytes);
+			bytes += moreBytes;
+		}
+	}
+
+	isEndOfStream = (bytes == 0);
+	return bytes;
+}
+
+void AudioStream::rewind()
+{
+#ifdef WITH_THREADS
+	if (decoder_ != nullptr)
+	{
+		// The audio thread cannot decode while the reader is rewound and the ring is cleared
+		decoder_->lock();
+		audioReader_->rewind();
+		ringBuffer_->clear();
+		isEndOfStream_.store(0, nctl::Atomic32::MemoryModel::RELEASE);
+		decoder_->unlock();
+		return;
+	}
+#endif
+
+	audioReader_->rewind();
+}
+
+void AudioStream::releaseSource(unsigned int source)
 {
 	// In order to unqueue all the buffers, the source must be stopped first
 	alSourceStop(source);
@@ -185,8 +289,29 @@ void AudioStream::stop(unsigned int source)
 		numProcessedBuffers--;
 	}
 
-	audioReader_->rewind();
 	currentBufferId_ = 0;
 }
 
+/*! The data is discarded a streaming buffer at a time, the bytes left to skip are returned in the reference.
+ *  \return False if the end of the stream has been reached */
+bool AudioStream::skip(unsigned long int &bytes, bool looping)
+{
+	while (bytes >= static_cast<unsigned long int>(BufferSize))
+	{
+		bool isEndOfStream = false;
+		const unsigned long int skippedBytes = fillBuffer(looping, isEndOfStream);
+		if (isEndOfStream)
+		{
+			bytes = 0;
+			return false;
+		}
+		// The audio thread has not decoded enough data yet
+		if (skippedBytes == 0)
+			break;
+		bytes -= skippedBytes;
+	}
+
+	return true;
+}
+
 }
@@ -0,0 +1,111 @@
+#include "common_macros.h"
+#include "AudioStreamDecoder.h"
+#include "AudioStream.h"
+#include "AudioRingBuffer.h"
+#include "Timer.h"
+#include "tracy.h"
+
+namespace ncine {
+
+const float AudioStreamDecoder::IdleTime = 0.005f;
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+AudioStreamDecoder::AudioStreamDecoder()
+    : streams_(16), shouldQuit_(false)
+{
+	thread_.run(threadFunction, this);
+#if !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+	thread_.setName("AudioThread");
+#endif
+}
+
+AudioStreamDecoder::~AudioStreamDecoder()
+{
+	mutex_.lock();
+	shouldQuit_ = true;
+	for (AudioStream *stream : streams_)
+		stream->decoder_ = nullptr;
+	streams_.clear();
+	streamsCV_.signal();
+	mutex_.unlock();
+
+	thread_.join();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void AudioStreamDecoder::registerStream(AudioStream &stream)
+{
+	if (stream.decoder_ == this)
+		return;
+
+	// The ring is created before the stream can be accessed by the audio thread
+	if (stream.ringBuffer_ == nullptr)
+		stream.ringBuffer_ = nctl::makeUnique<AudioRingBuffer>(AudioStream::RingBufferSize);
+	stream.decoder_ = this;
+
+	mutex_.lock();
+	streams_.pushBack(&stream);
+	streamsCV_.signal();
+	mutex_.unlock();
+}
+
+void AudioStreamDecoder::unregisterStream(AudioStream &stream)
+{
+	mutex_.lock();
+	for (unsigned int i = 0; i < streams_.size(); i++)
+	{
+		if (streams_[i] == &stream)
+		{
+			streams_.unorderedRemoveAt(i);
+			break;
+		}
+	}
+	mutex_.unlock();
+
+	stream.decoder_ = nullptr;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void AudioStreamDecoder::threadFunction(void *arg)
+{
+	AudioStreamDecoder *decoder = static_cast<AudioStreamDecoder *>(arg);
+
+	LOGD_X("Audio thread %u is starting", Thread::self());
+
+	decoder->mutex_.lock();
+	while (decoder->shouldQuit_ == false)
+	{
+		if (decoder->streams_.isEmpty())
+		{
+			decoder->streamsCV_.wait(decoder->mutex_);
+			continue;
+		}
+
+		unsigned long int decodedBytes = 0;
+		{
+			ZoneScopedN("Decode audio streams");
+			for (AudioStream *stream : decoder->streams_)
+				decodedBytes += stream->decodeAhead(ChunkSize);
+		}
+
+		// The mutex is released between passes, so that the main thread can stop or destroy a stream
+		decoder->mutex_.unlock();
+		if (decodedBytes == 0)
+			Timer::sleep(IdleTime);
+		decoder->mutex_.lock();
+	}
+	decoder->mutex_.unlock();
+
+	LOGD_X("Audio thread %u is exiting", Thread::self());
+}
+
+}
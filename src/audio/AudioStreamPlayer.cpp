@@ -10,23 +10,23 @@ namespace ncine {
 ///////////////////////////////////////////////////////////
 
 AudioStreamPlayer::AudioStreamPlayer(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize)
-    : IAudioPlayer(ObjectType::AUDIOSTREAM_PLAYER, bufferName), audioStream_(bufferName, bufferPtr, bufferSize)
+    : IAudioPlayer(ObjectType::AUDIOSTREAM_PLAYER, bufferName), audioStream_(bufferName, bufferPtr, bufferSize), virtualBytes_(0)
 {
 }
 
 AudioStreamPlayer::AudioStreamPlayer(const char *filename)
-    : IAudioPlayer(ObjectType::AUDIOSTREAM_PLAYER, filename), audioStream_(filename)
+    : IAudioPlayer(ObjectType::AUDIOSTREAM_PLAYER, filename), audioStream_(filename), virtualBytes_(0)
 {
 }
 
 AudioStreamPlayer::AudioStreamPlayer(AudioData &audioData)
-    : IAudioPlayer(ObjectType::AUDIOSTREAM_PLAYER, audioData.filename()), audioStream_(audioData)
+    : IAudioPlayer(ObjectType::AUDIOSTREAM_PLAYER, audioData.filename()), audioStream_(audioData), virtualBytes_(0)
 {
 }
 
 AudioStreamPlayer::~AudioStreamPlayer()
 {
-	if (state_ != PlayerState::STOPPED)
+	if (state_ != PlayerState::STOPPED && sourceId_ != IAudioDevice::UnavailableSource)
 		audioStream_.stop(sourceId_);
 }
 
@@ -34,6 +34,7 @@ AudioStreamPlayer::~AudioStreamPlayer()
 // PUBLIC FUNCTIONS
 ///////////////////////////////////////////////////////////
 
+/*! When there are no available sources the player starts as virtual, it will be heard when given a source. */
 void AudioStreamPlayer::play()
 {
 	switch (state_)
@@ -41,22 +42,17 @@ void AudioStreamPlayer::play()
 		case PlayerState::INITIAL:
 		case PlayerState::STOPPED:
 		{
-			const unsigned int source = theServiceLocator().audioDevice().nextAvailableSource();
-			if (source == IAudioDevice::UnavailableSource)
+			virtualBytes_ = 0;
+			sourceId_ = theServiceLocator().audioDevice().nextAvailableSource();
+			if (sourceId_ != IAudioDevice::UnavailableSource)
 			{
-				LOGW("No more available audio sources for playing");
-				return;
+				// Streams looping is not handled at enqueued buffer level
+				alSourcei(sourceId_, AL_LOOPING, AL_FALSE);
+				applySourceProperties();
+				alSourcePlay(sourceId_);
 			}
-			sourceId_ = source;
-
-			// Streams looping is not handled at enqueued buffer level
-			alSourcei(sourceId_, AL_LOOPING, AL_FALSE);
-
-			alSourcef(sourceId_, AL_GAIN, gain_);
-			alSourcef(sourceId_, AL_PITCH, pitch_);
-			alSourcefv(sourceId_, AL_POSITION, position_.data());
-
-			alSourcePlay(sourceId_);
+			else
+				virtualTimeStamp_ = TimeStamp::now();
 			state_ = PlayerState::PLAYING;
 
 			theServiceLocator().audioDevice().registerPlayer(this);
@@ -66,7 +62,10 @@ void AudioStreamPlayer::play()
 			break;
 		case PlayerState::PAUSED:
 		{
-			alSourcePlay(sourceId_);
+			if (sourceId_ != IAudioDevice::UnavailableSource)
+				alSourcePlay(sourceId_);
+			else
+				virtualTimeStamp_ = TimeStamp::now();
 			state_ = PlayerState::PLAYING;
 
 			theServiceLocator().audioDevice().registerPlayer(this);
@@ -84,7 +83,10 @@ void AudioStreamPlayer::pause()
 			break;
 		case PlayerState::PLAYING:
 		{
-			alSourcePause(sourceId_);
+			if (sourceId_ != IAudioDevice::UnavailableSource)
+				alSourcePause(sourceId_);
+			else
+				skipVirtualTime();
 			state_ = PlayerState::PAUSED;
 			break;
 		}
@@ -103,10 +105,15 @@ void AudioStreamPlayer::stop()
 		case PlayerState::PLAYING:
 		case PlayerState::PAUSED:
 		{
-			// Stop the source then unqueue every buffer
-			audioStream_.stop(sourceId_);
-			// Detach the buffer from source
-			alSourcei(sourceId_, AL_BUFFER, 0);
+			if (sourceId_ != IAudioDevice::UnavailableSource)
+			{
+				// Stop the source then unqueue every buffer
+				audioStream_.stop(sourceId_);
+				// Detach the buffer from source
+				alSourcei(sourceId_, AL_BUFFER, 0);
+			}
+			else
+				audioStream_.rewind();
 
 			sourceId_ = 0;
 			state_ = PlayerState::STOPPED;
@@ -117,7 +124,16 @@ void AudioStreamPlayer::stop()
 
 void AudioStreamPlayer::updateState()
 {
-	if (state_ == PlayerState::PLAYING)
+	if (state_ == PlayerState::PLAYING && sourceId_ == IAudioDevice::UnavailableSource)
+	{
+		if (skipVirtualTime() == false)
+		{
+			audioStream_.rewind();
+			sourceId_ = 0;
+			state_ = PlayerState::STOPPED;
+		}
+	}
+	else if (state_ == PlayerState::PLAYING)
 	{
 		const bool shouldStillPlay = audioStream_.enqueue(sourceId_, isLooping_);
 		if (shouldStillPlay == false)
@@ -125,4 +141,43 @@ void AudioStreamPlayer::updateState()
 	}
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! The buffers already queued to the source are lost, the stream continues from the data decoded after them. */
+void AudioStreamPlayer::virtualize()
+{
+	ASSERT(state_ == PlayerState::PLAYING && sourceId_ != IAudioDevice::UnavailableSource);
+
+	audioStream_.releaseSource(sourceId_);
+	// Detach the buffer from source
+	alSourcei(sourceId_, AL_BUFFER, 0);
+
+	sourceId_ = IAudioDevice::UnavailableSource;
+	virtualTimeStamp_ = TimeStamp::now();
+}
+
+void AudioStreamPlayer::devirtualize(unsigned int source)
+{
+	ASSERT(state_ == PlayerState::PLAYING && sourceId_ == IAudioDevice::UnavailableSource);
+
+	skipVirtualTime();
+	virtualBytes_ = 0;
+
+	sourceId_ = source;
+	// Streams looping is not handled at enqueued buffer level
+	alSourcei(sourceId_, AL_LOOPING, AL_FALSE);
+	applySourceProperties();
+	alSourcePlay(sourceId_);
+}
+
+bool AudioStreamPlayer::skipVirtualTime()
+{
+	// Streams always hold 16 bits samples
+	const float bytesPerSecond = static_cast<float>(audioStream_.frequency() * audioStream_.numChannels() * 2);
+	virtualBytes_ += static_cast<unsigned long int>(advanceVirtualTime() * bytesPerSecond);
+	return audioStream_.skip(virtualBytes_, isLooping_);
+}
+
 }
@@ -59,7 +59,7 @@ nctl::UniquePtr<IAudioLoader> IAudioLoader::createFromFile(const char *filename)
 {
 	LOGI_X("Loading file: \"%s\"", filename);
 	// Creating a handle from IFile static method to detect assets file
-	return createLoader(nctl::move(IFile::createFileHandle(filename)), filename);
+	return createLoader(nctl::move(IFile::createReadFileHandle(filename)), filename);
 }
 
 ///////////////////////////////////////////////////////////
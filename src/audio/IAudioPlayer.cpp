@@ -11,14 +11,14 @@ namespace ncine {
 
 IAudioPlayer::IAudioPlayer(ObjectType type, const char *name)
     : Object(type, name), sourceId_(IAudioDevice::UnavailableSource),
-      state_(PlayerState::STOPPED), isLooping_(false),
+      state_(PlayerState::STOPPED), isLooping_(false), priority_(0),
       gain_(1.0f), pitch_(1.0f), position_(0.0f, 0.0f, 0.0f)
 {
 }
 
 IAudioPlayer::IAudioPlayer(ObjectType type)
     : Object(type), sourceId_(IAudioDevice::UnavailableSource),
-      state_(PlayerState::STOPPED), isLooping_(false),
+      state_(PlayerState::STOPPED), isLooping_(false), priority_(0),
       gain_(1.0f), pitch_(1.0f), position_(0.0f, 0.0f, 0.0f)
 {
 }
@@ -27,11 +27,16 @@ IAudioPlayer::IAudioPlayer(ObjectType type)
 // PUBLIC FUNCTIONS
 ///////////////////////////////////////////////////////////
 
+bool IAudioPlayer::isVirtual() const
+{
+	return (state_ == PlayerState::PLAYING || state_ == PlayerState::PAUSED) && sourceId_ == IAudioDevice::UnavailableSource;
+}
+
 /*! The change is applied to the OpenAL source only when playing. */
 void IAudioPlayer::setGain(float gain)
 {
 	gain_ = gain;
-	if (state_ == PlayerState::PLAYING)
+	if (state_ == PlayerState::PLAYING && sourceId_ != IAudioDevice::UnavailableSource)
 		alSourcef(sourceId_, AL_GAIN, gain_);
 }
 
@@ -39,7 +44,7 @@ void IAudioPlayer::setGain(float gain)
 void IAudioPlayer::setPitch(float pitch)
 {
 	pitch_ = pitch;
-	if (state_ == PlayerState::PLAYING)
+	if (state_ == PlayerState::PLAYING && sourceId_ != IAudioDevice::UnavailableSource)
 		alSourcef(sourceId_, AL_PITCH, pitch_);
 }
 
@@ -47,7 +52,7 @@ void IAudioPlayer::setPitch(float pitch)
 void IAudioPlayer::setPosition(const Vector3f &position)
 {
 	position_ = position;
-	if (state_ == PlayerState::PLAYING)
+	if (state_ == PlayerState::PLAYING && sourceId_ != IAudioDevice::UnavailableSource)
 		alSourcefv(sourceId_, AL_POSITION, position_.data());
 }
 
@@ -55,8 +60,26 @@ void IAudioPlayer::setPosition(const Vector3f &position)
 void IAudioPlayer::setPosition(float x, float y, float z)
 {
 	position_.set(x, y, z);
-	if (state_ == PlayerState::PLAYING)
+	if (state_ == PlayerState::PLAYING && sourceId_ != IAudioDevice::UnavailableSource)
 		alSourcefv(sourceId_, AL_POSITION, position_.data());
 }
 
+///////////////////////////////////////////////////////////
+// PROTECTED FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void IAudioPlayer::applySourceProperties()
+{
+	alSourcef(sourceId_, AL_GAIN, gain_);
+	alSourcef(sourceId_, AL_PITCH, pitch_);
+	alSourcefv(sourceId_, AL_POSITION, position_.data());
+}
+
+float IAudioPlayer::advanceVirtualTime()
+{
+	const float elapsedTime = virtualTimeStamp_.secondsSince() * pitch_;
+	virtualTimeStamp_ = TimeStamp::now();
+	return elapsedTime;
+}
+
 }
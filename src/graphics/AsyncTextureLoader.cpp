@@ -0,0 +1,172 @@
+#include "common_macros.h"
+#include "AsyncTextureLoader.h"
+#include "Texture.h"
+#include "ITextureLoader.h"
+#include "IThreadPool.h"
+#include <nctl/String.h>
+#include <nctl/Atomic.h>
+#include "tracy.h"
+
+namespace ncine {
+
+struct AsyncTextureLoader::Request
+{
+	explicit Request(const char *name)
+	    : filename(name), texture(nullptr), callback(nullptr), userData(nullptr),
+	      generatesMipMaps(false), mipMapFilter(MipMapGenerator::Filter::BOX), isDecoded(0) {}
+
+	nctl::String filename;
+	/// The texture to upload to, it is null if the texture has been destroyed in the meantime
+	Texture *texture;
+	CompletionCallback callback;
+	void *userData;
+	/// MIP map settings, copied at submission time as they are read by the worker thread
+	bool generatesMipMaps;
+	MipMapGenerator::Filter mipMapFilter;
+	/// The loader holding the decoded pixels, written by the worker thread
+	nctl::UniquePtr<ITextureLoader> texLoader;
+	/// Set by the worker thread when the loader can be accessed by the main thread
+	nctl::Atomic32 isDecoded;
+};
+
+/// A thread pool command that decodes a texture file
+class AsyncTextureLoader::DecodeTextureCommand : public IThreadCommand
+{
+  public:
+	explicit DecodeTextureCommand(const nctl::SharedPtr<Request> &request)
+	    : request_(request) {}
+
+	void execute() override
+	{
+		ZoneScopedN("Decode texture");
+		request_->texLoader = ITextureLoader::createFromFile(request_->filename.data());
+		if (request_->generatesMipMaps && request_->texLoader->hasLoaded())
+		{
+			ZoneScopedN("Generate MIP maps");
+			request_->texLoader->generateMipMaps(request_->mipMapFilter);
+		}
+		request_->isDecoded.store(1, nctl::Atomic32::MemoryModel::RELEASE);
+	}
+
+  private:
+	nctl::SharedPtr<Request> request_;
+};
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+AsyncTextureLoader::AsyncTextureLoader(bool withThreadPool)
+    : withThreadPool_(withThreadPool), uploadBudget_(0), generatesMipMaps_(false),
+      mipMapFilter_(MipMapGenerator::Filter::BOX), placeholderColor_(Colorf::White), requests_(16)
+{
+}
+
+/*! \note Pending textures keep their placeholder content, the decoding commands still own their requests */
+AsyncTextureLoader::~AsyncTextureLoader()
+{
+	for (nctl::SharedPtr<Request> &request : requests_)
+	{
+		if (request->texture)
+			request->texture->loadingState_ = Texture::LoadingState::FAILED;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::UniquePtr<Texture> AsyncTextureLoader::loadTexture(const char *filename)
+{
+	return loadTexture(filename, nullptr, nullptr);
+}
+
+nctl::UniquePtr<Texture> AsyncTextureLoader::loadTexture(const char *filename, CompletionCallback callback, void *userData)
+{
+	ZoneScoped;
+	nctl::UniquePtr<Texture> texture(new Texture(filename, placeholderColor_));
+
+	nctl::SharedPtr<Request> request = nctl::makeShared<Request>(filename);
+	request->texture = texture.get();
+	request->callback = callback;
+	request->userData = userData;
+	request->generatesMipMaps = generatesMipMaps_;
+	request->mipMapFilter = mipMapFilter_;
+	requests_.pushBack(request);
+
+	if (withThreadPool_)
+		theServiceLocator().threadPool().enqueueCommand(nctl::makeUnique<DecodeTextureCommand>(request));
+
+	return texture;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void AsyncTextureLoader::update()
+{
+	if (requests_.isEmpty())
+		return;
+
+	// Without a thread pool the oldest request is decoded on the main thread
+	if (withThreadPool_ == false)
+	{
+		for (nctl::SharedPtr<Request> &request : requests_)
+		{
+			if (request->texture != nullptr && request->isDecoded.load(nctl::Atomic32::MemoryModel::ACQUIRE) == 0)
+			{
+				DecodeTextureCommand(request).execute();
+				break;
+			}
+		}
+	}
+
+	unsigned long uploadedBytes = 0;
+	unsigned int index = 0;
+	while (index < requests_.size())
+	{
+		Request &request = *requests_[index];
+		// A request can only be removed when a worker thread is not decoding it anymore
+		const bool isDecoded = (request.isDecoded.load(nctl::Atomic32::MemoryModel::ACQUIRE) != 0);
+		if (isDecoded == false && (withThreadPool_ || request.texture != nullptr))
+		{
+			index++;
+			continue;
+		}
+
+		if (isDecoded && request.texture != nullptr)
+		{
+			const bool hasLoaded = request.texLoader->hasLoaded();
+			if (hasLoaded)
+			{
+				if (uploadBudget_ > 0 && uploadedBytes > 0 && uploadedBytes + request.texLoader->dataSize() > uploadBudget_)
+					break;
+				uploadedBytes += request.texLoader->dataSize();
+			}
+			else
+				LOGW_X("Texture \"%s\" cannot be loaded asynchronously", request.filename.data());
+
+			Texture *texture = request.texture;
+			texture->completeAsyncLoad(hasLoaded ? request.texLoader.get() : nullptr);
+			if (request.callback)
+				request.callback(*texture, hasLoaded, request.userData);
+		}
+
+		requests_.removeAt(index);
+	}
+}
+
+void AsyncTextureLoader::cancel(const Texture *texture)
+{
+	for (nctl::SharedPtr<Request> &request : requests_)
+	{
+		if (request->texture == texture)
+		{
+			request->texture = nullptr;
+			break;
+		}
+	}
+}
+
+}
@@ -1,5 +1,6 @@
 #include "BaseSprite.h"
 #include "RenderCommand.h"
+#include "TextureAtlas.h"
 
 namespace ncine {
 
@@ -61,6 +62,12 @@ void BaseSprite::setTexRect(const Recti &rect)
 	}
 }
 
+void BaseSprite::setTextureRegion(const TextureRegion &region)
+{
+	setTexture(region.texture);
+	setTexRect(region.rect);
+}
+
 void BaseSprite::setFlippedX(bool flippedX)
 {
 	if (flippedX_ != flippedX)
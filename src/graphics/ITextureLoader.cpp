@@ -1,4 +1,5 @@
 #include "common_macros.h"
+#include <cstring> // for memcpy()
 #include "ITextureLoader.h"
 #include "TextureLoaderDds.h"
 #include "TextureLoaderPvr.h"
@@ -22,7 +23,7 @@ namespace ncine {
 
 ITextureLoader::ITextureLoader(nctl::UniquePtr<IFile> fileHandle)
     : hasLoaded_(false), fileHandle_(nctl::move(fileHandle)), width_(0),
-      height_(0), bpp_(0), headerSize_(0), dataSize_(0), mipMapCount_(1)
+      height_(0), bpp_(0), headerSize_(0), dataSize_(0), mipMapCount_(1), pixelsView_(nullptr)
 {
 }
 
@@ -45,13 +46,14 @@ long ITextureLoader::dataSize(unsigned int mipMapLevel) const
 const GLubyte *ITextureLoader::pixels(unsigned int mipMapLevel) const
 {
 	const GLubyte *pixels = nullptr;
+	const GLubyte *basePixels = this->pixels();
 
-	if (pixels_ != nullptr)
+	if (basePixels != nullptr)
 	{
 		if (mipMapCount_ > 1 && int(mipMapLevel) < mipMapCount_)
-			pixels = pixels_.get() + mipDataOffsets_[mipMapLevel];
+			pixels = basePixels + mipDataOffsets_[mipMapLevel];
 		else if (mipMapLevel == 0)
-			pixels = pixels_.get();
+			pixels = basePixels;
 	}
 
 	return pixels;
@@ -72,8 +74,43 @@ nctl::UniquePtr<ITextureLoader> ITextureLoader::createFromMemory(const char *buf
 nctl::UniquePtr<ITextureLoader> ITextureLoader::createFromFile(const char *filename)
 {
 	LOGI_X("Loading file: \"%s\"", filename);
-	// Creating a handle from IFile static method to detect assets file
-	return createLoader(nctl::move(IFile::createFileHandle(filename)), filename);
+	// Compressed containers are uploaded straight from a memory mapping and other formats are decoded from it,
+	// files that cannot be mapped are read with a buffered fallback
+	return createLoader(nctl::move(IFile::createMappedFileHandle(filename)), filename);
+}
+
+bool ITextureLoader::generateMipMaps(MipMapGenerator::Filter filter)
+{
+	if (hasLoaded_ == false || mipMapCount_ > 1 || texFormat_.isCompressed() || texFormat_.type() != GL_UNSIGNED_BYTE)
+		return false;
+
+	// Levels are tightly packed, rows that are not aligned to four bytes are uploaded with an unpack alignment of one
+	const GLenum internalFormat = texFormat_.internalFormat();
+	if (internalFormat != GL_RGBA8 && internalFormat != GL_RGB8 && internalFormat != GL_RG8 && internalFormat != GL_R8)
+		return false;
+
+	const int numLevels = MipMapGenerator::numLevels(width_, height_);
+	if (numLevels <= 1)
+		return false;
+
+	const unsigned int numChannels = texFormat_.numChannels();
+	nctl::UniquePtr<unsigned long[]> mipDataOffsets = nctl::makeUnique<unsigned long[]>(numLevels);
+	nctl::UniquePtr<unsigned long[]> mipDataSizes = nctl::makeUnique<unsigned long[]>(numLevels);
+	const unsigned long chainDataSize = TextureFormat::calculateMipSizes(texFormat_.internalFormat(), width_, height_, numLevels, mipDataOffsets.get(), mipDataSizes.get());
+	ASSERT(chainDataSize == MipMapGenerator::chainDataSize(width_, height_, numChannels, numLevels));
+
+	nctl::UniquePtr<GLubyte[]> chainPixels = nctl::makeUnique<GLubyte[]>(chainDataSize);
+	memcpy(chainPixels.get(), pixels(), mipDataSizes[0]);
+	MipMapGenerator::generate(chainPixels.get(), width_, height_, numChannels, numLevels, filter);
+
+	pixels_ = nctl::move(chainPixels);
+	pixelsView_ = nullptr;
+	mipDataOffsets_ = nctl::move(mipDataOffsets);
+	mipDataSizes_ = nctl::move(mipDataSizes);
+	mipMapCount_ = numLevels;
+	dataSize_ = chainDataSize;
+
+	return true;
 }
 
 ///////////////////////////////////////////////////////////
@@ -128,8 +165,16 @@ void ITextureLoader::loadPixels(GLenum internalFormat, GLenum type)
 		fileHandle_->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
 
 	dataSize_ = fileHandle_->size() - headerSize_;
-	fileHandle_->seek(headerSize_, SEEK_SET);
 
+	// The file stays opened and mapped for as long as the loader exists
+	const unsigned char *mappedData = fileHandle_->mappedData();
+	if (mappedData != nullptr)
+	{
+		pixelsView_ = mappedData + headerSize_;
+		return;
+	}
+
+	fileHandle_->seek(headerSize_, SEEK_SET);
 	pixels_ = nctl::makeUnique<unsigned char[]>(dataSize_);
 	fileHandle_->read(pixels_.get(), dataSize_);
 }
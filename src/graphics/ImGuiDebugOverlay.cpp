@@ -14,6 +14,8 @@
 #endif
 
 #include "RenderStatistics.h"
+#include "TextureCache.h"
+#include "Texture.h"
 #ifdef WITH_LUA
 	#include "LuaStatistics.h"
 #endif
@@ -269,6 +271,7 @@ void ImGuiDebugOverlay::guiWindow()
 		if (appCfg.withScenegraph)
 			guiRenderingSettings();
 		guiWindowSettings();
+		guiTextureCache();
 		guiAudioPlayers();
 		guiInputState();
 		guiRenderDoc();
@@ -627,6 +630,7 @@ void ImGuiDebugOverlay::guiRenderingSettings()
 		Application::RenderingSettings &settings = theApplication().renderingSettings();
 		int minBatchSize = settings.minBatchSize;
 		int maxBatchSize = settings.maxBatchSize;
+		int maxBatchTextures = settings.maxBatchTextures;
 
 		ImGui::Checkbox("Batching", &settings.batchingEnabled);
 		ImGui::SameLine();
@@ -634,9 +638,11 @@ void ImGuiDebugOverlay::guiRenderingSettings()
 		ImGui::SameLine();
 		ImGui::Checkbox("Culling", &settings.cullingEnabled);
 		ImGui::DragIntRange2("Batch size", &minBatchSize, &maxBatchSize, 1.0f, 0, 512);
+		ImGui::SliderInt("Batch textures", &maxBatchTextures, 1, 4);
 
 		settings.minBatchSize = minBatchSize;
 		settings.maxBatchSize = maxBatchSize;
+		settings.maxBatchTextures = maxBatchTextures;
 	}
 }
 
@@ -714,6 +720,32 @@ void ImGuiDebugOverlay::guiWindowSettings()
 #endif
 }
 
+void ImGuiDebugOverlay::guiTextureCache()
+{
+	if (ImGui::CollapsingHeader("Texture Cache"))
+	{
+		TextureCache &textureCache = theApplication().textureCache();
+		const RenderStatistics::CachedTextures &cachedTextures = RenderStatistics::cachedTextures();
+
+		ImGui::Text("Textures: %u (%.2f Kb)", textureCache.numEntries(), textureCache.dataSize() / 1024.0f);
+		ImGui::Text("Hits: %u, Misses: %u, Hit Rate: %.1f%%", cachedTextures.hits, cachedTextures.misses, cachedTextures.hitRate() * 100.0f);
+		ImGui::Text("Evictions: %u", cachedTextures.evictions);
+
+		int memoryBudget = static_cast<int>(textureCache.memoryBudget() / 1024);
+		if (ImGui::InputInt("Memory Budget (Kb)", &memoryBudget, 1024, 16384))
+			textureCache.setMemoryBudget(static_cast<unsigned long>(memoryBudget > 0 ? memoryBudget : 0) * 1024);
+		if (ImGui::Button("Evict Unreferenced"))
+			textureCache.evictUnreferenced();
+
+		for (nctl::StringHashMap<TextureCache::Entry>::ConstIterator i = textureCache.entries().begin(); i != textureCache.entries().end(); ++i)
+		{
+			const Texture &texture = *i.value().texture;
+			ImGui::BulletText("%s: %dx%d, %.2f Kb, %u reference(s)", i.key().data(), texture.width(), texture.height(),
+			                  texture.dataSize() / 1024.0f, i.value().numReferences());
+		}
+	}
+}
+
 void ImGuiDebugOverlay::guiAudioPlayers()
 {
 #ifdef WITH_AUDIO
@@ -723,7 +755,7 @@ void ImGuiDebugOverlay::guiAudioPlayers()
 		ImGui::Text("Listener Gain: %f", theServiceLocator().audioDevice().gain());
 
 		unsigned int numPlayers = theServiceLocator().audioDevice().numPlayers();
-		ImGui::Text("Active Players: %d", numPlayers);
+		ImGui::Text("Active Players: %d (%u virtual)", numPlayers, theServiceLocator().audioDevice().numVirtualPlayers());
 
 		if (numPlayers > 0)
 		{
@@ -750,7 +782,9 @@ void ImGuiDebugOverlay::guiAudioPlayers()
 				ImGui::NewLine();
 
 				ImGui::Text("State: %s", audioPlayerStateToString(player->state()));
+				ImGui::Text("Virtual: %s", player->isVirtual() ? "true" : "false");
 				ImGui::Text("Looping: %s", player->isLooping() ? "true" : "false");
+				ImGui::Text("Priority: %d", player->priority());
 				ImGui::Text("Gain: %f", player->gain());
 				ImGui::Text("Pitch: %f", player->pitch());
 				const Vector3f &pos = player->position();
@@ -1328,6 +1362,7 @@ void ImGuiDebugOverlay::guiTopLeft()
 {
 	const RenderStatistics::VaoPool &vaoPool = RenderStatistics::vaoPool();
 	const RenderStatistics::Textures &textures = RenderStatistics::textures();
+	const RenderStatistics::CachedTextures &cachedTextures = RenderStatistics::cachedTextures();
 	const RenderStatistics::CustomBuffers &customVbos = RenderStatistics::customVBOs();
 	const RenderStatistics::CustomBuffers &customIbos = RenderStatistics::customIBOs();
 	const RenderStatistics::Buffers &vboBuffers = RenderStatistics::buffers(RenderBuffersManager::BufferTypes::ARRAY);
@@ -1352,6 +1387,7 @@ void ImGuiDebugOverlay::guiTopLeft()
 
 		ImGui::Text("%u/%u VAOs (%u reuses, %u bindings)", vaoPool.size, vaoPool.capacity, vaoPool.reuses, vaoPool.bindings);
 		ImGui::Text("%.2f Kb in %u Texture(s)", textures.dataSize / 1024.0f, textures.count);
+		ImGui::Text("%.2f Kb in %u cached Texture(s) (%.1f%% hits)", cachedTextures.dataSize / 1024.0f, cachedTextures.count, cachedTextures.hitRate() * 100.0f);
 		ImGui::Text("%.2f Kb in %u custom VBO(s)", customVbos.dataSize / 1024.0f, customVbos.count);
 		ImGui::Text("%.2f Kb in %u custom IBO(s)", customIbos.dataSize / 1024.0f, customIbos.count);
 		ImGui::Text("%.2f/%lu Kb in %u VBO(s)", vboBuffers.usedSpace / 1024.0f, vboBuffers.size / 1024, vboBuffers.count);
@@ -1455,6 +1491,9 @@ void ImGuiDebugOverlay::guiTopRight()
 				ImGui::SameLine();
 				ImGui::PlotLines("", plotValues_[ValuesType::TOTAL_VERTICES].get(), numValues_, 0, nullptr, 0.0f, FLT_MAX);
 			}
+
+			const RenderStatistics::DrawCalls &drawCalls = RenderStatistics::drawCalls();
+			ImGui::Text("Submitted: %u commands, %uDC issued (%u texture splits)", drawCalls.submitted, allCommands.commands, drawCalls.textureSplits);
 		}
 		ImGui::End();
 	}
@@ -14,14 +14,15 @@ namespace ncine {
 
 Material::Material()
     : isBlendingEnabled_(false), srcBlendingFactor_(GL_SRC_ALPHA), destBlendingFactor_(GL_ONE_MINUS_SRC_ALPHA),
-      shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(nullptr), texture_(nullptr)
+      shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(nullptr), textures_{}
 {
 }
 
 Material::Material(GLShaderProgram *program, GLTexture *texture)
     : isBlendingEnabled_(false), srcBlendingFactor_(GL_SRC_ALPHA), destBlendingFactor_(GL_ONE_MINUS_SRC_ALPHA),
-      shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), texture_(texture)
+      shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), textures_{}
 {
+	textures_[0] = texture;
 	setShaderProgram(program);
 }
 
@@ -78,6 +79,9 @@ void Material::setShaderProgramType(ShaderProgramType shaderProgramType)
 		case ShaderProgramType::BATCHED_TEXTNODES_RED:
 			setShaderProgram(RenderResources::batchedTextnodesRedShaderProgram());
 			break;
+		case ShaderProgramType::BATCHED_SPRITES_MULTITEXTURE:
+			setShaderProgram(RenderResources::batchedSpritesMultiTextureShaderProgram());
+			break;
 		case ShaderProgramType::CUSTOM:
 			break;
 	}
@@ -105,6 +109,7 @@ void Material::setShaderProgramType(ShaderProgramType shaderProgramType)
 			break;
 		case ShaderProgramType::BATCHED_SPRITES:
 		case ShaderProgramType::BATCHED_SPRITES_GRAY:
+		case ShaderProgramType::BATCHED_SPRITES_MULTITEXTURE:
 			// Uniforms data pointer not set at this time
 			break;
 		case ShaderProgramType::BATCHED_MESH_SPRITES:
@@ -160,7 +165,13 @@ void Material::setUniformsDataPointer(GLubyte *dataPointer)
 
 void Material::setTexture(const Texture &texture)
 {
-	texture_ = texture.glTexture_.get();
+	textures_[0] = texture.glTexture_.get();
+}
+
+void Material::setTexture(unsigned int unit, const GLTexture *texture)
+{
+	ASSERT(unit < MaxTextureUnits);
+	textures_[unit] = texture;
 }
 
 ///////////////////////////////////////////////////////////
@@ -169,8 +180,12 @@ void Material::setTexture(const Texture &texture)
 
 void Material::bind()
 {
-	if (texture_)
-		texture_->bind();
+	// Binding the first unit last leaves it as the active one
+	for (int unit = MaxTextureUnits - 1; unit >= 0; unit--)
+	{
+		if (textures_[unit])
+			textures_[unit]->bind(unit);
+	}
 
 	if (shaderProgram_)
 	{
@@ -216,8 +231,8 @@ uint32_t Material::sortKey()
 	uint32_t middle = 0;
 	uint32_t upper = 0;
 
-	if (texture_)
-		lower = static_cast<uint16_t>(texture_->glHandle());
+	if (textures_[0])
+		lower = static_cast<uint16_t>(textures_[0]->glHandle());
 
 	if (shaderProgram_)
 		middle = shaderProgram_->glHandle() << 16;
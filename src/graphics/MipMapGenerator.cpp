@@ -0,0 +1,285 @@
+#include <cmath>
+#include <cstring> // for memcpy()
+#include <nctl/UniquePtr.h>
+#include "MipMapGenerator.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define NCINE_MIPMAPGENERATOR_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+	#define NCINE_MIPMAPGENERATOR_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace ncine {
+
+namespace {
+
+	/// Number of source pixels contributing to a destination one for each direction
+	const int KaiserTaps = 6;
+	/// Half the width of the Kaiser window, in destination pixels
+	const float KaiserHalfWidth = 1.5f;
+	/// Shape parameter of the Kaiser window
+	const float KaiserAlpha = 4.0f;
+
+	/// Zeroth order modified Bessel function of the first kind
+	float besselI0(float x)
+	{
+		float sum = 1.0f;
+		float term = 1.0f;
+		const float halfX2 = (x * x) * 0.25f;
+		for (int k = 1; k < 32 && term > sum * 1e-7f; k++)
+		{
+			term *= halfX2 / static_cast<float>(k * k);
+			sum += term;
+		}
+		return sum;
+	}
+
+	/// Computes the normalized weights of the taps at -2.5, -1.5, -0.5, 0.5, 1.5 and 2.5 source pixels from the center
+	void computeKaiserWeights(float weights[KaiserTaps])
+	{
+		const float Pi = 3.14159265358979f;
+		const float windowScale = 1.0f / besselI0(KaiserAlpha);
+
+		float sum = 0.0f;
+		for (int i = 0; i < KaiserTaps; i++)
+		{
+			// Distance in destination pixels
+			const float t = (static_cast<float>(i) - 2.5f) * 0.5f;
+			const float sinc = sinf(Pi * t) / (Pi * t);
+			const float r = t / KaiserHalfWidth;
+			const float window = (r * r < 1.0f) ? besselI0(KaiserAlpha * sqrtf(1.0f - r * r)) * windowScale : 0.0f;
+			weights[i] = sinc * window;
+			sum += weights[i];
+		}
+
+		for (int i = 0; i < KaiserTaps; i++)
+			weights[i] /= sum;
+	}
+
+	inline int clampIndex(int index, int size)
+	{
+		return (index < 0) ? 0 : ((index >= size) ? size - 1 : index);
+	}
+
+	void downsampleBox(const uint8_t *src, int srcWidth, int srcHeight, unsigned int numChannels, uint8_t *dest)
+	{
+		const int destWidth = MipMapGenerator::levelSize(srcWidth, 1);
+		const int destHeight = MipMapGenerator::levelSize(srcHeight, 1);
+		const unsigned long srcStride = static_cast<unsigned long>(srcWidth) * numChannels;
+
+		for (int y = 0; y < destHeight; y++)
+		{
+			// A single row or column source is averaged with itself
+			const uint8_t *rowA = src + static_cast<unsigned long>(y * 2) * srcStride;
+			const uint8_t *rowB = (srcHeight > 1) ? rowA + srcStride : rowA;
+			uint8_t *destRow = dest + static_cast<unsigned long>(y) * destWidth * numChannels;
+
+			int x = 0;
+			if (numChannels == 4 && srcWidth > 1)
+			{
+#if defined(NCINE_MIPMAPGENERATOR_SSE2)
+				const __m128i zero = _mm_setzero_si128();
+				const __m128i two = _mm_set1_epi16(2);
+				for (; x + 4 <= destWidth; x += 4)
+				{
+					const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rowA + x * 8));
+					const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rowA + x * 8 + 16));
+					const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rowB + x * 8));
+					const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rowB + x * 8 + 16));
+
+					// Vertical sums of source pixels 0-1, 2-3, 4-5 and 6-7
+					const __m128i s01 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+					const __m128i s23 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+					const __m128i s45 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+					const __m128i s67 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+					// Horizontal sums of adjacent pixels, each 64 bits half holds one pixel
+					const __m128i d01 = _mm_add_epi16(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+					const __m128i d23 = _mm_add_epi16(_mm_unpacklo_epi64(s45, s67), _mm_unpackhi_epi64(s45, s67));
+
+					const __m128i r01 = _mm_srli_epi16(_mm_add_epi16(d01, two), 2);
+					const __m128i r23 = _mm_srli_epi16(_mm_add_epi16(d23, two), 2);
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(destRow + x * 4), _mm_packus_epi16(r01, r23));
+				}
+#elif defined(NCINE_MIPMAPGENERATOR_NEON)
+				for (; x + 8 <= destWidth; x += 8)
+				{
+					const uint8x16x4_t a = vld4q_u8(rowA + x * 8);
+					const uint8x16x4_t b = vld4q_u8(rowB + x * 8);
+					uint8x8x4_t result;
+					for (int c = 0; c < 4; c++)
+					{
+						// Pairwise widening adds sum adjacent pixels of the same channel
+						const uint16x8_t sum = vaddq_u16(vpaddlq_u8(a.val[c]), vpaddlq_u8(b.val[c]));
+						result.val[c] = vrshrn_n_u16(sum, 2);
+					}
+					vst4_u8(destRow + x * 4, result);
+				}
+#endif
+			}
+
+			for (; x < destWidth; x++)
+			{
+				const unsigned int x0 = static_cast<unsigned int>(x * 2) * numChannels;
+				const unsigned int x1 = static_cast<unsigned int>(clampIndex(x * 2 + 1, srcWidth)) * numChannels;
+				for (unsigned int c = 0; c < numChannels; c++)
+				{
+					const unsigned int sum = rowA[x0 + c] + rowA[x1 + c] + rowB[x0 + c] + rowB[x1 + c];
+					destRow[x * numChannels + c] = static_cast<uint8_t>((sum + 2) >> 2);
+				}
+			}
+		}
+	}
+
+	/// Filters a row to half its width, the channel count is known at compile time so that sums stay in registers
+	template <unsigned int NumChannels>
+	void kaiserFilterRow(const uint8_t *srcRow, int srcWidth, const float weights[KaiserTaps], float *destRow)
+	{
+		const int destWidth = MipMapGenerator::levelSize(srcWidth, 1);
+
+		int x = 0;
+#if defined(NCINE_MIPMAPGENERATOR_SSE2)
+		if (NumChannels == 4)
+		{
+			// A whole pixel is converted and accumulated in a single register
+			const __m128i zero = _mm_setzero_si128();
+			for (; x < destWidth; x++)
+			{
+				const int firstX = x * 2 - 2;
+				const bool isInterior = (firstX >= 0 && firstX + KaiserTaps <= srcWidth);
+				__m128 sum = _mm_setzero_ps();
+				for (int i = 0; i < KaiserTaps; i++)
+				{
+					const int srcX = isInterior ? firstX + i : clampIndex(firstX + i, srcWidth);
+					int pixel;
+					memcpy(&pixel, srcRow + srcX * 4, sizeof(int));
+					const __m128i channels = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero);
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_cvtepi32_ps(channels), _mm_set1_ps(weights[i])));
+				}
+				_mm_storeu_ps(destRow + x * 4, sum);
+			}
+		}
+#endif
+		for (; x < destWidth; x++)
+		{
+			float sums[NumChannels] = {};
+			const int firstX = x * 2 - 2;
+			// Indices are only clamped near the borders
+			const bool isInterior = (firstX >= 0 && firstX + KaiserTaps <= srcWidth);
+			for (int i = 0; i < KaiserTaps; i++)
+			{
+				const int srcX = isInterior ? firstX + i : clampIndex(firstX + i, srcWidth);
+				const uint8_t *srcPixel = srcRow + srcX * NumChannels;
+				for (unsigned int c = 0; c < NumChannels; c++)
+					sums[c] += weights[i] * srcPixel[c];
+			}
+			for (unsigned int c = 0; c < NumChannels; c++)
+				destRow[x * NumChannels + c] = sums[c];
+		}
+	}
+
+	void downsampleKaiser(const uint8_t *src, int srcWidth, int srcHeight, unsigned int numChannels, uint8_t *dest)
+	{
+		const int destWidth = MipMapGenerator::levelSize(srcWidth, 1);
+		const int destHeight = MipMapGenerator::levelSize(srcHeight, 1);
+		const unsigned long srcStride = static_cast<unsigned long>(srcWidth) * numChannels;
+		const unsigned long tempStride = static_cast<unsigned long>(destWidth) * numChannels;
+
+		float weights[KaiserTaps];
+		computeKaiserWeights(weights);
+
+		void (*filterRow)(const uint8_t *, int, const float *, float *) = nullptr;
+		switch (numChannels)
+		{
+			case 1: filterRow = kaiserFilterRow<1>; break;
+			case 2: filterRow = kaiserFilterRow<2>; break;
+			case 3: filterRow = kaiserFilterRow<3>; break;
+			default: filterRow = kaiserFilterRow<4>; break;
+		}
+
+		// Horizontally filtered rows are kept in a ring, as each destination row only needs six consecutive source ones
+		nctl::UniquePtr<float[]> temp = nctl::makeUnique<float[]>(tempStride * (KaiserTaps + 1));
+		float *sums = temp.get() + tempStride * KaiserTaps;
+		int numFilteredRows = 0;
+
+		for (int y = 0; y < destHeight; y++)
+		{
+			const int lastRow = clampIndex(y * 2 + KaiserTaps / 2, srcHeight);
+			for (; numFilteredRows <= lastRow; numFilteredRows++)
+				filterRow(src + numFilteredRows * srcStride, srcWidth, weights, temp.get() + (numFilteredRows % KaiserTaps) * tempStride);
+
+			for (unsigned long j = 0; j < tempStride; j++)
+				sums[j] = 0.0f;
+			for (int i = 0; i < KaiserTaps; i++)
+			{
+				const float *tempRow = temp.get() + (clampIndex(y * 2 - 2 + i, srcHeight) % KaiserTaps) * tempStride;
+				for (unsigned long j = 0; j < tempStride; j++)
+					sums[j] += weights[i] * tempRow[j];
+			}
+
+			uint8_t *destRow = dest + y * tempStride;
+			for (unsigned long j = 0; j < tempStride; j++)
+			{
+				// The negative lobes can overshoot the valid range
+				const float value = sums[j] + 0.5f;
+				destRow[j] = static_cast<uint8_t>((value <= 0.0f) ? 0 : ((value >= 255.0f) ? 255 : static_cast<int>(value)));
+			}
+		}
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+int MipMapGenerator::numLevels(int width, int height)
+{
+	int maxSize = (width > height) ? width : height;
+	int numLevels = 1;
+	while (maxSize > 1)
+	{
+		maxSize /= 2;
+		numLevels++;
+	}
+	return numLevels;
+}
+
+int MipMapGenerator::levelSize(int baseSize, int level)
+{
+	const int size = baseSize >> level;
+	return (size > 0) ? size : 1;
+}
+
+unsigned long MipMapGenerator::chainDataSize(int width, int height, unsigned int numChannels, int numLevels)
+{
+	unsigned long dataSize = 0;
+	for (int i = 0; i < numLevels; i++)
+		dataSize += static_cast<unsigned long>(levelSize(width, i)) * levelSize(height, i) * numChannels;
+	return dataSize;
+}
+
+void MipMapGenerator::downsample(const uint8_t *src, int srcWidth, int srcHeight, unsigned int numChannels, uint8_t *dest, Filter filter)
+{
+	if (filter == Filter::KAISER)
+		downsampleKaiser(src, srcWidth, srcHeight, numChannels, dest);
+	else
+		downsampleBox(src, srcWidth, srcHeight, numChannels, dest);
+}
+
+void MipMapGenerator::generate(uint8_t *pixels, int width, int height, unsigned int numChannels, int numLevels, Filter filter)
+{
+	uint8_t *level = pixels;
+	for (int i = 1; i < numLevels; i++)
+	{
+		const int levelWidth = levelSize(width, i - 1);
+		const int levelHeight = levelSize(height, i - 1);
+		uint8_t *nextLevel = level + static_cast<unsigned long>(levelWidth) * levelHeight * numChannels;
+		downsample(level, levelWidth, levelHeight, numChannels, nextLevel, filter);
+		level = nextLevel;
+	}
+}
+
+}
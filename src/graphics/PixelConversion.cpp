@@ -0,0 +1,135 @@
+#include "PixelConversion.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define NCINE_PIXELCONVERSION_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+	#define NCINE_PIXELCONVERSION_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace ncine {
+
+namespace {
+
+#ifdef NCINE_PIXELCONVERSION_SSE2
+	/// Swaps the first and the third byte of each 32 bits lane
+	inline __m128i swapLanesRedBlue(__m128i v)
+	{
+		const __m128i greenAlphaMask = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+		const __m128i lowByteMask = _mm_set1_epi32(0x000000FF);
+		const __m128i thirdByteMask = _mm_set1_epi32(0x00FF0000);
+
+		const __m128i ga = _mm_and_si128(v, greenAlphaMask);
+		const __m128i r = _mm_and_si128(_mm_srli_epi32(v, 16), lowByteMask);
+		const __m128i b = _mm_and_si128(_mm_slli_epi32(v, 16), thirdByteMask);
+		return _mm_or_si128(ga, _mm_or_si128(r, b));
+	}
+
+	/// Returns a mask of the bytes of one of the three registers of a 48 bytes block that belong to the specified channel
+	inline __m128i rgbChannelMask(unsigned int registerIndex, unsigned int channel)
+	{
+		alignas(16) uint8_t bytes[16];
+		for (unsigned int i = 0; i < 16; i++)
+			bytes[i] = ((registerIndex * 16 + i) % 3 == channel) ? 0xFF : 0;
+		return _mm_load_si128(reinterpret_cast<const __m128i *>(bytes));
+	}
+
+	/// Swaps the red and blue bytes of the three channel pixels in a register, taking the bytes of split pixels from its neighbours
+	inline __m128i swapRgbRedBlue(__m128i prev, __m128i v, __m128i next, __m128i redMask, __m128i greenMask, __m128i blueMask)
+	{
+		// Red bytes come from two bytes later and blue bytes from two bytes earlier
+		const __m128i fromNext = _mm_or_si128(_mm_srli_si128(v, 2), _mm_slli_si128(next, 14));
+		const __m128i fromPrev = _mm_or_si128(_mm_slli_si128(v, 2), _mm_srli_si128(prev, 14));
+		return _mm_or_si128(_mm_and_si128(redMask, fromNext), _mm_or_si128(_mm_and_si128(blueMask, fromPrev), _mm_and_si128(greenMask, v)));
+	}
+#endif
+
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+PixelConversion::Kernels PixelConversion::kernels()
+{
+#if defined(NCINE_PIXELCONVERSION_SSE2)
+	return Kernels::SSE2;
+#elif defined(NCINE_PIXELCONVERSION_NEON)
+	return Kernels::NEON;
+#else
+	return Kernels::SCALAR;
+#endif
+}
+
+void PixelConversion::swapRedBlue(const uint8_t *src, uint8_t *dest, unsigned int numPixels)
+{
+	unsigned int i = 0;
+
+#if defined(NCINE_PIXELCONVERSION_SSE2)
+	for (; i + 4 <= numPixels; i += 4)
+	{
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i * 4), swapLanesRedBlue(v));
+	}
+#elif defined(NCINE_PIXELCONVERSION_NEON)
+	for (; i + 16 <= numPixels; i += 16)
+	{
+		uint8x16x4_t pixels = vld4q_u8(src + i * 4);
+		const uint8x16_t red = pixels.val[0];
+		pixels.val[0] = pixels.val[2];
+		pixels.val[2] = red;
+		vst4q_u8(dest + i * 4, pixels);
+	}
+#endif
+
+	for (; i < numPixels; i++)
+	{
+		const uint8_t red = src[i * 4 + 0];
+		dest[i * 4 + 0] = src[i * 4 + 2];
+		dest[i * 4 + 1] = src[i * 4 + 1];
+		dest[i * 4 + 2] = red;
+		dest[i * 4 + 3] = src[i * 4 + 3];
+	}
+}
+
+void PixelConversion::swapRedBlueRgb(const uint8_t *src, uint8_t *dest, unsigned int numPixels)
+{
+	unsigned int i = 0;
+
+#if defined(NCINE_PIXELCONVERSION_SSE2)
+	// Sixteen pixels fill three registers, the masks follow the position of the channels in each of them
+	const __m128i redMasks[3] = { rgbChannelMask(0, 0), rgbChannelMask(1, 0), rgbChannelMask(2, 0) };
+	const __m128i greenMasks[3] = { rgbChannelMask(0, 1), rgbChannelMask(1, 1), rgbChannelMask(2, 1) };
+	const __m128i blueMasks[3] = { rgbChannelMask(0, 2), rgbChannelMask(1, 2), rgbChannelMask(2, 2) };
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= numPixels; i += 16)
+	{
+		const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+		const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3 + 16));
+		const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3 + 32));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i * 3), swapRgbRedBlue(zero, v0, v1, redMasks[0], greenMasks[0], blueMasks[0]));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i * 3 + 16), swapRgbRedBlue(v0, v1, v2, redMasks[1], greenMasks[1], blueMasks[1]));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i * 3 + 32), swapRgbRedBlue(v1, v2, zero, redMasks[2], greenMasks[2], blueMasks[2]));
+	}
+#elif defined(NCINE_PIXELCONVERSION_NEON)
+	for (; i + 16 <= numPixels; i += 16)
+	{
+		uint8x16x3_t pixels = vld3q_u8(src + i * 3);
+		const uint8x16_t red = pixels.val[0];
+		pixels.val[0] = pixels.val[2];
+		pixels.val[2] = red;
+		vst3q_u8(dest + i * 3, pixels);
+	}
+#endif
+
+	for (; i < numPixels; i++)
+	{
+		const uint8_t red = src[i * 3 + 0];
+		dest[i * 3 + 0] = src[i * 3 + 2];
+		dest[i * 3 + 1] = src[i * 3 + 1];
+		dest[i * 3 + 2] = red;
+	}
+}
+
+}
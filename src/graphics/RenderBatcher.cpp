@@ -1,5 +1,6 @@
 #include <cstring> // for memcpy()
 #include "RenderBatcher.h"
+#include "RenderStatistics.h"
 #include "RenderResources.h" // TODO: Remove dependency?
 #include "Application.h"
 
@@ -47,7 +48,29 @@ namespace {
 	bool isBatchedSprite(Material::ShaderProgramType type)
 	{
 		return (type == Material::ShaderProgramType::BATCHED_SPRITES ||
-		        type == Material::ShaderProgramType::BATCHED_SPRITES_GRAY);
+		        type == Material::ShaderProgramType::BATCHED_SPRITES_GRAY ||
+		        type == Material::ShaderProgramType::BATCHED_SPRITES_MULTITEXTURE);
+	}
+
+	/// Offset of the texture slot in a sprite instance, in the padding after the `spriteSize` member of the std140 block
+	const unsigned int TextureSlotOffset = sizeof(GLfloat) * (16 + 4 + 4 + 2);
+
+	/// Returns the slot of the texture in the array, adding it if there is still space, or -1 if the array is full
+	int textureSlot(const GLTexture *texture, const GLTexture **slots, unsigned int &numSlots, unsigned int maxSlots)
+	{
+		for (unsigned int i = 0; i < numSlots; i++)
+		{
+			if (slots[i] == texture)
+				return static_cast<int>(i);
+		}
+
+		if (numSlots < maxSlots)
+		{
+			slots[numSlots] = texture;
+			return static_cast<int>(numSlots++);
+		}
+
+		return -1;
 	}
 
 	bool isBatchedMeshSprite(Material::ShaderProgramType type)
@@ -75,6 +98,20 @@ void RenderBatcher::createBatches(const nctl::Array<RenderCommand *> &srcQueue,
 	const unsigned int maxBatchSize = theApplication().renderingSettings().maxBatchSize;
 #endif
 
+	// Sprites using different textures can be batched together up to the number of texture units
+	const IGfxCapabilities &gfxCaps = theServiceLocator().gfxCapabilities();
+	const unsigned int maxTextureUnits = static_cast<unsigned int>(gfxCaps.value(IGfxCapabilities::GLIntValues::MAX_TEXTURE_IMAGE_UNITS));
+	unsigned int maxBatchTextures = theApplication().renderingSettings().maxBatchTextures;
+	if (maxBatchTextures > Material::MaxTextureUnits)
+		maxBatchTextures = Material::MaxTextureUnits;
+	if (maxBatchTextures > maxTextureUnits)
+		maxBatchTextures = maxTextureUnits;
+
+	const GLTexture *batchTextures[Material::MaxTextureUnits];
+	unsigned int numBatchTextures = 0;
+	if (srcQueue.isEmpty() == false)
+		textureSlot(srcQueue[0]->material().texture(), batchTextures, numBatchTextures, maxBatchTextures);
+
 	unsigned int lastSplit = 0;
 
 	for (unsigned int i = 1; i < srcQueue.size(); i++)
@@ -99,8 +136,16 @@ void RenderBatcher::createBatches(const nctl::Array<RenderCommand *> &srcQueue,
 		const bool blendingDiffers = isBlendingEnabled && prevIsBlendingEnabled &&
 		                             (prevSrcBlendingFactor != srcBlendingFactor || prevDestBlendingFactor != destBlendingFactor);
 
+		// A different texture is assigned to a free slot of a multi-texture batch instead of splitting
+		bool textureDiffers = (prevTexture != texture);
+		if (textureDiffers && maxBatchTextures > 1 && type == Material::ShaderProgramType::SPRITE && prevType == type)
+			textureDiffers = (textureSlot(texture, batchTextures, numBatchTextures, maxBatchTextures) < 0);
+
 		// Should split if the shader differs or if it's the same but texture, blending or primitive type aren't
-		const bool shouldSplit = prevType != type || prevTexture != texture || prevPrimitive != primitive || blendingDiffers;
+		const bool shouldSplit = prevType != type || textureDiffers || prevPrimitive != primitive || blendingDiffers;
+		// Splits that sharing a texture atlas page would have avoided
+		if (shouldSplit && prevType == type && prevPrimitive == primitive && blendingDiffers == false)
+			RenderStatistics::addTextureSplit();
 
 		// Also collect the very last command if it can be batched with the previous one
 		unsigned int endSplit = (i == srcQueue.size() - 1 && !shouldSplit) ? i + 1 : i;
@@ -134,6 +179,11 @@ void RenderBatcher::createBatches(const nctl::Array<RenderCommand *> &srcQueue,
 					destQueue.pushBack(srcQueue[j]);
 			}
 			lastSplit = endSplit;
+
+			// The texture slots of the next batch start from the first command after the split
+			numBatchTextures = 0;
+			if (lastSplit < srcQueue.size())
+				textureSlot(srcQueue[lastSplit]->material().texture(), batchTextures, numBatchTextures, maxBatchTextures);
 		}
 	}
 
@@ -176,7 +226,19 @@ RenderCommand *RenderBatcher::collectCommands(
 
 	if (refCommand->material().shaderProgramType() == Material::ShaderProgramType::SPRITE)
 	{
-		batchCommand = retrieveCommandFromPool(Material::ShaderProgramType::BATCHED_SPRITES);
+		// The batcher only groups sprites with different textures if they all fit in the texture slots
+		bool multipleTextures = false;
+		for (nctl::Array<RenderCommand *>::ConstIterator it = start; it != end; ++it)
+		{
+			if ((*it)->material().texture() != refCommand->material().texture())
+			{
+				multipleTextures = true;
+				break;
+			}
+		}
+
+		batchCommand = retrieveCommandFromPool(multipleTextures ? Material::ShaderProgramType::BATCHED_SPRITES_MULTITEXTURE
+		                                                        : Material::ShaderProgramType::BATCHED_SPRITES);
 		singleInstanceBlockSize = (*start)->material().uniformBlock("SpriteBlock")->size();
 	}
 	else if (refCommand->material().shaderProgramType() == Material::ShaderProgramType::SPRITE_GRAY)
@@ -272,8 +334,18 @@ RenderCommand *RenderBatcher::collectCommands(
 	else
 		instancesVertexDataSize -= 2 * (refCommand->geometry().numElementsPerVertex() + 1) * sizeof(GLfloat);
 
+	const bool isMultiTexture = (batchCommand->material().shaderProgramType() == Material::ShaderProgramType::BATCHED_SPRITES_MULTITEXTURE);
 	batchCommand->material().setUniformsDataPointer(acquireMemory(instancesBlockSize));
-	batchCommand->material().uniform("uTexture")->setIntValue(0); // GL_TEXTURE0
+	if (isMultiTexture)
+	{
+		FATAL_ASSERT(singleInstanceBlockSize >= static_cast<int>(TextureSlotOffset + sizeof(GLfloat)));
+		batchCommand->material().uniform("uTexture0")->setIntValue(0); // GL_TEXTURE0
+		batchCommand->material().uniform("uTexture1")->setIntValue(1); // GL_TEXTURE1
+		batchCommand->material().uniform("uTexture2")->setIntValue(2); // GL_TEXTURE2
+		batchCommand->material().uniform("uTexture3")->setIntValue(3); // GL_TEXTURE3
+	}
+	else
+		batchCommand->material().uniform("uTexture")->setIntValue(0); // GL_TEXTURE0
 	batchCommand->material().uniform("projection")->setFloatVector(RenderResources::projectionMatrix().data());
 
 	RenderResources::VertexFormatPos2Tex2Index *destVtx = nullptr;
@@ -288,6 +360,9 @@ RenderCommand *RenderBatcher::collectCommands(
 			destIdx = batchCommand->geometry().acquireIndexPointer(instancesIndicesAmount);
 	}
 
+	const GLTexture *batchTextures[Material::MaxTextureUnits];
+	unsigned int numBatchTextures = 0;
+
 	it = start;
 	unsigned int instancesBlockOffset = 0;
 	unsigned short batchFirstVertexId = 0;
@@ -300,6 +375,13 @@ RenderCommand *RenderBatcher::collectCommands(
 		{
 			const GLUniformBlockCache *singleInstanceBlock = command->material().uniformBlock("SpriteBlock");
 			memcpy(instancesBlock->dataPointer() + instancesBlockOffset, singleInstanceBlock->dataPointer(), singleInstanceBlockSize);
+			if (isMultiTexture)
+			{
+				const int slot = textureSlot(command->material().texture(), batchTextures, numBatchTextures, Material::MaxTextureUnits);
+				FATAL_ASSERT(slot >= 0);
+				const GLfloat slotValue = static_cast<GLfloat>(slot);
+				memcpy(instancesBlock->dataPointer() + instancesBlockOffset + TextureSlotOffset, &slotValue, sizeof(GLfloat));
+			}
 			instancesBlockOffset += singleInstanceBlockSize;
 		}
 		else
@@ -384,7 +466,13 @@ RenderCommand *RenderBatcher::collectCommands(
 			batchCommand->geometry().releaseIndexPointer();
 	}
 
-	batchCommand->material().setTexture(refCommand->material().texture());
+	if (isMultiTexture)
+	{
+		for (unsigned int i = 0; i < Material::MaxTextureUnits; i++)
+			batchCommand->material().setTexture(i, (i < numBatchTextures) ? batchTextures[i] : nullptr);
+	}
+	else
+		batchCommand->material().setTexture(refCommand->material().texture());
 	batchCommand->material().setBlendingEnabled(refCommand->material().isBlendingEnabled());
 	batchCommand->material().setBlendingFactors(refCommand->material().srcBlendingFactor(), refCommand->material().destBlendingFactor());
 	batchCommand->setBatchSize(nextStart - start);
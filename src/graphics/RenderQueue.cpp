@@ -79,6 +79,7 @@ void RenderQueue::draw()
 
 	// Reset all rendering statistics
 	ncine::RenderStatistics::reset();
+	RenderStatistics::addSubmittedCommands(opaqueQueue_.size() + transparentQueue_.size());
 
 	// Sorting the queues with the relevant orders
 	nctl::quicksort(opaqueQueue_.begin(), opaqueQueue_.end(), descendingOrder);
@@ -27,6 +27,7 @@ nctl::UniquePtr<GLShaderProgram> RenderResources::batchedMeshSpritesShaderProgra
 nctl::UniquePtr<GLShaderProgram> RenderResources::batchedMeshSpritesGrayShaderProgram_;
 nctl::UniquePtr<GLShaderProgram> RenderResources::batchedTextnodesRedShaderProgram_;
 nctl::UniquePtr<GLShaderProgram> RenderResources::batchedTextnodesAlphaShaderProgram_;
+nctl::UniquePtr<GLShaderProgram> RenderResources::batchedSpritesMultiTextureShaderProgram_;
 Matrix4x4f RenderResources::projectionMatrix_ = Matrix4x4f::Identity;
 bool RenderResources::projectionHasChanged_ = false;
 bool RenderResources::projectionHasChangedBatching_ = false;
@@ -98,7 +99,8 @@ void RenderResources::create()
 		{ RenderResources::batchedMeshSpritesShaderProgram_, "batched_meshsprites_vs.glsl", "sprite_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS },
 		{ RenderResources::batchedMeshSpritesGrayShaderProgram_, "batched_meshsprites_vs.glsl", "sprite_gray_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS },
 		{ RenderResources::batchedTextnodesAlphaShaderProgram_, "batched_textnodes_vs.glsl", "textnode_alpha_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS },
-		{ RenderResources::batchedTextnodesRedShaderProgram_, "batched_textnodes_vs.glsl", "textnode_red_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS }
+		{ RenderResources::batchedTextnodesRedShaderProgram_, "batched_textnodes_vs.glsl", "textnode_red_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS },
+		{ RenderResources::batchedSpritesMultiTextureShaderProgram_, "batched_sprites_multitexture_vs.glsl", "sprite_multitexture_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS }
 #else
 		// Skipping the initial new line character of the raw string literal
 		{ RenderResources::spriteShaderProgram_, ShaderStrings::sprite_vs + 1, ShaderStrings::sprite_fs + 1, GLShaderProgram::Introspection::ENABLED },
@@ -112,7 +114,8 @@ void RenderResources::create()
 		{ RenderResources::batchedMeshSpritesShaderProgram_, ShaderStrings::batched_meshsprites_vs + 1, ShaderStrings::sprite_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS },
 		{ RenderResources::batchedMeshSpritesGrayShaderProgram_, ShaderStrings::batched_meshsprites_vs + 1, ShaderStrings::sprite_gray_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS },
 		{ RenderResources::batchedTextnodesAlphaShaderProgram_, ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_alpha_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS },
-		{ RenderResources::batchedTextnodesRedShaderProgram_, ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_red_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS }
+		{ RenderResources::batchedTextnodesRedShaderProgram_, ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_red_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS },
+		{ RenderResources::batchedSpritesMultiTextureShaderProgram_, ShaderStrings::batched_sprites_multitexture_vs + 1, ShaderStrings::sprite_multitexture_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS }
 #endif
 	};
 
@@ -148,6 +151,7 @@ void RenderResources::create()
 
 void RenderResources::dispose()
 {
+	batchedSpritesMultiTextureShaderProgram_.reset(nullptr);
 	batchedTextnodesRedShaderProgram_.reset(nullptr);
 	batchedTextnodesAlphaShaderProgram_.reset(nullptr);
 	batchedMeshSpritesGrayShaderProgram_.reset(nullptr);
@@ -12,6 +12,8 @@ RenderStatistics::Commands RenderStatistics::allCommands_;
 RenderStatistics::Commands RenderStatistics::typedCommands_[RenderCommand::CommandTypes::COUNT];
 RenderStatistics::Buffers RenderStatistics::typedBuffers_[RenderBuffersManager::BufferTypes::COUNT];
 RenderStatistics::Textures RenderStatistics::textures_;
+RenderStatistics::CachedTextures RenderStatistics::cachedTextures_;
+RenderStatistics::DrawCalls RenderStatistics::drawCalls_;
 RenderStatistics::CustomBuffers RenderStatistics::customVbos_;
 RenderStatistics::CustomBuffers RenderStatistics::customIbos_;
 unsigned int RenderStatistics::index_ = 0;
@@ -30,6 +32,7 @@ void RenderStatistics::reset()
 	for (unsigned int i = 0; i < RenderCommand::CommandTypes::COUNT; i++)
 		typedCommands_[i].reset();
 	allCommands_.reset();
+	drawCalls_.reset();
 
 	for (unsigned int i = 0; i < RenderBuffersManager::BufferTypes::COUNT; i++)
 		typedBuffers_[i].reset();
@@ -0,0 +1,345 @@
+#define NCINE_INCLUDE_OPENGL
+#include "common_headers.h"
+#include "common_macros.h"
+#include <cstring> // for memcpy()
+#include <nctl/String.h>
+#include <nctl/Atomic.h>
+#include "ScreenCapture.h"
+#include "Application.h"
+#include "Texture.h"
+#include "GLTexture.h"
+#include "GLBufferObject.h"
+#include "GLFramebufferObject.h"
+#include "IThreadPool.h"
+#include "FileSystem.h"
+#include "ITextureSaver.h"
+#ifdef WITH_PNG
+	#include "TextureSaverPng.h"
+#endif
+#ifdef WITH_WEBP
+	#include "TextureSaverWebP.h"
+#endif
+#include "tracy.h"
+
+namespace ncine {
+
+struct ScreenCapture::Request
+{
+	enum class State
+	{
+		/// The screen will be read back at the end of the frame
+		WAITING_FRAME,
+		/// The pixels are being transferred to the buffer object
+		READING,
+		/// The pixels have been copied and the image is being encoded and saved
+		ENCODING
+	};
+
+	explicit Request(const char *name)
+	    : filename(name), state(State::WAITING_FRAME), isWebP(false), isOpaque(false), width(0), height(0),
+	      callback(nullptr), userData(nullptr), fence(nullptr), success(false), isSaved(0) {}
+
+	nctl::String filename;
+	State state;
+	bool isWebP;
+	/// Screen captures discard the alpha channel of the framebuffer
+	bool isOpaque;
+	int width;
+	int height;
+	CompletionCallback callback;
+	void *userData;
+	/// The pixel buffer object receiving the readback, released when the pixels are copied out
+	nctl::UniquePtr<GLBufferObject> pixelBuffer;
+	GLsync fence;
+	/// Top to bottom RGBA pixels, written by the main thread before the encoding starts
+	nctl::UniquePtr<uint8_t[]> pixels;
+	/// The result of the saving, written by the worker thread
+	bool success;
+	/// Set by the worker thread when the file has been saved or has failed
+	nctl::Atomic32 isSaved;
+};
+
+namespace {
+
+	/// Issues an asynchronous read of the bound read framebuffer into a new pixel buffer object
+	nctl::UniquePtr<GLBufferObject> readPixelsToBuffer(int width, int height, GLsync &fence)
+	{
+		const GLsizeiptr dataSize = static_cast<GLsizeiptr>(width) * height * 4;
+		nctl::UniquePtr<GLBufferObject> pixelBuffer = nctl::makeUnique<GLBufferObject>(GL_PIXEL_PACK_BUFFER);
+		pixelBuffer->bufferData(dataSize, nullptr, GL_STREAM_READ);
+
+		// With a pixel pack buffer bound the last parameter is an offset and the call does not wait for the GPU
+		pixelBuffer->bind();
+		glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		pixelBuffer->unbind();
+		fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		return pixelBuffer;
+	}
+
+	bool saveImage(const ITextureSaver::Properties &properties, const nctl::String &filename, bool isWebP)
+	{
+#ifdef WITH_WEBP
+		if (isWebP)
+		{
+			TextureSaverWebP saver;
+			return saver.saveToFile(properties, filename.data());
+		}
+#endif
+#ifdef WITH_PNG
+		if (isWebP == false)
+		{
+			TextureSaverPng saver;
+			return saver.saveToFile(properties, filename.data());
+		}
+#endif
+		return false;
+	}
+
+}
+
+/// A thread pool command that encodes and saves a captured image
+class ScreenCapture::EncodeImageCommand : public IThreadCommand
+{
+  public:
+	explicit EncodeImageCommand(const nctl::SharedPtr<Request> &request)
+	    : request_(request) {}
+
+	void execute() override
+	{
+		ZoneScopedN("Encode capture");
+		ITextureSaver::Properties properties;
+		properties.width = request_->width;
+		properties.height = request_->height;
+		properties.format = ITextureSaver::Format::RGBA8;
+		properties.pixels = request_->pixels.get();
+
+		// Pixels are missing if the buffer object could not be mapped
+		request_->success = (request_->pixels != nullptr) ? saveImage(properties, request_->filename, request_->isWebP) : false;
+		request_->pixels.reset(nullptr);
+		request_->isSaved.store(1, nctl::Atomic32::MemoryModel::RELEASE);
+	}
+
+  private:
+	nctl::SharedPtr<Request> request_;
+};
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+ScreenCapture::ScreenCapture(bool withThreadPool)
+    : withThreadPool_(withThreadPool), maxPendingCaptures_(DefaultMaxPendingCaptures), requests_(DefaultMaxPendingCaptures)
+{
+}
+
+/*! \note Readbacks still in flight are completed and saved without invoking their callbacks,
+ * the ones that are being encoded are left to the thread pool */
+ScreenCapture::~ScreenCapture()
+{
+	for (nctl::SharedPtr<Request> &request : requests_)
+	{
+		if (request->state == Request::State::READING)
+		{
+			collectPixels(*request, true);
+			EncodeImageCommand(request).execute();
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool ScreenCapture::captureScreen(const char *filename)
+{
+	return captureScreen(filename, nullptr, nullptr);
+}
+
+bool ScreenCapture::captureScreen(const char *filename, CompletionCallback callback, void *userData)
+{
+	Request *request = createRequest(filename, callback, userData);
+	if (request == nullptr)
+		return false;
+
+	request->isOpaque = true;
+	return true;
+}
+
+bool ScreenCapture::captureTexture(Texture &texture, const char *filename)
+{
+	return captureTexture(texture, filename, nullptr, nullptr);
+}
+
+bool ScreenCapture::captureTexture(Texture &texture, const char *filename, CompletionCallback callback, void *userData)
+{
+	ZoneScoped;
+	if (texture.isCompressed())
+	{
+		LOGE_X("Texture \"%s\" is compressed and cannot be captured", texture.name());
+		return false;
+	}
+
+	Request *request = createRequest(filename, callback, userData);
+	if (request == nullptr)
+		return false;
+
+	GLFramebufferObject fbo;
+	fbo.attachTexture(*texture.glTexture_, GL_COLOR_ATTACHMENT0);
+	if (fbo.isStatusComplete() == false)
+	{
+		LOGE_X("Texture \"%s\" cannot be attached to a framebuffer to be captured", texture.name());
+		fbo.unbind();
+		requests_.popBack();
+		return false;
+	}
+
+	// The texture content is read now, as it could change or be destroyed before the end of the frame
+	request->width = texture.width();
+	request->height = texture.height();
+	request->pixelBuffer = readPixelsToBuffer(request->width, request->height, request->fence);
+	request->state = Request::State::READING;
+	fbo.unbind();
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+ScreenCapture::Request *ScreenCapture::createRequest(const char *filename, CompletionCallback callback, void *userData)
+{
+	if (requests_.size() >= maxPendingCaptures_)
+	{
+		LOGW_X("Capture \"%s\" refused, %u captures are already pending", filename, requests_.size());
+		return nullptr;
+	}
+
+	bool isSupported = false;
+	bool isWebP = false;
+#ifdef WITH_PNG
+	if (fs::hasExtension(filename, "png"))
+		isSupported = true;
+#endif
+#ifdef WITH_WEBP
+	if (fs::hasExtension(filename, "webp"))
+	{
+		isSupported = true;
+		isWebP = true;
+	}
+#endif
+	if (isSupported == false)
+	{
+		LOGE_X("Capture \"%s\" has an extension that does not match any available image format", filename);
+		return nullptr;
+	}
+
+	nctl::SharedPtr<Request> request = nctl::makeShared<Request>(filename);
+	request->isWebP = isWebP;
+	request->callback = callback;
+	request->userData = userData;
+	requests_.pushBack(request);
+
+	return request.get();
+}
+
+void ScreenCapture::update()
+{
+	if (requests_.isEmpty())
+		return;
+
+	ZoneScoped;
+	for (nctl::SharedPtr<Request> &request : requests_)
+	{
+		if (request->state == Request::State::WAITING_FRAME)
+		{
+			request->width = theApplication().widthInt();
+			request->height = theApplication().heightInt();
+			request->pixelBuffer = readPixelsToBuffer(request->width, request->height, request->fence);
+			request->state = Request::State::READING;
+		}
+		else if (request->state == Request::State::READING && collectPixels(*request, false))
+		{
+			request->state = Request::State::ENCODING;
+			encode(request);
+		}
+	}
+
+	unsigned int index = 0;
+	while (index < requests_.size())
+	{
+		Request &request = *requests_[index];
+		if (request.state != Request::State::ENCODING || request.isSaved.load(nctl::Atomic32::MemoryModel::ACQUIRE) == 0)
+		{
+			index++;
+			continue;
+		}
+
+		if (request.success == false)
+			LOGW_X("Capture \"%s\" cannot be saved", request.filename.data());
+		if (request.callback)
+			request.callback(request.filename.data(), request.success, request.userData);
+		requests_.removeAt(index);
+	}
+}
+
+bool ScreenCapture::collectPixels(Request &request, bool wait)
+{
+	ASSERT(request.state == Request::State::READING);
+
+	// Polling does not block, the fence is checked again at the end of the next frame
+	const GLuint64 timeout = wait ? 1000000000ULL : 0;
+	const GLenum status = glClientWaitSync(request.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout);
+	if (status == GL_TIMEOUT_EXPIRED && wait == false)
+		return false;
+	glDeleteSync(request.fence);
+	request.fence = nullptr;
+
+	ZoneScoped;
+	const unsigned long rowSize = static_cast<unsigned long>(request.width) * 4;
+	const unsigned long dataSize = rowSize * request.height;
+	request.pixels = nctl::makeUnique<uint8_t[]>(dataSize);
+
+	// Rows are flipped while copying, as OpenGL reads them from the bottom one
+#ifdef __EMSCRIPTEN__
+	// Buffer objects cannot be mapped for reading in WebGL
+	nctl::UniquePtr<uint8_t[]> bufferPixels = nctl::makeUnique<uint8_t[]>(dataSize);
+	request.pixelBuffer->getBufferSubData(0, dataSize, bufferPixels.get());
+	const uint8_t *mappedPixels = bufferPixels.get();
+#else
+	const uint8_t *mappedPixels = static_cast<const uint8_t *>(request.pixelBuffer->mapBufferRange(0, dataSize, GL_MAP_READ_BIT));
+#endif
+	if (mappedPixels != nullptr)
+	{
+		for (int y = 0; y < request.height; y++)
+			memcpy(request.pixels.get() + y * rowSize, mappedPixels + (request.height - 1 - y) * rowSize, rowSize);
+
+		if (request.isOpaque)
+		{
+			for (unsigned long i = 3; i < dataSize; i += 4)
+				request.pixels[i] = 255;
+		}
+#ifndef __EMSCRIPTEN__
+		request.pixelBuffer->unmap();
+#endif
+	}
+	else
+	{
+		LOGE_X("Pixels of capture \"%s\" cannot be mapped", request.filename.data());
+		request.pixels.reset(nullptr);
+	}
+	request.pixelBuffer.reset(nullptr);
+
+	return true;
+}
+
+void ScreenCapture::encode(const nctl::SharedPtr<Request> &request)
+{
+	if (withThreadPool_)
+		theServiceLocator().threadPool().enqueueCommand(nctl::makeUnique<EncodeImageCommand>(request));
+	else
+		EncodeImageCommand(request).execute();
+}
+
+}
@@ -0,0 +1,121 @@
+#include "common_macros.h"
+#include "SkylinePacker.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+SkylinePacker::SkylinePacker(int width, int height)
+    : width_(width), height_(height), numRects_(0), usedArea_(0), skyline_(16)
+{
+	FATAL_ASSERT(width > 0 && height > 0);
+	skyline_.emplaceBack(0, 0, width_);
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool SkylinePacker::insert(int width, int height, Recti &rect)
+{
+	if (width <= 0 || height <= 0)
+		return false;
+
+	int bestIndex = -1;
+	int bestY = height_;
+	int bestWidth = width_;
+	for (unsigned int i = 0; i < skyline_.size(); i++)
+	{
+		const int y = fitsAt(i, width, height);
+		// The lowest position wins, ties are broken by the narrowest segment to reduce waste
+		if (y >= 0 && (y < bestY || (y == bestY && skyline_[i].width < bestWidth)))
+		{
+			bestIndex = static_cast<int>(i);
+			bestY = y;
+			bestWidth = skyline_[i].width;
+		}
+	}
+
+	if (bestIndex < 0)
+		return false;
+
+	rect.set(skyline_[bestIndex].x, bestY, width, height);
+	addSegment(static_cast<unsigned int>(bestIndex), rect);
+	numRects_++;
+	usedArea_ += static_cast<unsigned long>(width) * height;
+
+	return true;
+}
+
+void SkylinePacker::clear()
+{
+	skyline_.clear();
+	skyline_.emplaceBack(0, 0, width_);
+	numRects_ = 0;
+	usedArea_ = 0;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+int SkylinePacker::fitsAt(unsigned int index, int width, int height) const
+{
+	if (skyline_[index].x + width > width_)
+		return -1;
+
+	int y = skyline_[index].y;
+	int widthLeft = width;
+	// The segments covered by the rectangle always exist as the skyline spans the whole width
+	while (widthLeft > 0)
+	{
+		if (skyline_[index].y > y)
+			y = skyline_[index].y;
+		if (y + height > height_)
+			return -1;
+		widthLeft -= skyline_[index].width;
+		index++;
+	}
+
+	return y;
+}
+
+void SkylinePacker::addSegment(unsigned int index, const Recti &rect)
+{
+	skyline_.insertAt(index, Segment(rect.x, rect.y + rect.h, rect.w));
+
+	// Shrinking or removing the segments covered by the new one
+	unsigned int i = index + 1;
+	while (i < skyline_.size())
+	{
+		const Segment &prev = skyline_[i - 1];
+		Segment &segment = skyline_[i];
+		const int prevEnd = prev.x + prev.width;
+		if (segment.x >= prevEnd)
+			break;
+
+		const int shrink = prevEnd - segment.x;
+		segment.x += shrink;
+		segment.width -= shrink;
+		if (segment.width > 0)
+			break;
+		skyline_.removeAt(i);
+	}
+
+	// Merging adjacent segments at the same height
+	i = 1;
+	while (i < skyline_.size())
+	{
+		if (skyline_[i - 1].y == skyline_[i].y)
+		{
+			skyline_[i - 1].width += skyline_[i].width;
+			skyline_.removeAt(i);
+		}
+		else
+			i++;
+	}
+}
+
+}
@@ -1,4 +1,5 @@
 #include "Sprite.h"
+#include "TextureAtlas.h"
 #include "RenderCommand.h"
 #include "tracy.h"
 
@@ -59,4 +60,17 @@ Sprite::Sprite(Texture *texture, const Vector2f &position)
 {
 }
 
+/*! \note The initial layer value for a sprite is `DrawableNode::SCENE_LAYER` */
+Sprite::Sprite(SceneNode *parent, const TextureRegion &region)
+    : Sprite(parent, region, 0.0f, 0.0f)
+{
+}
+
+/*! \note The initial layer value for a sprite is `DrawableNode::SCENE_LAYER` */
+Sprite::Sprite(SceneNode *parent, const TextureRegion &region, float xx, float yy)
+    : Sprite(parent, region.texture, xx, yy)
+{
+	setTexRect(region.rect);
+}
+
 }
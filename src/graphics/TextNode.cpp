@@ -24,6 +24,7 @@ TextNode::TextNode(SceneNode *parent, Font *font, unsigned int maxStringLength)
       lineHeight_(font ? font->lineHeight() : 0.0f), textnodeBlock_(nullptr)
 {
 	ASSERT(font);
+	ASSERT_MSG(font->texture() != nullptr, "A font without a texture cannot be rendered");
 	ASSERT(maxStringLength > 0);
 
 	type_ = ObjectType::TEXTNODE;
@@ -72,6 +73,7 @@ void TextNode::setFont(Font *font)
 {
 	if (font && font != font_)
 	{
+		ASSERT_MSG(font->texture() != nullptr, "A font without a texture cannot be rendered");
 		// Keep the ratio between text node lineHeight and font one
 		lineHeight_ = (lineHeight_ / font_->lineHeight()) * font->lineHeight();
 
@@ -176,7 +178,7 @@ void TextNode::draw(RenderQueue &renderQueue)
 						{
 							unsigned int nextCodepoint = nctl::String::InvalidUnicode;
 							string_.utf8ToCodePoint(i + codePointLength, nextCodepoint);
-							xAdvance_ += glyph->kerning(nextCodepoint);
+							xAdvance_ += font_->kerning(codepoint, nextCodepoint);
 						}
 					}
 				}
@@ -236,7 +238,7 @@ void TextNode::calculateBoundaries() const
 						{
 							unsigned int nextCodepoint = nctl::String::InvalidUnicode;
 							string_.utf8ToCodePoint(i + codePointLength, nextCodepoint);
-							xAdvance_ += glyph->kerning(nextCodepoint);
+							xAdvance_ += font_->kerning(codepoint, nextCodepoint);
 						}
 					}
 				}
@@ -7,6 +7,10 @@
 #include "ITextureLoader.h"
 #include "GLTexture.h"
 #include "RenderStatistics.h"
+#include "Application.h"
+#include "AsyncTextureLoader.h"
+#include "Color.h"
+#include "Colorf.h"
 #include "tracy.h"
 
 namespace ncine {
@@ -22,7 +26,7 @@ Texture::Texture(const char *bufferName, const unsigned char *bufferPtr, unsigne
 
 Texture::Texture(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize, int width, int height)
     : Object(ObjectType::TEXTURE, bufferName), glTexture_(nctl::makeUnique<GLTexture>(GL_TEXTURE_2D)),
-      width_(0), height_(0), mipMapLevels_(1), isCompressed_(false), numChannels_(0), dataSize_(0),
+      width_(0), height_(0), mipMapLevels_(1), isCompressed_(false), numChannels_(0), dataSize_(0), loadingState_(LoadingState::LOADED),
       minFiltering_(Filtering::NEAREST), magFiltering_(Filtering::NEAREST), wrapMode_(Wrap::CLAMP_TO_EDGE)
 {
 	ZoneScoped;
@@ -48,7 +52,7 @@ Texture::Texture(const char *filename)
 
 Texture::Texture(const char *filename, int width, int height)
     : Object(ObjectType::TEXTURE, filename), glTexture_(nctl::makeUnique<GLTexture>(GL_TEXTURE_2D)),
-      width_(0), height_(0), mipMapLevels_(1), isCompressed_(false), numChannels_(0), dataSize_(0),
+      width_(0), height_(0), mipMapLevels_(1), isCompressed_(false), numChannels_(0), dataSize_(0), loadingState_(LoadingState::LOADED),
       minFiltering_(Filtering::NEAREST), magFiltering_(Filtering::NEAREST), wrapMode_(Wrap::CLAMP_TO_EDGE)
 {
 	ZoneScoped;
@@ -74,7 +78,7 @@ Texture::Texture(const TextureData &texData)
 
 Texture::Texture(const TextureData &texData, int width, int height)
     : Object(ObjectType::TEXTURE, texData.filename()), glTexture_(nctl::makeUnique<GLTexture>(GL_TEXTURE_2D)),
-      width_(0), height_(0), mipMapLevels_(1), isCompressed_(false), numChannels_(0), dataSize_(0),
+      width_(0), height_(0), mipMapLevels_(1), isCompressed_(false), numChannels_(0), dataSize_(0), loadingState_(LoadingState::LOADED),
       minFiltering_(Filtering::NEAREST), magFiltering_(Filtering::NEAREST), wrapMode_(Wrap::CLAMP_TO_EDGE)
 {
 	FATAL_ASSERT(texData.isValid());
@@ -95,8 +99,52 @@ Texture::Texture(const TextureData &texData, Vector2i size)
 {
 }
 
+/*! \note The single pixel texture is created with a mutable storage so that it can be specified again with the decoded content */
+Texture::Texture(const char *filename, const Colorf &placeholderColor)
+    : Object(ObjectType::TEXTURE, filename), glTexture_(nctl::makeUnique<GLTexture>(GL_TEXTURE_2D)),
+      width_(1), height_(1), mipMapLevels_(1), isCompressed_(false), numChannels_(4), dataSize_(4), loadingState_(LoadingState::PENDING),
+      minFiltering_(Filtering::NEAREST), magFiltering_(Filtering::NEAREST), wrapMode_(Wrap::CLAMP_TO_EDGE)
+{
+	ZoneScoped;
+	ZoneText(filename, nctl::strnlen(filename, nctl::String::MaxCStringLength));
+	glTexture_->bind();
+	setGLTextureLabel(filename);
+
+	glTexture_->texParameteri(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexture_->texParameteri(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexture_->texParameteri(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexture_->texParameteri(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	const Color color(placeholderColor);
+	glTexture_->texImage2D(0, GL_RGBA, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, color.data());
+
+	RenderStatistics::addTexture(dataSize_);
+}
+
+/*! \note The pixels are tightly packed RGBA with eight bits per channel */
+Texture::Texture(const char *name, int width, int height, const unsigned char *rgbaPixels)
+    : Object(ObjectType::TEXTURE, name), glTexture_(nctl::makeUnique<GLTexture>(GL_TEXTURE_2D)),
+      width_(width), height_(height), mipMapLevels_(1), isCompressed_(false), numChannels_(4), dataSize_(static_cast<unsigned long>(width) * height * 4),
+      loadingState_(LoadingState::LOADED), minFiltering_(Filtering::LINEAR), magFiltering_(Filtering::LINEAR), wrapMode_(Wrap::CLAMP_TO_EDGE)
+{
+	ZoneScoped;
+	ZoneText(name, nctl::strnlen(name, nctl::String::MaxCStringLength));
+	glTexture_->bind();
+	setGLTextureLabel(name);
+
+	glTexture_->texParameteri(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexture_->texParameteri(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexture_->texParameteri(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexture_->texParameteri(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexture_->texImage2D(0, GL_RGBA8, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgbaPixels);
+
+	RenderStatistics::addTexture(dataSize_);
+}
+
 Texture::~Texture()
 {
+	if (loadingState_ == LoadingState::PENDING)
+		theApplication().asyncTextureLoader().cancel(this);
+
 	RenderStatistics::removeTexture(dataSize_);
 }
 
@@ -216,6 +264,11 @@ void Texture::load(const ITextureLoader &texLoader, int width, int height)
 	const bool withTexStorage = gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_TEXTURE_STORAGE);
 #endif
 
+	// Rows of pixels with less than four bytes, like RGB8 ones, are tightly packed and not aligned to four bytes
+	const bool isUnaligned = (texFormat.isCompressed() == false && texLoader.bpp() % 4 != 0);
+	if (isUnaligned)
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
 	if (withTexStorage)
 		glTexture_->texStorage2D(texLoader.mipMapCount(), texFormat.internalFormat(), width, height);
 	for (int i = 0; i < texLoader.mipMapCount(); i++)
@@ -235,10 +288,13 @@ void Texture::load(const ITextureLoader &texLoader, int width, int height)
 				glTexture_->texImage2D(i, texFormat.internalFormat(), levelWidth, levelHeight, texFormat.format(), texFormat.type(), texLoader.pixels(i));
 		}
 
-		levelWidth /= 2;
-		levelHeight /= 2;
+		levelWidth = (levelWidth > 1) ? levelWidth / 2 : 1;
+		levelHeight = (levelHeight > 1) ? levelHeight / 2 : 1;
 	}
 
+	if (isUnaligned)
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
 	width_ = width;
 	height_ = height;
 	mipMapLevels_ = texLoader.mipMapCount();
@@ -247,6 +303,23 @@ void Texture::load(const ITextureLoader &texLoader, int width, int height)
 	dataSize_ = texLoader.dataSize();
 }
 
+void Texture::completeAsyncLoad(const ITextureLoader *texLoader)
+{
+	ZoneScoped;
+	if (texLoader == nullptr)
+	{
+		loadingState_ = LoadingState::FAILED;
+		return;
+	}
+
+	ZoneText(texLoader->filename(), nctl::strnlen(texLoader->filename(), nctl::String::MaxCStringLength));
+	RenderStatistics::removeTexture(dataSize_);
+	glTexture_->bind();
+	load(*texLoader, 0, 0);
+	RenderStatistics::addTexture(dataSize_);
+	loadingState_ = LoadingState::LOADED;
+}
+
 void Texture::setGLTextureLabel(const char *filename)
 {
 	glTexture_->setObjectLabel(filename);
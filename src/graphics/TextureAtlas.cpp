@@ -0,0 +1,263 @@
+#define NCINE_INCLUDE_OPENGL
+#include "common_headers.h"
+#include "common_macros.h"
+#include "return_macros.h"
+#include <cstring> // for memset() and memcpy()
+#include <nctl/algorithms.h>
+#include "TextureAtlas.h"
+#include "SkylinePacker.h"
+#include "Texture.h"
+#include "ITextureLoader.h"
+#include "IGfxCapabilities.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+
+	/// Copies an image with one to four channels to an RGBA page
+	void blitToRgba(const ITextureLoader &texLoader, unsigned char *page, int pageWidth, const Recti &rect)
+	{
+		const unsigned int numChannels = texLoader.texFormat().numChannels();
+		const unsigned long srcStride = texLoader.dataSize(0) / texLoader.height();
+		const GLubyte *srcPixels = texLoader.pixels(0);
+
+		for (int y = 0; y < rect.h; y++)
+		{
+			const GLubyte *src = srcPixels + y * srcStride;
+			unsigned char *dest = page + ((rect.y + y) * pageWidth + rect.x) * 4;
+			for (int x = 0; x < rect.w; x++)
+			{
+				switch (numChannels)
+				{
+					case 1: // luminance
+						dest[0] = src[0];
+						dest[1] = src[0];
+						dest[2] = src[0];
+						dest[3] = 255;
+						break;
+					case 2: // luminance and alpha
+						dest[0] = src[0];
+						dest[1] = src[0];
+						dest[2] = src[0];
+						dest[3] = src[1];
+						break;
+					case 3:
+						dest[0] = src[0];
+						dest[1] = src[1];
+						dest[2] = src[2];
+						dest[3] = 255;
+						break;
+					default:
+						dest[0] = src[0];
+						dest[1] = src[1];
+						dest[2] = src[2];
+						dest[3] = src[3];
+						break;
+				}
+				src += numChannels;
+				dest += 4;
+			}
+		}
+	}
+
+	/// Replicates the border pixels of an image in the RGBA page into its padding, so that linear filtering does not sample other texels
+	void extrudeBorders(unsigned char *page, int pageWidth, const Recti &rect, int padding)
+	{
+		const unsigned long pageStride = static_cast<unsigned long>(pageWidth) * 4;
+		for (int y = 0; y < rect.h; y++)
+		{
+			unsigned char *row = page + (rect.y + y) * pageStride;
+			const unsigned char *first = row + rect.x * 4;
+			const unsigned char *last = row + (rect.x + rect.w - 1) * 4;
+			for (int i = 1; i <= padding; i++)
+			{
+				memcpy(row + (rect.x - i) * 4, first, 4);
+				memcpy(row + (rect.x + rect.w - 1 + i) * 4, last, 4);
+			}
+		}
+
+		// The padded rows include the extruded corners
+		const unsigned long paddedRowSize = static_cast<unsigned long>(rect.w + padding * 2) * 4;
+		const unsigned char *firstRow = page + rect.y * pageStride + (rect.x - padding) * 4;
+		const unsigned char *lastRow = page + (rect.y + rect.h - 1) * pageStride + (rect.x - padding) * 4;
+		for (int i = 1; i <= padding; i++)
+		{
+			memcpy(page + (rect.y - i) * pageStride + (rect.x - padding) * 4, firstRow, paddedRowSize);
+			memcpy(page + (rect.y + rect.h - 1 + i) * pageStride + (rect.x - padding) * 4, lastRow, paddedRowSize);
+		}
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+TextureAtlas::TextureAtlas()
+    : TextureAtlas(DefaultPageSize, DefaultPageSize)
+{
+}
+
+TextureAtlas::TextureAtlas(int pageWidth, int pageHeight)
+    : pageWidth_(pageWidth), pageHeight_(pageHeight), padding_(1), images_(16), imageIndices_(InitialCapacity), pages_(1)
+{
+	const IGfxCapabilities &gfxCaps = theServiceLocator().gfxCapabilities();
+	const int maxTextureSize = gfxCaps.value(IGfxCapabilities::GLIntValues::MAX_TEXTURE_SIZE);
+	if (maxTextureSize > 0)
+	{
+		pageWidth_ = (pageWidth_ <= maxTextureSize) ? pageWidth_ : maxTextureSize;
+		pageHeight_ = (pageHeight_ <= maxTextureSize) ? pageHeight_ : maxTextureSize;
+	}
+	FATAL_ASSERT(pageWidth_ > 0 && pageHeight_ > 0);
+}
+
+TextureAtlas::~TextureAtlas()
+{
+	// Defined to solve deletion of incomplete type pointer (forward declared class)
+}
+
+TextureAtlas::Image::Image()
+    : pageIndex(0)
+{
+}
+
+TextureAtlas::Image::~Image()
+{
+	// Defined to solve deletion of incomplete type pointer (forward declared class)
+}
+
+TextureAtlas::Image::Image(Image &&) = default;
+
+TextureAtlas::Image &TextureAtlas::Image::operator=(Image &&) = default;
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+int TextureAtlas::addImage(const char *filename)
+{
+	return addDecodedImage(filename, ITextureLoader::createFromFile(filename));
+}
+
+int TextureAtlas::addImage(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize)
+{
+	return addDecodedImage(bufferName, ITextureLoader::createFromMemory(bufferName, bufferPtr, bufferSize));
+}
+
+bool TextureAtlas::build()
+{
+	ZoneScoped;
+	RETURNF_ASSERT_MSG(isBuilt() == false, "The texture atlas has already been built");
+	// An atlas without pages would not be reported as built
+	RETURNF_ASSERT_MSG(images_.isEmpty() == false, "The texture atlas has no images to pack");
+
+	// Packing from the tallest image to the shortest one gives flatter skylines
+	nctl::Array<unsigned int> order(images_.size());
+	for (unsigned int i = 0; i < images_.size(); i++)
+		order.pushBack(i);
+	nctl::quicksort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+		return images_[a].texLoader->height() > images_[b].texLoader->height();
+	});
+
+	nctl::Array<SkylinePacker> packers(1);
+	for (unsigned int i = 0; i < order.size(); i++)
+	{
+		Image &image = images_[order[i]];
+		const int width = image.texLoader->width() + padding_ * 2;
+		const int height = image.texLoader->height() + padding_ * 2;
+
+		Recti rect;
+		bool packed = false;
+		for (unsigned int j = 0; j < packers.size() && packed == false; j++)
+		{
+			packed = packers[j].insert(width, height, rect);
+			image.pageIndex = j;
+		}
+		if (packed == false)
+		{
+			packers.emplaceBack(pageWidth_, pageHeight_);
+			packed = packers.back().insert(width, height, rect);
+			image.pageIndex = packers.size() - 1;
+		}
+		RETURNF_ASSERT_MSG_X(packed, "Image \"%s\" (%dx%d) does not fit in a %dx%d page", image.name.data(),
+		                     image.texLoader->width(), image.texLoader->height(), pageWidth_, pageHeight_);
+
+		image.region.rect.set(rect.x + padding_, rect.y + padding_, image.texLoader->width(), image.texLoader->height());
+	}
+
+	nctl::String pageName(64);
+	const unsigned long pageSize = static_cast<unsigned long>(pageWidth_) * pageHeight_ * 4;
+	nctl::UniquePtr<unsigned char[]> pixels = nctl::makeUnique<unsigned char[]>(pageSize);
+	for (unsigned int i = 0; i < packers.size(); i++)
+	{
+		// Pixels not covered by any image or its padding stay transparent
+		memset(pixels.get(), 0, pageSize);
+		for (Image &image : images_)
+		{
+			if (image.pageIndex == i)
+			{
+				blitToRgba(*image.texLoader, pixels.get(), pageWidth_, image.region.rect);
+				extrudeBorders(pixels.get(), pageWidth_, image.region.rect, padding_);
+			}
+		}
+
+		pageName.format("TextureAtlas page %u", i);
+		pages_.pushBack(nctl::UniquePtr<Texture>(new Texture(pageName.data(), pageWidth_, pageHeight_, pixels.get())));
+		LOGI_X("Texture atlas page %u packed with %u images, occupancy: %.2f", i, packers[i].numRects(), packers[i].occupancy());
+	}
+
+	// The decoded images are not needed anymore, their pixels are in the pages
+	for (Image &image : images_)
+	{
+		image.region.texture = pages_[image.pageIndex].get();
+		image.texLoader.reset(nullptr);
+	}
+
+	return true;
+}
+
+const TextureRegion *TextureAtlas::findRegion(const char *name) const
+{
+	const unsigned int *index = imageIndices_.find(name);
+	return (index != nullptr) ? &images_[*index].region : nullptr;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+int TextureAtlas::addDecodedImage(const char *name, nctl::UniquePtr<ITextureLoader> texLoader)
+{
+	if (isBuilt())
+	{
+		LOGE_X("Image \"%s\" cannot be added to an atlas that has already been built", name);
+		return -1;
+	}
+	if (texLoader->hasLoaded() == false)
+	{
+		LOGE_X("Image \"%s\" cannot be loaded", name);
+		return -1;
+	}
+	const TextureFormat &texFormat = texLoader->texFormat();
+	if (texFormat.isCompressed() || texFormat.type() != GL_UNSIGNED_BYTE)
+	{
+		LOGE_X("Image \"%s\" is not in an uncompressed 8 bits per channel format", name);
+		return -1;
+	}
+
+	images_.emplaceBack();
+	Image &image = images_.back();
+	image.name = name;
+	image.texLoader = nctl::move(texLoader);
+
+	// If more images have the same name, only the first one can be found by name
+	const unsigned int index = images_.size() - 1;
+	if (imageIndices_.loadFactor() >= 0.75f)
+		imageIndices_.rehash(imageIndices_.capacity() * 2);
+	imageIndices_.insert(image.name, index);
+
+	return static_cast<int>(index);
+}
+
+}
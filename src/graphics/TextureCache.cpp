@@ -0,0 +1,104 @@
+#include "TextureCache.h"
+#include "Texture.h"
+#include "CacheEviction.h"
+#include "RenderStatistics.h"
+#include "tracy.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+TextureCache::TextureCache()
+    : entries_(InitialCapacity), memoryBudget_(0), dataSize_(0), accessCounter_(0), keyString_(nctl::String::MaxCStringLength)
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::SharedPtr<Texture> TextureCache::retrieve(const char *filename)
+{
+	return retrieve(filename, 0, 0);
+}
+
+nctl::SharedPtr<Texture> TextureCache::retrieve(const char *filename, int width, int height)
+{
+	ZoneScoped;
+	// The size override is part of the key as it changes the uploaded texture
+	if (width == 0 || height == 0)
+		keyString_ = filename;
+	else
+		keyString_.format("%s#%dx%d", filename, width, height);
+
+	accessCounter_++;
+	Entry *entry = entries_.find(keyString_);
+	if (entry != nullptr)
+	{
+		entry->lastUse = accessCounter_;
+		RenderStatistics::addTextureCacheHit();
+		return entry->texture;
+	}
+
+	RenderStatistics::addTextureCacheMiss();
+	if (entries_.loadFactor() >= 0.75f)
+		entries_.rehash(entries_.capacity() * 2);
+
+	Entry newEntry;
+	newEntry.texture = nctl::SharedPtr<Texture>(nctl::makeUnique<Texture>(filename, width, height));
+	newEntry.lastUse = accessCounter_;
+	newEntry.dataSize = newEntry.texture->dataSize();
+	entries_.insert(keyString_, newEntry);
+	dataSize_ += newEntry.dataSize;
+
+	// The new texture is referenced by the returned pointer and cannot be evicted
+	nctl::SharedPtr<Texture> texture = newEntry.texture;
+	trim();
+	return texture;
+}
+
+nctl::SharedPtr<Texture> TextureCache::retrieve(const char *filename, Vector2i size)
+{
+	return retrieve(filename, size.x, size.y);
+}
+
+void TextureCache::setMemoryBudget(unsigned long memoryBudget)
+{
+	memoryBudget_ = memoryBudget;
+	trim();
+}
+
+void TextureCache::trim()
+{
+	if (memoryBudget_ > 0)
+		evict(memoryBudget_);
+
+	updateStatistics();
+}
+
+void TextureCache::evictUnreferenced()
+{
+	evict(0);
+	updateStatistics();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void TextureCache::evict(unsigned long targetSize)
+{
+	dataSize_ = evictLeastRecentlyUsed(entries_, dataSize_, targetSize, [](const nctl::String &key, unsigned long dataSize) {
+		LOGI_X("Evicting texture \"%s\" from the cache (%lu bytes)", key.data(), dataSize);
+		RenderStatistics::addTextureCacheEviction();
+	});
+}
+
+void TextureCache::updateStatistics()
+{
+	RenderStatistics::gatherTextureCacheStatistics(entries_.size(), dataSize_);
+}
+
+}
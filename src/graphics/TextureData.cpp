@@ -31,4 +31,9 @@ const char *TextureData::filename() const
 	return texLoader_->filename();
 }
 
+bool TextureData::generateMipMaps(MipMapGenerator::Filter filter)
+{
+	return isValid_ ? texLoader_->generateMipMaps(filter) : false;
+}
+
 }
@@ -53,22 +53,6 @@ unsigned int TextureFormat::numChannels() const
 	}
 }
 
-void TextureFormat::bgrFormat()
-{
-	if (format_ == GL_RGBA)
-	{
-#if !defined(__ANDROID__) && !defined(WITH_ANGLE)
-		format_ = GL_BGRA;
-#else
-		format_ = GL_BGRA_EXT;
-#endif
-	}
-#if !defined(__ANDROID__) && !defined(WITH_ANGLE)
-	else if (format_ == GL_RGB)
-		format_ = GL_BGR;
-#endif
-}
-
 unsigned long TextureFormat::calculateMipSizes(GLenum internalFormat, int width, int height, int mipMapCount, unsigned long *mipDataOffsets, unsigned long *mipDataSizes)
 {
 	unsigned int blockWidth = 1; // Compression block width in pixels
@@ -267,8 +251,9 @@ unsigned long TextureFormat::calculateMipSizes(GLenum internalFormat, int width,
 		if (mipDataSizes[i] < minDataSize)
 			mipDataSizes[i] = minDataSize;
 
-		levelWidth /= 2;
-		levelHeight /= 2;
+		// Non square levels keep halving the longest side until both are one pixel
+		levelWidth = (levelWidth > 1) ? levelWidth / 2 : 1;
+		levelHeight = (levelHeight > 1) ? levelHeight / 2 : 1;
 		dataSizesSum += mipDataSizes[i];
 	}
 
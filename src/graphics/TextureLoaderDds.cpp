@@ -1,5 +1,6 @@
 #include "return_macros.h"
 #include "TextureLoaderDds.h"
+#include "PixelConversion.h"
 
 namespace ncine {
 
@@ -158,10 +159,29 @@ bool TextureLoaderDds::parseFormat(const DdsHeader &header)
 		else
 			RETURNF_MSG_X("Unsupported DDS uncompressed pixel format: %u", flags);
 
+		// Rows of pixels with less than four bytes are tightly packed and need a different unpack alignment
+		bpp_ = static_cast<int>(bitCount / 8);
 		loadPixels(internalFormat, type);
 
-		if (redMask > blueMask && bitCount > 16)
-			texFormat_.bgrFormat();
+		// Swizzling at decode time, as BGR formats are not core in OpenGL ES and usually need a driver conversion
+		if (redMask > blueMask && (bitCount == 32 || bitCount == 24))
+		{
+			const unsigned int bytesPerPixel = bitCount / 8;
+			const unsigned int numPixels = static_cast<unsigned int>(dataSize_ / bytesPerPixel);
+			const unsigned char *srcPixels = pixels_.get();
+			if (pixels_ == nullptr)
+			{
+				// The pixels of a memory mapped file are read-only
+				pixels_ = nctl::makeUnique<unsigned char[]>(dataSize_);
+				srcPixels = pixelsView_;
+				pixelsView_ = nullptr;
+			}
+
+			if (bytesPerPixel == 4)
+				PixelConversion::swapRedBlue(srcPixels, pixels_.get(), numPixels);
+			else
+				PixelConversion::swapRedBlueRgb(srcPixels, pixels_.get(), numPixels);
+		}
 	}
 
 	if (mipMapCount_ > 1)
@@ -142,6 +142,14 @@ GLboolean GLBufferObject::unmap()
 	return glUnmapBuffer(target_);
 }
 
+#if !defined(__ANDROID__) && !defined(WITH_ANGLE)
+void GLBufferObject::getBufferSubData(GLintptr offset, GLsizeiptr size, GLvoid *data)
+{
+	bind();
+	glGetBufferSubData(target_, offset, size, data);
+}
+#endif
+
 #if (!defined(__ANDROID__) && !defined(WITH_ANGLE)) || (defined(__ANDROID__) && GL_ES_VERSION_3_2)
 void GLBufferObject::texBuffer(GLenum internalformat)
 {
@@ -65,7 +65,7 @@ void GLShader::loadFromString(const char *string)
 
 void GLShader::loadFromFile(const char *filename)
 {
-	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filename);
+	nctl::UniquePtr<IFile> fileHandle = IFile::createReadFileHandle(filename);
 
 	fileHandle->open(IFile::OpenMode::READ);
 	if (fileHandle->isOpened())
@@ -5,16 +5,22 @@
 #include "common_headers.h"
 
 #include "IAudioDevice.h"
-#include <nctl/List.h>
+#include <nctl/Array.h>
 #include <nctl/StaticArray.h>
+#include <nctl/UniquePtr.h>
+#include <nctl/SharedPtr.h>
 
 namespace ncine {
 
+class AudioStreamDecoder;
+class AudioBufferPlayer;
+
 /// It represents the interface to the OpenAL audio device
 class ALAudioDevice : public IAudioDevice
 {
   public:
-	ALAudioDevice();
+	/// Creates the device, with an audio thread that decodes streams ahead if requested
+	explicit ALAudioDevice(bool withStreamingThread);
 	~ALAudioDevice() override;
 
 	inline const char *name() const override { return deviceName_; }
@@ -23,6 +29,7 @@ class ALAudioDevice : public IAudioDevice
 	void setGain(float gain) override;
 
 	inline unsigned int numPlayers() const override { return players_.size(); }
+	unsigned int numVirtualPlayers() const override;
 	const IAudioPlayer *player(unsigned int index) const override;
 
 	void stopPlayers() override;
@@ -35,11 +42,31 @@ class ALAudioDevice : public IAudioDevice
 
 	unsigned int nextAvailableSource() override;
 	void registerPlayer(IAudioPlayer *player) override;
+	bool playOneShot(AudioBuffer &audioBuffer, float gain, float pitch, const Vector3f &position) override;
+	bool playOneShot(const nctl::SharedPtr<AudioBuffer> &audioBuffer, float gain, float pitch, const Vector3f &position) override;
+	void stopOneShots(const AudioBuffer &audioBuffer) override;
 	void updatePlayers() override;
 
   private:
 	/// Maximum number of OpenAL sources (HACK: should use a query)
 	static const unsigned int MaxSources = 16;
+	/// Number of pre-allocated players for one-shot sounds
+	static const unsigned int OneShotPoolSize = 32;
+	/// How much more audible a virtual player has to be to take the source of a player with the same priority
+	static const float VirtualizationHysteresis;
+
+	/// A playing player ranked for the assignment of sources
+	struct RankedPlayer
+	{
+		RankedPlayer()
+		    : player(nullptr), audibility(0.0f) {}
+		RankedPlayer(IAudioPlayer *pl, float au)
+		    : player(pl), audibility(au) {}
+
+		IAudioPlayer *player;
+		/// The gain attenuated by the distance from the listener
+		float audibility;
+	};
 
 	/// The OpenAL device
 	ALCdevice *device_;
@@ -49,12 +76,30 @@ class ALAudioDevice : public IAudioDevice
 	ALfloat gain_;
 	/// The sources pool
 	nctl::StaticArray<ALuint, MaxSources> sources_;
-	/// The array of currently active audio players
-	nctl::StaticArray<IAudioPlayer *, MaxSources> players_;
+	/// The array of currently active audio players, including the virtual ones
+	nctl::Array<IAudioPlayer *> players_;
+	/// The playing players sorted by importance, kept as a member to avoid allocations
+	nctl::Array<RankedPlayer> rankedPlayers_;
+	/// The pool of players used for one-shot sounds
+	nctl::Array<nctl::UniquePtr<AudioBufferPlayer>> oneShotPlayers_;
+	/// The shared buffers kept alive by the pooled players until their one-shot sounds stop
+	nctl::StaticArray<nctl::SharedPtr<AudioBuffer>, OneShotPoolSize> oneShotBuffers_;
+	/// The index of the pooled player to check first for the next one-shot sound
+	unsigned int nextOneShot_;
 
 	/// The OpenAL device name string
 	const char *deviceName_;
 
+#ifdef WITH_THREADS
+	/// The audio thread decoding streams, it is `nullptr` if they are decoded by the main thread
+	nctl::UniquePtr<AudioStreamDecoder> streamDecoder_;
+#endif
+
+	/// Gives the sources to the most important players, making the others virtual
+	void assignSources();
+	/// Plays a buffer on the first pooled player that is not busy, returns its index or -1 if none is found
+	int startOneShot(AudioBuffer &audioBuffer, float gain, float pitch, const Vector3f &position);
+
 	/// Deleted copy constructor
 	ALAudioDevice(const ALAudioDevice &) = delete;
 	/// Deleted assignment operator
@@ -0,0 +1,86 @@
+#ifndef CLASS_NCINE_ASSETPACKFORMAT
+#define CLASS_NCINE_ASSETPACKFORMAT
+
+#include <cstdint> // for header
+#include "common_defines.h"
+
+namespace ncine {
+
+/// The layout of an asset pack archive, shared by `AssetPack` and `AssetPackBuilder`
+/*! An archive starts with a fixed size header, followed by an open addressing hash table of entry indices,
+ * the array of entry records, the concatenated entry paths and finally the entry data, all in little endian.
+ * The index is used in place from a memory mapping and each lookup is a hash and a few probes.
+ * Data of every entry starts at a multiple of the archive alignment, so that uncompressed entries can be
+ * accessed in place without any copy. */
+struct AssetPackFormat
+{
+	/// The signature at the beginning of every asset pack
+	static const uint32_t Signature = 0x4B50434E; // "NCPK"
+	/// The version of the asset pack format
+	static const uint16_t Version = 1;
+	/// The hash table slot value of an empty slot
+	static const uint32_t EmptySlot = 0xFFFFFFFF;
+
+	/// Entry flags
+	struct Flags
+	{
+		enum
+		{
+			/// Entry data is compressed with `BlockCompression`
+			COMPRESSED = 1
+		};
+	};
+
+	/// Header for the asset pack format
+	struct Header
+	{
+		uint32_t signature;
+		uint16_t version;
+		uint16_t headerSize;
+		uint32_t numEntries;
+		/// Number of hash table slots, always a power of two
+		uint32_t numSlots;
+		/// Alignment of entry data in bytes, always a power of two
+		uint32_t alignment;
+		/// Size of the concatenated entry paths in bytes
+		uint32_t pathsSize;
+	};
+
+	/// An entry record
+	struct Entry
+	{
+		uint32_t hash;
+		/// Offset of the path from the beginning of the paths area, paths are not null terminated
+		uint32_t pathOffset;
+		uint32_t pathLength;
+		uint32_t flags;
+		/// Offset of the data from the beginning of the archive
+		uint64_t dataOffset;
+		/// Size of the data as stored in the archive
+		uint64_t storedSize;
+		/// Size of the data once decompressed
+		uint64_t size;
+	};
+
+	/// Returns the size of the index, from the beginning of the archive to the end of the paths area
+	static inline uint64_t indexSize(uint32_t numEntries, uint32_t numSlots, uint32_t pathsSize)
+	{
+		return sizeof(Header) + uint64_t(numSlots) * sizeof(uint32_t) + uint64_t(numEntries) * sizeof(Entry) + pathsSize;
+	}
+
+	/// Returns the FNV-1a hash of a path, with backslashes hashed as forward slashes
+	static inline uint32_t hashPath(const char *path, unsigned int length)
+	{
+		uint32_t hash = 2166136261U;
+		for (unsigned int i = 0; i < length; i++)
+		{
+			const unsigned char c = (path[i] == '\\') ? '/' : static_cast<unsigned char>(path[i]);
+			hash = (hash ^ c) * 16777619U;
+		}
+		return hash;
+	}
+};
+
+}
+
+#endif
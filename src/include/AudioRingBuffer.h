@@ -0,0 +1,53 @@
+#ifndef CLASS_NCINE_AUDIORINGBUFFER
+#define CLASS_NCINE_AUDIORINGBUFFER
+
+#include <nctl/UniquePtr.h>
+#include <nctl/Atomic.h>
+
+namespace ncine {
+
+/// A lock-free ring of decoded audio bytes with a single producer and a single consumer
+/*! The producer decodes directly into the contiguous region returned by `writeRegion()`,
+ * then publishes the bytes with `commitWrite()`, while the consumer copies them out with `read()`.
+ * Positions are never wrapped, their difference is the number of bytes in the ring. */
+class AudioRingBuffer
+{
+  public:
+	/// Creates a ring with the specified capacity in bytes, which must be a power of two
+	explicit AudioRingBuffer(unsigned int capacity);
+
+	/// Returns the capacity of the ring in bytes
+	inline unsigned int capacity() const { return capacity_; }
+	/// Returns the number of bytes that can be read
+	unsigned int size() const;
+	/// Returns the number of bytes that can be written
+	inline unsigned int freeSpace() const { return capacity_ - size(); }
+
+	/// Returns the contiguous region that can be written by the producer and its length in bytes
+	char *writeRegion(unsigned int &length);
+	/// Publishes the bytes written by the producer in the region
+	void commitWrite(unsigned int bytes);
+	/// Copies up to the specified number of bytes out of the ring, returns the number of copied bytes
+	unsigned int read(char *buffer, unsigned int bytes);
+
+	/// Discards every byte in the ring
+	/*! \note It should only be called by the consumer while the producer is not writing */
+	void clear();
+
+  private:
+	nctl::UniquePtr<char[]> buffer_;
+	unsigned int capacity_;
+	/// Only written by the consumer
+	mutable nctl::Atomic32 readPosition_;
+	/// Only written by the producer
+	mutable nctl::Atomic32 writePosition_;
+
+	/// Deleted copy constructor
+	AudioRingBuffer(const AudioRingBuffer &) = delete;
+	/// Deleted assignment operator
+	AudioRingBuffer &operator=(const AudioRingBuffer &) = delete;
+};
+
+}
+
+#endif
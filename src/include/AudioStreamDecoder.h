@@ -0,0 +1,58 @@
+#ifndef CLASS_NCINE_AUDIOSTREAMDECODER
+#define CLASS_NCINE_AUDIOSTREAMDECODER
+
+#include <nctl/Array.h>
+#include "Thread.h"
+#include "ThreadSync.h"
+
+namespace ncine {
+
+class AudioStream;
+
+/// A dedicated audio thread that decodes streams ahead of playback
+/*! Every registered stream is decoded into its own ring buffer, a chunk at a time, while the main
+ * thread only copies the decoded bytes out of the ring and queues them to OpenAL.
+ * The thread polls the rings when there is nothing to decode, as a ring holds enough data
+ * to cover hundreds of milliseconds of playback. */
+class AudioStreamDecoder
+{
+  public:
+	AudioStreamDecoder();
+	/// Stops the thread and detaches the registered streams, which will then be decoded by the main thread
+	~AudioStreamDecoder();
+
+	/// Starts decoding a stream on the audio thread
+	void registerStream(AudioStream &stream);
+	/// Stops decoding a stream, waiting for the current chunk to be decoded
+	void unregisterStream(AudioStream &stream);
+
+	/// Prevents the audio thread from decoding, to safely rewind a reader and clear its ring
+	inline void lock() { mutex_.lock(); }
+	/// Resumes decoding on the audio thread
+	inline void unlock() { mutex_.unlock(); }
+
+  private:
+	/// The number of bytes decoded for a stream before moving to the next one
+	static const unsigned int ChunkSize = 4 * 1024;
+	/// The time in seconds the thread sleeps when no ring has space to decode into
+	static const float IdleTime;
+
+	Thread thread_;
+	/// Guards the array of streams and the readers they own
+	Mutex mutex_;
+	/// Signaled when the first stream is registered or when the thread should quit
+	CondVariable streamsCV_;
+	nctl::Array<AudioStream *> streams_;
+	bool shouldQuit_;
+
+	static void threadFunction(void *arg);
+
+	/// Deleted copy constructor
+	AudioStreamDecoder(const AudioStreamDecoder &) = delete;
+	/// Deleted assignment operator
+	AudioStreamDecoder &operator=(const AudioStreamDecoder &) = delete;
+};
+
+}
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef CLASS_NCINE_BLOCKCOMPRESSION
+#define CLASS_NCINE_BLOCKCOMPRESSION
+
+#include "common_defines.h"
+
+namespace ncine {
+
+/// A fast LZ77 compressor and decompressor for memory blocks
+/*! The output follows the LZ4 block format, a sequence of literal runs and back references
+ * to the previous 64 KiB, which is decompressed at memory bandwidth speed.
+ * \note The compressor favors speed over ratio, with a single hash table probe per position */
+class DLL_PUBLIC BlockCompression
+{
+  public:
+	/// Returns the maximum size of the compressed data for an input of the specified size
+	static unsigned long int compressBound(unsigned long int size);
+	/// Compresses a block of memory, returns the compressed size or zero if it does not fit in the destination
+	static unsigned long int compress(const unsigned char *src, unsigned long int srcSize, unsigned char *dest, unsigned long int destCapacity);
+	/// Decompresses a block of memory, returns false if the data is corrupted or if it does not decompress to exactly `destSize` bytes
+	static bool decompress(const unsigned char *src, unsigned long int srcSize, unsigned char *dest, unsigned long int destSize);
+};
+
+}
+
+#endif
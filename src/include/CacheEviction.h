@@ -0,0 +1,62 @@
+#ifndef NCINE_CACHEEVICTION
+#define NCINE_CACHEEVICTION
+
+#include <nctl/Array.h>
+#include <nctl/HashMap.h>
+#include <nctl/HashMapIterator.h>
+#include <nctl/String.h>
+#include <nctl/algorithms.h>
+
+namespace ncine {
+
+/// Evicts the least recently used unreferenced entries of a cache until its data size is not above the target one
+/*! The entry type should have the `lastUse` and `dataSize` members and a `numReferences()` method.
+ * The unreferenced entries are collected and sorted once, instead of searching for the least recently used one
+ * after every eviction. The `onEvict` function is called with the key and the data size of an entry before removing it.
+ * \return The data size of the cache after the evictions */
+template <class Entry, class EvictFunction>
+unsigned long evictLeastRecentlyUsed(nctl::StringHashMap<Entry> &entries, unsigned long dataSize, unsigned long targetSize, EvictFunction onEvict)
+{
+	if (dataSize <= targetSize)
+		return dataSize;
+
+	struct Candidate
+	{
+		const nctl::String *key;
+		unsigned long int lastUse;
+		unsigned long dataSize;
+	};
+
+	nctl::Array<Candidate> candidates(entries.size());
+	for (typename nctl::StringHashMap<Entry>::ConstIterator i = entries.cBegin(); i != entries.cEnd(); ++i)
+	{
+		const Entry &entry = i.value();
+		if (entry.numReferences() == 0)
+			candidates.pushBack({ &i.key(), entry.lastUse, entry.dataSize });
+	}
+	nctl::quicksort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+		return a.lastUse < b.lastUse;
+	});
+
+	unsigned int numEvicted = 0;
+	unsigned long remainingSize = dataSize;
+	while (numEvicted < candidates.size() && remainingSize > targetSize)
+		remainingSize -= candidates[numEvicted++].dataSize;
+
+	// The keys are copied before removing any entry from the hashmap
+	nctl::Array<nctl::String> evictedKeys(numEvicted);
+	for (unsigned int i = 0; i < numEvicted; i++)
+		evictedKeys.pushBack(*candidates[i].key);
+
+	for (unsigned int i = 0; i < numEvicted; i++)
+	{
+		onEvict(evictedKeys[i], candidates[i].dataSize);
+		entries.remove(evictedKeys[i]);
+	}
+
+	return remainingSize;
+}
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef CLASS_NCINE_FNTBINARY
+#define CLASS_NCINE_FNTBINARY
+
+#include <cstdint> // for header
+#include <nctl/UniquePtr.h>
+#include "FntParser.h"
+
+namespace ncine {
+
+class IFile;
+
+/// Precompiled binary FNT format, used in place without parsing
+/*! The format is composed by a fixed size header followed by an array of
+ * character records and an array of kerning records, all in the byte order of the host that saved them.
+ * As records are used in place, a file saved on a host with a different byte order is rejected by the signature check.
+ * A binary font can be created from an AngelCode's `FNT` file with `saveToFile()`,
+ * its files are recognized by the `nfnt` extension.
+ * \note Memory buffers should be aligned to four bytes */
+class DLL_PUBLIC FntBinary
+{
+  public:
+	/// The signature at the beginning of every binary font
+	static const uint32_t Signature = 0x544E464E; // "NFNT"
+	/// The version of the binary font format
+	static const uint16_t Version = 1;
+
+	/// Header for the binary font format
+	struct Header
+	{
+		uint32_t signature;
+		uint16_t version;
+		uint16_t headerSize;
+		int16_t size;
+		uint16_t lineHeight;
+		uint16_t base;
+		uint16_t scaleW;
+		uint16_t scaleH;
+		uint16_t pages;
+		uint8_t packed;
+		uint8_t outline;
+		uint8_t alphaChnl;
+		uint8_t redChnl;
+		uint8_t greenChnl;
+		uint8_t blueChnl;
+		uint16_t reserved;
+		uint32_t numChars;
+		uint32_t numKernings;
+		char face[FntParser::MaxFaceNameLength];
+		char pageFile[FntParser::MaxFileNameLength];
+	};
+
+	/// A character record, with the same field names of `FntParser::CharTag`
+	struct CharTag
+	{
+		uint32_t id;
+		uint16_t x;
+		uint16_t y;
+		uint16_t width;
+		uint16_t height;
+		int16_t xoffset;
+		int16_t yoffset;
+		int16_t xadvance;
+		uint16_t page;
+	};
+
+	/// A kerning record, with the same field names of `FntParser::KerningTag`
+	struct KerningTag
+	{
+		uint32_t first;
+		uint32_t second;
+		int32_t amount;
+	};
+
+	/// Uses a binary font from a memory buffer of the specified size
+	/*! \note The buffer is not copied and it should outlive the object */
+	FntBinary(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize);
+	/// Maps a binary font file in memory, or loads it in a memory buffer, then uses it
+	explicit FntBinary(const char *filename);
+	~FntBinary();
+
+	/// Returns true if the binary font has been successfully loaded and validated
+	inline bool isValid() const { return header_ != nullptr; }
+
+	/// Returns the "info" tag structure reconstructed from the header
+	const FntParser::InfoTag &infoTag() const { return infoTag_; }
+	/// Returns the "common" tag structure reconstructed from the header
+	const FntParser::CommonTag &commonTag() const { return commonTag_; }
+	/// Returns the number of "page" tag structures
+	unsigned int numPageTags() const { return isValid() ? 1 : 0; }
+	/// Returns the specified "page" tag structure reconstructed from the header
+	const FntParser::PageTag &pageTag(unsigned int index) const
+	{
+		FATAL_ASSERT(index < numPageTags());
+		return pageTag_;
+	}
+	/// Returns the number of character records
+	unsigned int numCharTags() const { return numCharTags_; }
+	/// Returns the specified character record, directly from the buffer
+	const CharTag &charTag(unsigned int index) const
+	{
+		FATAL_ASSERT(index < numCharTags_);
+		return charTags_[index];
+	}
+	/// Returns the number of kerning records
+	unsigned int numKerningTags() const { return numKerningTags_; }
+	/// Returns the specified kerning record, directly from the buffer
+	const KerningTag &kerningTag(unsigned int index) const
+	{
+		FATAL_ASSERT(index < numKerningTags_);
+		return kerningTags_[index];
+	}
+
+	/// Returns the name of the buffer or file used to load data from
+	inline const char *filename() const { return filename_.data(); }
+
+	/// Returns true if the file name has the binary font extension
+	static bool hasBinaryExtension(const char *filename);
+	/// Returns true if the memory buffer starts with a binary font header
+	static bool hasSignature(const unsigned char *bufferPtr, unsigned long int bufferSize);
+	/// Writes the information from a parsed FNT file to a binary font file
+	static bool saveToFile(const FntParser &fntParser, const char *filename);
+
+  private:
+	/// The handle of the file mapped in memory, kept open while the records are used
+	nctl::UniquePtr<IFile> fileHandle_;
+	/// The buffer holding the file content, if the object has been created from a file that cannot be mapped
+	nctl::UniquePtr<unsigned char[]> fileBuffer_;
+	/// Pointer to the header inside the buffer
+	const Header *header_;
+	/// Pointer to the first character record inside the buffer
+	const CharTag *charTags_;
+	/// Pointer to the first kerning record inside the buffer
+	const KerningTag *kerningTags_;
+
+	unsigned int numCharTags_;
+	unsigned int numKerningTags_;
+
+	/// The "info" tag structure reconstructed from the header
+	FntParser::InfoTag infoTag_;
+	/// The "common" tag structure reconstructed from the header
+	FntParser::CommonTag commonTag_;
+	/// The "page" tag structure reconstructed from the header
+	FntParser::PageTag pageTag_;
+
+	/// File or buffer name used to load data from
+	nctl::String filename_;
+
+	/// Validates the buffer and initializes the record pointers
+	bool useBuffer(const unsigned char *bufferPtr, unsigned long int bufferSize);
+};
+
+}
+
+#endif
@@ -1,12 +1,12 @@
 #ifndef CLASS_NCINE_FONTGLYPH
 #define CLASS_NCINE_FONTGLYPH
 
-#include <nctl/Array.h>
 #include "Rect.h"
 
 namespace ncine {
 
 /// A class holding information about a single glyph (character)
+/*! \note Kerning pairs are stored by the `Font` class in a single hashmap */
 class FontGlyph
 {
   public:
@@ -27,47 +27,27 @@ class FontGlyph
 	/// Returns the X offset to advance in order to start rendering the next glyph
 	inline int xAdvance() const { return xAdvance_; }
 
-	/// Adds the kerning amount for a subsequent glyph
-	inline void addKerning(unsigned int secondGlyph, int amount) { kernings_.pushBack(Kerning(secondGlyph, amount)); }
-	/// Returns the kerning amount for a subsequent glyph
-	int kerning(unsigned int secondGlyph) const;
-
   private:
-	/// A structure holding glyph pairs kerning offsets
-	struct Kerning
-	{
-		unsigned int secondGlyph_;
-		int amount_;
-
-		Kerning()
-		    : secondGlyph_(0), amount_(0) {}
-		Kerning(unsigned int secondGlyph, int amount)
-		{
-			secondGlyph_ = secondGlyph;
-			amount_ = amount;
-		}
-	};
-
-	unsigned int x_;
-	unsigned int y_;
-	unsigned int width_;
-	unsigned int height_;
-	int xOffset_;
-	int yOffset_;
-	int xAdvance_;
-	nctl::Array<Kerning> kernings_;
+	/// Glyph metrics are stored as 16 bits values to keep the glyph tables compact
+	unsigned short int x_;
+	unsigned short int y_;
+	unsigned short int width_;
+	unsigned short int height_;
+	short int xOffset_;
+	short int yOffset_;
+	short int xAdvance_;
 };
 
 inline void FontGlyph::set(unsigned int x, unsigned int y, unsigned int width, unsigned int height,
                            int xOffset, int yOffset, int xAdvance)
 {
-	x_ = x;
-	y_ = y;
-	width_ = width;
-	height_ = height;
-	xOffset_ = xOffset;
-	yOffset_ = yOffset;
-	xAdvance_ = xAdvance;
+	x_ = static_cast<unsigned short int>(x);
+	y_ = static_cast<unsigned short int>(y);
+	width_ = static_cast<unsigned short int>(width);
+	height_ = static_cast<unsigned short int>(height);
+	xOffset_ = static_cast<short int>(xOffset);
+	yOffset_ = static_cast<short int>(yOffset);
+	xAdvance_ = static_cast<short int>(xAdvance);
 }
 
 }
@@ -30,6 +30,9 @@ class GLBufferObject
 	void *mapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield access);
 	void flushMappedBufferRange(GLintptr offset, GLsizeiptr length);
 	GLboolean unmap();
+#if !defined(__ANDROID__) && !defined(WITH_ANGLE)
+	void getBufferSubData(GLintptr offset, GLsizeiptr size, GLvoid *data);
+#endif
 #if (!defined(__ANDROID__) && !defined(WITH_ANGLE)) || (defined(__ANDROID__) && GL_ES_VERSION_3_2)
 	void texBuffer(GLenum internalformat);
 #endif
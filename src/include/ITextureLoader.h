@@ -4,6 +4,7 @@
 #include "TextureFormat.h"
 #include "Vector2.h"
 #include "IFile.h"
+#include "MipMapGenerator.h"
 
 namespace ncine {
 
@@ -35,13 +36,18 @@ class ITextureLoader
 	/// Returns the texture format object
 	inline const TextureFormat &texFormat() const { return texFormat_; }
 	/// Returns the pointer to pixel data
-	inline const GLubyte *pixels() const { return pixels_.get(); }
+	inline const GLubyte *pixels() const { return pixels_ ? pixels_.get() : pixelsView_; }
 	/// Returns the pointer to pixel data for the specified MIP map level
 	const GLubyte *pixels(unsigned int mipMapLevel) const;
 
 	/// Returns the name of the buffer or the file managed by the file handle
 	const char *filename() const;
 
+	/// Generates a complete MIP map chain for an uncompressed 8 bits per channel image that has only the base level
+	/*! The levels are computed on the calling thread, so that the upload does not need `glGenerateMipmap()`.
+	 * \return True if the chain has been generated */
+	bool generateMipMaps(MipMapGenerator::Filter filter);
+
 	/// Returns the proper texture loader according to the memory buffer name extension
 	static nctl::UniquePtr<ITextureLoader> createFromMemory(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize);
 	/// Returns the proper texture loader according to the file extension
@@ -63,6 +69,8 @@ class ITextureLoader
 	nctl::UniquePtr<unsigned long[]> mipDataSizes_;
 	TextureFormat texFormat_;
 	nctl::UniquePtr<GLubyte[]> pixels_;
+	/// Pointer to pixel data inside a memory mapped file, used when `pixels_` is empty
+	const GLubyte *pixelsView_;
 
 	explicit ITextureLoader(nctl::UniquePtr<IFile> fileHandle);
 
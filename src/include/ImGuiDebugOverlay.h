@@ -98,6 +98,7 @@ class ImGuiDebugOverlay : public IDebugOverlay
 	void guiApplicationConfiguration();
 	void guiRenderingSettings();
 	void guiWindowSettings();
+	void guiTextureCache();
 	void guiAudioPlayers();
 	void guiInputState();
 	void guiRenderDoc();
@@ -18,6 +18,7 @@ class LuaIAudioDevice
 	static int setGain(lua_State *L);
 
 	static int numPlayers(lua_State *L);
+	static int numVirtualPlayers(lua_State *L);
 	static int player(lua_State *L);
 
 	static int stopPlayers(lua_State *L);
@@ -25,6 +26,8 @@ class LuaIAudioDevice
 
 	static int freezePlayers(lua_State *L);
 	static int unfreezePlayers(lua_State *L);
+
+	static int playOneShot(lua_State *L);
 };
 
 }
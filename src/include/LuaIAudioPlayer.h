@@ -24,10 +24,14 @@ class LuaIAudioPlayer
 	static int isPlaying(lua_State *L);
 	static int isPaused(lua_State *L);
 	static int isStopped(lua_State *L);
+	static int isVirtual(lua_State *L);
 
 	static int isLooping(lua_State *L);
 	static int setLooping(lua_State *L);
 
+	static int priority(lua_State *L);
+	static int setPriority(lua_State *L);
+
 	static int gain(lua_State *L);
 	static int setGain(lua_State *L);
 	static int pitch(lua_State *L);
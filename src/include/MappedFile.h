@@ -0,0 +1,57 @@
+#ifndef CLASS_NCINE_MAPPEDFILE
+#define CLASS_NCINE_MAPPEDFILE
+
+#include "IFile.h"
+
+namespace ncine {
+
+class StandardFile;
+
+/// The class mapping a read-only file in memory
+/*! The content can be accessed in place through `mappedData()`, without an intermediate copy.
+ * If the file cannot be mapped, like when it is empty, it is opened as a standard file instead and
+ * `mappedData()` returns `nullptr`, so that the content can still be accessed with buffered reads. */
+class MappedFile : public IFile
+{
+  public:
+	/// Constructs a memory mapped file object
+	/*! \param filename File name including its path */
+	explicit MappedFile(const char *filename);
+	~MappedFile() override;
+
+	/// Tries to open and map the file in memory
+	/*! \note Only the `READ` and `BINARY` modes are supported */
+	void open(unsigned char mode) override;
+	/// Unmaps the file
+	void close() override;
+	long int seek(long int offset, int whence) const override;
+	long int tell() const override;
+	unsigned long int read(void *buffer, unsigned long int bytes) const override;
+	unsigned long int write(void *buffer, unsigned long int bytes) override;
+
+	inline const unsigned char *mappedData() const override { return mappedPtr_; }
+	/// Returns true if the file has been opened as a standard file because it could not be mapped
+	inline bool isBuffered() const { return fallbackFile_ != nullptr; }
+
+  private:
+	/// Pointer to the beginning of the mapping
+	const unsigned char *mappedPtr_;
+	/// The standard file used for buffered reads when the mapping fails
+	nctl::UniquePtr<StandardFile> fallbackFile_;
+	/// \note Modified by `seek` and `tell` constant methods
+	mutable unsigned long int seekOffset_;
+
+	/// Deleted copy constructor
+	MappedFile(const MappedFile &) = delete;
+	/// Deleted assignment operator
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	/// Reports a failure to open the file, exiting if requested
+	void failToOpen(const char *reason);
+	/// Opens the file as a standard one after a failed mapping
+	void openFallback(const char *reason);
+};
+
+}
+
+#endif
@@ -44,10 +44,15 @@ class Material
 		BATCHED_TEXTNODES_ALPHA,
 		/// Shader program for a batch of TextNode classes with grayscale font texture
 		BATCHED_TEXTNODES_RED,
+		/// Shader program for a batch of Sprite classes sampling from multiple textures
+		BATCHED_SPRITES_MULTITEXTURE,
 		/// A custom shader program
 		CUSTOM
 	};
 
+	/// The number of texture units a material can bind
+	static const unsigned int MaxTextureUnits = 4;
+
 	/// Default constructor
 	Material();
 	Material(GLShaderProgram *program, GLTexture *texture);
@@ -71,9 +76,13 @@ class Material
 	inline GLUniformBlockCache *uniformBlock(const char *name) { return shaderUniformBlocks_.uniformBlock(name); }
 	/// Wrapper around `GLShaderAttributes::attribute()`
 	inline GLVertexFormat::Attribute *attribute(const char *name) { return shaderAttributes_.attribute(name); }
-	inline const GLTexture *texture() const { return texture_; }
-	inline void setTexture(const GLTexture *texture) { texture_ = texture; }
+	inline const GLTexture *texture() const { return textures_[0]; }
+	inline void setTexture(const GLTexture *texture) { textures_[0] = texture; }
 	void setTexture(const Texture &texture);
+	/// Returns the texture bound to the specified unit
+	inline const GLTexture *texture(unsigned int unit) const { return textures_[unit]; }
+	/// Sets the texture to be bound to the specified unit
+	void setTexture(unsigned int unit, const GLTexture *texture);
 
   private:
 	bool isBlendingEnabled_;
@@ -85,7 +94,7 @@ class Material
 	GLShaderUniforms shaderUniforms_;
 	GLShaderUniformBlocks shaderUniformBlocks_;
 	GLShaderAttributes shaderAttributes_;
-	const GLTexture *texture_;
+	const GLTexture *textures_[MaxTextureUnits];
 
 	/// Memory buffer with uniform values to be sent to the GPU
 	nctl::UniquePtr<GLubyte[]> uniformsHostBuffer_;
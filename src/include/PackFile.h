@@ -0,0 +1,52 @@
+#ifndef CLASS_NCINE_PACKFILE
+#define CLASS_NCINE_PACKFILE
+
+#include "IFile.h"
+#include <nctl/SharedPtr.h>
+
+namespace ncine {
+
+class AssetPack;
+
+/// The class giving access to an entry of a mounted asset pack
+/*! Uncompressed entries of a mapped pack are accessed in place, the other ones are loaded in a buffer when opened.
+ * In both cases the content is available through `mappedData()` while the file is opened. */
+class PackFile : public IFile
+{
+  public:
+	/// Constructs a file object for an entry of an asset pack
+	/*! \param filename File name including its path, as requested to the file handle factory method */
+	PackFile(const char *filename, const nctl::SharedPtr<AssetPack> &pack, unsigned int entryIndex);
+	~PackFile() override;
+
+	/// Tries to open the entry
+	/*! \note Only the `READ` and `BINARY` modes are supported */
+	void open(unsigned char mode) override;
+	void close() override;
+	long int seek(long int offset, int whence) const override;
+	long int tell() const override;
+	unsigned long int read(void *buffer, unsigned long int bytes) const override;
+	unsigned long int write(void *buffer, unsigned long int bytes) override;
+
+	inline const unsigned char *mappedData() const override { return dataPtr_; }
+
+  private:
+	/// The pack is kept alive while its entries are in use, even if it is unmounted
+	nctl::SharedPtr<AssetPack> pack_;
+	unsigned int entryIndex_;
+	/// Pointer to the beginning of the entry data, either inside the pack mapping or inside the buffer
+	const unsigned char *dataPtr_;
+	/// The buffer holding the entry data when it cannot be accessed in place
+	nctl::UniquePtr<unsigned char[]> dataBuffer_;
+	/// \note Modified by `seek` and `tell` constant methods
+	mutable unsigned long int seekOffset_;
+
+	/// Deleted copy constructor
+	PackFile(const PackFile &) = delete;
+	/// Deleted assignment operator
+	PackFile &operator=(const PackFile &) = delete;
+};
+
+}
+
+#endif
@@ -49,6 +49,7 @@ class RenderResources
 	static inline GLShaderProgram *batchedMeshSpritesGrayShaderProgram() { return batchedMeshSpritesGrayShaderProgram_.get(); }
 	static inline GLShaderProgram *batchedTextnodesAlphaShaderProgram() { return batchedTextnodesAlphaShaderProgram_.get(); }
 	static inline GLShaderProgram *batchedTextnodesRedShaderProgram() { return batchedTextnodesRedShaderProgram_.get(); }
+	static inline GLShaderProgram *batchedSpritesMultiTextureShaderProgram() { return batchedSpritesMultiTextureShaderProgram_.get(); }
 	static inline const Matrix4x4f &projectionMatrix() { return projectionMatrix_; }
 	static inline bool hasProjectionChanged(bool batchingEnabled) { return (batchingEnabled) ? projectionHasChangedBatching_ : projectionHasChanged_; }
 	static void clearDirtyProjectionFlag(bool batchingEnabled);
@@ -70,6 +71,7 @@ class RenderResources
 	static nctl::UniquePtr<GLShaderProgram> batchedMeshSpritesGrayShaderProgram_;
 	static nctl::UniquePtr<GLShaderProgram> batchedTextnodesAlphaShaderProgram_;
 	static nctl::UniquePtr<GLShaderProgram> batchedTextnodesRedShaderProgram_;
+	static nctl::UniquePtr<GLShaderProgram> batchedSpritesMultiTextureShaderProgram_;
 
 	static Matrix4x4f projectionMatrix_;
 	static bool projectionHasChanged_;
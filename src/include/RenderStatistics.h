@@ -72,6 +72,42 @@ class RenderStatistics
 		friend RenderStatistics;
 	};
 
+	class CachedTextures
+	{
+	  public:
+		unsigned int count;
+		unsigned long dataSize;
+		unsigned int hits;
+		unsigned int misses;
+		unsigned int evictions;
+
+		CachedTextures()
+		    : count(0), dataSize(0), hits(0), misses(0), evictions(0) {}
+
+		/// Returns the ratio of cache retrievals that did not need to load a texture
+		inline float hitRate() const { return (hits + misses > 0) ? hits / static_cast<float>(hits + misses) : 0.0f; }
+	};
+
+	class DrawCalls
+	{
+	  public:
+		/// Number of render commands submitted to the queue, before batching
+		unsigned int submitted;
+		/// Number of batch splits caused only by a different texture
+		unsigned int textureSplits;
+
+		DrawCalls()
+		    : submitted(0), textureSplits(0) {}
+
+	  private:
+		void reset()
+		{
+			submitted = 0;
+			textureSplits = 0;
+		}
+		friend RenderStatistics;
+	};
+
 	class CustomBuffers
 	{
 	  public:
@@ -123,6 +159,12 @@ class RenderStatistics
 	/// Returns aggregated texture statistics
 	static inline const Textures &textures() { return textures_; }
 
+	/// Returns texture cache statistics
+	static inline const CachedTextures &cachedTextures() { return cachedTextures_; }
+
+	/// Returns statistics about submitted commands and batch splits, to be compared with the issued ones
+	static inline const DrawCalls &drawCalls() { return drawCalls_; }
+
 	/// Returns aggregated custom VBOs statistics
 	static inline const CustomBuffers &customVBOs() { return customVbos_; }
 
@@ -143,6 +185,8 @@ class RenderStatistics
 	static Commands typedCommands_[RenderCommand::CommandTypes::COUNT];
 	static Buffers typedBuffers_[RenderBuffersManager::BufferTypes::COUNT];
 	static Textures textures_;
+	static CachedTextures cachedTextures_;
+	static DrawCalls drawCalls_;
 	static CustomBuffers customVbos_;
 	static CustomBuffers customIbos_;
 	static unsigned int index_;
@@ -167,6 +211,16 @@ class RenderStatistics
 		textures_.count--;
 		textures_.dataSize -= datasize;
 	}
+	static inline void gatherTextureCacheStatistics(unsigned int count, unsigned long dataSize)
+	{
+		cachedTextures_.count = count;
+		cachedTextures_.dataSize = dataSize;
+	}
+	static inline void addTextureCacheHit() { cachedTextures_.hits++; }
+	static inline void addTextureCacheMiss() { cachedTextures_.misses++; }
+	static inline void addTextureCacheEviction() { cachedTextures_.evictions++; }
+	static inline void addSubmittedCommands(unsigned int count) { drawCalls_.submitted += count; }
+	static inline void addTextureSplit() { drawCalls_.textureSplits++; }
 	static inline void addCustomVbo(unsigned long datasize)
 	{
 		customVbos_.count++;
@@ -192,8 +246,10 @@ class RenderStatistics
 	static inline void addVaoPoolBinding() { vaoPool_.bindings++; }
 
 	friend class RenderQueue;
+	friend class RenderBatcher;
 	friend class RenderBuffersManager;
 	friend class Texture;
+	friend class TextureCache;
 	friend class Geometry;
 	friend class DrawableNode;
 	friend class RenderVaoPool;
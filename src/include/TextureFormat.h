@@ -26,9 +26,6 @@ class TextureFormat
 	/// Returns the number of color channels
 	unsigned int numChannels() const;
 
-	/// Converts the external format to the corresponding BGR one
-	void bgrFormat();
-
 	/// Calculates the pixel data size for each MIP map level
 	static unsigned long calculateMipSizes(GLenum internalFormat, int width, int height, int mipMapCount, unsigned long *mipDataOffsets, unsigned long *mipDataSizes);
 
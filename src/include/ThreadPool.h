@@ -2,14 +2,21 @@
 #define CLASS_NCINE_THREADPOOL
 
 #include "IThreadPool.h"
-#include <nctl/List.h>
 #include "ThreadSync.h"
 #include <nctl/Array.h>
+#include <nctl/Atomic.h>
+#include <nctl/MpmcQueue.h>
 #include "Thread.h"
+#include "WorkStealingDeque.h"
 
 namespace ncine {
 
 /// Thread pool class
+/*! Every worker owns a work-stealing deque for the commands it enqueues itself, while commands
+ * coming from other threads are added to a shared injection queue. An idle worker looks for a command
+ * in its own deque, then in the injection queue, and then it tries to steal one from the other workers.
+ * It spins for a while before going to sleep, for longer when spinning has recently paid off.
+ * Functions are enqueued in commands taken from a pool, so that submitting them does not allocate memory. */
 class ThreadPool : public IThreadPool
 {
   public:
@@ -21,26 +28,90 @@ class ThreadPool : public IThreadPool
 
 	/// Enqueues a command request for a worker thread
 	void enqueueCommand(nctl::UniquePtr<IThreadCommand> threadCommand) override;
+	/// Enqueues a function for a worker thread, in a pooled command if one is available
+	void enqueue(ThreadFunction function) override;
+	/// Returns the number of worker threads
+	inline unsigned int numThreads() const override { return numThreads_; }
+	/// Executes one of the pending commands on the calling thread, stealing it from a worker if needed
+	bool executePendingCommand() override;
 
   private:
-	struct ThreadStruct
+	/// The number of commands a worker deque can hold before they spill into the injection queue
+	static const unsigned int DequeCapacity = 256;
+	/// The initial capacity of the injection queue, doubled when full
+	static const unsigned int InjectionQueueCapacity = 64;
+	/// The minimum number of attempts to find a command before an idle worker goes to sleep
+	static const unsigned int MinSpinCount = 8;
+	/// The maximum number of attempts to find a command before an idle worker goes to sleep
+	static const unsigned int MaxSpinCount = 256;
+	/// The number of pooled commands for enqueued functions, more functions in flight are wrapped in allocated commands
+	static const unsigned int NumPooledCommands = 1024;
+	/// The number of free pooled commands a worker keeps for itself, reused without any atomic operation
+	static const unsigned int NumWorkerFreeCommands = 64;
+
+	struct Worker
 	{
-		nctl::List<nctl::UniquePtr<IThreadCommand>> *queue;
-		Mutex *queueMutex;
-		CondVariable *queueCV;
-		bool shouldQuit;
+		Worker(ThreadPool *threadPool, unsigned int workerIndex)
+		    : pool(threadPool), index(workerIndex), deque(DequeCapacity), spinCount(MinSpinCount), randomState(workerIndex + 1),
+		      freeCommands(NumWorkerFreeCommands, nctl::ArrayMode::FIXED_CAPACITY) {}
+
+		ThreadPool *pool;
+		unsigned int index;
+		WorkStealingDeque deque;
+		/// The current number of attempts before going to sleep, adapted to how often spinning finds a command
+		unsigned int spinCount;
+		/// The state of the generator used to pick the first victim to steal from
+		unsigned int randomState;
+		/// The free pooled commands only used by this worker
+		nctl::Array<FunctionCommand *> freeCommands;
 	};
 
-	nctl::List<nctl::UniquePtr<IThreadCommand>> queue_;
 	nctl::Array<Thread> threads_;
+	nctl::Array<nctl::UniquePtr<Worker>> workers_;
+	unsigned int numThreads_;
+
+	/// Guards the injection queue and the sleeping workers
 	Mutex queueMutex_;
+	/// Signaled when a command is enqueued and a worker is sleeping, or when the pool is destroyed
 	CondVariable queueCV_;
-	Mutex quitMutex_;
-	unsigned int numThreads_;
+	/// A circular queue of commands enqueued by threads that are not workers of the pool
+	nctl::Array<IThreadCommand *> injectionQueue_;
+	unsigned int injectionHead_;
+	/// The number of commands in the injection queue, readable without locking the mutex
+	nctl::Atomic32 numInjected_;
+	nctl::Atomic32 numSleeping_;
+	nctl::Atomic32 shouldQuit_;
+
+	/// The commands used to enqueue functions
+	nctl::UniquePtr<FunctionCommand[]> pooledCommands_;
+	/// The pooled commands that are not enqueued or kept by a worker, they can be taken and given back by any thread
+	nctl::MpmcQueue<FunctionCommand *> freeCommands_;
 
-	ThreadStruct threadStruct_;
 	static void workerFunction(void *arg);
 
+	/// Returns the worker running on the calling thread if it belongs to this pool, or `nullptr`
+	Worker *currentPoolWorker();
+	/// Adds a command to the deque of the calling worker or to the injection queue
+	void pushCommand(IThreadCommand *command);
+	/// Returns a free pooled command, or `nullptr` if there are none
+	FunctionCommand *acquireCommand();
+	/// Executes a command, then gives it back to the pool or deletes it
+	void executeCommand(IThreadCommand *command);
+	/// Gives a command back to the pool if it belongs to it, or deletes it
+	void releaseCommand(IThreadCommand *command);
+
+	/// Returns a command from the worker deque, the injection queue or another worker, or `nullptr`
+	/*! The worker is `nullptr` when the calling thread does not belong to the pool */
+	IThreadCommand *findCommand(Worker *worker);
+	/// Adds a command to the back of the injection queue, the mutex should be locked
+	void pushInjected(IThreadCommand *command);
+	/// Removes a command from the front of the injection queue, returns `nullptr` if it is empty
+	IThreadCommand *popInjected();
+	/// Returns true if there is a command in the injection queue or in any deque, the mutex should be locked
+	bool hasPendingCommands();
+	/// Wakes up a sleeping worker, if there is one
+	void wakeWorker();
+
 	/// Deleted copy constructor
 	ThreadPool(const ThreadPool &) = delete;
 	/// Deleted assignment operator
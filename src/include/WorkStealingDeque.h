@@ -0,0 +1,53 @@
+#ifndef CLASS_NCINE_WORKSTEALINGDEQUE
+#define CLASS_NCINE_WORKSTEALINGDEQUE
+
+#include <nctl/Atomic.h>
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+class IThreadCommand;
+
+/// A bounded Chase-Lev work-stealing deque of thread commands
+/*! Only the owner thread can push and pop commands at the bottom, in LIFO order,
+ * while any other thread can steal them from the top, in FIFO order.
+ * The deque does not take ownership of the commands and it never grows:
+ * a push fails when it is full, leaving the caller to find another place for the command.
+ * Based on "Correct and Efficient Work-Stealing for Weak Memory Models" by Lê et al. */
+class WorkStealingDeque
+{
+  public:
+	/// Creates a deque with the specified capacity, rounded up to a power of two
+	explicit WorkStealingDeque(unsigned int capacity);
+
+	/// Pushes a command at the bottom, returns false if the deque is full (owner thread only)
+	bool push(IThreadCommand *command);
+	/// Pops the most recently pushed command, returns `nullptr` if the deque is empty (owner thread only)
+	IThreadCommand *pop();
+	/// Steals the least recently pushed command, returns `nullptr` if the deque is empty or the race is lost (any thread)
+	IThreadCommand *steal();
+
+	/// Returns true if the deque has no commands, the value can be stale when read by another thread
+	bool isEmpty();
+	/// Returns the maximum number of commands in the deque
+	inline unsigned int capacity() const { return mask_ + 1; }
+
+  private:
+	/// The number of slots minus one, used to wrap the indices
+	unsigned int mask_;
+	/// The slots storing the command pointers, atomic as a thief can read one while the owner writes it
+	nctl::UniquePtr<nctl::Atomic64[]> slots_;
+	/// The index of the next command to steal
+	nctl::Atomic64 top_;
+	/// The index of the next free slot
+	nctl::Atomic64 bottom_;
+
+	/// Deleted copy constructor
+	WorkStealingDeque(const WorkStealingDeque &) = delete;
+	/// Deleted assignment operator
+	WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+};
+
+}
+
+#endif
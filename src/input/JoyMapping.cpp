@@ -172,7 +172,7 @@ void JoyMapping::addMappingsFromStrings(const char **mappingStrings)
 
 void JoyMapping::addMappingsFromFile(const char *filename)
 {
-	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filename);
+	nctl::UniquePtr<IFile> fileHandle = IFile::createReadFileHandle(filename);
 	fileHandle->open(IFile::OpenMode::READ);
 
 	const long int fileSize = fileHandle->size();
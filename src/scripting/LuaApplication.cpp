@@ -40,6 +40,7 @@ namespace Application {
 		static const char *cullingEnabled = "culling";
 		static const char *minBatchSize = "min_batch_size";
 		static const char *maxBatchSize = "max_batch_size";
+		static const char *maxBatchTextures = "max_batch_textures";
 	}
 
 	namespace DebugOverlaySettings {
@@ -89,12 +90,13 @@ int LuaApplication::renderingSettings(lua_State *L)
 {
 	const Application::RenderingSettings &settings = theApplication().renderingSettings();
 
-	lua_createtable(L, 5, 0);
+	lua_createtable(L, 6, 0);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::batchingEnabled, settings.batchingEnabled);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::batchingWithIndices, settings.batchingWithIndices);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::cullingEnabled, settings.cullingEnabled);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::minBatchSize, settings.minBatchSize);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::maxBatchSize, settings.maxBatchSize);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::maxBatchTextures, settings.maxBatchTextures);
 
 	return 1;
 }
@@ -111,6 +113,7 @@ int LuaApplication::setRenderingSettings(lua_State *L)
 	settings.cullingEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::cullingEnabled);
 	settings.minBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::minBatchSize);
 	settings.maxBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::maxBatchSize);
+	LuaUtils::tryRetrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::maxBatchTextures, settings.maxBatchTextures);
 
 	return 0;
 }
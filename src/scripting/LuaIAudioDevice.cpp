@@ -4,6 +4,8 @@
 #include "LuaIAudioDevice.h"
 #include "LuaUtils.h"
 #include "LuaClassWrapper.h"
+#include "LuaVector3Utils.h"
+#include "AudioBuffer.h"
 
 namespace ncine {
 
@@ -17,6 +19,7 @@ namespace IAudioDevice {
 	static const char *setGain = "set_gain";
 
 	static const char *numPlayers = "num_players";
+	static const char *numVirtualPlayers = "num_virtual_players";
 	static const char *player = "get_player";
 
 	static const char *pausePlayers = "pause_players";
@@ -24,6 +27,8 @@ namespace IAudioDevice {
 
 	static const char *freezePlayers = "freeze_players";
 	static const char *unfreezePlayers = "unfreeze_players";
+
+	static const char *playOneShot = "play_one_shot";
 }}
 
 ///////////////////////////////////////////////////////////
@@ -40,6 +45,7 @@ void LuaIAudioDevice::expose(lua_State *L)
 	LuaUtils::addFunction(L, LuaNames::IAudioDevice::setGain, setGain);
 
 	LuaUtils::addFunction(L, LuaNames::IAudioDevice::numPlayers, numPlayers);
+	LuaUtils::addFunction(L, LuaNames::IAudioDevice::numVirtualPlayers, numVirtualPlayers);
 	LuaUtils::addFunction(L, LuaNames::IAudioDevice::player, player);
 
 	LuaUtils::addFunction(L, LuaNames::IAudioDevice::pausePlayers, pausePlayers);
@@ -48,6 +54,8 @@ void LuaIAudioDevice::expose(lua_State *L)
 	LuaUtils::addFunction(L, LuaNames::IAudioDevice::freezePlayers, freezePlayers);
 	LuaUtils::addFunction(L, LuaNames::IAudioDevice::unfreezePlayers, unfreezePlayers);
 
+	LuaUtils::addFunction(L, LuaNames::IAudioDevice::playOneShot, playOneShot);
+
 	lua_setfield(L, -2, LuaNames::IAudioDevice::IAudioDevice);
 }
 
@@ -83,6 +91,14 @@ int LuaIAudioDevice::numPlayers(lua_State *L)
 	return 1;
 }
 
+int LuaIAudioDevice::numVirtualPlayers(lua_State *L)
+{
+	const unsigned int numVirtualPlayers = theServiceLocator().audioDevice().numVirtualPlayers();
+	LuaUtils::push(L, numVirtualPlayers);
+
+	return 1;
+}
+
 int LuaIAudioDevice::player(lua_State *L)
 {
 	const int unsigned index = LuaUtils::retrieve<uint32_t>(L, -1);
@@ -116,4 +132,18 @@ int LuaIAudioDevice::unfreezePlayers(lua_State *L)
 	return 0;
 }
 
+int LuaIAudioDevice::playOneShot(lua_State *L)
+{
+	int vectorIndex = 0;
+	const Vector3f position = LuaVector3fUtils::retrieve(L, -1, vectorIndex);
+	const float pitch = LuaUtils::retrieve<float>(L, vectorIndex - 1);
+	const float gain = LuaUtils::retrieve<float>(L, vectorIndex - 2);
+	AudioBuffer *audioBuffer = LuaClassWrapper<AudioBuffer>::unwrapUserData(L, vectorIndex - 3);
+
+	const bool hasPlayed = theServiceLocator().audioDevice().playOneShot(*audioBuffer, gain, pitch, position);
+	LuaUtils::push(L, hasPlayed);
+
+	return 1;
+}
+
 }
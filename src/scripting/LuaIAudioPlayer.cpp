@@ -21,10 +21,14 @@ namespace IAudioPlayer {
 	static const char *isPlaying = "is_playing";
 	static const char *isPaused = "is_paused";
 	static const char *isStopped = "is_stopped";
+	static const char *isVirtual = "is_virtual";
 
 	static const char *isLooping = "is_looping";
 	static const char *setLooping = "set_looping";
 
+	static const char *priority = "get_priority";
+	static const char *setPriority = "set_priority";
+
 	static const char *gain = "get_gain";
 	static const char *setGain = "set_gain";
 	static const char *pitch = "get_pitch";
@@ -52,10 +56,14 @@ void LuaIAudioPlayer::exposeFunctions(lua_State *L)
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::isPlaying, isPlaying);
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::isPaused, isPaused);
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::isStopped, isStopped);
+	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::isVirtual, isVirtual);
 
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::isLooping, isLooping);
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::setLooping, setLooping);
 
+	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::priority, priority);
+	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::setPriority, setPriority);
+
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::gain, gain);
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::setGain, setGain);
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::pitch, pitch);
@@ -171,6 +179,16 @@ int LuaIAudioPlayer::isStopped(lua_State *L)
 	return 1;
 }
 
+int LuaIAudioPlayer::isVirtual(lua_State *L)
+{
+	IAudioPlayer *audioPlayer = LuaClassWrapper<IAudioPlayer>::unwrapUserData(L, -1);
+
+	const bool isVirtual = audioPlayer->isVirtual();
+	LuaUtils::push(L, isVirtual);
+
+	return 1;
+}
+
 int LuaIAudioPlayer::isLooping(lua_State *L)
 {
 	IAudioPlayer *audioPlayer = LuaClassWrapper<IAudioPlayer>::unwrapUserData(L, -1);
@@ -191,6 +209,26 @@ int LuaIAudioPlayer::setLooping(lua_State *L)
 	return 0;
 }
 
+int LuaIAudioPlayer::priority(lua_State *L)
+{
+	IAudioPlayer *audioPlayer = LuaClassWrapper<IAudioPlayer>::unwrapUserData(L, -1);
+
+	const int priority = audioPlayer->priority();
+	LuaUtils::push(L, priority);
+
+	return 1;
+}
+
+int LuaIAudioPlayer::setPriority(lua_State *L)
+{
+	IAudioPlayer *audioPlayer = LuaClassWrapper<IAudioPlayer>::unwrapUserData(L, -2);
+	const int priority = LuaUtils::retrieve<int>(L, -1);
+
+	audioPlayer->setPriority(priority);
+
+	return 0;
+}
+
 int LuaIAudioPlayer::gain(lua_State *L)
 {
 	IAudioPlayer *audioPlayer = LuaClassWrapper<IAudioPlayer>::unwrapUserData(L, -1);
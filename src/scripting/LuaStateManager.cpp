@@ -242,11 +242,17 @@ void LuaStateManager::exposeScriptApi()
 
 bool LuaStateManager::run(const char *filename)
 {
-	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filename);
+	nctl::UniquePtr<IFile> fileHandle = IFile::createMappedFileHandle(filename);
 	LOGI_X("Loading file: \"%s\"", fileHandle->filename());
 
 	fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
 	unsigned long fileSize = fileHandle->size();
+
+	// The script is loaded straight from the memory mapping when available
+	const unsigned char *mappedData = fileHandle->mappedData();
+	if (mappedData != nullptr)
+		return runFromMemory(filename, reinterpret_cast<const char *>(mappedData), fileSize);
+
 	nctl::UniquePtr<char[]> buffer = nctl::makeUnique<char[]>(fileSize);
 	fileHandle->read(buffer.get(), fileSize);
 
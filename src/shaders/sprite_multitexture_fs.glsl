@@ -0,0 +1,31 @@
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D uTexture0;
+uniform sampler2D uTexture1;
+uniform sampler2D uTexture2;
+uniform sampler2D uTexture3;
+in vec2 vTexCoords;
+in vec4 vColor;
+flat in int vTextureSlot;
+out vec4 fragColor;
+
+void main()
+{
+	// Derivatives are computed outside of the branches as they might diverge between neighbouring fragments
+	vec2 dx = dFdx(vTexCoords);
+	vec2 dy = dFdy(vTexCoords);
+
+	vec4 texColor;
+	if (vTextureSlot == 0)
+		texColor = textureGrad(uTexture0, vTexCoords, dx, dy);
+	else if (vTextureSlot == 1)
+		texColor = textureGrad(uTexture1, vTexCoords, dx, dy);
+	else if (vTextureSlot == 2)
+		texColor = textureGrad(uTexture2, vTexCoords, dx, dy);
+	else
+		texColor = textureGrad(uTexture3, vTexCoords, dx, dy);
+
+	fragColor = texColor * vColor;
+}
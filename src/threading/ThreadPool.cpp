@@ -3,6 +3,15 @@
 
 namespace ncine {
 
+namespace {
+
+	using MemoryModel = nctl::Atomic32::MemoryModel;
+
+	/// The worker running on the calling thread, `nullptr` if it is not a worker thread
+	thread_local void *currentWorker = nullptr;
+
+}
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -13,19 +22,23 @@ ThreadPool::ThreadPool()
 }
 
 ThreadPool::ThreadPool(unsigned int numThreads)
-    : threads_(numThreads, nctl::ArrayMode::FIXED_CAPACITY), numThreads_(numThreads)
+    : threads_(numThreads, nctl::ArrayMode::FIXED_CAPACITY), workers_(numThreads, nctl::ArrayMode::FIXED_CAPACITY),
+      numThreads_(numThreads), injectionQueue_(InjectionQueueCapacity), injectionHead_(0),
+      numInjected_(0), numSleeping_(0), shouldQuit_(0),
+      pooledCommands_(nctl::makeUnique<FunctionCommand[]>(NumPooledCommands)), freeCommands_(NumPooledCommands)
 {
-	threadStruct_.queue = &queue_;
-	threadStruct_.queueMutex = &queueMutex_;
-	threadStruct_.queueCV = &queueCV_;
-	threadStruct_.shouldQuit = false;
+	injectionQueue_.setSize(InjectionQueueCapacity);
+	for (unsigned int i = 0; i < NumPooledCommands; i++)
+		freeCommands_.push(&pooledCommands_[i]);
 
-	quitMutex_.lock();
+	// Every deque is created before any thread can try to steal from it
+	for (unsigned int i = 0; i < numThreads_; i++)
+		workers_.pushBack(nctl::makeUnique<Worker>(this, i));
 
 	nctl::String threadName;
 	for (unsigned int i = 0; i < numThreads_; i++)
 	{
-		threads_.emplaceBack(workerFunction, &threadStruct_);
+		threads_.emplaceBack(workerFunction, workers_[i].get());
 #if !defined(__EMSCRIPTEN__)
 	#if !defined(__APPLE__)
 		threadName.format("WorkerThread#%02d", i);
@@ -40,11 +53,30 @@ ThreadPool::ThreadPool(unsigned int numThreads)
 
 ThreadPool::~ThreadPool()
 {
-	threadStruct_.shouldQuit = true;
+	queueMutex_.lock();
+	shouldQuit_.store(1);
 	queueCV_.broadcast();
+	queueMutex_.unlock();
 
 	for (unsigned int i = 0; i < numThreads_; i++)
 		threads_[i].join();
+
+	// Destroying the commands that have not been executed
+	for (unsigned int i = 0; i < numThreads_; i++)
+	{
+		IThreadCommand *command = workers_[i]->deque.pop();
+		while (command != nullptr)
+		{
+			releaseCommand(command);
+			command = workers_[i]->deque.pop();
+		}
+	}
+	IThreadCommand *command = popInjected();
+	while (command != nullptr)
+	{
+		releaseCommand(command);
+		command = popInjected();
+	}
 }
 
 ///////////////////////////////////////////////////////////
@@ -54,11 +86,31 @@ ThreadPool::~ThreadPool()
 void ThreadPool::enqueueCommand(nctl::UniquePtr<IThreadCommand> threadCommand)
 {
 	ASSERT(threadCommand);
+	pushCommand(threadCommand.release());
+}
 
-	queueMutex_.lock();
-	queue_.pushBack(nctl::move(threadCommand));
-	queueCV_.broadcast();
-	queueMutex_.unlock();
+void ThreadPool::enqueue(ThreadFunction function)
+{
+	ASSERT(function);
+
+	FunctionCommand *command = acquireCommand();
+	if (command != nullptr)
+	{
+		command->setFunction(nctl::move(function));
+		pushCommand(command);
+	}
+	else
+		enqueueCommand(nctl::makeUnique<FunctionCommand>(nctl::move(function)));
+}
+
+bool ThreadPool::executePendingCommand()
+{
+	IThreadCommand *command = findCommand(currentPoolWorker());
+	if (command == nullptr)
+		return false;
+
+	executeCommand(command);
+	return true;
 }
 
 ///////////////////////////////////////////////////////////
@@ -67,31 +119,214 @@ void ThreadPool::enqueueCommand(nctl::UniquePtr<IThreadCommand> threadCommand)
 
 void ThreadPool::workerFunction(void *arg)
 {
-	ThreadStruct *threadStruct = static_cast<ThreadStruct *>(arg);
+	Worker *worker = static_cast<Worker *>(arg);
+	ThreadPool *pool = worker->pool;
+	currentWorker = worker;
 
 	LOGD_X("Worker thread %u is starting", Thread::self());
 
-	while (true)
+	while (pool->shouldQuit_.load(MemoryModel::ACQUIRE) == 0)
 	{
-		threadStruct->queueMutex->lock();
-		while (threadStruct->queue->isEmpty() && threadStruct->shouldQuit == false)
-			threadStruct->queueCV->wait(*(threadStruct->queueMutex));
+		IThreadCommand *command = pool->findCommand(worker);
 
-		if (threadStruct->shouldQuit)
+		unsigned int numSpins = 0;
+		while (command == nullptr && numSpins < worker->spinCount && pool->shouldQuit_.load(MemoryModel::RELAXED) == 0)
 		{
-			threadStruct->queueMutex->unlock();
-			break;
+			Thread::yieldExecution();
+			command = pool->findCommand(worker);
+			numSpins++;
+		}
+
+		if (command != nullptr)
+		{
+			// Spinning paid off, the worker will spin for longer the next time
+			if (numSpins > 0 && worker->spinCount < MaxSpinCount)
+				worker->spinCount *= 2;
+
+			pool->executeCommand(command);
+			continue;
 		}
 
-		nctl::UniquePtr<IThreadCommand> threadCommand = nctl::move(threadStruct->queue->front());
-		threadStruct->queue->popFront();
-		threadStruct->queueMutex->unlock();
+		if (worker->spinCount > MinSpinCount)
+			worker->spinCount /= 2;
 
-		LOGD_X("Worker thread %u is executing its command", Thread::self());
-		threadCommand->execute();
+		// The sleeping counter is incremented before checking for commands, so that a concurrent enqueue either
+		// makes its command visible to the check or sees the counter and signals the condition variable
+		pool->queueMutex_.lock();
+		pool->numSleeping_.fetchAdd(1);
+		while (pool->shouldQuit_.load(MemoryModel::RELAXED) == 0 && pool->hasPendingCommands() == false)
+			pool->queueCV_.wait(pool->queueMutex_);
+		pool->numSleeping_.fetchSub(1);
+		pool->queueMutex_.unlock();
 	}
 
+	currentWorker = nullptr;
 	LOGD_X("Worker thread %u is exiting", Thread::self());
 }
 
+ThreadPool::Worker *ThreadPool::currentPoolWorker()
+{
+	Worker *worker = static_cast<Worker *>(currentWorker);
+	return (worker != nullptr && worker->pool == this) ? worker : nullptr;
+}
+
+void ThreadPool::pushCommand(IThreadCommand *command)
+{
+	// A command enqueued by a worker goes to its own deque, without contending for the mutex
+	Worker *worker = currentPoolWorker();
+	if (worker != nullptr && worker->deque.push(command))
+	{
+		wakeWorker();
+		return;
+	}
+
+	queueMutex_.lock();
+	pushInjected(command);
+	if (numSleeping_.load() > 0)
+		queueCV_.signal();
+	queueMutex_.unlock();
+}
+
+FunctionCommand *ThreadPool::acquireCommand()
+{
+	Worker *worker = currentPoolWorker();
+	if (worker != nullptr && worker->freeCommands.isEmpty() == false)
+	{
+		FunctionCommand *command = worker->freeCommands.back();
+		worker->freeCommands.popBack();
+		return command;
+	}
+
+	FunctionCommand *command = nullptr;
+	freeCommands_.pop(command);
+	return command;
+}
+
+void ThreadPool::executeCommand(IThreadCommand *command)
+{
+	command->execute();
+	releaseCommand(command);
+}
+
+void ThreadPool::releaseCommand(IThreadCommand *command)
+{
+	const uintptr_t address = reinterpret_cast<uintptr_t>(command);
+	const uintptr_t poolBegin = reinterpret_cast<uintptr_t>(pooledCommands_.get());
+	const uintptr_t poolEnd = reinterpret_cast<uintptr_t>(pooledCommands_.get() + NumPooledCommands);
+
+	if (address >= poolBegin && address < poolEnd)
+	{
+		FunctionCommand *functionCommand = static_cast<FunctionCommand *>(command);
+		// Destroying the captured state now, instead of when the command is reused
+		functionCommand->resetFunction();
+
+		Worker *worker = currentPoolWorker();
+		if (worker != nullptr && worker->freeCommands.size() < NumWorkerFreeCommands)
+			worker->freeCommands.pushBack(functionCommand);
+		else
+			freeCommands_.push(functionCommand);
+	}
+	else
+	{
+		nctl::UniquePtr<IThreadCommand> threadCommand(command);
+	}
+}
+
+IThreadCommand *ThreadPool::findCommand(Worker *worker)
+{
+	IThreadCommand *command = nullptr;
+	if (worker != nullptr)
+	{
+		command = worker->deque.pop();
+		if (command != nullptr)
+			return command;
+	}
+
+	if (numInjected_.load(MemoryModel::ACQUIRE) > 0)
+	{
+		queueMutex_.lock();
+		command = popInjected();
+		queueMutex_.unlock();
+		if (command != nullptr)
+			return command;
+	}
+
+	// Trying to steal from every other worker, starting from a random one to spread the contention
+	unsigned int firstVictim = 0;
+	if (worker != nullptr)
+	{
+		worker->randomState ^= worker->randomState << 13;
+		worker->randomState ^= worker->randomState >> 17;
+		worker->randomState ^= worker->randomState << 5;
+		firstVictim = worker->randomState % numThreads_;
+	}
+
+	for (unsigned int i = 0; i < numThreads_; i++)
+	{
+		const unsigned int victimIndex = (firstVictim + i) % numThreads_;
+		if (worker != nullptr && victimIndex == worker->index)
+			continue;
+
+		command = workers_[victimIndex]->deque.steal();
+		if (command != nullptr)
+			return command;
+	}
+
+	return nullptr;
+}
+
+void ThreadPool::pushInjected(IThreadCommand *command)
+{
+	const unsigned int capacity = injectionQueue_.size();
+	const unsigned int numInjected = static_cast<unsigned int>(numInjected_.load(MemoryModel::RELAXED));
+	if (numInjected == capacity)
+	{
+		// Growing the circular queue, moving its commands to the beginning of the new array
+		nctl::Array<IThreadCommand *> newQueue(capacity * 2);
+		newQueue.setSize(capacity * 2);
+		for (unsigned int i = 0; i < numInjected; i++)
+			newQueue[i] = injectionQueue_[(injectionHead_ + i) % capacity];
+		injectionQueue_ = nctl::move(newQueue);
+		injectionHead_ = 0;
+	}
+
+	injectionQueue_[(injectionHead_ + numInjected) % injectionQueue_.size()] = command;
+	numInjected_.store(static_cast<int32_t>(numInjected + 1), MemoryModel::RELEASE);
+}
+
+IThreadCommand *ThreadPool::popInjected()
+{
+	const int32_t numInjected = numInjected_.load(MemoryModel::RELAXED);
+	if (numInjected == 0)
+		return nullptr;
+
+	IThreadCommand *command = injectionQueue_[injectionHead_];
+	injectionHead_ = (injectionHead_ + 1) % injectionQueue_.size();
+	numInjected_.store(numInjected - 1, MemoryModel::RELEASE);
+	return command;
+}
+
+bool ThreadPool::hasPendingCommands()
+{
+	if (numInjected_.load(MemoryModel::RELAXED) > 0)
+		return true;
+
+	for (unsigned int i = 0; i < numThreads_; i++)
+	{
+		if (workers_[i]->deque.isEmpty() == false)
+			return true;
+	}
+	return false;
+}
+
+void ThreadPool::wakeWorker()
+{
+	if (numSleeping_.load() > 0)
+	{
+		queueMutex_.lock();
+		queueCV_.signal();
+		queueMutex_.unlock();
+	}
+}
+
 }
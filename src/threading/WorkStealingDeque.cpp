@@ -0,0 +1,100 @@
+#include "WorkStealingDeque.h"
+#include "IThreadCommand.h"
+
+namespace ncine {
+
+namespace {
+
+	using MemoryModel = nctl::Atomic64::MemoryModel;
+
+	inline int64_t toSlotValue(IThreadCommand *command)
+	{
+		return static_cast<int64_t>(reinterpret_cast<intptr_t>(command));
+	}
+
+	inline IThreadCommand *fromSlotValue(int64_t value)
+	{
+		return reinterpret_cast<IThreadCommand *>(static_cast<intptr_t>(value));
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+WorkStealingDeque::WorkStealingDeque(unsigned int capacity)
+    : mask_(0), top_(0), bottom_(0)
+{
+	unsigned int numSlots = 2;
+	while (numSlots < capacity)
+		numSlots *= 2;
+
+	mask_ = numSlots - 1;
+	slots_ = nctl::makeUnique<nctl::Atomic64[]>(numSlots);
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool WorkStealingDeque::push(IThreadCommand *command)
+{
+	const int64_t bottom = bottom_.load(MemoryModel::RELAXED);
+	const int64_t top = top_.load(MemoryModel::ACQUIRE);
+	if (bottom - top > static_cast<int64_t>(mask_))
+		return false;
+
+	slots_[bottom & mask_].store(toSlotValue(command), MemoryModel::RELAXED);
+	// Sequentially consistent, so that a sleeping worker either sees the command or is woken up
+	bottom_.store(bottom + 1, MemoryModel::SEQ_CST);
+	return true;
+}
+
+IThreadCommand *WorkStealingDeque::pop()
+{
+	const int64_t bottom = bottom_.load(MemoryModel::RELAXED) - 1;
+	bottom_.store(bottom, MemoryModel::SEQ_CST);
+	int64_t top = top_.load(MemoryModel::SEQ_CST);
+
+	if (top > bottom)
+	{
+		// The deque was empty
+		bottom_.store(bottom + 1, MemoryModel::RELAXED);
+		return nullptr;
+	}
+
+	IThreadCommand *command = fromSlotValue(slots_[bottom & mask_].load(MemoryModel::RELAXED));
+	if (top == bottom)
+	{
+		// The last command in the deque, racing against the thieves
+		if (top_.cmpExchange(top + 1, top, MemoryModel::SEQ_CST) == false)
+			command = nullptr;
+		bottom_.store(bottom + 1, MemoryModel::RELAXED);
+	}
+
+	return command;
+}
+
+IThreadCommand *WorkStealingDeque::steal()
+{
+	const int64_t top = top_.load(MemoryModel::SEQ_CST);
+	const int64_t bottom = bottom_.load(MemoryModel::SEQ_CST);
+	if (top >= bottom)
+		return nullptr;
+
+	IThreadCommand *command = fromSlotValue(slots_[top & mask_].load(MemoryModel::RELAXED));
+	if (top_.cmpExchange(top + 1, top, MemoryModel::SEQ_CST) == false)
+		return nullptr;
+
+	return command;
+}
+
+bool WorkStealingDeque::isEmpty()
+{
+	const int64_t bottom = bottom_.load(MemoryModel::SEQ_CST);
+	const int64_t top = top_.load(MemoryModel::SEQ_CST);
+	return (top >= bottom);
+}
+
+}
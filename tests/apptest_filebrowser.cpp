@@ -5,6 +5,7 @@
 #include <nctl/algorithms.h>
 #include <ncine/Application.h>
 #include <ncine/FileSystem.h>
+#include <ncine/DirectoryScanner.h>
 #include "apptest_datapath.h"
 
 #ifdef __ANDROID__
@@ -183,18 +184,37 @@ bool fileDialog(FileDialogConfig &config, nctl::String &selection)
 
 	ImGui::BeginChild("File View", ImVec2(0, -ImGui::GetFrameHeightWithSpacing() - 4.0f));
 
-	nc::fs::Directory dir(config.directory.data());
+	// The current and the parent directories are not returned by the scanner
 	dirEntries.clear();
-	while (const char *entryName = dir.readNext())
+	const char *dotEntryNames[2] = { ".", ".." };
+	for (const char *entryName : dotEntryNames)
 	{
-		DirEntry entry;
 		filePath = nc::fs::joinPath(config.directory, entryName);
+		if (nc::fs::isDirectory(filePath.data()) == false)
+			continue;
+
+		DirEntry entry;
 		entry.name = entryName;
-		entry.isHidden = nc::fs::isHidden(filePath.data());
-		entry.size = nc::fs::fileSize(filePath.data());
 		entry.date = nc::fs::lastModificationTime(filePath.data());
 		entry.permissions = nc::fs::permissions(filePath.data());
-		entry.isDirectory = nc::fs::isDirectory(filePath.data());
+		entry.isDirectory = true;
+		dirEntries.pushBack(entry);
+	}
+
+	nc::DirectoryScanner::Options scanOptions;
+	scanOptions.recursive = false;
+	const nctl::SharedPtr<nc::DirectoryScanner::Result> scanResult = nc::DirectoryScanner::scan(config.directory.data(), scanOptions);
+	const unsigned int numScannedEntries = (scanResult != nullptr) ? scanResult->entries.size() : 0;
+	for (unsigned int i = 0; i < numScannedEntries; i++)
+	{
+		const nc::DirectoryScanner::Entry &scannedEntry = scanResult->entries[i];
+		DirEntry entry;
+		entry.name = scannedEntry.path;
+		entry.isHidden = scannedEntry.isHidden;
+		entry.size = scannedEntry.size;
+		entry.date = nc::DirectoryScanner::fileDate(scannedEntry.modificationTime);
+		entry.permissions = scannedEntry.permissions;
+		entry.isDirectory = scannedEntry.isDirectory;
 
 		if (config.extensions == nullptr || entry.isDirectory)
 			dirEntries.pushBack(entry);
@@ -213,7 +233,6 @@ bool fileDialog(FileDialogConfig &config, nctl::String &selection)
 			}
 		}
 	}
-	dir.close();
 
 	nctl::quicksort(dirEntries.begin(), dirEntries.end(), [&config](const DirEntry &entry1, const DirEntry &entry2) {
 		if (config.sortDirectoriesfirst)
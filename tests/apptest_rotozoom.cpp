@@ -44,7 +44,7 @@ void MyEventHandler::onInit()
 	nc::SceneNode &rootNode = nc::theApplication().rootNode();
 
 #if LOAD_FROM_MEMORY
-	nctl::UniquePtr<nc::IFile> megaTextureFile = nc::IFile::createFileHandle(prefixDataPath("textures", TextureFile).data());
+	nctl::UniquePtr<nc::IFile> megaTextureFile = nc::IFile::createReadFileHandle(prefixDataPath("textures", TextureFile).data());
 	uint8_t megaTextureBuffer[24 * 1024];
 	megaTextureFile->open(nc::IFile::OpenMode::READ);
 	const unsigned long int megaTextureBufferSize = megaTextureFile->size();
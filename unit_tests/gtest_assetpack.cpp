@@ -0,0 +1,234 @@
+#include <ncine/AssetPack.h>
+#include <ncine/AssetPackBuilder.h>
+#include <ncine/FileSystem.h>
+#include <ncine/IFile.h>
+#include <ncine/VirtualFileSystem.h>
+#include "AssetPackFormat.h"
+#include "gtest/gtest.h"
+#include "test_file_functions.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const char *PackFilename = "TestPack.ncpk";
+const char *MountPoint = "PackMount";
+const unsigned int TextSize = 4096;
+const unsigned int NoiseSize = 1024;
+
+class AssetPackTest : public ::testing::Test
+{
+  public:
+	void SetUp() override
+	{
+		// Repeated text compresses well, noise does not
+		const char *line = "The quick brown fox jumps over the lazy dog. ";
+		const unsigned int lineLength = strlen(line);
+		for (unsigned int i = 0; i < TextSize; i++)
+			text_[i] = static_cast<unsigned char>(line[i % lineLength]);
+
+		uint32_t state = 12345;
+		for (unsigned int i = 0; i < NoiseSize; i++)
+		{
+			state = state * 1664525U + 1013904223U;
+			noise_[i] = static_cast<unsigned char>(state >> 24);
+		}
+
+		nc::AssetPackBuilder builder;
+		builder.setAlignment(64);
+		builder.addBuffer("text/fox.txt", text_, TextSize);
+		builder.addBuffer("./noise.bin", noise_, NoiseSize);
+		builder.addBuffer("empty.bin", nullptr, 0);
+		ASSERT_EQ(builder.numEntries(), 3u);
+		ASSERT_TRUE(builder.saveToFile(PackFilename));
+	}
+
+	void TearDown() override
+	{
+		nc::VirtualFileSystem::unmountAll();
+		nc::fs::deleteFile(PackFilename);
+	}
+
+	unsigned char text_[TextSize];
+	unsigned char noise_[NoiseSize];
+};
+
+TEST_F(AssetPackTest, OpenAndFindEntries)
+{
+	printf("Opening an asset pack and looking up its entries\n");
+	nc::AssetPack pack(PackFilename);
+	ASSERT_TRUE(pack.isValid());
+	ASSERT_EQ(pack.numEntries(), 3u);
+
+	const int textIndex = pack.findEntry("text/fox.txt");
+	const int noiseIndex = pack.findEntry("noise.bin");
+	ASSERT_GE(textIndex, 0);
+	ASSERT_GE(noiseIndex, 0);
+	ASSERT_EQ(pack.findEntry("text/fox.png"), -1);
+	ASSERT_EQ(pack.findEntry("text"), -1);
+	ASSERT_EQ(pack.findEntry("text\\fox.txt"), textIndex);
+
+	ASSERT_STREQ(pack.entryPath(textIndex).data(), "text/fox.txt");
+	ASSERT_EQ(pack.entrySize(textIndex), TextSize);
+	ASSERT_EQ(pack.entrySize(noiseIndex), NoiseSize);
+	ASSERT_TRUE(pack.isEntryCompressed(textIndex));
+	ASSERT_FALSE(pack.isEntryCompressed(noiseIndex));
+}
+
+TEST_F(AssetPackTest, ReadMountedEntries)
+{
+	printf("Reading compressed and uncompressed entries from a mounted asset pack\n");
+	ASSERT_TRUE(nc::VirtualFileSystem::mountPack(PackFilename, MountPoint));
+	ASSERT_EQ(nc::VirtualFileSystem::numMounts(), 1u);
+
+	const nctl::String textPath = nc::fs::joinPath(MountPoint, "text/fox.txt");
+	ASSERT_TRUE(nc::VirtualFileSystem::isFile(textPath.data()));
+	nctl::UniquePtr<nc::IFile> textFile = nc::IFile::createReadFileHandle(textPath.data());
+	ASSERT_EQ(textFile->type(), nc::IFile::FileType::PACK);
+	textFile->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+	ASSERT_TRUE(textFile->isOpened());
+	ASSERT_EQ(textFile->size(), TextSize);
+
+	unsigned char buffer[TextSize];
+	ASSERT_EQ(textFile->read(buffer, TextSize), TextSize);
+	ASSERT_EQ(memcmp(buffer, text_, TextSize), 0);
+	ASSERT_EQ(textFile->read(buffer, 1), 0u);
+
+	const nctl::String noisePath = nc::fs::joinPath(MountPoint, "noise.bin");
+	nctl::UniquePtr<nc::IFile> noiseFile = nc::IFile::createMappedFileHandle(noisePath.data());
+	noiseFile->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+	ASSERT_TRUE(noiseFile->isOpened());
+	ASSERT_NE(noiseFile->mappedData(), nullptr);
+	ASSERT_EQ(memcmp(noiseFile->mappedData(), noise_, NoiseSize), 0);
+	// Uncompressed entries are used in place and respect the pack alignment
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(noiseFile->mappedData()) % 64, 0u);
+
+	ASSERT_EQ(noiseFile->seek(-16, SEEK_END), static_cast<long int>(NoiseSize - 16));
+	ASSERT_EQ(noiseFile->read(buffer, 32), 16u);
+	ASSERT_EQ(memcmp(buffer, noise_ + NoiseSize - 16, 16), 0);
+}
+
+TEST_F(AssetPackTest, EmptyEntry)
+{
+	printf("Opening an empty entry of a mounted asset pack\n");
+	ASSERT_TRUE(nc::VirtualFileSystem::mountPack(PackFilename, MountPoint));
+
+	const nctl::String emptyPath = nc::fs::joinPath(MountPoint, "empty.bin");
+	nctl::UniquePtr<nc::IFile> emptyFile = nc::IFile::createReadFileHandle(emptyPath.data());
+	emptyFile->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+	ASSERT_TRUE(emptyFile->isOpened());
+	ASSERT_EQ(emptyFile->size(), 0);
+}
+
+TEST_F(AssetPackTest, FilesOutsideTheMountPoint)
+{
+	printf("Files outside the mount point or missing from the pack are opened from the file system\n");
+	ASSERT_TRUE(nc::VirtualFileSystem::mountPack(PackFilename, MountPoint));
+
+	nctl::UniquePtr<nc::IFile> outsideFile = nc::IFile::createReadFileHandle("text/fox.txt");
+	ASSERT_NE(outsideFile->type(), nc::IFile::FileType::PACK);
+	const nctl::String missingPath = nc::fs::joinPath(MountPoint, "missing.txt");
+	nctl::UniquePtr<nc::IFile> missingFile = nc::IFile::createReadFileHandle(missingPath.data());
+	ASSERT_NE(missingFile->type(), nc::IFile::FileType::PACK);
+	const nctl::String prefixPath = nctl::String(MountPoint) + "Suffix/text/fox.txt";
+	ASSERT_FALSE(nc::VirtualFileSystem::isFile(prefixPath.data()));
+}
+
+TEST_F(AssetPackTest, UnmountKeepsOpenedFiles)
+{
+	printf("Unmounting an asset pack while one of its files is opened\n");
+	ASSERT_TRUE(nc::VirtualFileSystem::mountPack(PackFilename, MountPoint));
+	ASSERT_FALSE(nc::VirtualFileSystem::mountPack(PackFilename, MountPoint));
+
+	const nctl::String noisePath = nc::fs::joinPath(MountPoint, "noise.bin");
+	nctl::UniquePtr<nc::IFile> noiseFile = nc::IFile::createReadFileHandle(noisePath.data());
+	ASSERT_TRUE(nc::VirtualFileSystem::unmount(PackFilename));
+	ASSERT_EQ(nc::VirtualFileSystem::numMounts(), 0u);
+	ASSERT_FALSE(nc::VirtualFileSystem::isFile(noisePath.data()));
+
+	noiseFile->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+	ASSERT_TRUE(noiseFile->isOpened());
+	ASSERT_EQ(memcmp(noiseFile->mappedData(), noise_, NoiseSize), 0);
+}
+
+TEST_F(AssetPackTest, DuplicatePathsAndOverrides)
+{
+	printf("The last entry added with a path wins, and the last mounted pack overrides the previous ones\n");
+	const char *overrideFilename = "TestPackOverride.ncpk";
+	const unsigned char first[] = "first";
+	const unsigned char second[] = "second";
+
+	nc::AssetPackBuilder builder;
+	builder.addBuffer("noise.bin", first, sizeof(first));
+	builder.addBuffer("noise.bin", second, sizeof(second));
+	ASSERT_TRUE(builder.saveToFile(overrideFilename));
+
+	ASSERT_TRUE(nc::VirtualFileSystem::mountPack(PackFilename, MountPoint));
+	ASSERT_TRUE(nc::VirtualFileSystem::mountPack(overrideFilename, MountPoint));
+
+	const nctl::String noisePath = nc::fs::joinPath(MountPoint, "noise.bin");
+	nctl::UniquePtr<nc::IFile> noiseFile = nc::IFile::createReadFileHandle(noisePath.data());
+	noiseFile->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+	ASSERT_EQ(noiseFile->size(), static_cast<long int>(sizeof(second)));
+	ASSERT_STREQ(reinterpret_cast<const char *>(noiseFile->mappedData()), "second");
+	noiseFile.reset(nullptr);
+
+	nc::VirtualFileSystem::unmountAll();
+	nc::fs::deleteFile(overrideFilename);
+}
+
+TEST_F(AssetPackTest, RejectCorruptedPack)
+{
+	printf("A truncated asset pack is rejected\n");
+	const char *truncatedFilename = "TestPackTruncated.ncpk";
+	{
+		nctl::UniquePtr<nc::IFile> packFile = nc::IFile::createReadFileHandle(PackFilename);
+		packFile->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+		const unsigned long int size = packFile->size() - 100;
+		nctl::UniquePtr<unsigned char[]> buffer = nctl::makeUnique<unsigned char[]>(size);
+		packFile->read(buffer.get(), size);
+
+		nctl::UniquePtr<nc::IFile> truncatedFile = nc::IFile::createFileHandle(truncatedFilename);
+		truncatedFile->open(nc::IFile::OpenMode::WRITE | nc::IFile::OpenMode::BINARY);
+		truncatedFile->write(buffer.get(), size);
+	}
+
+	nc::AssetPack pack(truncatedFilename);
+	ASSERT_FALSE(pack.isValid());
+	ASSERT_FALSE(nc::VirtualFileSystem::mountPack(truncatedFilename, MountPoint));
+	nc::fs::deleteFile(truncatedFilename);
+}
+
+TEST_F(AssetPackTest, RejectOverflowingEntry)
+{
+	printf("An asset pack entry whose data offset and size overflow when summed is rejected\n");
+	const char *corruptFilename = "TestPackOverflow.ncpk";
+	unsigned long int size = 0;
+	nctl::UniquePtr<unsigned char[]> buffer;
+	{
+		nctl::UniquePtr<nc::IFile> packFile = nc::IFile::createReadFileHandle(PackFilename);
+		packFile->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+		size = packFile->size();
+		buffer = nctl::makeUnique<unsigned char[]>(size);
+		packFile->read(buffer.get(), size);
+	}
+
+	nc::AssetPackFormat::Header header;
+	memcpy(&header, buffer.get(), sizeof(nc::AssetPackFormat::Header));
+	const unsigned long int entryOffset = sizeof(nc::AssetPackFormat::Header) + nc::IFile::int32FromLE(header.numSlots) * sizeof(uint32_t);
+	nc::AssetPackFormat::Entry entry;
+	memcpy(&entry, buffer.get() + entryOffset, sizeof(nc::AssetPackFormat::Entry));
+	// The sum wraps around to a small value that is inside the file
+	entry.dataOffset = nc::IFile::int64FromLE(0xFFFFFFFFFFFFFF00ULL);
+	entry.storedSize = nc::IFile::int64FromLE(0x200ULL);
+	entry.size = entry.storedSize;
+	entry.flags = 0;
+	memcpy(buffer.get() + entryOffset, &entry, sizeof(nc::AssetPackFormat::Entry));
+	ASSERT_TRUE(writeFile(corruptFilename, buffer.get(), size));
+
+	nc::AssetPack pack(corruptFilename);
+	ASSERT_FALSE(pack.isValid());
+	nc::fs::deleteFile(corruptFilename);
+}
+
+}
@@ -0,0 +1,173 @@
+#include <ncine/AsyncFileReader.h>
+#include <ncine/FileSystem.h>
+#include "gtest/gtest.h"
+#include "test_file_functions.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const char *Filename = "AsyncFileReaderTest.bin";
+const char *MissingFilename = "AsyncFileReaderMissing.bin";
+const unsigned int FileSize = 64 * 1024;
+
+struct CallbackData
+{
+	unsigned int numCompleted = 0;
+	unsigned int numFailed = 0;
+};
+
+void completionCallback(const nc::AsyncRead &read, void *userData)
+{
+	CallbackData *data = static_cast<CallbackData *>(userData);
+	if (read.state() == nc::AsyncRead::State::COMPLETED)
+		data->numCompleted++;
+	else
+		data->numFailed++;
+}
+
+class AsyncFileReaderTest : public ::testing::Test
+{
+  public:
+	void SetUp() override
+	{
+		for (unsigned int i = 0; i < FileSize; i++)
+			content_[i] = static_cast<unsigned char>((i * 7) ^ (i >> 8));
+
+		ASSERT_TRUE(writeFile(Filename, content_, FileSize));
+	}
+
+	void TearDown() override
+	{
+		nc::fs::deleteFile(Filename);
+	}
+
+	unsigned char content_[FileSize];
+};
+
+TEST_F(AsyncFileReaderTest, ReadWholeFile)
+{
+	printf("Reading a whole file without a worker thread\n");
+	nc::AsyncFileReader reader(false);
+	nctl::SharedPtr<nc::AsyncRead> read = reader.readFile(Filename);
+	ASSERT_EQ(reader.numPendingReads(), 1u);
+
+	reader.wait(*read);
+	ASSERT_EQ(read->state(), nc::AsyncRead::State::COMPLETED);
+	ASSERT_EQ(read->size(), FileSize);
+	ASSERT_EQ(memcmp(read->data(), content_, FileSize), 0);
+
+	reader.update();
+	ASSERT_EQ(reader.numPendingReads(), 0u);
+	nctl::UniquePtr<unsigned char[]> data = read->takeData();
+	ASSERT_NE(data.get(), nullptr);
+	ASSERT_EQ(data[100], content_[100]);
+}
+
+TEST_F(AsyncFileReaderTest, ReadWholeFileWithWorkerThread)
+{
+	printf("Reading a whole file with a worker thread\n");
+	nc::AsyncFileReader reader(true);
+	nctl::SharedPtr<nc::AsyncRead> read = reader.readFile(Filename);
+	ASSERT_EQ(reader.numPendingReads(), 1u);
+
+	reader.wait(*read);
+	ASSERT_EQ(read->state(), nc::AsyncRead::State::COMPLETED);
+	ASSERT_EQ(read->size(), FileSize);
+	ASSERT_EQ(memcmp(read->data(), content_, FileSize), 0);
+
+	reader.update();
+	ASSERT_EQ(reader.numPendingReads(), 0u);
+	nctl::UniquePtr<unsigned char[]> data = read->takeData();
+	ASSERT_NE(data.get(), nullptr);
+	ASSERT_EQ(data[100], content_[100]);
+}
+
+TEST_F(AsyncFileReaderTest, ReadRanges)
+{
+	printf("Reading ranges of a file, including one past its end\n");
+	nc::AsyncFileReader reader(true);
+	nctl::SharedPtr<nc::AsyncRead> last = reader.readRange(Filename, FileSize - 100, 1000);
+	nctl::SharedPtr<nc::AsyncRead> first = reader.readRange(Filename, 0, 4096);
+	nctl::SharedPtr<nc::AsyncRead> middle = reader.readRange(Filename, 32768, 4096);
+	nctl::SharedPtr<nc::AsyncRead> outside = reader.readRange(Filename, FileSize + 1, 16);
+
+	reader.wait(*first);
+	reader.wait(*middle);
+	reader.wait(*last);
+	reader.wait(*outside);
+
+	ASSERT_EQ(first->size(), 4096u);
+	ASSERT_EQ(memcmp(first->data(), content_, 4096), 0);
+	ASSERT_EQ(middle->size(), 4096u);
+	ASSERT_EQ(memcmp(middle->data(), content_ + 32768, 4096), 0);
+	// A range past the end of the file is truncated
+	ASSERT_EQ(last->size(), 100u);
+	ASSERT_EQ(memcmp(last->data(), content_ + FileSize - 100, 100), 0);
+	ASSERT_EQ(outside->state(), nc::AsyncRead::State::FAILED);
+	ASSERT_EQ(outside->data(), nullptr);
+}
+
+TEST_F(AsyncFileReaderTest, OverlappingRangesAreCopied)
+{
+	printf("Overlapping ranges queued together are served with a single read of the shared bytes\n");
+	// Without a worker thread all the queued reads are served as one batch
+	nc::AsyncFileReader reader(false);
+	nctl::SharedPtr<nc::AsyncRead> whole = reader.readFile(Filename);
+	nctl::SharedPtr<nc::AsyncRead> inside = reader.readRange(Filename, 100, 200);
+	nctl::SharedPtr<nc::AsyncRead> duplicate = reader.readFile(Filename);
+	reader.update();
+
+	ASSERT_EQ(reader.numCoalescedReads(), 2u);
+	ASSERT_EQ(whole->size(), FileSize);
+	ASSERT_EQ(memcmp(whole->data(), content_, FileSize), 0);
+	ASSERT_EQ(memcmp(inside->data(), content_ + 100, 200), 0);
+	ASSERT_EQ(memcmp(duplicate->data(), content_, FileSize), 0);
+}
+
+TEST_F(AsyncFileReaderTest, Callbacks)
+{
+	printf("Completion callbacks are invoked by the update function\n");
+	CallbackData callbackData;
+	nc::AsyncFileReader reader(true);
+	nctl::SharedPtr<nc::AsyncRead> read = reader.readFile(Filename, completionCallback, &callbackData);
+	nctl::SharedPtr<nc::AsyncRead> missing = reader.readFile(MissingFilename, completionCallback, &callbackData);
+
+	reader.wait(*read);
+	reader.wait(*missing);
+	ASSERT_EQ(missing->state(), nc::AsyncRead::State::FAILED);
+	ASSERT_EQ(callbackData.numCompleted, 0u);
+
+	reader.update();
+	ASSERT_EQ(callbackData.numCompleted, 1u);
+	ASSERT_EQ(callbackData.numFailed, 1u);
+	ASSERT_EQ(reader.numPendingReads(), 0u);
+}
+
+TEST_F(AsyncFileReaderTest, Cancel)
+{
+	printf("A canceled read is not served and does not invoke its callback\n");
+	CallbackData callbackData;
+	nctl::SharedPtr<nc::AsyncRead> canceled;
+	nctl::SharedPtr<nc::AsyncRead> pending;
+	{
+		nc::AsyncFileReader reader(false);
+		canceled = reader.readFile(Filename, completionCallback, &callbackData);
+		pending = reader.readFile(Filename, completionCallback, &callbackData);
+		ASSERT_TRUE(reader.cancel(*canceled));
+		ASSERT_FALSE(reader.cancel(*canceled));
+
+		reader.wait(*pending);
+		reader.update();
+		ASSERT_EQ(canceled->state(), nc::AsyncRead::State::CANCELED);
+		ASSERT_EQ(canceled->data(), nullptr);
+		ASSERT_EQ(callbackData.numCompleted, 1u);
+		ASSERT_EQ(callbackData.numFailed, 0u);
+
+		pending = reader.readFile(Filename);
+	}
+	// Destroying the reader cancels the reads that have not been served
+	ASSERT_EQ(pending->state(), nc::AsyncRead::State::CANCELED);
+}
+
+}
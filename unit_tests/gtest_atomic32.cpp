@@ -82,4 +82,20 @@ TEST_F(AtomicTest32, CompareAndExchange)
 	ASSERT_EQ(nonAtom_, NumThreads * NumIterations);
 }
 
+TEST_F(AtomicTest32, LoadAndStore)
+{
+	tr_.runThreads([](void *arg) -> ThreadRunner<NumThreads>::threadFuncRet {
+		AtomicTest32 *obj = static_cast<AtomicTest32 *>(arg);
+		// Every thread waits for the value stored by the previous one, then stores the next value
+		const int32_t turn = obj->lock_.fetchAdd(1);
+		while (obj->atom_.load(nctl::Atomic32::MemoryModel::ACQUIRE) != turn) {}
+		obj->atom_.store(turn + 1, nctl::Atomic32::MemoryModel::RELEASE);
+		return static_cast<AtomicTest32 *>(arg)->tr_.retFunc();
+	});
+
+	const int32_t value = atom_.load(nctl::Atomic32::MemoryModel::RELAXED);
+	printf("Loading and storing the atomic in turn with %u threads: %d\n", NumThreads, value);
+	ASSERT_EQ(value, NumThreads);
+}
+
 }
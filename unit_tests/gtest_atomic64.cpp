@@ -82,4 +82,20 @@ TEST_F(AtomicTest64, CompareAndExchange)
 	ASSERT_EQ(nonAtom_, NumThreads * NumIterations);
 }
 
+TEST_F(AtomicTest64, LoadAndStore)
+{
+	tr_.runThreads([](void *arg) -> ThreadRunner<NumThreads>::threadFuncRet {
+		AtomicTest64 *obj = static_cast<AtomicTest64 *>(arg);
+		// Every thread waits for the value stored by the previous one, then stores the next value
+		const int64_t turn = obj->lock_.fetchAdd(1);
+		while (obj->atom_.load(nctl::Atomic64::MemoryModel::ACQUIRE) != turn) {}
+		obj->atom_.store(turn + 1, nctl::Atomic64::MemoryModel::RELEASE);
+		return static_cast<AtomicTest64 *>(arg)->tr_.retFunc();
+	});
+
+	const int64_t value = atom_.load(nctl::Atomic64::MemoryModel::RELAXED);
+	printf("Loading and storing the atomic in turn with %u threads: %ld\n", NumThreads, value);
+	ASSERT_EQ(value, NumThreads);
+}
+
 }
@@ -0,0 +1,182 @@
+#include <ncine/DirectoryScanner.h>
+#include <ncine/ServiceLocator.h>
+#include <ncine/FileSystem.h>
+#include "gtest/gtest.h"
+#include "test_thread_pool.h"
+#include "test_file_functions.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const char *RootDir = "ScannerTestDir";
+const unsigned int NumSubDirs = 4;
+const unsigned int NumFilesPerDir = 8;
+/// The content of the test files, as many bytes as needed by the biggest one
+const char ZeroBytes[NumFilesPerDir] = {};
+
+nctl::String subDirPath(unsigned int dirIndex)
+{
+	nctl::String path(64);
+	path.format("%s/Dir%u", RootDir, dirIndex);
+	return path;
+}
+
+nctl::String filePath(unsigned int dirIndex, unsigned int fileIndex)
+{
+	nctl::String path(64);
+	path.format("%s/Dir%u/File%u.bin", RootDir, dirIndex, fileIndex);
+	return path;
+}
+
+/// Returns the index of the entry with the specified path, or -1
+int findEntry(const nc::DirectoryScanner::Result &result, const char *path)
+{
+	for (unsigned int i = 0; i < result.entries.size(); i++)
+	{
+		if (result.entries[i].path == path)
+			return static_cast<int>(i);
+	}
+	return -1;
+}
+
+class DirectoryScannerTest : public ::testing::Test
+{
+  public:
+	void SetUp() override
+	{
+		ASSERT_TRUE(nc::fs::createDir(RootDir));
+		ASSERT_TRUE(writeFile("ScannerTestDir/.Hidden", ZeroBytes, 1));
+		for (unsigned int i = 0; i < NumSubDirs; i++)
+		{
+			ASSERT_TRUE(nc::fs::createDir(subDirPath(i).data()));
+			for (unsigned int j = 0; j < NumFilesPerDir; j++)
+				ASSERT_TRUE(writeFile(filePath(i, j).data(), ZeroBytes, j));
+		}
+	}
+
+	void TearDown() override
+	{
+		nc::DirectoryScanner::clearCache();
+		for (unsigned int i = 0; i < NumSubDirs; i++)
+		{
+			for (unsigned int j = 0; j < NumFilesPerDir; j++)
+				nc::fs::deleteFile(filePath(i, j).data());
+			nc::fs::deleteEmptyDir(subDirPath(i).data());
+		}
+		nc::fs::deleteFile("ScannerTestDir/.Hidden");
+		nc::fs::deleteEmptyDir(RootDir);
+	}
+
+	void checkTree(const nc::DirectoryScanner::Result &result)
+	{
+		ASSERT_EQ(result.entries.size(), 1 + NumSubDirs * (NumFilesPerDir + 1));
+		ASSERT_EQ(result.numDirectories, NumSubDirs + 1);
+
+		const int hiddenIndex = findEntry(result, ".Hidden");
+		ASSERT_NE(hiddenIndex, -1);
+		ASSERT_TRUE(result.entries[hiddenIndex].isHidden);
+
+		for (unsigned int i = 0; i < NumSubDirs; i++)
+		{
+			nctl::String path(64);
+			path.format("Dir%u", i);
+			const int dirIndex = findEntry(result, path.data());
+			ASSERT_NE(dirIndex, -1);
+			ASSERT_TRUE(result.entries[dirIndex].isDirectory);
+			ASSERT_FALSE(result.entries[dirIndex].isHidden);
+
+			for (unsigned int j = 0; j < NumFilesPerDir; j++)
+			{
+				path.format("Dir%u/File%u.bin", i, j);
+				const int fileIndex = findEntry(result, path.data());
+				ASSERT_GT(fileIndex, dirIndex);
+				ASSERT_FALSE(result.entries[fileIndex].isDirectory);
+				ASSERT_EQ(result.entries[fileIndex].size, static_cast<long int>(j));
+			}
+		}
+	}
+};
+
+TEST_F(DirectoryScannerTest, ScanMissingDirectory)
+{
+	printf("Scanning a missing directory returns an empty result\n");
+	ASSERT_EQ(nc::DirectoryScanner::scan("ScannerMissingDir"), nullptr);
+	ASSERT_EQ(nc::DirectoryScanner::scan(filePath(0, 0).data()), nullptr);
+}
+
+TEST_F(DirectoryScannerTest, ScanTree)
+{
+	printf("Scanning a directory tree without a thread pool\n");
+	nctl::SharedPtr<nc::DirectoryScanner::Result> result = nc::DirectoryScanner::scan(RootDir);
+	ASSERT_NE(result, nullptr);
+	ASSERT_STREQ(result->path.data(), RootDir);
+	checkTree(*result);
+
+	const int fileIndex = findEntry(*result, "Dir0/File1.bin");
+	ASSERT_EQ(result->entries[fileIndex].permissions & nc::fs::Permission::READ, nc::fs::Permission::READ);
+	ASSERT_GT(result->entries[fileIndex].modificationTime, 0);
+	const nc::fs::FileDate date = nc::DirectoryScanner::fileDate(result->entries[fileIndex].modificationTime);
+	ASSERT_GE(date.year, 2000);
+}
+
+TEST_F(DirectoryScannerTest, ScanTreeWithThreadPool)
+{
+	printf("Scanning a directory tree with the workers of a thread pool\n");
+	nc::theServiceLocator().registerThreadPool(nctl::makeUnique<TestThreadPool>(3));
+	nctl::SharedPtr<nc::DirectoryScanner::Result> result = nc::DirectoryScanner::scan(RootDir);
+	nc::theServiceLocator().unregisterThreadPool();
+
+	ASSERT_NE(result, nullptr);
+	checkTree(*result);
+}
+
+TEST_F(DirectoryScannerTest, ScanWithoutRecursion)
+{
+	printf("Scanning a directory without its subdirectories and without metadata\n");
+	nc::DirectoryScanner::Options options;
+	options.recursive = false;
+	options.withMetadata = false;
+	nctl::SharedPtr<nc::DirectoryScanner::Result> result = nc::DirectoryScanner::scan(RootDir, options);
+
+	ASSERT_NE(result, nullptr);
+	ASSERT_EQ(result->entries.size(), NumSubDirs + 1);
+	ASSERT_EQ(result->numDirectories, 1u);
+	const int dirIndex = findEntry(*result, "Dir2");
+	ASSERT_NE(dirIndex, -1);
+	ASSERT_TRUE(result->entries[dirIndex].isDirectory);
+	ASSERT_EQ(result->entries[dirIndex].permissions, 0);
+}
+
+TEST_F(DirectoryScannerTest, Cache)
+{
+	printf("Cached results are returned until they are invalidated\n");
+	nc::DirectoryScanner::Options options;
+	options.useCache = true;
+	nctl::SharedPtr<nc::DirectoryScanner::Result> first = nc::DirectoryScanner::scan(RootDir, options);
+	nctl::SharedPtr<nc::DirectoryScanner::Result> second = nc::DirectoryScanner::scan(RootDir, options);
+	ASSERT_EQ(first, second);
+	ASSERT_EQ(nc::DirectoryScanner::numCachedResults(), 1u);
+
+	// Results with different options are cached separately
+	options.recursive = false;
+	nctl::SharedPtr<nc::DirectoryScanner::Result> shallow = nc::DirectoryScanner::scan(RootDir, options);
+	ASSERT_NE(shallow, first);
+	ASSERT_EQ(nc::DirectoryScanner::numCachedResults(), 2u);
+
+	ASSERT_TRUE(writeFile("ScannerTestDir/New.bin", ZeroBytes, 4));
+	options.recursive = true;
+	ASSERT_EQ(findEntry(*nc::DirectoryScanner::scan(RootDir, options), "New.bin"), -1);
+
+	ASSERT_TRUE(nc::DirectoryScanner::invalidateCache(RootDir));
+	ASSERT_FALSE(nc::DirectoryScanner::invalidateCache(RootDir));
+	ASSERT_EQ(nc::DirectoryScanner::numCachedResults(), 0u);
+	nctl::SharedPtr<nc::DirectoryScanner::Result> updated = nc::DirectoryScanner::scan(RootDir, options);
+	const int newIndex = findEntry(*updated, "New.bin");
+	ASSERT_NE(newIndex, -1);
+	ASSERT_EQ(updated->entries[newIndex].size, 4);
+
+	nc::fs::deleteFile("ScannerTestDir/New.bin");
+}
+
+}
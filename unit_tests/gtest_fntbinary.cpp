@@ -0,0 +1,155 @@
+#include <cstring>
+#include <ncine/FontData.h>
+#include <ncine/FileSystem.h>
+#include <ncine/IFile.h>
+#include "FntParser.h"
+#include "FntBinary.h"
+#include "gtest/gtest.h"
+#include "test_file_functions.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const char *FntFilename = "TestFont.fnt";
+const char *BinaryFilename = "TestFont.nfnt";
+const char *CorruptFilename = "TestFontCorrupt.nfnt";
+
+const char *FntContent =
+    "info face=\"Test Font\" size=32 bold=0 italic=0 charset=\"\" unicode=1 stretchH=100 smooth=1 aa=1 padding=0,0,0,0 spacing=1,1 outline=2\n"
+    "common lineHeight=36 base=29 scaleW=256 scaleH=128 pages=1 packed=0 alphaChnl=1 redChnl=0 greenChnl=0 blueChnl=0\n"
+    "page id=0 file=\"test_font.png\"\n"
+    "chars count=2\n"
+    "char id=65 x=1 y=2 width=20 height=24 xoffset=-1 yoffset=5 xadvance=19 page=0 chnl=15\n"
+    "char id=86 x=22 y=2 width=21 height=24 xoffset=-2 yoffset=5 xadvance=18 page=0 chnl=15\n"
+    "kernings count=1\n"
+    "kerning first=65 second=86 amount=-2\n";
+
+/// Reads a whole file in a buffer aligned to four bytes
+unsigned long int readFile(const char *filename, nctl::UniquePtr<uint32_t[]> &buffer)
+{
+	nctl::UniquePtr<nc::IFile> fileHandle = nc::IFile::createFileHandle(filename);
+	fileHandle->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+	const unsigned long int size = static_cast<unsigned long int>(fileHandle->size());
+	buffer = nctl::makeUnique<uint32_t[]>(size / sizeof(uint32_t) + 1);
+	return fileHandle->read(buffer.get(), size);
+}
+
+class FntBinaryTest : public ::testing::Test
+{
+  public:
+	void SetUp() override
+	{
+		ASSERT_TRUE(writeFile(FntFilename, FntContent));
+		ASSERT_TRUE(nc::FontData::convertToBinary(FntFilename, BinaryFilename));
+	}
+
+	void TearDown() override
+	{
+		nc::fs::deleteFile(CorruptFilename);
+		nc::fs::deleteFile(BinaryFilename);
+		nc::fs::deleteFile(FntFilename);
+	}
+};
+
+TEST_F(FntBinaryTest, RoundTrip)
+{
+	printf("Converting a FNT file to a binary font and loading it back\n");
+	nc::FntParser fntParser(FntFilename);
+	nc::FntBinary fntBinary(BinaryFilename);
+	ASSERT_TRUE(fntBinary.isValid());
+
+	ASSERT_STREQ(fntBinary.infoTag().face.data(), "Test Font");
+	ASSERT_EQ(fntBinary.infoTag().size, fntParser.infoTag().size);
+	ASSERT_EQ(fntBinary.infoTag().outline, fntParser.infoTag().outline);
+	ASSERT_EQ(fntBinary.commonTag().lineHeight, fntParser.commonTag().lineHeight);
+	ASSERT_EQ(fntBinary.commonTag().base, fntParser.commonTag().base);
+	ASSERT_EQ(fntBinary.commonTag().scaleW, fntParser.commonTag().scaleW);
+	ASSERT_EQ(fntBinary.commonTag().scaleH, fntParser.commonTag().scaleH);
+	ASSERT_EQ(fntBinary.commonTag().alphaChnl, fntParser.commonTag().alphaChnl);
+	ASSERT_EQ(fntBinary.numPageTags(), 1u);
+	ASSERT_STREQ(fntBinary.pageTag(0).file.data(), "test_font.png");
+
+	ASSERT_EQ(fntBinary.numCharTags(), fntParser.numCharTags());
+	for (unsigned int i = 0; i < fntBinary.numCharTags(); i++)
+	{
+		const nc::FntBinary::CharTag &record = fntBinary.charTag(i);
+		const nc::FntParser::CharTag &charTag = fntParser.charTag(i);
+		ASSERT_EQ(static_cast<int>(record.id), charTag.id);
+		ASSERT_EQ(record.x, charTag.x);
+		ASSERT_EQ(record.y, charTag.y);
+		ASSERT_EQ(record.width, charTag.width);
+		ASSERT_EQ(record.height, charTag.height);
+		ASSERT_EQ(record.xoffset, charTag.xoffset);
+		ASSERT_EQ(record.yoffset, charTag.yoffset);
+		ASSERT_EQ(record.xadvance, charTag.xadvance);
+		ASSERT_EQ(record.page, charTag.page);
+	}
+
+	ASSERT_EQ(fntBinary.numKerningTags(), 1u);
+	ASSERT_EQ(fntBinary.kerningTag(0).first, 65u);
+	ASSERT_EQ(fntBinary.kerningTag(0).second, 86u);
+	ASSERT_EQ(fntBinary.kerningTag(0).amount, -2);
+}
+
+TEST_F(FntBinaryTest, LoadFromMemory)
+{
+	printf("Using a binary font from a memory buffer\n");
+	nctl::UniquePtr<uint32_t[]> buffer;
+	const unsigned long int size = readFile(BinaryFilename, buffer);
+	const unsigned char *bufferPtr = reinterpret_cast<const unsigned char *>(buffer.get());
+
+	ASSERT_TRUE(nc::FntBinary::hasSignature(bufferPtr, size));
+	nc::FntBinary fntBinary("TestFont", bufferPtr, size);
+	ASSERT_TRUE(fntBinary.isValid());
+	ASSERT_EQ(fntBinary.numCharTags(), 2u);
+	ASSERT_EQ(fntBinary.charTag(1).id, 86u);
+}
+
+TEST_F(FntBinaryTest, RejectTruncated)
+{
+	printf("A truncated binary font is rejected\n");
+	nctl::UniquePtr<uint32_t[]> buffer;
+	const unsigned long int size = readFile(BinaryFilename, buffer);
+	const unsigned char *bufferPtr = reinterpret_cast<const unsigned char *>(buffer.get());
+
+	nc::FntBinary withoutKerning("TestFont", bufferPtr, size - 1);
+	ASSERT_FALSE(withoutKerning.isValid());
+	nc::FntBinary withoutHeader("TestFont", bufferPtr, sizeof(nc::FntBinary::Header) - 1);
+	ASSERT_FALSE(withoutHeader.isValid());
+
+	ASSERT_TRUE(writeFile(CorruptFilename, bufferPtr, size - sizeof(nc::FntBinary::KerningTag)));
+	nc::FntBinary truncatedFile(CorruptFilename);
+	ASSERT_FALSE(truncatedFile.isValid());
+}
+
+TEST_F(FntBinaryTest, RejectCorrupt)
+{
+	printf("A binary font with a corrupt header is rejected\n");
+	nctl::UniquePtr<uint32_t[]> buffer;
+	const unsigned long int size = readFile(BinaryFilename, buffer);
+	unsigned char *bufferPtr = reinterpret_cast<unsigned char *>(buffer.get());
+	nc::FntBinary::Header *header = reinterpret_cast<nc::FntBinary::Header *>(bufferPtr);
+
+	header->version = nc::FntBinary::Version + 1;
+	ASSERT_FALSE(nc::FntBinary("TestFont", bufferPtr, size).isValid());
+	header->version = nc::FntBinary::Version;
+
+	// Character counts that would overflow the expected size in 32 bits
+	const uint32_t numChars = header->numChars;
+	header->numChars = 0xFFFFFFFF;
+	ASSERT_FALSE(nc::FntBinary("TestFont", bufferPtr, size).isValid());
+	header->numChars = numChars;
+
+	header->headerSize++;
+	ASSERT_FALSE(nc::FntBinary("TestFont", bufferPtr, size).isValid());
+	header->headerSize--;
+
+	header->signature = 0x4E464E54; // swapped byte order
+	ASSERT_FALSE(nc::FntBinary::hasSignature(bufferPtr, size));
+	ASSERT_TRUE(writeFile(CorruptFilename, bufferPtr, size));
+	nc::FntBinary corruptFile(CorruptFilename);
+	ASSERT_FALSE(corruptFile.isValid());
+}
+
+}
@@ -0,0 +1,146 @@
+#include <nctl/Function.h>
+#include "gtest/gtest.h"
+
+namespace {
+
+int addOne(int value)
+{
+	return value + 1;
+}
+
+/// A callable object that counts how many instances are alive
+class CountedCallable
+{
+  public:
+	explicit CountedCallable(int &numInstances)
+	    : numInstances_(numInstances) { numInstances_++; }
+	CountedCallable(const CountedCallable &other)
+	    : numInstances_(other.numInstances_) { numInstances_++; }
+	~CountedCallable() { numInstances_--; }
+
+	int operator()(int value) { return value; }
+
+  private:
+	int &numInstances_;
+};
+
+/// A callable object too big to be stored inline
+struct BigCallable
+{
+	explicit BigCallable(int v)
+	{
+		for (unsigned int i = 0; i < 16; i++)
+			values[i] = v;
+	}
+	int operator()(int value) { return value + values[15]; }
+
+	int values[16];
+};
+
+TEST(FunctionTest, Empty)
+{
+	printf("Creating an empty function\n");
+	nctl::Function<void()> function;
+	ASSERT_FALSE(function);
+	ASSERT_FALSE(function.isInline());
+}
+
+TEST(FunctionTest, FromLambda)
+{
+	const int value = 5;
+	printf("Creating a function from a lambda capturing a value\n");
+	nctl::Function<int(int)> function([value](int arg) { return arg + value; });
+	ASSERT_TRUE(function);
+	ASSERT_TRUE(function.isInline());
+	ASSERT_EQ(function(1), 6);
+}
+
+TEST(FunctionTest, FromFunctionPointer)
+{
+	printf("Creating a function from a function pointer\n");
+	nctl::Function<int(int)> function(addOne);
+	ASSERT_TRUE(function.isInline());
+	ASSERT_EQ(function(1), 2);
+}
+
+TEST(FunctionTest, MutableLambda)
+{
+	printf("Calling a lambda that modifies its captured state\n");
+	int counter = 0;
+	nctl::Function<int()> function([counter]() mutable { return ++counter; });
+	function();
+	function();
+	ASSERT_EQ(function(), 3);
+}
+
+TEST(FunctionTest, ReferenceArgument)
+{
+	printf("Calling a function that modifies an argument passed by reference\n");
+	nctl::Function<void(int &)> function([](int &arg) { arg *= 2; });
+	int value = 4;
+	function(value);
+	ASSERT_EQ(value, 8);
+}
+
+TEST(FunctionTest, HeapCallable)
+{
+	printf("Creating a function from a callable that does not fit the inline storage\n");
+	nctl::Function<int(int)> function(BigCallable(10));
+	ASSERT_TRUE(function);
+	ASSERT_FALSE(function.isInline());
+	ASSERT_EQ(function(1), 11);
+}
+
+TEST(FunctionTest, BiggerInlineStorage)
+{
+	printf("Creating a function with an inline storage big enough for the callable\n");
+	nctl::Function<int(int), sizeof(BigCallable)> function(BigCallable(10));
+	ASSERT_TRUE(function.isInline());
+	ASSERT_EQ(function(1), 11);
+}
+
+TEST(FunctionTest, MoveConstruction)
+{
+	printf("Creating functions with move construction\n");
+	nctl::Function<int(int)> inlineFunction(addOne);
+	nctl::Function<int(int)> heapFunction(BigCallable(10));
+
+	nctl::Function<int(int)> newInlineFunction(nctl::move(inlineFunction));
+	nctl::Function<int(int)> newHeapFunction(nctl::move(heapFunction));
+	ASSERT_FALSE(inlineFunction);
+	ASSERT_FALSE(heapFunction);
+	ASSERT_EQ(newInlineFunction(1), 2);
+	ASSERT_EQ(newHeapFunction(1), 11);
+}
+
+TEST(FunctionTest, MoveAssignment)
+{
+	printf("Assigning functions with move assignment\n");
+	int numInstances = 0;
+	nctl::Function<int(int)> function(CountedCallable{ numInstances });
+	ASSERT_EQ(numInstances, 1);
+
+	nctl::Function<int(int)> newFunction(addOne);
+	function = nctl::move(newFunction);
+	ASSERT_EQ(numInstances, 0);
+	ASSERT_FALSE(newFunction);
+	ASSERT_EQ(function(1), 2);
+}
+
+TEST(FunctionTest, Reset)
+{
+	printf("Resetting functions destroys their callable\n");
+	int numInstances = 0;
+	nctl::Function<int(int)> inlineFunction(CountedCallable{ numInstances });
+	{
+		nctl::Function<int(int)> otherFunction(CountedCallable{ numInstances });
+		ASSERT_EQ(numInstances, 2);
+	}
+	ASSERT_EQ(numInstances, 1);
+
+	inlineFunction.reset();
+	ASSERT_FALSE(inlineFunction);
+	ASSERT_EQ(numInstances, 0);
+}
+
+}
@@ -0,0 +1,176 @@
+#include <ncine/MipMapGenerator.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const int Width = 37;
+const int Height = 13;
+const unsigned int NumChannels = 4;
+
+uint8_t boxReference(const uint8_t *src, int srcWidth, int srcHeight, unsigned int numChannels, int x, int y, unsigned int c)
+{
+	const int x0 = x * 2;
+	const int x1 = (x * 2 + 1 < srcWidth) ? x * 2 + 1 : srcWidth - 1;
+	const int y0 = y * 2;
+	const int y1 = (y * 2 + 1 < srcHeight) ? y * 2 + 1 : srcHeight - 1;
+	const unsigned int sum = src[(y0 * srcWidth + x0) * numChannels + c] + src[(y0 * srcWidth + x1) * numChannels + c] +
+	                         src[(y1 * srcWidth + x0) * numChannels + c] + src[(y1 * srcWidth + x1) * numChannels + c];
+	return static_cast<uint8_t>((sum + 2) / 4);
+}
+
+class MipMapGeneratorTest : public ::testing::Test
+{
+  public:
+	void SetUp() override
+	{
+		for (unsigned int i = 0; i < Width * Height * NumChannels; i++)
+			pixels_[i] = static_cast<uint8_t>(i * 37 + 11);
+	}
+
+	uint8_t pixels_[Width * Height * NumChannels];
+};
+
+TEST(MipMapGeneratorLayoutTest, NumLevels)
+{
+	printf("Number of levels of a complete MIP map chain\n");
+	ASSERT_EQ(nc::MipMapGenerator::numLevels(1, 1), 1);
+	ASSERT_EQ(nc::MipMapGenerator::numLevels(256, 256), 9);
+	ASSERT_EQ(nc::MipMapGenerator::numLevels(256, 16), 9);
+	ASSERT_EQ(nc::MipMapGenerator::numLevels(37, 13), 6);
+}
+
+TEST(MipMapGeneratorLayoutTest, LevelSizes)
+{
+	printf("Level sizes are clamped to one pixel\n");
+	ASSERT_EQ(nc::MipMapGenerator::levelSize(37, 1), 18);
+	ASSERT_EQ(nc::MipMapGenerator::levelSize(13, 3), 1);
+	ASSERT_EQ(nc::MipMapGenerator::levelSize(13, 5), 1);
+	// 8x2 + 4x1 + 2x1 + 1x1
+	ASSERT_EQ(nc::MipMapGenerator::chainDataSize(8, 2, 4, 4), (16 + 4 + 2 + 1) * 4UL);
+}
+
+TEST_F(MipMapGeneratorTest, BoxMatchesReference)
+{
+	printf("Box filtering a %dx%d image with %u channels\n", Width, Height, NumChannels);
+	const int destWidth = Width / 2;
+	const int destHeight = Height / 2;
+	uint8_t dest[destWidth * destHeight * NumChannels];
+	nc::MipMapGenerator::downsample(pixels_, Width, Height, NumChannels, dest, nc::MipMapGenerator::Filter::BOX);
+
+	for (int y = 0; y < destHeight; y++)
+	{
+		for (int x = 0; x < destWidth; x++)
+		{
+			for (unsigned int c = 0; c < NumChannels; c++)
+				ASSERT_EQ(dest[(y * destWidth + x) * NumChannels + c], boxReference(pixels_, Width, Height, NumChannels, x, y, c));
+		}
+	}
+}
+
+TEST_F(MipMapGeneratorTest, BoxSingleRowAndChannel)
+{
+	printf("Box filtering a single row image with one channel\n");
+	uint8_t dest[Width / 2];
+	nc::MipMapGenerator::downsample(pixels_, Width, 1, 1, dest, nc::MipMapGenerator::Filter::BOX);
+
+	for (int x = 0; x < Width / 2; x++)
+		ASSERT_EQ(dest[x], boxReference(pixels_, Width, 1, 1, x, 0, 0));
+}
+
+TEST(MipMapGeneratorKaiserTest, ConstantImageStaysConstant)
+{
+	printf("Kaiser filtering a constant image\n");
+	const int size = 16;
+	uint8_t pixels[size * size * 2];
+	for (unsigned int i = 0; i < size * size * 2; i++)
+		pixels[i] = (i % 2) ? 200 : 17;
+
+	uint8_t dest[(size / 2) * (size / 2) * 2];
+	nc::MipMapGenerator::downsample(pixels, size, size, 2, dest, nc::MipMapGenerator::Filter::KAISER);
+
+	for (unsigned int i = 0; i < (size / 2) * (size / 2) * 2; i++)
+		ASSERT_EQ(dest[i], (i % 2) ? 200 : 17);
+}
+
+TEST(MipMapGeneratorKaiserTest, KeepsContrast)
+{
+	printf("Kaiser filtering a checkerboard of 4x4 blocks keeps most of the contrast\n");
+	const int size = 16;
+	uint8_t pixels[size * size];
+	for (int y = 0; y < size; y++)
+	{
+		for (int x = 0; x < size; x++)
+			pixels[y * size + x] = ((x / 4 + y / 4) % 2) ? 255 : 0;
+	}
+
+	uint8_t dest[(size / 2) * (size / 2)];
+	nc::MipMapGenerator::downsample(pixels, size, size, 1, dest, nc::MipMapGenerator::Filter::KAISER);
+
+	for (int y = 0; y < size / 2; y++)
+	{
+		for (int x = 0; x < size / 2; x++)
+		{
+			if ((x / 2 + y / 2) % 2)
+				ASSERT_GT(dest[y * (size / 2) + x], 208);
+			else
+				ASSERT_LT(dest[y * (size / 2) + x], 48);
+		}
+	}
+}
+
+/// Checks every level of a chain against the box filtered previous one, levels are tightly packed
+void checkBoxChain(const uint8_t *pixels, unsigned int numChannels)
+{
+	const int numLevels = nc::MipMapGenerator::numLevels(Width, Height);
+	const unsigned long dataSize = nc::MipMapGenerator::chainDataSize(Width, Height, numChannels, numLevels);
+	uint8_t chain[dataSize];
+	for (unsigned int i = 0; i < Width * Height * numChannels; i++)
+		chain[i] = pixels[i];
+	nc::MipMapGenerator::generate(chain, Width, Height, numChannels, numLevels, nc::MipMapGenerator::Filter::BOX);
+
+	const uint8_t *level = chain;
+	for (int i = 1; i < numLevels; i++)
+	{
+		const int srcWidth = nc::MipMapGenerator::levelSize(Width, i - 1);
+		const int srcHeight = nc::MipMapGenerator::levelSize(Height, i - 1);
+		const int destWidth = nc::MipMapGenerator::levelSize(Width, i);
+		const int destHeight = nc::MipMapGenerator::levelSize(Height, i);
+		const uint8_t *nextLevel = level + srcWidth * srcHeight * numChannels;
+
+		for (int y = 0; y < destHeight; y++)
+		{
+			for (int x = 0; x < destWidth; x++)
+			{
+				for (unsigned int c = 0; c < numChannels; c++)
+					ASSERT_EQ(nextLevel[(y * destWidth + x) * numChannels + c], boxReference(level, srcWidth, srcHeight, numChannels, x, y, c));
+			}
+		}
+		level = nextLevel;
+	}
+	// The last level is a single pixel at the end of the buffer
+	ASSERT_EQ(level + numChannels, chain + dataSize);
+}
+
+TEST_F(MipMapGeneratorTest, GenerateChain)
+{
+	printf("Generating a complete MIP map chain for a %dx%d image\n", Width, Height);
+	checkBoxChain(pixels_, NumChannels);
+}
+
+TEST_F(MipMapGeneratorTest, GenerateRgbChain)
+{
+	printf("Generating a complete MIP map chain for a %dx%d RGB image\n", Width, Height);
+	// Rows of three channel levels are not aligned to four bytes
+	ASSERT_NE((Width * 3) % 4, 0);
+	checkBoxChain(pixels_, 3);
+}
+
+TEST_F(MipMapGeneratorTest, GenerateSingleChannelChain)
+{
+	printf("Generating a complete MIP map chain for a %dx%d single channel image\n", Width, Height);
+	checkBoxChain(pixels_, 1);
+}
+
+}
@@ -0,0 +1,169 @@
+#include <thread>
+#include <nctl/MpmcQueue.h>
+#include "gtest_queues.h"
+#include "test_movable.h"
+#include "test_thread_functions.h"
+
+#if NCINE_WITH_ALLOCATORS
+	#include <nctl/FreeListAllocator.h>
+#endif
+
+namespace {
+
+const unsigned int NumProducers = 4;
+const unsigned int NumConsumers = 4;
+const unsigned int NumThreads = NumProducers + NumConsumers;
+const unsigned int NumElementsPerProducer = NumElements / NumProducers;
+
+class MpmcQueueTest : public ::testing::Test
+{
+  public:
+	MpmcQueueTest()
+	    : queue_(Capacity), tr_(this) {}
+
+	nctl::MpmcQueue<int> queue_;
+	nctl::Atomic32 threadIndex_;
+	nctl::Atomic32 numPopped_;
+	nctl::Atomic64 sum_;
+	ThreadRunner<NumThreads> tr_;
+};
+
+TEST_F(MpmcQueueTest, Capacity)
+{
+	printf("Creating queues with capacities that are not a power of two\n");
+	nctl::MpmcQueue<int> queue1(1);
+	nctl::MpmcQueue<int> queue2(5);
+	nctl::MpmcQueue<int> queue3(64);
+
+	ASSERT_EQ(queue_.capacity(), Capacity);
+	ASSERT_EQ(queue1.capacity(), 1u);
+	ASSERT_EQ(queue2.capacity(), 8u);
+	ASSERT_EQ(queue3.capacity(), 64u);
+	ASSERT_TRUE(queue_.isEmpty());
+	ASSERT_EQ(queue_.size(), 0u);
+}
+
+TEST_F(MpmcQueueTest, PushAndPop)
+{
+	printf("Pushing elements until the queue is full, then popping them\n");
+	for (unsigned int i = 0; i < Capacity; i++)
+		ASSERT_TRUE(queue_.push(static_cast<int>(i)));
+	ASSERT_FALSE(queue_.push(-1));
+	ASSERT_EQ(queue_.size(), Capacity);
+
+	int value = -1;
+	for (unsigned int i = 0; i < Capacity; i++)
+	{
+		ASSERT_TRUE(queue_.pop(value));
+		ASSERT_EQ(value, static_cast<int>(i));
+	}
+	ASSERT_FALSE(queue_.pop(value));
+	ASSERT_TRUE(queue_.isEmpty());
+}
+
+TEST_F(MpmcQueueTest, WrapAround)
+{
+	printf("Pushing and popping more elements than the queue capacity\n");
+	int value = -1;
+	for (unsigned int i = 0; i < Capacity * 10; i++)
+	{
+		ASSERT_TRUE(queue_.push(static_cast<int>(i)));
+		ASSERT_TRUE(queue_.push(static_cast<int>(i)));
+		ASSERT_TRUE(queue_.pop(value));
+		ASSERT_TRUE(queue_.pop(value));
+		ASSERT_EQ(value, static_cast<int>(i));
+	}
+	ASSERT_TRUE(queue_.isEmpty());
+}
+
+TEST_F(MpmcQueueTest, DestructRemainingElements)
+{
+	printf("Destroying a queue that still holds some elements\n");
+	{
+		nctl::MpmcQueue<Counted> queue(Capacity);
+		for (unsigned int i = 0; i < Capacity; i++)
+			queue.emplace(static_cast<int>(i));
+		Counted element;
+		queue.pop(element);
+		queue.emplace(-1);
+		ASSERT_EQ(element.value(), 0);
+		ASSERT_EQ(Counted::numInstances, static_cast<int>(Capacity + 1));
+	}
+	ASSERT_EQ(Counted::numInstances, 0);
+}
+
+TEST_F(MpmcQueueTest, MoveElements)
+{
+	printf("Moving elements in and out of the queue\n");
+	nctl::MpmcQueue<Movable> queue(Capacity);
+	Movable movable(Movable::Construction::INITIALIZED);
+	const unsigned int size = movable.size();
+	queue.push(nctl::move(movable));
+	ASSERT_EQ(movable.size(), 0u);
+
+	Movable popped;
+	ASSERT_TRUE(queue.pop(popped));
+	ASSERT_EQ(popped.size(), size);
+	popped.printAndAssert();
+}
+
+TEST_F(MpmcQueueTest, ProducersConsumers)
+{
+	printf("Passing %u elements from %u producer threads to %u consumer threads\n", NumElements, NumProducers, NumConsumers);
+	tr_.runThreads([](void *arg) -> ThreadRunner<NumThreads>::threadFuncRet {
+		MpmcQueueTest *obj = static_cast<MpmcQueueTest *>(arg);
+		const unsigned int index = static_cast<unsigned int>(obj->threadIndex_.fetchAdd(1));
+		if (index < NumProducers)
+		{
+			for (unsigned int i = 0; i < NumElementsPerProducer; i++)
+			{
+				while (obj->queue_.push(static_cast<int>(index * NumElementsPerProducer + i)) == false)
+					std::this_thread::yield();
+			}
+		}
+		else
+		{
+			int value = -1;
+			while (obj->numPopped_.load() < static_cast<int32_t>(NumElementsPerProducer * NumProducers))
+			{
+				if (obj->queue_.pop(value))
+				{
+					obj->sum_.fetchAdd(value);
+					obj->numPopped_.fetchAdd(1);
+				}
+				else
+					std::this_thread::yield();
+			}
+		}
+		return obj->tr_.retFunc();
+	});
+
+	const int64_t numValues = NumElementsPerProducer * NumProducers;
+	ASSERT_EQ(numPopped_.load(), numValues);
+	ASSERT_EQ(sum_.load(), numValues * (numValues - 1) / 2);
+	ASSERT_TRUE(queue_.isEmpty());
+}
+
+#if NCINE_WITH_ALLOCATORS
+TEST_F(MpmcQueueTest, CustomAllocator)
+{
+	const size_t BufferSize = 4096;
+	uint8_t buffer[BufferSize];
+	nctl::FreeListAllocator allocator(BufferSize, &buffer);
+
+	printf("Creating a queue with a custom allocator\n");
+	{
+		nctl::MpmcQueue<int> queue(Capacity, allocator);
+		ASSERT_EQ(allocator.numAllocations(), 2u);
+		for (unsigned int i = 0; i < Capacity; i++)
+			queue.push(static_cast<int>(i));
+		int value = -1;
+		ASSERT_TRUE(queue.pop(value));
+		ASSERT_EQ(value, 0);
+	}
+	ASSERT_EQ(allocator.numAllocations(), 0u);
+	ASSERT_EQ(allocator.usedMemory(), 0u);
+}
+#endif
+
+}
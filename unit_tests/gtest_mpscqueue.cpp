@@ -0,0 +1,130 @@
+#include <thread>
+#include <nctl/MpscQueue.h>
+#include <nctl/Array.h>
+#include "gtest_queues.h"
+#include "test_thread_functions.h"
+
+namespace {
+
+const unsigned int NumProducers = 4;
+const unsigned int NumElementsPerProducer = NumElements / NumProducers;
+
+struct Node : public nctl::MpscQueueNode
+{
+	Node()
+	    : producer(0), value(0) {}
+	Node(unsigned int p, unsigned int v)
+	    : producer(p), value(v) {}
+
+	unsigned int producer;
+	unsigned int value;
+};
+
+class MpscQueueTest : public ::testing::Test
+{
+  public:
+	MpscQueueTest()
+	    : nodes_(NumElements), numErrors_(0), tr_(this)
+	{
+		for (unsigned int i = 0; i < NumElementsPerProducer * NumProducers; i++)
+			nodes_.emplaceBack(i / NumElementsPerProducer, i % NumElementsPerProducer);
+	}
+
+	nctl::MpscQueue<Node> queue_;
+	nctl::Array<Node> nodes_;
+	nctl::Atomic32 threadIndex_;
+	int numErrors_;
+	ThreadRunner<NumProducers + 1> tr_;
+};
+
+TEST_F(MpscQueueTest, PushAndPop)
+{
+	printf("Pushing some nodes in the queue, then popping them\n");
+	ASSERT_TRUE(queue_.isEmpty());
+	ASSERT_EQ(queue_.pop(), nullptr);
+
+	for (unsigned int i = 0; i < Capacity; i++)
+		queue_.push(&nodes_[i]);
+	ASSERT_FALSE(queue_.isEmpty());
+
+	for (unsigned int i = 0; i < Capacity; i++)
+		ASSERT_EQ(queue_.pop(), &nodes_[i]);
+	ASSERT_EQ(queue_.pop(), nullptr);
+	ASSERT_TRUE(queue_.isEmpty());
+}
+
+TEST_F(MpscQueueTest, PushAndPopOneByOne)
+{
+	printf("Pushing and popping one node at a time, emptying the queue every time\n");
+	for (unsigned int i = 0; i < Capacity; i++)
+	{
+		queue_.push(&nodes_[i]);
+		ASSERT_EQ(queue_.pop(), &nodes_[i]);
+		ASSERT_EQ(queue_.pop(), nullptr);
+		ASSERT_TRUE(queue_.isEmpty());
+	}
+}
+
+TEST_F(MpscQueueTest, PushAgain)
+{
+	printf("Pushing again a node that has already been popped\n");
+	queue_.push(&nodes_[0]);
+	queue_.push(&nodes_[1]);
+	ASSERT_EQ(queue_.pop(), &nodes_[0]);
+	queue_.push(&nodes_[0]);
+	ASSERT_EQ(queue_.pop(), &nodes_[1]);
+	ASSERT_EQ(queue_.pop(), &nodes_[0]);
+	ASSERT_TRUE(queue_.isEmpty());
+}
+
+TEST_F(MpscQueueTest, CopyNode)
+{
+	printf("Copying a node that is in the queue\n");
+	queue_.push(&nodes_[0]);
+	queue_.push(&nodes_[1]);
+	Node copy(nodes_[0]);
+	nodes_[2] = nodes_[0];
+	ASSERT_EQ(copy.value, nodes_[0].value);
+
+	ASSERT_EQ(queue_.pop(), &nodes_[0]);
+	ASSERT_EQ(queue_.pop(), &nodes_[1]);
+	ASSERT_EQ(queue_.pop(), nullptr);
+}
+
+TEST_F(MpscQueueTest, ProducersConsumer)
+{
+	printf("Passing %u nodes from %u producer threads to a consumer thread\n", NumElements, NumProducers);
+	tr_.runThreads([](void *arg) -> ThreadRunner<NumProducers + 1>::threadFuncRet {
+		MpscQueueTest *obj = static_cast<MpscQueueTest *>(arg);
+		const unsigned int index = static_cast<unsigned int>(obj->threadIndex_.fetchAdd(1));
+		if (index < NumProducers)
+		{
+			for (unsigned int i = 0; i < NumElementsPerProducer; i++)
+				obj->queue_.push(&obj->nodes_[index * NumElementsPerProducer + i]);
+		}
+		else
+		{
+			// The nodes of every producer should be popped in the same order they have been pushed
+			unsigned int nextValues[NumProducers] = {};
+			for (unsigned int i = 0; i < NumElementsPerProducer * NumProducers; i++)
+			{
+				Node *node = obj->queue_.pop();
+				while (node == nullptr)
+				{
+					std::this_thread::yield();
+					node = obj->queue_.pop();
+				}
+				if (node->value != nextValues[node->producer])
+					obj->numErrors_++;
+				nextValues[node->producer] = node->value + 1;
+			}
+		}
+		return obj->tr_.retFunc();
+	});
+
+	ASSERT_EQ(numErrors_, 0);
+	ASSERT_EQ(queue_.pop(), nullptr);
+	ASSERT_TRUE(queue_.isEmpty());
+}
+
+}
@@ -0,0 +1,191 @@
+#include <nctl/parallel_algorithms.h>
+#include <nctl/StaticArray.h>
+#include "gtest/gtest.h"
+#include "test_thread_pool.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int Size = 10000;
+
+/// Fills an array with pseudo-random values, with many repetitions
+void fillRandom(nctl::Array<int> &array, unsigned int size)
+{
+	unsigned int state = 12345;
+	array.clear();
+	for (unsigned int i = 0; i < size; i++)
+	{
+		state = state * 1103515245u + 12345u;
+		array.pushBack(static_cast<int>((state >> 16) % 1000));
+	}
+}
+
+class ParallelAlgorithmsTest : public ::testing::Test
+{
+  public:
+	ParallelAlgorithmsTest()
+	    : array_(Size) {}
+
+  protected:
+	void SetUp() override { fillRandom(array_, Size); }
+
+	TestThreadPool threadPool_;
+	nctl::Array<int> array_;
+};
+
+TEST_F(ParallelAlgorithmsTest, ParallelForEveryIndexOnce)
+{
+	printf("Visiting every index of a range in parallel\n");
+	nctl::Array<int> visits(Size);
+	for (unsigned int i = 0; i < Size; i++)
+		visits.pushBack(0);
+
+	nctl::parallelFor(threadPool_, 0, Size, 64, [&](unsigned int i) { visits[i]++; });
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_EQ(visits[i], 1);
+}
+
+TEST_F(ParallelAlgorithmsTest, ParallelForRangeChunks)
+{
+	printf("Visiting a range in chunks that start at multiples of the grain size\n");
+	const unsigned int grainSize = 300;
+	nctl::Array<unsigned int> chunkSizes(Size / grainSize + 1);
+	for (unsigned int i = 0; i < Size / grainSize + 1; i++)
+		chunkSizes.pushBack(0);
+
+	nctl::parallelForRange(threadPool_, 0, Size, grainSize, [&](unsigned int begin, unsigned int end) {
+		chunkSizes[begin / grainSize] = end - begin;
+	});
+
+	unsigned int total = 0;
+	for (unsigned int i = 0; i < chunkSizes.size(); i++)
+	{
+		ASSERT_LE(chunkSizes[i], grainSize);
+		total += chunkSizes[i];
+	}
+	ASSERT_EQ(total, Size);
+}
+
+TEST_F(ParallelAlgorithmsTest, ParallelForEmptyRange)
+{
+	printf("Visiting an empty range\n");
+	bool called = false;
+	nctl::parallelFor(threadPool_, 10, 10, [&](unsigned int i) { called = true; });
+	ASSERT_FALSE(called);
+}
+
+TEST_F(ParallelAlgorithmsTest, ParallelTransform)
+{
+	printf("Transforming an array in parallel\n");
+	nctl::Array<int> result(Size);
+	for (unsigned int i = 0; i < Size; i++)
+		result.pushBack(0);
+
+	nctl::parallelTransform(threadPool_, array_.begin(), array_.end(), result.begin(), [](int value) { return value * 2 + 1; });
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_EQ(result[i], array_[i] * 2 + 1);
+}
+
+TEST_F(ParallelAlgorithmsTest, ParallelReduce)
+{
+	printf("Reducing an array in parallel\n");
+	int expected = 7;
+	for (unsigned int i = 0; i < Size; i++)
+		expected += array_[i];
+
+	const int sum = nctl::parallelReduce(threadPool_, array_.begin(), array_.end(), 7, nctl::Plus<int>, 100);
+	printf("Sum of the elements: %d\n", sum);
+	ASSERT_EQ(sum, expected);
+
+	const int maximum = nctl::parallelReduce(threadPool_, array_.begin(), array_.end(), -1, [](int a, int b) { return (a > b) ? a : b; });
+	ASSERT_EQ(maximum, *nctl::maxElement(array_.begin(), array_.end()));
+}
+
+TEST_F(ParallelAlgorithmsTest, ParallelReduceEmpty)
+{
+	printf("Reducing an empty range in parallel\n");
+	const int sum = nctl::parallelReduce(threadPool_, array_.begin(), array_.begin(), 42, nctl::Plus<int>);
+	ASSERT_EQ(sum, 42);
+}
+
+TEST_F(ParallelAlgorithmsTest, ParallelSort)
+{
+	printf("Sorting an array in parallel\n");
+	nctl::Array<int> expected(Size);
+	for (unsigned int i = 0; i < Size; i++)
+		expected.pushBack(array_[i]);
+	nctl::quicksort(expected.begin(), expected.end());
+
+	nctl::parallelSort(threadPool_, array_.begin(), array_.end());
+
+	ASSERT_TRUE(nctl::isSorted(array_.begin(), array_.end()));
+	ASSERT_TRUE(nctl::equal(array_.begin(), array_.end(), expected.begin()));
+}
+
+TEST_F(ParallelAlgorithmsTest, ParallelSortGrainSizes)
+{
+	printf("Sorting arrays of different sizes in parallel, with different grain sizes\n");
+	const unsigned int sizes[] = { 2, 3, 17, 100, 1000, 4097 };
+	const unsigned int grainSizes[] = { 1, 7, 64, 0 };
+
+	for (unsigned int size : sizes)
+	{
+		for (unsigned int grainSize : grainSizes)
+		{
+			fillRandom(array_, size);
+			nctl::parallelSort(threadPool_, array_.begin(), array_.end(), nctl::IsGreater<int>, grainSize);
+			ASSERT_TRUE(nctl::isSorted(array_.begin(), array_.end(), nctl::IsGreater<int>));
+			ASSERT_EQ(array_.size(), size);
+		}
+	}
+}
+
+TEST_F(ParallelAlgorithmsTest, ParallelSortStaticArray)
+{
+	printf("Sorting a static array in parallel\n");
+	nctl::StaticArray<int, 1000> staticArray;
+	for (unsigned int i = 0; i < 1000; i++)
+		staticArray.pushBack(array_[i]);
+
+	nctl::parallelSort(threadPool_, staticArray.begin(), staticArray.end());
+	ASSERT_TRUE(nctl::isSorted(staticArray.begin(), staticArray.end()));
+}
+
+TEST_F(ParallelAlgorithmsTest, ParallelSortMoveOnly)
+{
+	printf("Sorting an array of move-only elements in parallel\n");
+	nctl::Array<nctl::UniquePtr<int>> pointers(Size);
+	for (unsigned int i = 0; i < Size; i++)
+		pointers.pushBack(nctl::makeUnique<int>(array_[i]));
+
+	nctl::parallelSort(threadPool_, pointers.begin(), pointers.end(),
+	                   [](const nctl::UniquePtr<int> &a, const nctl::UniquePtr<int> &b) { return *a < *b; }, 64);
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_NE(pointers[i].get(), nullptr);
+	for (unsigned int i = 1; i < Size; i++)
+		ASSERT_LE(*pointers[i - 1], *pointers[i]);
+}
+
+TEST_F(ParallelAlgorithmsTest, WithoutThreads)
+{
+	printf("Executing the parallel algorithms without worker threads\n");
+	nc::NullThreadPool nullThreadPool;
+
+	unsigned int numVisits = 0;
+	nctl::parallelFor(nullThreadPool, 0, Size, 16, [&](unsigned int i) { numVisits++; });
+	ASSERT_EQ(numVisits, Size);
+
+	int expected = 0;
+	for (unsigned int i = 0; i < Size; i++)
+		expected += array_[i];
+	ASSERT_EQ(nctl::parallelReduce(nullThreadPool, array_.begin(), array_.end(), 0, nctl::Plus<int>), expected);
+
+	nctl::parallelSort(nullThreadPool, array_.begin(), array_.end());
+	ASSERT_TRUE(nctl::isSorted(array_.begin(), array_.end()));
+}
+
+}
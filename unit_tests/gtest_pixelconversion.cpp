@@ -0,0 +1,91 @@
+#include <ncine/PixelConversion.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+// An odd number of pixels exercises both the vector kernels and the scalar remainder
+const unsigned int NumPixels = 37;
+
+const char *kernelsName(nc::PixelConversion::Kernels kernels)
+{
+	switch (kernels)
+	{
+		case nc::PixelConversion::Kernels::SSE2: return "SSE2";
+		case nc::PixelConversion::Kernels::NEON: return "NEON";
+		default: return "scalar";
+	}
+}
+
+class PixelConversionTest : public ::testing::Test
+{
+  public:
+	void SetUp() override
+	{
+		for (unsigned int i = 0; i < NumPixels * 4; i++)
+			rgba_[i] = static_cast<uint8_t>(i * 37 + 11);
+		for (unsigned int i = 0; i < NumPixels * 3; i++)
+			rgb_[i] = static_cast<uint8_t>(i * 53 + 7);
+	}
+
+	uint8_t rgba_[NumPixels * 4];
+	uint8_t rgb_[NumPixels * 3];
+};
+
+TEST_F(PixelConversionTest, SwapRedBlueInPlace)
+{
+	printf("Swapping red and blue channels of %u pixels in place, twice\n", NumPixels);
+	uint8_t pixels[NumPixels * 4];
+	for (unsigned int i = 0; i < NumPixels * 4; i++)
+		pixels[i] = rgba_[i];
+
+	nc::PixelConversion::swapRedBlue(pixels, pixels, NumPixels);
+	for (unsigned int i = 0; i < NumPixels; i++)
+	{
+		ASSERT_EQ(pixels[i * 4 + 0], rgba_[i * 4 + 2]);
+		ASSERT_EQ(pixels[i * 4 + 1], rgba_[i * 4 + 1]);
+		ASSERT_EQ(pixels[i * 4 + 2], rgba_[i * 4 + 0]);
+		ASSERT_EQ(pixels[i * 4 + 3], rgba_[i * 4 + 3]);
+	}
+
+	nc::PixelConversion::swapRedBlue(pixels, pixels, NumPixels);
+	for (unsigned int i = 0; i < NumPixels * 4; i++)
+		ASSERT_EQ(pixels[i], rgba_[i]);
+}
+
+TEST_F(PixelConversionTest, SwapRedBlueRgb)
+{
+	printf("Converting %u BGR pixels to RGB with %s kernels\n", NumPixels, kernelsName(nc::PixelConversion::kernels()));
+	uint8_t dest[NumPixels * 3];
+	nc::PixelConversion::swapRedBlueRgb(rgb_, dest, NumPixels);
+
+	for (unsigned int i = 0; i < NumPixels; i++)
+	{
+		ASSERT_EQ(dest[i * 3 + 0], rgb_[i * 3 + 2]);
+		ASSERT_EQ(dest[i * 3 + 1], rgb_[i * 3 + 1]);
+		ASSERT_EQ(dest[i * 3 + 2], rgb_[i * 3 + 0]);
+	}
+}
+
+TEST_F(PixelConversionTest, SwapRedBlueRgbInPlace)
+{
+	printf("Swapping red and blue channels of %u three channel pixels in place, twice\n", NumPixels);
+	uint8_t pixels[NumPixels * 3];
+	for (unsigned int i = 0; i < NumPixels * 3; i++)
+		pixels[i] = rgb_[i];
+
+	nc::PixelConversion::swapRedBlueRgb(pixels, pixels, NumPixels);
+	for (unsigned int i = 0; i < NumPixels; i++)
+	{
+		ASSERT_EQ(pixels[i * 3 + 0], rgb_[i * 3 + 2]);
+		ASSERT_EQ(pixels[i * 3 + 1], rgb_[i * 3 + 1]);
+		ASSERT_EQ(pixels[i * 3 + 2], rgb_[i * 3 + 0]);
+	}
+
+	nc::PixelConversion::swapRedBlueRgb(pixels, pixels, NumPixels);
+	for (unsigned int i = 0; i < NumPixels * 3; i++)
+		ASSERT_EQ(pixels[i], rgb_[i]);
+}
+
+}
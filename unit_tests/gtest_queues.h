@@ -0,0 +1,40 @@
+#ifndef GTEST_QUEUES_H
+#define GTEST_QUEUES_H
+
+#include "gtest/gtest.h"
+
+namespace {
+
+const unsigned int Capacity = 32;
+const unsigned int NumElements = 100000;
+
+/// An element that counts how many instances are alive
+class Counted
+{
+  public:
+	static int numInstances;
+
+	Counted()
+	    : value_(0) { numInstances++; }
+	explicit Counted(int value)
+	    : value_(value) { numInstances++; }
+	Counted(const Counted &other)
+	    : value_(other.value_) { numInstances++; }
+	~Counted() { numInstances--; }
+	Counted &operator=(const Counted &other)
+	{
+		value_ = other.value_;
+		return *this;
+	}
+
+	inline int value() const { return value_; }
+
+  private:
+	int value_;
+};
+
+int Counted::numInstances = 0;
+
+}
+
+#endif
@@ -5,6 +5,17 @@ namespace {
 
 const int NumThreads = 100;
 const int NumIterations = 1000;
+const int NumRounds = 10;
+
+/// An object that counts how many times it has been destroyed
+struct Destructible
+{
+	~Destructible() { numDestructions.fetchAdd(1); }
+
+	static nctl::Atomic32 numDestructions;
+};
+
+nctl::Atomic32 Destructible::numDestructions;
 
 class SharedPtrThreadsTest : public ::testing::Test
 {
@@ -13,6 +24,8 @@ class SharedPtrThreadsTest : public ::testing::Test
 	    : ptr_(newObject<int>(Value)), tr_(this) {}
 
 	nctl::SharedPtr<int> ptr_;
+	nctl::SharedPtr<Destructible> owners_[NumThreads];
+	nctl::Atomic32 threadIndex_;
 	ThreadRunner<NumThreads> tr_;
 };
 
@@ -31,4 +44,28 @@ TEST_F(SharedPtrThreadsTest, ShareAssignmentMultithread)
 	ASSERT_EQ(ptr_.useCount(), 1);
 }
 
+TEST_F(SharedPtrThreadsTest, ReleaseMultithread)
+{
+	printf("Releasing the owners of an object from %d threads at the same time, %d times\n", NumThreads, NumRounds);
+	Destructible::numDestructions.store(0);
+	for (int round = 0; round < NumRounds; round++)
+	{
+		nctl::SharedPtr<Destructible> ptr(newObject<Destructible>());
+		for (int i = 0; i < NumThreads; i++)
+			owners_[i] = ptr;
+		ptr = nctl::SharedPtr<Destructible>();
+		threadIndex_.store(0);
+
+		// Only the last owner to be released should destroy the object
+		tr_.runThreads([](void *arg) -> ThreadRunner<NumThreads>::threadFuncRet {
+			SharedPtrThreadsTest *obj = static_cast<SharedPtrThreadsTest *>(arg);
+			const int index = obj->threadIndex_.fetchAdd(1);
+			obj->owners_[index] = nctl::SharedPtr<Destructible>();
+			return obj->tr_.retFunc();
+		});
+
+		ASSERT_EQ(Destructible::numDestructions.load(), round + 1);
+	}
+}
+
 }
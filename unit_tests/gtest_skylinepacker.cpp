@@ -0,0 +1,123 @@
+#include <ncine/SkylinePacker.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const int Width = 256;
+const int Height = 128;
+
+bool overlaps(const nc::Recti &a, const nc::Recti &b)
+{
+	return (a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h);
+}
+
+class SkylinePackerTest : public ::testing::Test
+{
+  public:
+	SkylinePackerTest()
+	    : packer_(Width, Height) {}
+
+	nc::SkylinePacker packer_;
+};
+
+TEST_F(SkylinePackerTest, EmptyPacker)
+{
+	printf("Packing area: %d x %d\n", packer_.width(), packer_.height());
+
+	ASSERT_EQ(packer_.width(), Width);
+	ASSERT_EQ(packer_.height(), Height);
+	ASSERT_EQ(packer_.numRects(), 0u);
+	ASSERT_EQ(packer_.occupancy(), 0.0f);
+}
+
+TEST_F(SkylinePackerTest, InsertFirstRect)
+{
+	nc::Recti rect;
+	const bool inserted = packer_.insert(32, 16, rect);
+	printf("Inserting a 32 x 16 rectangle at <%d, %d>\n", rect.x, rect.y);
+
+	ASSERT_TRUE(inserted);
+	ASSERT_EQ(rect.x, 0);
+	ASSERT_EQ(rect.y, 0);
+	ASSERT_EQ(rect.w, 32);
+	ASSERT_EQ(rect.h, 16);
+	ASSERT_EQ(packer_.numRects(), 1u);
+}
+
+TEST_F(SkylinePackerTest, InsertSideBySide)
+{
+	nc::Recti first, second;
+	packer_.insert(32, 16, first);
+	packer_.insert(32, 16, second);
+	printf("Inserting two 32 x 16 rectangles at <%d, %d> and <%d, %d>\n", first.x, first.y, second.x, second.y);
+
+	ASSERT_EQ(second.x, 32);
+	ASSERT_EQ(second.y, 0);
+}
+
+TEST_F(SkylinePackerTest, InsertTooBig)
+{
+	nc::Recti rect;
+	printf("Inserting rectangles bigger than the packing area\n");
+
+	ASSERT_FALSE(packer_.insert(Width + 1, 1, rect));
+	ASSERT_FALSE(packer_.insert(1, Height + 1, rect));
+	ASSERT_FALSE(packer_.insert(0, 1, rect));
+	ASSERT_EQ(packer_.numRects(), 0u);
+}
+
+TEST_F(SkylinePackerTest, FillCompletely)
+{
+	nc::Recti rect;
+	unsigned int numInserted = 0;
+	while (packer_.insert(16, 16, rect))
+		numInserted++;
+	printf("Inserted %u rectangles of 16 x 16, occupancy: %.2f\n", numInserted, packer_.occupancy());
+
+	ASSERT_EQ(numInserted, (Width / 16) * (Height / 16));
+	ASSERT_EQ(packer_.occupancy(), 1.0f);
+}
+
+TEST_F(SkylinePackerTest, NoOverlaps)
+{
+	const unsigned int MaxRects = 128;
+	nc::Recti rects[MaxRects];
+	unsigned int numRects = 0;
+
+	for (unsigned int i = 0; i < MaxRects; i++)
+	{
+		const int w = 4 + static_cast<int>((i * 7) % 29);
+		const int h = 4 + static_cast<int>((i * 13) % 23);
+		if (packer_.insert(w, h, rects[numRects]))
+			numRects++;
+	}
+	printf("Inserted %u rectangles of different sizes, occupancy: %.2f\n", numRects, packer_.occupancy());
+
+	ASSERT_GT(numRects, 0u);
+	for (unsigned int i = 0; i < numRects; i++)
+	{
+		ASSERT_GE(rects[i].x, 0);
+		ASSERT_GE(rects[i].y, 0);
+		ASSERT_LE(rects[i].x + rects[i].w, Width);
+		ASSERT_LE(rects[i].y + rects[i].h, Height);
+		for (unsigned int j = i + 1; j < numRects; j++)
+			ASSERT_FALSE(overlaps(rects[i], rects[j]));
+	}
+}
+
+TEST_F(SkylinePackerTest, Clear)
+{
+	nc::Recti rect;
+	packer_.insert(64, 64, rect);
+	packer_.clear();
+	packer_.insert(32, 32, rect);
+	printf("Inserting a rectangle after clearing the packer at <%d, %d>\n", rect.x, rect.y);
+
+	ASSERT_EQ(packer_.numRects(), 1u);
+	ASSERT_EQ(rect.x, 0);
+	ASSERT_EQ(rect.y, 0);
+}
+
+}
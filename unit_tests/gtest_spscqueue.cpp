@@ -0,0 +1,156 @@
+#include <thread>
+#include <nctl/SpscQueue.h>
+#include "gtest_queues.h"
+#include "test_movable.h"
+#include "test_thread_functions.h"
+
+#if NCINE_WITH_ALLOCATORS
+	#include <nctl/FreeListAllocator.h>
+#endif
+
+namespace {
+
+class SpscQueueTest : public ::testing::Test
+{
+  public:
+	SpscQueueTest()
+	    : queue_(Capacity), numErrors_(0), tr_(this) {}
+
+	nctl::SpscQueue<int> queue_;
+	nctl::Atomic32 threadIndex_;
+	int numErrors_;
+	ThreadRunner<2> tr_;
+};
+
+TEST_F(SpscQueueTest, Capacity)
+{
+	printf("Creating queues with capacities that are not a power of two\n");
+	nctl::SpscQueue<int> queue1(1);
+	nctl::SpscQueue<int> queue2(5);
+	nctl::SpscQueue<int> queue3(64);
+
+	ASSERT_EQ(queue_.capacity(), Capacity);
+	ASSERT_EQ(queue1.capacity(), 1u);
+	ASSERT_EQ(queue2.capacity(), 8u);
+	ASSERT_EQ(queue3.capacity(), 64u);
+	ASSERT_TRUE(queue_.isEmpty());
+	ASSERT_EQ(queue_.size(), 0u);
+}
+
+TEST_F(SpscQueueTest, PushAndPop)
+{
+	printf("Pushing elements until the queue is full, then popping them\n");
+	for (unsigned int i = 0; i < Capacity; i++)
+		ASSERT_TRUE(queue_.push(static_cast<int>(i)));
+	ASSERT_FALSE(queue_.push(-1));
+	ASSERT_EQ(queue_.size(), Capacity);
+
+	int value = -1;
+	for (unsigned int i = 0; i < Capacity; i++)
+	{
+		ASSERT_TRUE(queue_.pop(value));
+		ASSERT_EQ(value, static_cast<int>(i));
+	}
+	ASSERT_FALSE(queue_.pop(value));
+	ASSERT_TRUE(queue_.isEmpty());
+}
+
+TEST_F(SpscQueueTest, WrapAround)
+{
+	printf("Pushing and popping more elements than the queue capacity\n");
+	int value = -1;
+	for (unsigned int i = 0; i < Capacity * 10; i++)
+	{
+		ASSERT_TRUE(queue_.push(static_cast<int>(i)));
+		ASSERT_TRUE(queue_.push(static_cast<int>(i)));
+		ASSERT_TRUE(queue_.pop(value));
+		ASSERT_TRUE(queue_.pop(value));
+		ASSERT_EQ(value, static_cast<int>(i));
+	}
+	ASSERT_TRUE(queue_.isEmpty());
+}
+
+TEST_F(SpscQueueTest, DestructRemainingElements)
+{
+	printf("Destroying a queue that still holds some elements\n");
+	{
+		nctl::SpscQueue<Counted> queue(Capacity);
+		for (unsigned int i = 0; i < Capacity / 2; i++)
+			queue.emplace(static_cast<int>(i));
+		Counted element;
+		queue.pop(element);
+		ASSERT_EQ(element.value(), 0);
+		ASSERT_EQ(Counted::numInstances, static_cast<int>(Capacity / 2));
+	}
+	ASSERT_EQ(Counted::numInstances, 0);
+}
+
+TEST_F(SpscQueueTest, MoveElements)
+{
+	printf("Moving elements in and out of the queue\n");
+	nctl::SpscQueue<Movable> queue(Capacity);
+	Movable movable(Movable::Construction::INITIALIZED);
+	const unsigned int size = movable.size();
+	queue.push(nctl::move(movable));
+	ASSERT_EQ(movable.size(), 0u);
+
+	Movable popped;
+	ASSERT_TRUE(queue.pop(popped));
+	ASSERT_EQ(popped.size(), size);
+	popped.printAndAssert();
+}
+
+TEST_F(SpscQueueTest, ProducerConsumer)
+{
+	printf("Passing %u elements from a producer thread to a consumer thread\n", NumElements);
+	tr_.runThreads([](void *arg) -> ThreadRunner<2>::threadFuncRet {
+		SpscQueueTest *obj = static_cast<SpscQueueTest *>(arg);
+		if (obj->threadIndex_.fetchAdd(1) == 0)
+		{
+			for (unsigned int i = 0; i < NumElements; i++)
+			{
+				while (obj->queue_.push(static_cast<int>(i)) == false)
+					std::this_thread::yield();
+			}
+		}
+		else
+		{
+			int value = -1;
+			for (unsigned int i = 0; i < NumElements; i++)
+			{
+				while (obj->queue_.pop(value) == false)
+					std::this_thread::yield();
+				if (value != static_cast<int>(i))
+					obj->numErrors_++;
+			}
+		}
+		return obj->tr_.retFunc();
+	});
+
+	ASSERT_EQ(numErrors_, 0);
+	ASSERT_TRUE(queue_.isEmpty());
+}
+
+#if NCINE_WITH_ALLOCATORS
+TEST_F(SpscQueueTest, CustomAllocator)
+{
+	const size_t BufferSize = 4096;
+	uint8_t buffer[BufferSize];
+	nctl::FreeListAllocator allocator(BufferSize, &buffer);
+
+	printf("Creating a queue with a custom allocator\n");
+	{
+		nctl::SpscQueue<int> queue(Capacity, allocator);
+		ASSERT_EQ(allocator.numAllocations(), 1u);
+		for (unsigned int i = 0; i < Capacity; i++)
+			queue.push(static_cast<int>(i));
+		int value = -1;
+		ASSERT_TRUE(queue.pop(value));
+		ASSERT_EQ(value, 0);
+	}
+	ASSERT_EQ(allocator.numAllocations(), 0u);
+	ASSERT_EQ(allocator.usedMemory(), 0u);
+}
+#endif
+
+}
@@ -0,0 +1,179 @@
+#include <ncine/TaskGraph.h>
+#include "gtest/gtest.h"
+#include "test_thread_pool.h"
+
+namespace nc = ncine;
+
+namespace {
+
+/// A thread pool without workers, its commands are only executed by the threads waiting for a task
+class HelpingThreadPool : public nc::IThreadPool
+{
+  public:
+	void enqueueCommand(nctl::UniquePtr<nc::IThreadCommand> threadCommand) override
+	{
+		commands_.pushBack(nctl::move(threadCommand));
+	}
+
+	unsigned int numThreads() const override { return 1; }
+
+	bool executePendingCommand() override
+	{
+		if (commands_.isEmpty())
+			return false;
+
+		nctl::UniquePtr<nc::IThreadCommand> command = nctl::move(commands_.back());
+		commands_.popBack();
+		command->execute();
+		return true;
+	}
+
+	inline unsigned int numPendingCommands() const { return commands_.size(); }
+
+  private:
+	nctl::Array<nctl::UniquePtr<nc::IThreadCommand>> commands_;
+};
+
+/// A command that records the order in which it has been executed
+class OrderCommand : public nc::IThreadCommand
+{
+  public:
+	explicit OrderCommand(nctl::Atomic32 &counter)
+	    : counter_(counter), order_(-1) {}
+
+	void execute() override { order_ = counter_.fetchAdd(1); }
+	inline int order() const { return order_; }
+
+  private:
+	nctl::Atomic32 &counter_;
+	int order_;
+};
+
+int orderOf(nc::Task &task)
+{
+	return static_cast<OrderCommand *>(task.command())->order();
+}
+
+TEST(TaskGraphTest, EnqueueFunctions)
+{
+	printf("Enqueueing lambdas on worker threads\n");
+	nctl::Atomic32 counter;
+	{
+		TestThreadPool threadPool;
+		for (unsigned int i = 0; i < 8; i++)
+			threadPool.enqueue([&counter]() { counter.fetchAdd(1); });
+	}
+	ASSERT_EQ(counter.load(), 8);
+
+	nc::NullThreadPool nullThreadPool;
+	nullThreadPool.enqueue([&counter]() { counter.fetchAdd(1); });
+	ASSERT_EQ(counter.load(), 8);
+}
+
+TEST(TaskGraphTest, SubmitWithoutThreads)
+{
+	printf("Submitting a task to a thread pool without threads\n");
+	nc::NullThreadPool threadPool;
+	nctl::Atomic32 counter;
+
+	nctl::SharedPtr<nc::Task> task = threadPool.submit(nctl::makeUnique<OrderCommand>(counter));
+	ASSERT_TRUE(task->isDone());
+	ASSERT_EQ(orderOf(*task), 0);
+	threadPool.wait(*task);
+}
+
+TEST(TaskGraphTest, ContinuationWithoutThreads)
+{
+	printf("Adding continuations to a task executed without threads\n");
+	nc::NullThreadPool threadPool;
+	nctl::Atomic32 counter;
+
+	nctl::SharedPtr<nc::Task> first = nc::Task::create(nctl::makeUnique<OrderCommand>(counter));
+	nctl::SharedPtr<nc::Task> second = threadPool.then(*first, nctl::makeUnique<OrderCommand>(counter));
+	ASSERT_EQ(second->state(), nc::Task::State::WAITING);
+	ASSERT_EQ(second->numPendingDependencies(), 1);
+
+	threadPool.submit(first);
+	ASSERT_TRUE(first->isDone());
+	ASSERT_TRUE(second->isDone());
+	ASSERT_EQ(orderOf(*first), 0);
+	ASSERT_EQ(orderOf(*second), 1);
+
+	// A continuation of a completed task starts immediately
+	nctl::SharedPtr<nc::Task> third = threadPool.then(*first, nctl::makeUnique<OrderCommand>(counter));
+	ASSERT_TRUE(third->isDone());
+	ASSERT_EQ(orderOf(*third), 2);
+}
+
+TEST(TaskGraphTest, WaitExecutesPendingCommands)
+{
+	printf("Waiting for a chain of tasks that is executed by the waiting thread\n");
+	HelpingThreadPool threadPool;
+	nctl::Atomic32 counter;
+
+	nctl::SharedPtr<nc::Task> first = threadPool.submit(nctl::makeUnique<OrderCommand>(counter));
+	nctl::SharedPtr<nc::Task> second = threadPool.then(*first, nctl::makeUnique<OrderCommand>(counter));
+	ASSERT_EQ(threadPool.numPendingCommands(), 1u);
+	ASSERT_FALSE(first->isDone());
+
+	threadPool.wait(*second);
+	ASSERT_TRUE(first->isDone());
+	ASSERT_TRUE(second->isDone());
+	ASSERT_EQ(orderOf(*first), 0);
+	ASSERT_EQ(orderOf(*second), 1);
+	ASSERT_EQ(threadPool.numPendingCommands(), 0u);
+}
+
+TEST(TaskGraphTest, DiamondGraph)
+{
+	printf("Executing a diamond shaped graph on worker threads\n");
+	TestThreadPool threadPool;
+	nctl::Atomic32 counter;
+
+	nc::TaskGraph graph;
+	const unsigned int top = graph.addTask(nctl::makeUnique<OrderCommand>(counter));
+	const unsigned int left = graph.addTask(nctl::makeUnique<OrderCommand>(counter));
+	const unsigned int right = graph.addTask(nctl::makeUnique<OrderCommand>(counter));
+	const unsigned int bottom = graph.addTask(nctl::makeUnique<OrderCommand>(counter));
+	graph.addDependency(left, top);
+	graph.addDependency(right, top);
+	graph.addDependency(bottom, left);
+	graph.addDependency(bottom, right);
+	ASSERT_EQ(graph.numTasks(), 4u);
+	ASSERT_EQ(graph.task(bottom).numPendingDependencies(), 3);
+
+	graph.submit(threadPool);
+	graph.wait(threadPool);
+	ASSERT_TRUE(graph.isDone());
+
+	ASSERT_EQ(orderOf(graph.task(top)), 0);
+	ASSERT_GT(orderOf(graph.task(left)), orderOf(graph.task(top)));
+	ASSERT_GT(orderOf(graph.task(right)), orderOf(graph.task(top)));
+	ASSERT_EQ(orderOf(graph.task(bottom)), 3);
+}
+
+TEST(TaskGraphTest, WideGraph)
+{
+	printf("Executing a graph where a task depends on many others\n");
+	TestThreadPool threadPool;
+	nctl::Atomic32 counter;
+	const unsigned int NumTasks = 32;
+
+	nc::TaskGraph graph;
+	const unsigned int last = graph.addTask(nctl::makeUnique<OrderCommand>(counter));
+	for (unsigned int i = 0; i < NumTasks; i++)
+	{
+		const unsigned int index = graph.addTask(nctl::makeUnique<OrderCommand>(counter));
+		graph.addDependency(last, index);
+	}
+
+	graph.submit(threadPool);
+	graph.wait(threadPool);
+	ASSERT_TRUE(graph.isDone());
+	ASSERT_EQ(orderOf(graph.task(last)), static_cast<int>(NumTasks));
+
+	graph.clear();
+	ASSERT_EQ(graph.numTasks(), 0u);
+}
+
+}
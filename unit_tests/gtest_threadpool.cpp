@@ -0,0 +1,130 @@
+#include <thread>
+#include <nctl/Atomic.h>
+#include "ThreadPool.h"
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int NumThreads = 4;
+/// More functions than the commands pooled by the thread pool, so that some of them are wrapped in allocated commands
+const unsigned int NumFunctions = 4 * 1024;
+/// The number of functions enqueued by every function of the nested test
+const unsigned int NumNested = 128;
+const unsigned int NumOuter = NumFunctions / NumNested;
+const unsigned int NumRounds = 4;
+
+/// An object that counts how many instances are alive, from any thread
+class Counted
+{
+  public:
+	Counted() { numInstances.fetchAdd(1); }
+	Counted(const Counted &) { numInstances.fetchAdd(1); }
+	~Counted() { numInstances.fetchSub(1); }
+
+	static nctl::Atomic32 numInstances;
+};
+
+nctl::Atomic32 Counted::numInstances;
+
+/// Executes the pending commands on the calling thread until the specified number of functions have been executed
+void waitFor(nc::ThreadPool &threadPool, nctl::Atomic32 &numExecuted, unsigned int numFunctions)
+{
+	while (numExecuted.load() < static_cast<int32_t>(numFunctions))
+	{
+		if (threadPool.executePendingCommand() == false)
+			std::this_thread::yield();
+	}
+}
+
+TEST(ThreadPoolTest, EnqueueMoreThanPooled)
+{
+	printf("Enqueueing %u functions while the workers are blocked by the first ones\n", NumFunctions);
+	nctl::Atomic32 isOpen(0);
+	nctl::Atomic32 numExecuted(0);
+	nc::ThreadPool threadPool(NumThreads);
+
+	for (unsigned int i = 0; i < NumFunctions; i++)
+	{
+		threadPool.enqueue([&isOpen, &numExecuted]() {
+			while (isOpen.load() == 0)
+				std::this_thread::yield();
+			numExecuted.fetchAdd(1);
+		});
+	}
+	isOpen.store(1);
+
+	waitFor(threadPool, numExecuted, NumFunctions);
+	ASSERT_EQ(numExecuted.load(), static_cast<int32_t>(NumFunctions));
+}
+
+TEST(ThreadPoolTest, EnqueueNestedFunctions)
+{
+	printf("Enqueueing %u functions from %u functions executed by the workers, %u times\n", NumOuter * NumNested, NumOuter, NumRounds);
+	nctl::Atomic32 numExecuted(0);
+	nc::ThreadPool threadPool(NumThreads);
+
+	// The pooled commands released by a round are reused by the next one, from the worker free lists or the shared queue
+	for (unsigned int round = 0; round < NumRounds; round++)
+	{
+		numExecuted.store(0);
+		for (unsigned int i = 0; i < NumOuter; i++)
+		{
+			threadPool.enqueue([&threadPool, &numExecuted]() {
+				for (unsigned int j = 0; j < NumNested; j++)
+					threadPool.enqueue([&numExecuted]() { numExecuted.fetchAdd(1); });
+				numExecuted.fetchAdd(1);
+			});
+		}
+
+		waitFor(threadPool, numExecuted, NumOuter * (NumNested + 1));
+		ASSERT_EQ(numExecuted.load(), static_cast<int32_t>(NumOuter * (NumNested + 1)));
+	}
+}
+
+TEST(ThreadPoolTest, EnqueueAfterCommands)
+{
+	printf("Mixing enqueued functions with commands\n");
+	nctl::Atomic32 numExecuted(0);
+	nc::ThreadPool threadPool(NumThreads);
+
+	for (unsigned int i = 0; i < NumFunctions; i++)
+	{
+		if (i % 2 == 0)
+			threadPool.enqueue([&numExecuted]() { numExecuted.fetchAdd(1); });
+		else
+			threadPool.enqueueCommand(nctl::makeUnique<nc::FunctionCommand>([&numExecuted]() { numExecuted.fetchAdd(1); }));
+	}
+
+	waitFor(threadPool, numExecuted, NumFunctions);
+	ASSERT_EQ(numExecuted.load(), static_cast<int32_t>(NumFunctions));
+}
+
+TEST(ThreadPoolTest, DestroyWithPendingFunctions)
+{
+	printf("Destroying a thread pool with %u pending functions\n", NumFunctions);
+	nctl::Atomic32 isOpen(0);
+	nctl::Atomic32 numExecuted(0);
+	{
+		nc::ThreadPool threadPool(1);
+		threadPool.enqueue([&isOpen]() {
+			while (isOpen.load() == 0)
+				std::this_thread::yield();
+		});
+
+		Counted counted;
+		for (unsigned int i = 0; i < NumFunctions; i++)
+			threadPool.enqueue([counted, &numExecuted]() { numExecuted.fetchAdd(1); });
+		ASSERT_EQ(Counted::numInstances.load(), static_cast<int32_t>(NumFunctions + 1));
+
+		// The functions that are not executed before the pool stops are destroyed with their captured state
+		isOpen.store(1);
+	}
+
+	printf("Functions executed before the destruction: %d\n", numExecuted.load());
+	ASSERT_LE(numExecuted.load(), static_cast<int32_t>(NumFunctions));
+	ASSERT_EQ(Counted::numInstances.load(), 0);
+}
+
+}
@@ -0,0 +1,205 @@
+#include <ncine/VirtualFileSystem.h>
+#include <ncine/AssetPackBuilder.h>
+#include <ncine/FileSystem.h>
+#include <ncine/IFile.h>
+#include "gtest/gtest.h"
+#include "test_file_functions.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const char *RootDir = "VfsTestDir";
+const char *SubDir = "VfsTestDir/Textures";
+const char *TextFilename = "VfsTestDir/Readme.TXT";
+const char *ImageFilename = "VfsTestDir/Textures/Image.bin";
+const char *PackFilename = "VfsTestPack.ncpk";
+const char *MountPoint = "Data";
+
+nctl::String readFile(const char *filename)
+{
+	nctl::UniquePtr<nc::IFile> fileHandle = nc::IFile::createReadFileHandle(filename);
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+		return nctl::String();
+
+	nctl::String content(static_cast<unsigned int>(fileHandle->size()) + 1);
+	const unsigned long int bytesRead = fileHandle->read(content.data(), fileHandle->size());
+	content.setLength(static_cast<unsigned int>(bytesRead));
+	content.data()[bytesRead] = '\0';
+	return content;
+}
+
+class VirtualFileSystemTest : public ::testing::Test
+{
+  public:
+	void SetUp() override
+	{
+		ASSERT_TRUE(nc::fs::createDir(RootDir));
+		ASSERT_TRUE(nc::fs::createDir(SubDir));
+		ASSERT_TRUE(writeFile(TextFilename, "text from the directory"));
+		ASSERT_TRUE(writeFile(ImageFilename, "image"));
+	}
+
+	void TearDown() override
+	{
+		nc::vfs::unmountAll();
+		nc::fs::deleteFile(PackFilename);
+		nc::fs::deleteFile(ImageFilename);
+		nc::fs::deleteFile(TextFilename);
+		nc::fs::deleteEmptyDir(SubDir);
+		nc::fs::deleteEmptyDir(RootDir);
+	}
+};
+
+TEST_F(VirtualFileSystemTest, MountDirectory)
+{
+	printf("Mounting a directory and querying its files\n");
+	ASSERT_TRUE(nc::vfs::mountDirectory(RootDir, MountPoint));
+	ASSERT_FALSE(nc::vfs::mountDirectory(RootDir, MountPoint));
+	ASSERT_EQ(nc::vfs::numMounts(), 1u);
+	ASSERT_EQ(nc::vfs::numMounts(nc::vfs::MountType::DIRECTORY), 1u);
+	// The mount point, the readme, the textures directory and the image
+	ASSERT_EQ(nc::vfs::numIndexedPaths(), 4u);
+
+	ASSERT_TRUE(nc::vfs::isFile("Data/Readme.TXT"));
+	ASSERT_TRUE(nc::vfs::isDirectory("Data/Textures"));
+	ASSERT_TRUE(nc::vfs::isDirectory("Data"));
+	ASSERT_FALSE(nc::vfs::isFile("Data/Textures"));
+	ASSERT_FALSE(nc::vfs::exists("Data/Missing.txt"));
+	ASSERT_FALSE(nc::vfs::exists("VfsTestDir/Readme.TXT"));
+	ASSERT_EQ(nc::vfs::fileSize("Data/Textures/Image.bin"), 5);
+	ASSERT_EQ(nc::vfs::fileSize("Data/Textures"), -1);
+
+	nc::vfs::MountType type = nc::vfs::MountType::BUFFER;
+	ASSERT_TRUE(nc::vfs::mountType("Data/Readme.TXT", type));
+	ASSERT_EQ(type, nc::vfs::MountType::DIRECTORY);
+
+	ASSERT_STREQ(readFile("Data/Textures/Image.bin").data(), "image");
+}
+
+TEST_F(VirtualFileSystemTest, NormalizedPaths)
+{
+	printf("Paths are looked up without regard to case, separators and dot components\n");
+	ASSERT_TRUE(nc::vfs::mountDirectory(RootDir, MountPoint));
+
+	ASSERT_TRUE(nc::vfs::isFile("data/readme.txt"));
+	ASSERT_TRUE(nc::vfs::isFile("DATA\\TEXTURES\\IMAGE.BIN"));
+	ASSERT_TRUE(nc::vfs::isFile("./Data//Textures/./Image.bin"));
+	ASSERT_TRUE(nc::vfs::isFile("Data/Textures/../Readme.TXT"));
+	ASSERT_TRUE(nc::vfs::isDirectory("Data/Textures/"));
+	ASSERT_FALSE(nc::vfs::exists("Data/Textures/../../Data2/Readme.TXT"));
+
+	// The file is opened from the directory with its actual name
+	ASSERT_STREQ(readFile("data/textures/image.bin").data(), "image");
+}
+
+TEST_F(VirtualFileSystemTest, MountBuffer)
+{
+	printf("Mounting a memory buffer as a file\n");
+	const unsigned char buffer[] = "text from the buffer";
+	ASSERT_TRUE(nc::vfs::mountBuffer("Memory/Buffer.txt", buffer, sizeof(buffer) - 1));
+	ASSERT_FALSE(nc::vfs::mountBuffer("Memory/Empty.txt", buffer, 0));
+
+	ASSERT_TRUE(nc::vfs::isFile("Memory/Buffer.txt"));
+	ASSERT_TRUE(nc::vfs::isDirectory("Memory"));
+	ASSERT_EQ(nc::vfs::fileSize("Memory/Buffer.txt"), static_cast<long int>(sizeof(buffer) - 1));
+
+	nctl::UniquePtr<nc::IFile> fileHandle = nc::IFile::createReadFileHandle("Memory/Buffer.txt");
+	ASSERT_EQ(fileHandle->type(), nc::IFile::FileType::MEMORY);
+	ASSERT_STREQ(readFile("Memory/Buffer.txt").data(), "text from the buffer");
+
+	ASSERT_TRUE(nc::vfs::unmount("Memory/Buffer.txt"));
+	ASSERT_FALSE(nc::vfs::exists("Memory/Buffer.txt"));
+	ASSERT_EQ(nc::vfs::numIndexedPaths(), 0u);
+}
+
+TEST_F(VirtualFileSystemTest, WriteIgnoresMounts)
+{
+	printf("Files are written to their real path even if a mount provides the same path\n");
+	const char *filename = "VfsTestWritten.txt";
+	const unsigned char buffer[] = "text from the buffer";
+	ASSERT_TRUE(nc::vfs::mountBuffer(filename, buffer, sizeof(buffer) - 1));
+
+	nctl::UniquePtr<nc::IFile> fileHandle = nc::IFile::createFileHandle(filename);
+	ASSERT_EQ(fileHandle->type(), nc::IFile::FileType::STANDARD);
+	ASSERT_TRUE(writeFile(filename, "text from the disk"));
+
+	// Reads are still served by the mount until it is removed
+	ASSERT_STREQ(readFile(filename).data(), "text from the buffer");
+	ASSERT_TRUE(nc::vfs::unmount(filename));
+	ASSERT_STREQ(readFile(filename).data(), "text from the disk");
+	nc::fs::deleteFile(filename);
+}
+
+TEST_F(VirtualFileSystemTest, MountPack)
+{
+	printf("Mounting an asset pack and listing its directories\n");
+	const unsigned char content[] = "text from the pack";
+	nc::AssetPackBuilder builder;
+	builder.addBuffer("Readme.TXT", content, sizeof(content) - 1);
+	builder.addBuffer("Sounds/Music/Theme.ogg", content, sizeof(content) - 1);
+	ASSERT_TRUE(builder.saveToFile(PackFilename));
+
+	ASSERT_TRUE(nc::vfs::mountPack(PackFilename, MountPoint));
+	ASSERT_EQ(nc::vfs::numMounts(nc::vfs::MountType::PACK), 1u);
+	ASSERT_TRUE(nc::vfs::isDirectory("Data/Sounds"));
+	ASSERT_TRUE(nc::vfs::isDirectory("Data/Sounds/Music"));
+	ASSERT_TRUE(nc::vfs::isFile("data/sounds/music/theme.ogg"));
+
+	nctl::UniquePtr<nc::IFile> fileHandle = nc::IFile::createReadFileHandle("Data/readme.txt");
+	ASSERT_EQ(fileHandle->type(), nc::IFile::FileType::PACK);
+	ASSERT_STREQ(readFile("Data/readme.txt").data(), "text from the pack");
+}
+
+TEST_F(VirtualFileSystemTest, Priorities)
+{
+	printf("Mounts with a higher priority override the others, then the last mounted one wins\n");
+	const unsigned char first[] = "first buffer";
+	const unsigned char second[] = "second buffer";
+
+	ASSERT_TRUE(nc::vfs::mountDirectory(RootDir, MountPoint, 1));
+	ASSERT_TRUE(nc::vfs::mountBuffer("Data/Readme.txt", first, sizeof(first) - 1));
+	ASSERT_STREQ(readFile("Data/Readme.txt").data(), "text from the directory");
+
+	ASSERT_TRUE(nc::vfs::mountBuffer("DATA/README.TXT", second, sizeof(second) - 1, 1));
+	ASSERT_STREQ(readFile("Data/Readme.txt").data(), "second buffer");
+
+	// Unmounting rebuilds the index from the remaining mounts
+	ASSERT_TRUE(nc::vfs::unmount("DATA/README.TXT"));
+	ASSERT_STREQ(readFile("Data/Readme.txt").data(), "text from the directory");
+	ASSERT_TRUE(nc::vfs::unmount(RootDir));
+	ASSERT_STREQ(readFile("Data/Readme.txt").data(), "first buffer");
+	ASSERT_FALSE(nc::vfs::unmount(RootDir));
+}
+
+TEST_F(VirtualFileSystemTest, RescanDirectories)
+{
+	printf("Rescanning the mounted directories to index new files\n");
+	const char *newFilename = "VfsTestDir/New.txt";
+	ASSERT_TRUE(nc::vfs::mountDirectory(RootDir, MountPoint));
+
+	ASSERT_TRUE(writeFile(newFilename, "new"));
+	ASSERT_FALSE(nc::vfs::exists("Data/New.txt"));
+	nc::vfs::rescanDirectories();
+	ASSERT_TRUE(nc::vfs::isFile("Data/New.txt"));
+	ASSERT_EQ(nc::vfs::fileSize("Data/New.txt"), 3);
+
+	nc::fs::deleteFile(newFilename);
+	nc::vfs::rescanDirectories();
+	ASSERT_FALSE(nc::vfs::exists("Data/New.txt"));
+}
+
+TEST_F(VirtualFileSystemTest, UnmountedPathsUseTheFileSystem)
+{
+	printf("Paths that are not mounted are opened from the file system\n");
+	ASSERT_TRUE(nc::vfs::mountDirectory(SubDir, MountPoint));
+	ASSERT_FALSE(nc::vfs::exists(TextFilename));
+
+	nctl::UniquePtr<nc::IFile> fileHandle = nc::IFile::createReadFileHandle(TextFilename);
+	ASSERT_EQ(fileHandle->type(), nc::IFile::FileType::STANDARD);
+	ASSERT_STREQ(readFile(TextFilename).data(), "text from the directory");
+}
+
+}
@@ -0,0 +1,29 @@
+#ifndef TEST_FILE_FUNCTIONS_H
+#define TEST_FILE_FUNCTIONS_H
+
+#include <cstring>
+#include <ncine/IFile.h>
+
+namespace {
+
+/// Writes a binary file with the specified data, returns false if it cannot be written
+bool writeFile(const char *filename, const void *data, unsigned long int size)
+{
+	nctl::UniquePtr<ncine::IFile> fileHandle = ncine::IFile::createFileHandle(filename);
+	fileHandle->setExitOnFailToOpen(false);
+	fileHandle->open(ncine::IFile::OpenMode::WRITE | ncine::IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+		return false;
+
+	return (fileHandle->write(const_cast<void *>(data), size) == size);
+}
+
+/// Writes a file with the specified string as content, returns false if it cannot be written
+bool writeFile(const char *filename, const char *content)
+{
+	return writeFile(filename, content, strlen(content));
+}
+
+}
+
+#endif
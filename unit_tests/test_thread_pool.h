@@ -0,0 +1,43 @@
+#ifndef TEST_THREAD_POOL_H
+#define TEST_THREAD_POOL_H
+
+#include <thread>
+#include <vector>
+#include <ncine/IThreadPool.h>
+
+namespace {
+
+/// A thread pool that executes every command on its own thread
+class TestThreadPool : public ncine::IThreadPool
+{
+  public:
+	TestThreadPool()
+	    : TestThreadPool(4) {}
+	explicit TestThreadPool(unsigned int numThreads)
+	    : numThreads_(numThreads) {}
+
+	~TestThreadPool() override
+	{
+		for (std::thread &thread : threads_)
+			thread.join();
+	}
+
+	void enqueueCommand(nctl::UniquePtr<ncine::IThreadCommand> threadCommand) override
+	{
+		ncine::IThreadCommand *command = threadCommand.release();
+		threads_.emplace_back([command]() {
+			command->execute();
+			delete command;
+		});
+	}
+
+	unsigned int numThreads() const override { return numThreads_; }
+
+  private:
+	unsigned int numThreads_;
+	std::vector<std::thread> threads_;
+};
+
+}
+
+#endif